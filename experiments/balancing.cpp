@@ -44,14 +44,17 @@ int main()
 
   experiment<std::string, uint32_t, uint32_t, uint32_t, uint32_t, double, bool> exp( "sop_balancing", "benchmark", "size_before", "depth_before", "size_after", "depth_after", "runtime", "equivalent" );
 
-  for ( auto const& benchmark : epfl_benchmarks() )
+  auto const benchmarks = epfl_benchmarks();
+  auto reader = read_benchmarks<xag_network>( benchmarks );
+  while ( auto result = reader.next() )
   {
+    auto const& benchmark = benchmarks[result->index];
     fmt::print( "[i] processing {}\n", benchmark );
-    xag_network xag;
-    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( xag ) ) != lorina::return_code::success )
+    if ( !result->success )
     {
       continue;
     }
+    xag_network const& xag = result->ntk;
 
     const uint32_t size_before = xag.num_gates();
     const uint32_t depth_before = depth_view{ xag }.depth();
@@ -46,6 +46,7 @@
 
 #include <fmt/color.h>
 #include <fmt/format.h>
+#include <mockturtle/io/batch_reader.hpp>
 #include <mockturtle/io/write_bench.hpp>
 #include <mockturtle/io/write_verilog.hpp>
 #include <nlohmann/json.hpp>
@@ -522,6 +523,18 @@ std::string cell_libraries_path( std::string const& cell_library_name )
 #endif
 }
 
+/* reads the AIGER files of benchmarks concurrently, results are returned in the order of `benchmarks` */
+template<class Ntk>
+mockturtle::batch_reader<Ntk> read_benchmarks( std::vector<std::string> const& benchmarks, mockturtle::batch_reader_params const& ps = {} )
+{
+  std::vector<std::string> filenames;
+  for ( auto const& benchmark : benchmarks )
+  {
+    filenames.emplace_back( benchmark_path( benchmark ) );
+  }
+  return mockturtle::batch_reader<Ntk>( filenames, ps );
+}
+
 
 template<class Ntk>
 inline bool abc_cec_impl( Ntk const& ntk, std::string const& benchmark_fullpath )
@@ -0,0 +1,631 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file cec.hpp
+  \brief Combinational equivalence checking of two networks
+
+  Structurally merges two networks, runs bit-parallel random simulation,
+  SAT sweeping with counter-example guided refinement of the equivalence
+  classes, and finally proves the remaining output pairs as independent
+  obligations in parallel.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../networks/xag.hpp"
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+#include "../utils/parallel_utils.hpp"
+#include "../utils/stopwatch.hpp"
+#include "../views/fanout_view.hpp"
+#include "circuit_validator.hpp"
+#include "cleanup.hpp"
+#include "cnf.hpp"
+#include "simulation.hpp"
+
+#include <bill/sat/interface/abc_bsat2.hpp>
+#include <bill/sat/interface/common.hpp>
+#include <fmt/format.h>
+#include <kitty/bit_operations.hpp>
+#include <kitty/hash.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for cec.
+ *
+ * The data structure `cec_params` holds configurable parameters with
+ * default arguments for `cec`.
+ */
+struct cec_params
+{
+  /*! \brief Number of initial random simulation patterns. */
+  uint32_t num_patterns{ 1024u };
+
+  /*! \brief Seed for the random simulation patterns. */
+  uint32_t random_seed{ 1u };
+
+  /*! \brief Whether to merge internal equivalences by SAT sweeping. */
+  bool sat_sweeping{ true };
+
+  /*! \brief Maximum number of sweeping rounds (each round refines the classes with the counter-examples of the previous one). */
+  uint32_t max_rounds{ 8u };
+
+  /*! \brief Conflict limit for each internal equivalence candidate. */
+  uint32_t sweep_conflict_limit{ 100u };
+
+  /*! \brief Maximum number of clauses of the sweeping solver before it is restarted. */
+  uint32_t max_clauses{ 1000u };
+
+  /*! \brief Conflict limit for each output obligation (0 = no limit). */
+  uint32_t conflict_limit{ 0u };
+
+  /*! \brief Number of threads to solve output obligations (0 = hardware concurrency). */
+  uint32_t num_threads{ 1u };
+
+  /*! \brief Be verbose. */
+  bool verbose{ false };
+};
+
+/*! \brief Statistics for cec.
+ *
+ * The data structure `cec_stats` provides data collected by running `cec`.
+ */
+struct cec_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{ 0 };
+
+  /*! \brief Time for simulation. */
+  stopwatch<>::duration time_sim{ 0 };
+
+  /*! \brief Time for SAT sweeping. */
+  stopwatch<>::duration time_sweep{ 0 };
+
+  /*! \brief Time for solving the output obligations. */
+  stopwatch<>::duration time_outputs{ 0 };
+
+  /*! \brief Number of nodes of the merged network. */
+  uint32_t num_nodes{ 0 };
+
+  /*! \brief Number of internal equivalences proven by SAT sweeping. */
+  uint32_t num_merges{ 0 };
+
+  /*! \brief Number of counter-examples found during SAT sweeping. */
+  uint32_t num_cex{ 0 };
+
+  /*! \brief Number of SAT sweeping timeouts. */
+  uint32_t num_timeout{ 0 };
+
+  /*! \brief Number of output pairs proven structurally (after sweeping). */
+  uint32_t num_structural{ 0 };
+
+  /*! \brief Number of output obligations solved with SAT. */
+  uint32_t num_obligations{ 0 };
+
+  /*! \brief Number of output obligations that could not be decided. */
+  uint32_t num_undecided{ 0 };
+
+  /*! \brief Index of an output in which the networks differ. */
+  std::optional<uint32_t> failing_output;
+
+  /*! \brief Counter-example, in case the networks are not equivalent. */
+  std::vector<bool> counter_example;
+
+  void report() const
+  {
+    // clang-format off
+    std::cout <<              "[i] Combinational equivalence checking\n";
+    std::cout << fmt::format( "[i] #nodes       = {:8d}\n", num_nodes );
+    std::cout << fmt::format( "[i] #merges      = {:8d}\n", num_merges );
+    std::cout << fmt::format( "[i] #CEX         = {:8d}\n", num_cex );
+    std::cout << fmt::format( "[i] #timeout     = {:8d}\n", num_timeout );
+    std::cout << fmt::format( "[i] #structural  = {:8d}\n", num_structural );
+    std::cout << fmt::format( "[i] #obligations = {:8d}\n", num_obligations );
+    std::cout << fmt::format( "[i] #undecided   = {:8d}\n", num_undecided );
+    if ( failing_output )
+    {
+      std::cout << fmt::format( "[i] Networks differ in output {} under input assignment: ", *failing_output );
+      for ( auto i = 0u; i < counter_example.size(); ++i )
+        std::cout << "pi" << i << "=" << counter_example[i] << " ";
+      std::cout << "\n";
+    }
+    std::cout << fmt::format( "[i] total time   = {:>5.2f} secs\n", to_seconds( time_total ) );
+    std::cout << fmt::format( "[i]   simulation = {:>5.2f} secs\n", to_seconds( time_sim ) );
+    std::cout << fmt::format( "[i]   sweeping   = {:>5.2f} secs\n", to_seconds( time_sweep ) );
+    std::cout << fmt::format( "[i]   outputs    = {:>5.2f} secs\n", to_seconds( time_outputs ) );
+    // clang-format on
+  }
+};
+
+namespace detail
+{
+
+template<class Ntk1, class Ntk2>
+class cec_impl
+{
+public:
+  using network_t = fanout_view<xag_network>;
+  using node = typename xag_network::node;
+  using signal = typename xag_network::signal;
+  using TT = unordered_node_map<kitty::partial_truth_table, network_t>;
+  using validator_t = circuit_validator<network_t, bill::solvers::bsat2>;
+
+  cec_impl( Ntk1 const& ntk1, Ntk2 const& ntk2, cec_params const& ps, cec_stats& st )
+      : ntk1( ntk1 ), ntk2( ntk2 ), ps( ps ), st( st )
+  {
+  }
+
+  std::optional<bool> run()
+  {
+    stopwatch t( st.time_total );
+
+    build_merged_network();
+    st.num_nodes = ntk.size();
+
+    if ( collect_obligations() )
+    {
+      return true;
+    }
+
+    /* without inputs, all outputs are constants and already decided */
+    if ( ntk.num_pis() == 0u )
+    {
+      st.failing_output = obligations.front();
+      return false;
+    }
+
+    network_t fntk{ ntk };
+    partial_simulator sim( ntk.num_pis(), ps.num_patterns, ps.random_seed );
+    TT tts( fntk );
+
+    call_with_stopwatch( st.time_sim, [&]() {
+      simulate_nodes<network_t>( fntk, tts, sim, true );
+    } );
+
+    if ( find_simulation_cex( fntk, tts, sim ) )
+    {
+      return false;
+    }
+
+    if ( ps.sat_sweeping )
+    {
+      call_with_stopwatch( st.time_sweep, [&]() {
+        sweep( fntk, tts, sim );
+      } );
+
+      if ( collect_obligations() )
+      {
+        return true;
+      }
+      if ( find_simulation_cex( fntk, tts, sim ) )
+      {
+        return false;
+      }
+    }
+
+    return call_with_stopwatch( st.time_outputs, [&]() {
+      return prove_obligations();
+    } );
+  }
+
+private:
+  void build_merged_network()
+  {
+    std::vector<signal> pis;
+    for ( auto i = 0u; i < ntk1.num_pis(); ++i )
+    {
+      pis.push_back( ntk.create_pi() );
+    }
+
+    /* structural hashing in the shared network merges common logic */
+    auto const pos1 = cleanup_dangling( ntk1, ntk, pis.begin(), pis.end() );
+    auto const pos2 = cleanup_dangling( ntk2, ntk, pis.begin(), pis.end() );
+
+    for ( auto const& f : pos1 )
+    {
+      ntk.create_po( f );
+    }
+    for ( auto const& f : pos2 )
+    {
+      ntk.create_po( f );
+    }
+  }
+
+  /* returns true if all output pairs are structurally equal */
+  bool collect_obligations()
+  {
+    obligations.clear();
+    uint32_t const num_outputs = ntk1.num_pos();
+    for ( auto i = 0u; i < num_outputs; ++i )
+    {
+      if ( ntk.po_at( i ) != ntk.po_at( i + num_outputs ) )
+      {
+        obligations.emplace_back( i );
+      }
+    }
+    st.num_structural = num_outputs - static_cast<uint32_t>( obligations.size() );
+    return obligations.empty();
+  }
+
+  bool find_simulation_cex( network_t const& fntk, TT& tts, partial_simulator const& sim )
+  {
+    uint32_t const num_outputs = ntk1.num_pos();
+    for ( auto const& i : obligations )
+    {
+      auto const f = ntk.po_at( i );
+      auto const g = ntk.po_at( i + num_outputs );
+      auto const& tt_f = get_tt( fntk, tts, sim, ntk.get_node( f ) );
+      auto const& tt_g = get_tt( fntk, tts, sim, ntk.get_node( g ) );
+      auto const diff = ntk.is_complemented( f ) == ntk.is_complemented( g ) ? ( tt_f ^ tt_g ) : ~( tt_f ^ tt_g );
+      auto const bit = kitty::find_first_one_bit( diff );
+      if ( bit != -1 )
+      {
+        auto const patterns = sim.get_patterns();
+        st.counter_example.clear();
+        for ( auto const& p : patterns )
+        {
+          st.counter_example.emplace_back( kitty::get_bit( p, bit ) );
+        }
+        st.failing_output = i;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  kitty::partial_truth_table const& get_tt( network_t const& fntk, TT& tts, partial_simulator const& sim, node const& n )
+  {
+    if ( !tts.has( n ) || tts[n].num_bits() != sim.num_bits() )
+    {
+      call_with_stopwatch( st.time_sim, [&]() {
+        simulate_node<network_t>( fntk, n, tts, sim );
+      } );
+    }
+    return tts[n];
+  }
+
+  void sweep( network_t& fntk, TT& tts, partial_simulator& sim )
+  {
+    validator_params vps;
+    vps.conflict_limit = ps.sweep_conflict_limit;
+    vps.max_clauses = ps.max_clauses;
+    validator_t validator( fntk, vps );
+
+    for ( auto round = 0u; round < ps.max_rounds; ++round )
+    {
+      /* candidate classes are keyed by the normalized signatures at the beginning of the round */
+      uint32_t const key_bits = sim.num_bits();
+      std::unordered_map<kitty::partial_truth_table, node, kitty::hash<kitty::partial_truth_table>> classes;
+      bool refined = false;
+
+      fntk.foreach_gate( [&]( auto const& n ) {
+        auto key = get_tt( fntk, tts, sim, n );
+        key.resize( key_bits );
+        if ( kitty::get_bit( key, 0 ) )
+        {
+          key = ~key;
+        }
+
+        auto const [it, inserted] = classes.try_emplace( key, n );
+        if ( inserted )
+        {
+          return;
+        }
+        auto const repr = it->second;
+        if ( fntk.is_dead( repr ) )
+        {
+          it->second = n;
+          return;
+        }
+
+        /* the candidate may already have been separated by counter-examples of this round */
+        auto const& tt_n = get_tt( fntk, tts, sim, n );
+        auto const& tt_r = get_tt( fntk, tts, sim, repr );
+        signal g;
+        if ( tt_n == tt_r )
+        {
+          g = fntk.make_signal( repr );
+        }
+        else if ( tt_n == ~tt_r )
+        {
+          g = !fntk.make_signal( repr );
+        }
+        else
+        {
+          return;
+        }
+
+        auto const res = validator.validate( n, g );
+        if ( !res ) /* timeout */
+        {
+          ++st.num_timeout;
+        }
+        else if ( !( *res ) ) /* SAT, cex found */
+        {
+          ++st.num_cex;
+          refined = true;
+          add_pattern( fntk, tts, sim, validator.cex );
+        }
+        else /* UNSAT, equivalence proven */
+        {
+          ++st.num_merges;
+          /* without structural hashing, the representative keeps a smaller index than all fanouts of `n` */
+          fntk.substitute_node_no_restrash( n, g );
+        }
+      } );
+
+      if ( !refined )
+      {
+        break;
+      }
+    }
+  }
+
+  void add_pattern( network_t const& fntk, TT& tts, partial_simulator& sim, std::vector<bool> const& pattern )
+  {
+    sim.add_pattern( pattern );
+
+    /* re-simulate the whole circuit (for the last block) when a block is full */
+    if ( sim.num_bits() % 64 == 0 )
+    {
+      call_with_stopwatch( st.time_sim, [&]() {
+        simulate_nodes<network_t>( fntk, tts, sim, false );
+      } );
+    }
+  }
+
+  /* solves each remaining output pair with its own solver, in parallel */
+  std::optional<bool> prove_obligations()
+  {
+    st.num_obligations = static_cast<uint32_t>( obligations.size() );
+
+    std::vector<std::optional<bool>> results( obligations.size() );
+    std::vector<std::vector<bool>> cexs( obligations.size() );
+    std::atomic<bool> found_cex{ false };
+
+    parallel_for( ps.num_threads, obligations.size(), [&]( uint64_t i, uint32_t ) {
+      if ( found_cex )
+      {
+        return;
+      }
+      results[i] = prove_obligation( obligations[i], cexs[i] );
+      if ( results[i] && !*results[i] )
+      {
+        found_cex = true;
+      }
+    } );
+
+    bool undecided = false;
+    for ( auto i = 0u; i < obligations.size(); ++i )
+    {
+      if ( !results[i] )
+      {
+        undecided = true;
+        if ( !found_cex )
+        {
+          ++st.num_undecided;
+        }
+      }
+      else if ( !*results[i] )
+      {
+        st.failing_output = obligations[i];
+        st.counter_example = cexs[i];
+        return false;
+      }
+    }
+
+    if ( undecided )
+    {
+      return std::nullopt;
+    }
+    return true;
+  }
+
+  std::optional<bool> prove_obligation( uint32_t index, std::vector<bool>& cex ) const
+  {
+    bill::solver<bill::solvers::bsat2> solver;
+    std::unordered_map<node, bill::lit_type> lits;
+    std::vector<std::pair<uint32_t, bill::lit_type>> pi_lits;
+
+    auto const add_clause = [&]( std::vector<bill::lit_type> const& clause ) {
+      solver.add_clause( clause );
+    };
+
+    /* constant-0 is mapped to a variable forced to false */
+    auto const const_lit = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+    solver.add_clause( { ~const_lit } );
+    lits.emplace( ntk.get_node( ntk.get_constant( false ) ), const_lit );
+
+    /* encode the transitive fanin cones iteratively (the networks may be very deep) */
+    std::unordered_set<node> expanded_nodes;
+    auto const encode = [&]( signal const& f ) {
+      std::vector<std::pair<node, bool>> stack{ { ntk.get_node( f ), false } };
+      while ( !stack.empty() )
+      {
+        auto const [n, expanded] = stack.back();
+        stack.pop_back();
+        if ( lits.find( n ) != lits.end() )
+        {
+          continue;
+        }
+        if ( ntk.is_pi( n ) )
+        {
+          auto const lit = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+          lits.emplace( n, lit );
+          pi_lits.emplace_back( ntk.pi_index( n ), lit );
+          continue;
+        }
+        if ( !expanded )
+        {
+          if ( !expanded_nodes.insert( n ).second )
+          {
+            continue; /* already waiting for its fanins */
+          }
+          stack.emplace_back( n, true );
+          ntk.foreach_fanin( n, [&]( auto const& fi ) {
+            if ( lits.find( ntk.get_node( fi ) ) == lits.end() )
+            {
+              stack.emplace_back( ntk.get_node( fi ), false );
+            }
+          } );
+          continue;
+        }
+
+        std::vector<bill::lit_type> child_lits;
+        ntk.foreach_fanin( n, [&]( auto const& fi ) {
+          child_lits.emplace_back( lit_not_cond( lits.at( ntk.get_node( fi ) ), ntk.is_complemented( fi ) ) );
+        } );
+        auto const lit = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+        if ( ntk.is_and( n ) )
+        {
+          detail::on_and( lit, child_lits[0], child_lits[1], add_clause );
+        }
+        else
+        {
+          assert( ntk.is_xor( n ) );
+          detail::on_xor( lit, child_lits[0], child_lits[1], add_clause );
+        }
+        lits.emplace( n, lit );
+      }
+      return lit_not_cond( lits.at( ntk.get_node( f ) ), ntk.is_complemented( f ) );
+    };
+
+    auto const lit_f = encode( ntk.po_at( index ) );
+    auto const lit_g = encode( ntk.po_at( index + ntk1.num_pos() ) );
+
+    auto const diff = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+    detail::on_xor( diff, lit_f, lit_g, add_clause );
+
+    auto const res = solver.solve( { diff }, ps.conflict_limit );
+    if ( res == bill::result::states::satisfiable )
+    {
+      auto const model = solver.get_model().model();
+      cex.assign( ntk.num_pis(), false );
+      for ( auto const& [i, lit] : pi_lits )
+      {
+        cex[i] = model.at( lit.variable() ) == bill::lbool_type::true_;
+      }
+      return false;
+    }
+    else if ( res == bill::result::states::unsatisfiable )
+    {
+      return true;
+    }
+    return std::nullopt;
+  }
+
+private:
+  Ntk1 const& ntk1;
+  Ntk2 const& ntk2;
+  cec_params const& ps;
+  cec_stats& st;
+
+  xag_network ntk;
+  std::vector<uint32_t> obligations;
+};
+
+} // namespace detail
+
+/*! \brief Combinational equivalence checking of two networks.
+ *
+ * Checks whether two networks with the same number of primary inputs and
+ * primary outputs compute the same functions.  Unlike `equivalence_checking`,
+ * which expects a miter, this function takes the two networks directly and
+ * copies them into a shared XAG, so that common structure is merged by
+ * structural hashing.
+ *
+ * The remaining output pairs are first checked with bit-parallel random
+ * simulation.  Then, if `sat_sweeping` is enabled, candidate internal
+ * equivalences (nodes with equal or complemented signatures) are proven
+ * with SAT and merged in topological order.  Counter-examples are added to
+ * the simulation patterns to refine the candidate classes in the next
+ * round.  Finally, each output pair that is not structurally equal is
+ * solved as an independent proof obligation with its own SAT solver; the
+ * obligations are distributed over `num_threads` threads.
+ *
+ * The function returns `nullopt` if the input and output counts differ or
+ * if an obligation could not be decided within the resource limits.
+ * Otherwise it returns `true` if the networks are equivalent and `false` if
+ * they are not.  In the latter case the index of a differing output and a
+ * counter-example following the order of the primary inputs are written to
+ * the statistics.
+ *
+ * **Required network functions (for both networks):**
+ * - `num_pis`
+ * - `num_pos`
+ * - `foreach_pi`
+ * - `foreach_po`
+ * - `foreach_node`
+ * - `foreach_fanin`
+ *
+ * \param ntk1 First network
+ * \param ntk2 Second network
+ * \param ps Parameters
+ * \param pst Statistics
+ */
+template<class Ntk1, class Ntk2>
+std::optional<bool> cec( Ntk1 const& ntk1, Ntk2 const& ntk2, cec_params const& ps = {}, cec_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk1>, "Ntk1 is not a network type" );
+  static_assert( is_network_type_v<Ntk2>, "Ntk2 is not a network type" );
+  static_assert( has_num_pis_v<Ntk1>, "Ntk1 does not implement the num_pis method" );
+  static_assert( has_num_pos_v<Ntk1>, "Ntk1 does not implement the num_pos method" );
+  static_assert( has_num_pis_v<Ntk2>, "Ntk2 does not implement the num_pis method" );
+  static_assert( has_num_pos_v<Ntk2>, "Ntk2 does not implement the num_pos method" );
+
+  if ( ( ntk1.num_pis() != ntk2.num_pis() ) || ( ntk1.num_pos() != ntk2.num_pos() ) )
+  {
+    return std::nullopt;
+  }
+
+  cec_stats st;
+  detail::cec_impl<Ntk1, Ntk2> impl( ntk1, ntk2, ps, st );
+  auto const result = impl.run();
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+
+  return result;
+}
+
+} /* namespace mockturtle */
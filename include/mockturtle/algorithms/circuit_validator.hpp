@@ -34,6 +34,7 @@
 #pragma once
 
 #include "../networks/events.hpp"
+#include "../traits.hpp"
 #include "../utils/index_list/index_list.hpp"
 #include "../utils/node_map.hpp"
 #include "cnf.hpp"
@@ -59,6 +60,22 @@ struct validator_params
 
   /*! \brief Seed for randomized solving. */
   uint32_t random_seed{ 0 };
+
+  /*! \brief Retire dead CNF cones instead of restarting the solver when `max_clauses` is exceeded.
+   *
+   * The clauses of each query are guarded by an activation literal, which is
+   * disabled right after solving, and the clauses of the encoded nodes are
+   * guarded by one activation literal per generation.  When the active clauses
+   * exceed `max_clauses`, the generations in which at least half of the clauses
+   * belong to dead (or re-encoded) nodes are retired, followed by the oldest
+   * ones until half of the clauses are free.  Live nodes depending on retired
+   * clauses are re-encoded on demand, and the learned clauses that do not
+   * depend on them are kept.  Not used with ODCs.
+   */
+  bool incremental_gc{ false };
+
+  /*! \brief Restart the solver anyway when it holds more than `gc_restart_ratio * max_clauses` clauses (including retired ones). */
+  uint32_t gc_restart_ratio{ 8 };
 };
 
 template<class Ntk, bill::solvers Solver = bill::solvers::glucose_41, bool use_pushpop = false, bool randomize = false, bool use_odc = false>
@@ -158,10 +175,7 @@ public:
       construct( ntk.get_node( d ) );
     }
     auto const res = validate( ntk.get_node( f ), lit_not_cond( literals[d], ntk.is_complemented( f ) ^ ntk.is_complemented( d ) ) );
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    check_clauses();
     return res;
   }
 
@@ -173,10 +187,7 @@ public:
       construct( ntk.get_node( d ) );
     }
     auto const res = validate( root, lit_not_cond( literals[d], ntk.is_complemented( d ) ) );
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    check_clauses();
     return res;
   }
 
@@ -238,6 +249,11 @@ public:
     {
       push();
     }
+    else if ( gc_enabled() )
+    {
+      /* guard the clauses of the index list by the activation literal of the query */
+      open_query();
+    }
 
     if constexpr ( std::is_same_v<index_list_type, xag_index_list<true>> || std::is_same_v<index_list_type, xag_index_list<false>> )
     {
@@ -286,10 +302,7 @@ public:
       pop();
     }
 
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    check_clauses();
 
     return res;
   }
@@ -333,10 +346,7 @@ public:
       res = solve( { lit_not_cond( literals[root], value ) } );
     }
 
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    check_clauses();
     return res;
   }
 
@@ -400,10 +410,7 @@ public:
     }
 
     pop();
-    if ( solver.num_clauses() > ps.max_clauses && num_invoke >= MIN_NUM_INVOKE )
-    {
-      restart();
-    }
+    check_clauses();
     return generated;
   }
 
@@ -432,6 +439,16 @@ private:
     solver.add_variables( ntk.num_pis() + 1 );
     solver.add_clause( { ~literals[ntk.get_constant( false )] } );
 
+    if ( gc_enabled() )
+    {
+      cnf_nodes.clear();
+      gen_lits.clear();
+      gen_clauses.clear();
+      gen_retired.clear();
+      num_retired_clauses = 0u;
+      new_generation();
+    }
+
     if constexpr ( has_EXCDC_interface_v<Ntk> )
     {
       ntk.add_EXCDC_clauses( solver );
@@ -500,25 +517,39 @@ private:
     bill::lit_type node_lit = literals[n] = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
     constructed[n] = true;
 
+    auto const num_clauses_before = solver.num_clauses();
+    cone_lit = node_lit;
+    auto const& clause_fn = gc_enabled() ? add_cone_clause_fn : add_clause_fn;
     if ( ntk.is_and( n ) )
     {
-      detail::on_and<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], add_clause_fn );
+      detail::on_and<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], clause_fn );
     }
     else if ( ntk.is_xor( n ) )
     {
-      detail::on_xor<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], add_clause_fn );
+      detail::on_xor<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], clause_fn );
     }
     else if ( ntk.is_xor3( n ) )
     {
-      detail::on_xor3<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], child_lits[2], add_clause_fn );
+      detail::on_xor3<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], child_lits[2], clause_fn );
     }
     else if ( ntk.is_maj( n ) )
     {
-      detail::on_maj<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], child_lits[2], add_clause_fn );
+      detail::on_maj<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], child_lits[2], clause_fn );
     }
     else if ( ntk.is_ite( n ) )
     {
-      detail::on_ite<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], child_lits[2], add_clause_fn );
+      detail::on_ite<add_clause_fn_t>( node_lit, child_lits[0], child_lits[1], child_lits[2], clause_fn );
+    }
+
+    if ( gc_enabled() )
+    {
+      cnf_node entry{ n, node_lit.variable(), uint32_t( gen_lits.size() - 1u ), solver.num_clauses() - num_clauses_before };
+      for ( auto const& l : child_lits )
+      {
+        entry.fanin_vars.emplace_back( l.variable() );
+      }
+      gen_clauses.back() += entry.num_clauses;
+      cnf_nodes.emplace_back( entry );
     }
     return node_lit;
   }
@@ -528,6 +559,10 @@ private:
     solver.push();
     between_push_pop = true;
     tmp.clear();
+    if ( gc_enabled() )
+    {
+      saved_gc_state = { uint32_t( cnf_nodes.size() ), gen_clauses.back(), num_retired_clauses };
+    }
   }
 
   void pop()
@@ -538,6 +573,177 @@ private:
       constructed.erase( n );
     }
     between_push_pop = false;
+    if ( gc_enabled() )
+    {
+      /* the clauses added after `push` were rolled back */
+      cnf_nodes.resize( std::get<0>( saved_gc_state ) );
+      gen_clauses.back() = std::get<1>( saved_gc_state );
+      num_retired_clauses = std::get<2>( saved_gc_state );
+    }
+  }
+
+  bool gc_enabled() const
+  {
+    if constexpr ( use_odc || has_EXODC_interface_v<Ntk> )
+    {
+      return false;
+    }
+    else
+    {
+      return ps.incremental_gc;
+    }
+  }
+
+  bool is_dead_node( node const& n ) const
+  {
+    if constexpr ( has_is_dead_v<Ntk> )
+    {
+      return ntk.is_dead( n );
+    }
+    else
+    {
+      (void)n;
+      return false;
+    }
+  }
+
+  /* restarts the solver, or collects garbage, when there are too many clauses */
+  void check_clauses()
+  {
+    if ( num_invoke < MIN_NUM_INVOKE )
+    {
+      return;
+    }
+
+    if ( !gc_enabled() )
+    {
+      if ( solver.num_clauses() > ps.max_clauses )
+      {
+        ++num_restarts;
+        restart();
+      }
+    }
+    else if ( solver.num_clauses() - num_retired_clauses > ps.max_clauses )
+    {
+      /* retired clauses are satisfied, but the solver keeps them in memory */
+      if ( solver.num_clauses() > uint64_t( ps.max_clauses ) * ps.gc_restart_ratio )
+      {
+        ++num_restarts;
+        restart();
+      }
+      else
+      {
+        collect_garbage();
+      }
+    }
+  }
+
+  void collect_garbage()
+  {
+    num_invoke = 0u;
+    ++num_garbage_collections;
+
+    /* count the clauses of dead and re-encoded nodes in each generation */
+    std::vector<uint32_t> garbage( gen_lits.size(), 0u );
+    for ( auto& e : cnf_nodes )
+    {
+      e.stale = e.stale || is_dead_node( e.n );
+      if ( e.stale )
+      {
+        garbage[e.gen] += e.num_clauses;
+      }
+    }
+
+    /* retire the generations consisting mostly of garbage */
+    std::vector<bool> retire( gen_lits.size(), false );
+    std::vector<uint32_t> live_gens;
+    uint32_t active = solver.num_clauses() - num_retired_clauses;
+    for ( auto g = 0u; g < gen_lits.size(); ++g )
+    {
+      if ( gen_retired[g] )
+      {
+        continue;
+      }
+      if ( gen_clauses[g] > 0u && 2u * garbage[g] >= gen_clauses[g] )
+      {
+        retire[g] = true;
+        active -= gen_clauses[g];
+      }
+      else
+      {
+        live_gens.emplace_back( g );
+      }
+    }
+
+    /* retire the oldest generations until half of the clauses are free, but keep the
+       newest one, which holds the cones of the latest queries (and bound the number of assumptions) */
+    for ( auto i = 0u; i + 1u < live_gens.size() && ( active > ps.max_clauses / 2u || live_gens.size() - i >= MAX_NUM_GENERATIONS ); ++i )
+    {
+      retire[live_gens[i]] = true;
+      active -= gen_clauses[live_gens[i]];
+    }
+
+    /* forget the nodes of retired generations and the nodes encoded on top of them */
+    std::vector<bool> invalid( solver.num_variables(), false );
+    std::vector<cnf_node> kept;
+    for ( auto& e : cnf_nodes )
+    {
+      bool const drop = retire[e.gen] || std::any_of( e.fanin_vars.begin(), e.fanin_vars.end(), [&]( auto v ) { return invalid[v]; } );
+      if ( drop )
+      {
+        invalid[e.var] = true;
+        if ( !e.stale && constructed.has( e.n ) && uint32_t( literals[e.n].variable() ) == e.var )
+        {
+          constructed.erase( e.n );
+        }
+        e.stale = true;
+      }
+      if ( !retire[e.gen] )
+      {
+        kept.emplace_back( e );
+      }
+    }
+    cnf_nodes = std::move( kept );
+
+    for ( auto g = 0u; g < gen_lits.size(); ++g )
+    {
+      if ( retire[g] )
+      {
+        solver.add_clause( { gen_lits[g] } );
+        num_retired_clauses += gen_clauses[g] + 1u;
+        gen_retired[g] = true;
+      }
+    }
+
+    new_generation();
+  }
+
+  void new_generation()
+  {
+    gen_lits.emplace_back( solver.add_variable(), bill::lit_type::polarities::positive );
+    gen_clauses.emplace_back( 0u );
+    gen_retired.emplace_back( false );
+  }
+
+  /* activation literal of the current query, disabled by `close_query` */
+  bill::lit_type open_query()
+  {
+    if ( !query_lit )
+    {
+      query_lit = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+      query_begin = solver.num_clauses();
+    }
+    return *query_lit;
+  }
+
+  void close_query()
+  {
+    if ( gc_enabled() )
+    {
+      solver.add_clause( { *query_lit } );
+      num_retired_clauses += solver.num_clauses() - query_begin;
+    }
+    query_lit = std::nullopt;
   }
 
   bill::lit_type add_clauses_for_2input_gate( bill::lit_type a, bill::lit_type b, std::optional<bill::lit_type> c = std::nullopt, gate_type type = AND )
@@ -547,11 +753,11 @@ private:
     auto nlit = c ? *c : bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
     if ( type == AND )
     {
-      detail::on_and<add_clause_fn_t>( nlit, a, b, add_clause_fn );
+      detail::on_and<add_clause_fn_t>( nlit, a, b, add_query_clause_fn );
     }
     else if ( type == XOR )
     {
-      detail::on_xor<add_clause_fn_t>( nlit, a, b, add_clause_fn );
+      detail::on_xor<add_clause_fn_t>( nlit, a, b, add_query_clause_fn );
     }
 
     return nlit;
@@ -564,15 +770,15 @@ private:
     auto nlit = d ? *d : bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
     if ( type == MAJ )
     {
-      detail::on_maj<add_clause_fn_t>( nlit, a, b, c, add_clause_fn );
+      detail::on_maj<add_clause_fn_t>( nlit, a, b, c, add_query_clause_fn );
     }
     else if ( type == XOR )
     {
-      detail::on_xor3<add_clause_fn_t>( nlit, a, b, c, add_clause_fn );
+      detail::on_xor3<add_clause_fn_t>( nlit, a, b, c, add_query_clause_fn );
     }
     else if ( type == MUX )
     {
-      detail::on_ite<add_clause_fn_t>( nlit, a, b, c, add_clause_fn );
+      detail::on_ite<add_clause_fn_t>( nlit, a, b, c, add_query_clause_fn );
     }
 
     return nlit;
@@ -581,6 +787,16 @@ private:
   std::optional<bool> solve( std::vector<bill::lit_type> assumptions )
   {
     ++num_invoke;
+    if ( gc_enabled() )
+    {
+      for ( auto g = 0u; g < gen_lits.size(); ++g )
+      {
+        if ( !gen_retired[g] )
+        {
+          assumptions.emplace_back( ~gen_lits[g] );
+        }
+      }
+    }
     auto const res = solver.solve( assumptions, ps.conflict_limit );
 
     if ( res == bill::result::states::satisfiable )
@@ -631,18 +847,20 @@ private:
       }
       else
       {
-        auto nlit = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+        auto const nlit = open_query();
         solver.add_clause( { literals[root], lit, nlit } );
         solver.add_clause( { ~( literals[root] ), ~lit, nlit } );
         res = solve( { ~nlit } );
+        close_query();
       }
     }
     else
     {
-      auto nlit = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+      auto const nlit = open_query();
       solver.add_clause( { literals[root], lit, nlit } );
       solver.add_clause( { ~( literals[root] ), ~lit, nlit } );
       res = solve( { ~nlit } );
+      close_query();
     }
 
     return res;
@@ -781,10 +999,55 @@ private:
   unordered_node_map<bool, Ntk> constructed;
   bill::solver<Solver> solver;
   add_clause_fn_t add_clause_fn = [&]( auto const& clause ) { solver.add_clause( clause ); };
+  /* only the clauses implying the node literal are guarded; once they are
+     disabled, the node is unconstrained from below and can always be false */
+  add_clause_fn_t add_cone_clause_fn = [&]( auto const& clause ) {
+    if ( std::find( clause.begin(), clause.end(), cone_lit ) == clause.end() )
+    {
+      solver.add_clause( clause );
+      return;
+    }
+    auto guarded = clause;
+    guarded.emplace_back( gen_lits.back() );
+    solver.add_clause( guarded );
+  };
+  add_clause_fn_t add_query_clause_fn = [&]( auto const& clause ) {
+    if ( gc_enabled() && query_lit )
+    {
+      auto guarded = clause;
+      guarded.emplace_back( *query_lit );
+      solver.add_clause( guarded );
+    }
+    else
+    {
+      solver.add_clause( clause );
+    }
+  };
 
   static const uint32_t MIN_NUM_INVOKE = 20u;
   uint32_t num_invoke;
 
+  /* incremental garbage collection */
+  struct cnf_node
+  {
+    node n;
+    uint32_t var;
+    uint32_t gen;
+    uint32_t num_clauses;
+    std::vector<uint32_t> fanin_vars{};
+    bool stale{ false };
+  };
+  static const uint32_t MAX_NUM_GENERATIONS = 16u;
+  std::vector<cnf_node> cnf_nodes;
+  std::vector<bill::lit_type> gen_lits;
+  std::vector<uint32_t> gen_clauses;
+  std::vector<bool> gen_retired;
+  uint32_t num_retired_clauses{ 0u };
+  bill::lit_type cone_lit;
+  std::optional<bill::lit_type> query_lit;
+  uint32_t query_begin{ 0u };
+  std::tuple<uint32_t, uint32_t, uint32_t> saved_gc_state;
+
   bool between_push_pop = false;
   std::vector<node> tmp;
 
@@ -794,6 +1057,10 @@ private:
 
 public:
   std::vector<bool> cex;
+
+  /* number of incremental garbage collections and of solver restarts */
+  uint32_t num_garbage_collections{ 0u };
+  uint32_t num_restarts{ 0u };
 };
 
 } /* namespace mockturtle */
\ No newline at end of file
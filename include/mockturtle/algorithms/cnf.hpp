@@ -36,7 +36,9 @@
 
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include <bill/sat/interface/common.hpp>
@@ -44,9 +46,12 @@
 #include <fmt/format.h>
 #include <kitty/cnf.hpp>
 #include <kitty/constructors.hpp>
+#include <kitty/isop.hpp>
 
 #include "../traits.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/stopwatch.hpp"
+#include "cut_enumeration.hpp"
 
 namespace mockturtle
 {
@@ -504,4 +509,409 @@ std::vector<lit_t> generate_cnf( Ntk const& ntk, clause_callback_t<lit_t> const&
   return impl.run();
 }
 
+/*! \brief Parameters for generate_mapped_cnf.
+ *
+ * The data structure `cnf_mapping_params` holds configurable parameters with
+ * default arguments for `generate_mapped_cnf`.
+ */
+struct cnf_mapping_params
+{
+  /*! \brief Maximum number of leaves of a cut. */
+  uint32_t cut_size{ 4u };
+
+  /*! \brief Maximum number of cuts per node. */
+  uint32_t cut_limit{ 8u };
+
+  /*! \brief Number of exact area recovery rounds after area flow. */
+  uint32_t area_rounds{ 2u };
+};
+
+/*! \brief Statistics for generate_mapped_cnf.
+ *
+ * The data structure `cnf_mapping_stats` provides data collected by running
+ * `generate_mapped_cnf`.
+ */
+struct cnf_mapping_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{ 0 };
+
+  /*! \brief Number of generated clauses. */
+  uint32_t num_clauses{ 0u };
+
+  /*! \brief Number of nodes selected as cut roots (encoded with a variable). */
+  uint32_t num_roots{ 0u };
+
+  /*! \brief Number of distinct cut functions whose covers were computed. */
+  uint32_t num_covers{ 0u };
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] clauses = {:8d}   roots = {:8d}   covers = {:6d}   time = {:>5.2f} secs\n",
+                              num_clauses, num_roots, num_covers, to_seconds( time_total ) );
+  }
+};
+
+namespace detail
+{
+
+template<class Ntk, typename lit_t>
+class generate_mapped_cnf_impl
+{
+public:
+  using node = typename Ntk::node;
+  using network_cuts_t = network_cuts<Ntk, true, empty_cut_data>;
+  using cut_t = typename network_cuts_t::cut_t;
+
+  /* ISOPs of the on-set and the off-set of a normalized cut function */
+  struct cover
+  {
+    std::vector<kitty::cube> onset;
+    std::vector<kitty::cube> offset;
+  };
+
+public:
+  generate_mapped_cnf_impl( Ntk const& ntk, clause_callback_t<lit_t> const& fn, std::optional<node_map<lit_t, Ntk>> const& node_lits, cnf_mapping_params const& ps, cnf_mapping_stats& st )
+      : ntk_( ntk ),
+        fn_( fn ),
+        node_lits_( node_lits ? *node_lits : node_literals<Ntk, lit_t>( ntk ) ),
+        ps_( ps ),
+        st_( st ),
+        cuts_( cut_enumeration<Ntk, true>( ntk, cut_params( ps ) ) ),
+        best_cut_( ntk.size(), 0u ),
+        map_refs_( ntk.size(), 0u ),
+        flows_( ntk.size(), 0.0f )
+  {
+  }
+
+  std::vector<lit_t> run()
+  {
+    stopwatch t( st_.time_total );
+
+    ntk_.foreach_gate( [&]( auto const& n ) {
+      gates_.emplace_back( n );
+    } );
+
+    compute_area_flow();
+    compute_map_refs();
+    for ( auto i = 0u; i < ps_.area_rounds; ++i )
+    {
+      compute_exact_area();
+    }
+
+    /* unit clause for constant-0 */
+    emit( { lit_not( node_lits_[ntk_.get_constant( false )] ) } );
+
+    for ( auto const& n : gates_ )
+    {
+      if ( map_refs_[ntk_.node_to_index( n )] > 0u )
+      {
+        emit_cut( n );
+      }
+    }
+
+    std::vector<lit_t> output_lits;
+    ntk_.foreach_po( [&]( auto const& f ) {
+      output_lits.push_back( lit_not_cond( node_lits_[f], ntk_.is_complemented( f ) ) );
+    } );
+
+    return output_lits;
+  }
+
+private:
+  static cut_enumeration_params cut_params( cnf_mapping_params const& ps )
+  {
+    cut_enumeration_params cps;
+    cps.cut_size = ps.cut_size;
+    cps.cut_limit = ps.cut_limit;
+    cps.minimize_truth_table = true;
+    return cps;
+  }
+
+  bool is_gate( uint32_t index ) const
+  {
+    auto const n = ntk_.index_to_node( index );
+    return !ntk_.is_constant( n ) && !ntk_.is_pi( n );
+  }
+
+  bool is_trivial( uint32_t index, cut_t const& cut ) const
+  {
+    return cut.size() == 1u && *cut.begin() == index;
+  }
+
+  cover const& cut_cover( cut_t const& cut )
+  {
+    auto const key = cut->func_id >> 1;
+    auto it = covers_.find( key );
+    if ( it == covers_.end() )
+    {
+      /* the cache returns the (possibly complemented) cut function */
+      auto tt = cuts_.truth_table( cut );
+      if ( cut->func_id & 1 )
+      {
+        tt = ~tt;
+      }
+      cover c;
+      c.onset = kitty::isop( tt );
+      c.offset = kitty::isop( ~tt );
+      it = covers_.emplace( key, std::move( c ) ).first;
+      ++st_.num_covers;
+    }
+    return it->second;
+  }
+
+  uint32_t cut_cost( cut_t const& cut )
+  {
+    auto const& c = cut_cover( cut );
+    return static_cast<uint32_t>( c.onset.size() + c.offset.size() );
+  }
+
+  void compute_area_flow()
+  {
+    for ( auto const& n : gates_ )
+    {
+      auto const index = ntk_.node_to_index( n );
+      auto best_flow = std::numeric_limits<float>::max();
+      uint32_t best_size{ 0u };
+
+      uint32_t i{ 0u };
+      for ( auto const* cut : cuts_.cuts( index ) )
+      {
+        if ( !is_trivial( index, *cut ) )
+        {
+          auto flow = static_cast<float>( cut_cost( *cut ) );
+          for ( auto leaf : *cut )
+          {
+            flow += flows_[leaf];
+          }
+
+          if ( flow < best_flow - epsilon || ( flow < best_flow + epsilon && cut->size() < best_size ) )
+          {
+            best_flow = flow;
+            best_size = cut->size();
+            best_cut_[index] = i;
+          }
+        }
+        ++i;
+      }
+
+      flows_[index] = best_flow / std::max( 1u, ntk_.fanout_size( n ) );
+    }
+  }
+
+  void compute_map_refs()
+  {
+    std::fill( map_refs_.begin(), map_refs_.end(), 0u );
+    ntk_.foreach_po( [&]( auto const& f ) {
+      ++map_refs_[ntk_.node_to_index( ntk_.get_node( f ) )];
+    } );
+
+    for ( auto it = gates_.rbegin(); it != gates_.rend(); ++it )
+    {
+      auto const index = ntk_.node_to_index( *it );
+      if ( map_refs_[index] > 0u )
+      {
+        for ( auto leaf : best_cut( index ) )
+        {
+          ++map_refs_[leaf];
+        }
+      }
+    }
+  }
+
+  void compute_exact_area()
+  {
+    for ( auto const& n : gates_ )
+    {
+      auto const index = ntk_.node_to_index( n );
+      if ( map_refs_[index] == 0u )
+      {
+        continue;
+      }
+
+      cut_deref( best_cut( index ) );
+
+      uint32_t best_area = std::numeric_limits<uint32_t>::max();
+      uint32_t best_size{ 0u };
+      uint32_t i{ 0u };
+      for ( auto const* cut : cuts_.cuts( index ) )
+      {
+        if ( !is_trivial( index, *cut ) )
+        {
+          auto const area = cut_ref( *cut );
+          cut_deref( *cut );
+          if ( area < best_area || ( area == best_area && cut->size() < best_size ) )
+          {
+            best_area = area;
+            best_size = cut->size();
+            best_cut_[index] = i;
+          }
+        }
+        ++i;
+      }
+
+      cut_ref( best_cut( index ) );
+    }
+  }
+
+  /* references the leaves of a cut and returns the number of clauses that are added */
+  uint32_t cut_ref( cut_t const& cut )
+  {
+    uint32_t area = cut_cost( cut );
+    for ( auto leaf : cut )
+    {
+      if ( map_refs_[leaf]++ == 0u && is_gate( leaf ) )
+      {
+        area += cut_ref( best_cut( leaf ) );
+      }
+    }
+    return area;
+  }
+
+  void cut_deref( cut_t const& cut )
+  {
+    for ( auto leaf : cut )
+    {
+      if ( --map_refs_[leaf] == 0u && is_gate( leaf ) )
+      {
+        cut_deref( best_cut( leaf ) );
+      }
+    }
+  }
+
+  cut_t const& best_cut( uint32_t index ) const
+  {
+    return cuts_.cuts( index )[best_cut_[index]];
+  }
+
+  void emit_cut( node const& n )
+  {
+    auto const& cut = best_cut( ntk_.node_to_index( n ) );
+    auto const& c = cut_cover( cut );
+    auto const complemented = ( cut->func_id & 1 ) == 1;
+    ++st_.num_roots;
+
+    std::vector<lit_t> leaf_lits;
+    for ( auto leaf : cut )
+    {
+      leaf_lits.emplace_back( node_lits_[ntk_.index_to_node( leaf )] );
+    }
+
+    /* each cube of the on-set implies the root, each cube of the off-set its complement */
+    auto const emit_cubes = [&]( std::vector<kitty::cube> const& cubes, lit_t const& root_lit ) {
+      for ( auto const& cube : cubes )
+      {
+        std::vector<lit_t> clause;
+        for ( auto i = 0u; i < leaf_lits.size(); ++i )
+        {
+          if ( cube.get_mask( i ) )
+          {
+            clause.push_back( lit_not_cond( leaf_lits[i], cube.get_bit( i ) ) );
+          }
+        }
+        clause.push_back( root_lit );
+        emit( clause );
+      }
+    };
+
+    auto const root_lit = lit_not_cond( node_lits_[n], complemented );
+    emit_cubes( c.onset, root_lit );
+    emit_cubes( c.offset, lit_not( root_lit ) );
+  }
+
+  void emit( std::vector<lit_t> const& clause )
+  {
+    ++st_.num_clauses;
+    fn_( clause );
+  }
+
+private:
+  static constexpr float epsilon{ 0.005f };
+
+  Ntk const& ntk_;
+  clause_callback_t<lit_t> const& fn_;
+  node_map<lit_t, Ntk> node_lits_;
+  cnf_mapping_params const& ps_;
+  cnf_mapping_stats& st_;
+
+  network_cuts_t cuts_;
+  std::vector<node> gates_;
+  std::vector<uint32_t> best_cut_;
+  std::vector<uint32_t> map_refs_;
+  std::vector<float> flows_;
+  std::unordered_map<uint32_t, cover> covers_;
+};
+
+} // namespace detail
+
+/*! \brief Generates a compact CNF for a logic network by cut mapping.
+ *
+ * Instead of one set of Tseytin clauses per gate, this function maps the
+ * network into cuts that minimize the total number of clauses and encodes
+ * only the root of each selected cut with a variable.  The clauses of a cut
+ * are derived from the irredundant sums-of-products of its function and of
+ * the complement, which are computed once per distinct cut function and
+ * cached.  The cuts are selected by area flow followed by `area_rounds`
+ * rounds of exact area recovery, using the clause count as area.
+ *
+ * The interface follows `generate_cnf`: each clause is passed to `fn`, the
+ * (optional) literal map `node_lits` defines the variables of the nodes, and
+ * the return value holds the literal of each primary output.  Only the
+ * literals of primary inputs, constants, and cut roots (including the
+ * drivers of primary outputs) are constrained by the generated clauses.
+ *
+ * \param ntk Logic network
+ * \param fn Clause creation function
+ * \param ps Parameters
+ * \param node_lits (optional) custom node literal map
+ * \param pst Statistics
+ */
+template<class Ntk>
+std::vector<uint32_t> generate_mapped_cnf( Ntk const& ntk, clause_callback_t<uint32_t> const& fn, cnf_mapping_params const& ps = {}, std::optional<node_map<uint32_t, Ntk>> const& node_lits = {}, cnf_mapping_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+  static_assert( has_is_pi_v<Ntk>, "Ntk does not implement the is_pi method" );
+  static_assert( has_fanout_size_v<Ntk>, "Ntk does not implement the fanout_size method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( has_index_to_node_v<Ntk>, "Ntk does not implement the index_to_node method" );
+
+  cnf_mapping_stats st;
+  detail::generate_mapped_cnf_impl<Ntk, uint32_t> impl( ntk, fn, node_lits, ps, st );
+  auto const output_lits = impl.run();
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+  return output_lits;
+}
+
+template<class Ntk, typename lit_t = bill::lit_type>
+std::vector<lit_t> generate_mapped_cnf( Ntk const& ntk, clause_callback_t<lit_t> const& fn, cnf_mapping_params const& ps = {}, std::optional<node_map<lit_t, Ntk>> const& node_lits = {}, cnf_mapping_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+  static_assert( has_is_pi_v<Ntk>, "Ntk does not implement the is_pi method" );
+  static_assert( has_fanout_size_v<Ntk>, "Ntk does not implement the fanout_size method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( has_index_to_node_v<Ntk>, "Ntk does not implement the index_to_node method" );
+
+  cnf_mapping_stats st;
+  detail::generate_mapped_cnf_impl<Ntk, lit_t> impl( ntk, fn, node_lits, ps, st );
+  auto const output_lits = impl.run();
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+  return output_lits;
+}
+
 } // namespace mockturtle
@@ -33,12 +33,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <numeric>
 #include <optional>
-#include <set>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 #include "../networks/klut.hpp"
@@ -46,6 +48,7 @@
 #include "../traits.hpp"
 #include "../utils/cost_functions.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/parallel_utils.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/cut_view.hpp"
@@ -101,6 +104,22 @@ struct cut_rewriting_params
   /*! \brief If true, candidates are only accepted if they do not increase logic level of node. */
   bool preserve_depth{ false };
 
+  /*! \brief Number of threads generating candidates (0 = hardware concurrency).
+   *
+   * Only used by `cut_rewriting_with_compatibility_graph`.  With more than
+   * one thread, the rewriting function is called concurrently on
+   * thread-local networks and must therefore be safe to call from several
+   * threads (as are `mig_npn_resynthesis`, `xmg_npn_resynthesis`, and
+   * `xag_npn_resynthesis`).  The candidates are evaluated in the same order
+   * as by the sequential algorithm, such that the result does not depend on
+   * the number of threads.  Don't cares are only supported by the
+   * sequential evaluation.
+   */
+  uint32_t num_threads{ 1u };
+
+  /*! \brief Number of nodes whose cuts are rewritten by one thread at a time. */
+  uint32_t window_gates{ 512u };
+
   /*! \brief Show progress. */
   bool progress{ false };
 
@@ -145,90 +164,141 @@ struct cut_rewriting_stats
 namespace detail
 {
 
-class graph
+/*! \brief Conflict graph of rewriting candidates.
+ *
+ * Each vertex is a candidate with a weight (its gain) and the nodes of its
+ * cone.  Two candidates are adjacent if their cones share a node.  Edges are
+ * not stored; instead, the candidates are indexed by the nodes of their
+ * cones, such that the memory is linear in the accumulated cone sizes.
+ * Neighbors are enumerated on demand and deduplicated with stamps.
+ */
+class conflict_graph
 {
 public:
-  auto add_vertex( uint32_t weight )
+  template<class NodeIterator>
+  uint32_t add_vertex( int32_t weight, NodeIterator begin, NodeIterator end )
   {
-    auto index = _weights.size();
+    auto const index = static_cast<uint32_t>( _weights.size() );
     _weights.emplace_back( weight );
-    _adjacent.emplace_back();
-    ++_num_vertices;
+    _cone_nodes.insert( _cone_nodes.end(), begin, end );
+    _cone_offsets.emplace_back( static_cast<uint32_t>( _cone_nodes.size() ) );
     return index;
   }
 
-  void add_edge( uint32_t v1, uint32_t v2 )
-  {
-    if ( v1 == v2 )
-      return;
-    if ( _adjacent[v1].count( v2 ) )
-      return;
-
-    _adjacent[v1].insert( v2 );
-    _adjacent[v2].insert( v1 );
-    ++_num_edges;
-  }
-
-  void remove_vertex( uint32_t vertex )
+  /*! \brief Indexes the candidates by the nodes of their cones, and computes the degrees. */
+  void finalize( uint32_t num_nodes, uint32_t num_threads = 1u )
   {
-    assert( _weights[vertex] != -1 );
-    _weights[vertex] = -1;
-
-    _num_edges -= _adjacent[vertex].size();
-
-    for ( auto w : _adjacent[vertex] )
+    _node_offsets.assign( num_nodes + 1u, 0u );
+    for ( auto const& n : _cone_nodes )
     {
-      _adjacent[w].erase( vertex );
+      ++_node_offsets[n + 1u];
     }
-    _adjacent[vertex].clear();
+    std::partial_sum( _node_offsets.begin(), _node_offsets.end(), _node_offsets.begin() );
 
-    --_num_vertices;
-  }
+    std::vector<uint32_t> pos( _node_offsets.begin(), _node_offsets.end() - 1u );
+    _node_vertices.resize( _cone_nodes.size() );
+    for ( auto v = 0u; v < num_vertices(); ++v )
+    {
+      foreach_node( v, [&]( auto n ) {
+        _node_vertices[pos[n]++] = v;
+      } );
+    }
 
-  bool has_vertex( uint32_t vertex ) const
-  {
-    return _weights[vertex] >= 0;
+    /* the degrees are computed independently for each vertex */
+    _degrees.assign( num_vertices(), 0u );
+    auto const threads = resolve_num_threads( num_threads );
+    std::vector<std::vector<uint32_t>> stamps( threads );
+    parallel_for( threads, num_vertices(), [&]( uint64_t v, uint32_t thread_id ) {
+      auto& stamp = stamps[thread_id];
+      stamp.resize( num_vertices(), 0u );
+      uint32_t degree{ 0u };
+      foreach_adjacent( static_cast<uint32_t>( v ), stamp, [&]( auto ) { ++degree; } );
+      _degrees[v] = degree;
+    } );
   }
 
+  /*! \brief Calls `fn` on each node in the cone of `vertex`. */
   template<typename Fn>
-  void foreach_adjacent( uint32_t vertex, Fn&& fn ) const
+  void foreach_node( uint32_t vertex, Fn&& fn ) const
   {
-    std::for_each( _adjacent[vertex].begin(), _adjacent[vertex].end(), fn );
+    auto const begin = vertex == 0u ? 0u : _cone_offsets[vertex - 1u];
+    std::for_each( _cone_nodes.begin() + begin, _cone_nodes.begin() + _cone_offsets[vertex], fn );
   }
 
+  /*! \brief Calls `fn` on each neighbor of `vertex`.
+   *
+   * The vector `stamps` must have one entry per vertex and must not contain
+   * `vertex + 1`, which is used to mark the visited neighbors.
+   */
   template<typename Fn>
-  void foreach_vertex( Fn&& fn ) const
+  void foreach_adjacent( uint32_t vertex, std::vector<uint32_t>& stamps, Fn&& fn ) const
   {
-    for ( auto i = 0u; i < _weights.size(); ++i )
-    {
-      if ( has_vertex( i ) )
+    stamps[vertex] = vertex + 1u;
+    foreach_node( vertex, [&]( auto n ) {
+      for ( auto i = _node_offsets[n]; i < _node_offsets[n + 1u]; ++i )
       {
-        fn( i );
+        auto const w = _node_vertices[i];
+        if ( stamps[w] != vertex + 1u )
+        {
+          stamps[w] = vertex + 1u;
+          fn( w );
+        }
       }
-    }
+    } );
   }
 
-  auto degree( uint32_t vertex ) const { return _adjacent[vertex].size(); }
+  auto degree( uint32_t vertex ) const { return _degrees[vertex]; }
   auto weight( uint32_t vertex ) const { return _weights[vertex]; }
   auto gwmin_value( uint32_t vertex ) const { return (double)weight( vertex ) / ( degree( vertex ) + 1 ); }
-  auto gwmax_value( uint32_t vertex ) const { return (double)weight( vertex ) / ( degree( vertex ) * ( degree( vertex ) + 1 ) ); }
 
-  auto num_vertices() const { return _num_vertices; }
-  auto num_edges() const { return _num_edges; }
+  uint32_t num_vertices() const { return static_cast<uint32_t>( _weights.size() ); }
+  std::size_t num_edges() const { return std::accumulate( _degrees.begin(), _degrees.end(), std::size_t{ 0u } ) / 2u; }
 
 private:
-  uint32_t _num_vertices{ 0u };
-  std::size_t _num_edges{ 0u };
+  std::vector<int32_t> _weights;
+
+  /* nodes in the cone of each vertex */
+  std::vector<uint32_t> _cone_offsets;
+  std::vector<uint32_t> _cone_nodes;
 
-  std::vector<std::set<uint32_t>> _adjacent;
+  /* vertices containing each node */
+  std::vector<uint32_t> _node_offsets;
+  std::vector<uint32_t> _node_vertices;
 
-  std::vector<int32_t> _weights; /* degree = -1 means vertex is removed */
+  std::vector<uint32_t> _degrees;
 };
 
-inline std::vector<uint32_t> maximum_weighted_independent_set_gwmin( graph& g )
+/* greedily selects vertices in the given order whose cones are disjoint from
+ * the ones of the already selected vertices */
+inline std::vector<uint32_t> select_independent_vertices( conflict_graph const& g, std::vector<uint32_t> const& order )
 {
-  std::vector<uint32_t> mwis;
+  std::vector<uint32_t> is;
+
+  std::vector<bool> claimed;
+  for ( auto v : order )
+  {
+    bool conflict{ false };
+    g.foreach_node( v, [&]( auto n ) {
+      conflict = conflict || ( n < claimed.size() && claimed[n] );
+    } );
+    if ( conflict )
+      continue;
+
+    is.emplace_back( v );
+    g.foreach_node( v, [&]( auto n ) {
+      if ( n >= claimed.size() )
+      {
+        claimed.resize( n + 1u, false );
+      }
+      claimed[n] = true;
+    } );
+  }
 
+  return is;
+}
+
+inline std::vector<uint32_t> maximum_weighted_independent_set_gwmin( conflict_graph const& g )
+{
   std::vector<uint32_t> vertices( g.num_vertices() );
   std::iota( vertices.begin(), vertices.end(), 0 );
 
@@ -238,49 +308,15 @@ inline std::vector<uint32_t> maximum_weighted_independent_set_gwmin( graph& g )
     return value_v > value_w || ( value_v == value_w && g.degree( v ) > g.degree( w ) );
   } );
 
-  for ( auto i : vertices )
-  {
-    if ( !g.has_vertex( i ) )
-      continue;
-
-    /* add vertex to independent set, then remove it and all its neighbors */
-    mwis.emplace_back( i );
-    std::vector<uint32_t> neighbors;
-    g.foreach_adjacent( i, [&]( auto v ) { neighbors.emplace_back( v ); } );
-    g.remove_vertex( i );
-
-    for ( auto v : neighbors )
-    {
-      g.remove_vertex( v );
-    }
-  }
-
-  return mwis;
+  return select_independent_vertices( g, vertices );
 }
 
-inline std::vector<uint32_t> maximal_weighted_independent_set( graph& g )
+inline std::vector<uint32_t> maximal_weighted_independent_set( conflict_graph const& g )
 {
-  std::vector<uint32_t> mwis;
-
-  auto num_vertices = g.num_vertices();
-  for ( auto i = 0u; i < num_vertices; ++i )
-  {
-    if ( !g.has_vertex( i ) )
-      continue;
-
-    /* add vertex to independent set, then remove it and all its neighbors */
-    mwis.emplace_back( i );
-    std::vector<uint32_t> neighbors;
-    g.foreach_adjacent( i, [&]( auto v ) { neighbors.emplace_back( v ); } );
-    g.remove_vertex( i );
-
-    for ( auto v : neighbors )
-    {
-      g.remove_vertex( v );
-    }
-  }
+  std::vector<uint32_t> vertices( g.num_vertices() );
+  std::iota( vertices.begin(), vertices.end(), 0 );
 
-  return mwis;
+  return select_independent_vertices( g, vertices );
 }
 
 struct cut_enumeration_cut_rewriting_cut
@@ -289,21 +325,29 @@ struct cut_enumeration_cut_rewriting_cut
 };
 
 template<typename Ntk, bool ComputeTruth>
-std::tuple<graph, std::vector<std::pair<node<Ntk>, uint32_t>>> network_cuts_graph( Ntk const& ntk, network_cuts<Ntk, ComputeTruth, cut_enumeration_cut_rewriting_cut> const& cuts, cut_rewriting_params const& ps )
+std::tuple<conflict_graph, std::vector<std::pair<node<Ntk>, uint32_t>>> network_cuts_graph( Ntk const& ntk, network_cuts<Ntk, ComputeTruth, cut_enumeration_cut_rewriting_cut> const& cuts, cut_rewriting_params const& ps )
 {
   static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
   static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
   static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
-  static_assert( has_clear_visited_v<Ntk>, "Ntk does not implement the clear_visited method" );
 
-  graph g;
+  conflict_graph g;
+  std::vector<std::pair<node<Ntk>, uint32_t>> vertex_to_cut_addr;
 
-  using cut_addr = std::pair<node<Ntk>, uint32_t>;
-  std::vector<std::vector<cut_addr>> conflicts( cuts.nodes_size() );
-  std::vector<cut_addr> vertex_to_cut_addr;
-  std::vector<std::vector<uint32_t>> cut_addr_to_vertex( cuts.nodes_size() );
-
-  ntk.clear_visited();
+  /* the cone of a cut consists of the gates between its leaves and its root */
+  std::vector<uint32_t> stamps( cuts.nodes_size(), 0u );
+  uint32_t stamp{ 0u };
+  std::vector<uint32_t> cone;
+  const auto collect_cone = [&]( auto&& self, node<Ntk> const& n ) -> void {
+    const auto index = ntk.node_to_index( n );
+    if ( stamps[index] == stamp || ntk.is_constant( n ) )
+      return;
+    stamps[index] = stamp;
+    cone.emplace_back( index );
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      self( self, ntk.get_node( f ) );
+    } );
+  };
 
   ntk.foreach_node( [&]( auto const& n, auto index ) {
     if ( index >= cuts.nodes_size() || ntk.is_constant( n ) || ntk.is_pi( n ) )
@@ -328,43 +372,22 @@ std::tuple<graph, std::vector<std::pair<node<Ntk>, uint32_t>>> network_cuts_grap
       if ( ( *cut )->data.gain < ( ps.allow_zero_gain ? 0 : 1 ) )
         continue;
 
-      std::vector<node<Ntk>> leaves;
+      ++stamp;
       for ( auto leaf_index : *cut )
       {
-        leaves.push_back( ntk.index_to_node( leaf_index ) );
+        stamps[leaf_index] = stamp;
       }
-      cut_view<Ntk> dcut( ntk, leaves, ntk.make_signal( n ) );
-      dcut.foreach_gate( [&]( auto const& n2 ) {
-        // if ( dcut.is_constant( n2 ) || dcut.is_pi( n2 ) )
-        //   return;
-        conflicts[ntk.node_to_index( n2 )].emplace_back( n, cctr );
-      } );
+      cone.clear();
+      collect_cone( collect_cone, n );
 
-      auto v = g.add_vertex( ( *cut )->data.gain );
-      assert( v == vertex_to_cut_addr.size() );
+      g.add_vertex( ( *cut )->data.gain, cone.begin(), cone.end() );
       vertex_to_cut_addr.emplace_back( n, cctr );
-      cut_addr_to_vertex[ntk.node_to_index( n )].emplace_back( static_cast<uint32_t>( v ) );
 
       ++cctr;
     }
   } );
 
-  for ( auto n = 0u; n < conflicts.size(); ++n )
-  {
-    for ( auto j = 1u; j < conflicts[n].size(); ++j )
-    {
-      for ( auto i = 0u; i < j; ++i )
-      {
-        const auto [n1, c1] = conflicts[n][i];
-        const auto [n2, c2] = conflicts[n][j];
-
-        if ( cut_addr_to_vertex[ntk.node_to_index( n1 )][c1] != cut_addr_to_vertex[ntk.node_to_index( n2 )][c2] )
-        {
-          g.add_edge( cut_addr_to_vertex[ntk.node_to_index( n1 )][c1], cut_addr_to_vertex[ntk.node_to_index( n2 )][c2] );
-        }
-      }
-    }
-  }
+  g.finalize( cuts.nodes_size(), ps.num_threads );
 
   return { g, vertex_to_cut_addr };
 }
@@ -420,6 +443,73 @@ public:
     const auto size = ntk.size();
     auto max_total_gain = 0u;
     progress_bar pbar{ ntk.size(), "cut_rewriting |{0}| node = {1:>4}@{2:>2} / " + std::to_string( size ) + "   comm. gain = {3}", ps.progress };
+
+    if constexpr ( has_clone_node_v<typename Ntk::base_type> )
+    {
+      if ( ps.num_threads != 1u && !ps.use_dont_cares )
+      {
+        evaluate_candidates_parallel( cuts, best_replacements, max_total_gain, pbar );
+      }
+      else
+      {
+        evaluate_candidates( cuts, best_replacements, max_total_gain, pbar );
+      }
+    }
+    else
+    {
+      evaluate_candidates( cuts, best_replacements, max_total_gain, pbar );
+    }
+
+    stopwatch t2( st.time_mis );
+    auto [g, map] = network_cuts_graph( ntk, cuts, ps );
+
+    if ( ps.very_verbose )
+    {
+      std::cout << "[i] replacement dependency graph has " << g.num_vertices() << " vertices and " << g.num_edges() << " edges\n";
+    }
+
+    const auto is = ( ps.candidate_selection_strategy == cut_rewriting_params::minimize_weight ) ? maximum_weighted_independent_set_gwmin( g ) : maximal_weighted_independent_set( g );
+
+    if ( ps.very_verbose )
+    {
+      std::cout << "[i] size of independent set is " << is.size() << "\n";
+    }
+
+    for ( const auto v : is )
+    {
+      const auto v_node = map[v].first;
+      const auto v_cut = map[v].second;
+
+      if ( ps.very_verbose )
+      {
+        std::cout << "[i] try to rewrite cut #" << v_cut << " in node #" << ntk.node_to_index( v_node ) << "\n";
+      }
+
+      if ( best_replacements[v_node].empty() )
+        continue;
+
+      const auto replacement = best_replacements[v_node][v_cut];
+
+      if ( ntk.is_constant( ntk.get_node( replacement ) ) || v_node == ntk.get_node( replacement ) )
+        continue;
+
+      if ( ps.very_verbose )
+      {
+        std::cout << "[i] optimize cut #" << v_cut << " in node #" << ntk.node_to_index( v_node ) << " and replace with node " << ntk.node_to_index( ntk.get_node( replacement ) ) << "\n";
+      }
+
+      ntk.substitute_node( v_node, replacement );
+    }
+  }
+
+private:
+  using cuts_t = network_cuts<Ntk, true, cut_enumeration_cut_rewriting_cut>;
+  using replacements_t = node_map<std::vector<signal<Ntk>>, Ntk>;
+
+  /* calls `fn` for the nodes with candidate cuts in topological order */
+  template<typename Fn>
+  void foreach_candidate_node( uint32_t size, Fn&& fn )
+  {
     ntk.foreach_node( [&]( auto const& n, auto index ) {
       /* stop once all original nodes were visited */
       if ( index >= size )
@@ -433,6 +523,14 @@ public:
       if ( mffc_size( ntk, n ) == 1 )
         return true;
 
+      fn( n, index );
+      return true;
+    } );
+  }
+
+  void evaluate_candidates( cuts_t const& cuts, replacements_t& best_replacements, uint32_t& max_total_gain, progress_bar& pbar )
+  {
+    foreach_candidate_node( cuts.nodes_size(), [&]( auto const& n, auto index ) {
       /* foreach cut */
       for ( auto& cut : cuts.cuts( ntk.node_to_index( n ) ) )
       {
@@ -440,9 +538,6 @@ public:
         if ( cut->size() < ps.min_cand_cut_size )
           continue;
 
-        const auto tt = cuts.truth_table( *cut );
-        assert( cut->size() == static_cast<unsigned>( tt.num_vars() ) );
-
         pbar( index, ntk.node_to_index( n ), best_replacements[n].size(), max_total_gain );
 
         std::vector<signal<Ntk>> children;
@@ -451,34 +546,8 @@ public:
           children.push_back( ntk.make_signal( ntk.index_to_node( l ) ) );
         }
 
-        int32_t value = recursive_deref<Ntk, NodeCostFn>( ntk, n );
-        {
+        evaluate_cut( n, *cut, best_replacements[n], max_total_gain, [&]( auto const& on_signal ) {
           stopwatch t( st.time_rewriting );
-          int32_t best_gain{ -1 };
-
-          const auto on_signal = [&]( auto const& f_new ) {
-            auto [v, contains] = recursive_ref_contains( ntk.get_node( f_new ), n );
-            recursive_deref<Ntk, NodeCostFn>( ntk, ntk.get_node( f_new ) );
-
-            int32_t gain = contains ? -1 : value - v;
-
-            if ( gain > 0 || ( ps.allow_zero_gain && gain == 0 ) )
-            {
-              if ( best_gain == -1 )
-              {
-                ( *cut )->data.gain = best_gain = gain;
-                best_replacements[n].push_back( f_new );
-              }
-              else if ( gain > best_gain )
-              {
-                ( *cut )->data.gain = best_gain = gain;
-                best_replacements[n].back() = f_new;
-              }
-            }
-
-            return true;
-          };
-
           if ( ps.use_dont_cares )
           {
             if constexpr ( has_rewrite_with_dont_cares_v<Ntk, RewritingFn, decltype( children.begin() )> )
@@ -499,62 +568,183 @@ public:
           {
             rewriting_fn( ntk, cuts.truth_table( *cut ), children.begin(), children.end(), on_signal );
           }
+        } );
+      }
+    } );
+  }
 
-          if ( best_gain > 0 )
-          {
-            max_total_gain += best_gain;
-          }
-        }
+  /* The rewriting function is called concurrently on thread-local networks
+   * whose primary inputs stand for the cut leaves.  The resulting structures
+   * are copied into the network in the same order as in the sequential
+   * evaluation, such that the gains and the candidates are the same. */
+  void evaluate_candidates_parallel( cuts_t const& cuts, replacements_t& best_replacements, uint32_t& max_total_gain, progress_bar& pbar )
+  {
+    using local_ntk_t = typename Ntk::base_type;
+    using local_signal_t = signal<local_ntk_t>;
 
-        recursive_ref<Ntk, NodeCostFn>( ntk, n );
-      }
+    auto const num_threads = resolve_num_threads( ps.num_threads );
+    auto const window_gates = std::max( ps.window_gates, 1u );
 
-      return true;
+    std::vector<std::pair<node<Ntk>, uint32_t>> nodes;
+    foreach_candidate_node( cuts.nodes_size(), [&]( auto const& n, auto index ) {
+      nodes.emplace_back( n, index );
     } );
 
-    stopwatch t2( st.time_mis );
-    auto [g, map] = network_cuts_graph( ntk, cuts, ps );
+    std::vector<local_ntk_t> locals( num_threads );
+    std::vector<std::vector<uint32_t>> local_leaves( num_threads );
+    std::vector<uint32_t> local_of_window;
+    std::vector<std::vector<std::vector<local_signal_t>>> local_candidates;
 
-    if ( ps.very_verbose )
+    for ( auto begin = 0u; begin < nodes.size(); begin += window_gates * num_threads )
     {
-      std::cout << "[i] replacement dependency graph has " << g.num_vertices() << " vertices and " << g.num_edges() << " edges\n";
-    }
+      auto const end = std::min<uint32_t>( begin + window_gates * num_threads, nodes.size() );
+      auto const num_windows = ( end - begin + window_gates - 1u ) / window_gates;
 
-    const auto is = ( ps.candidate_selection_strategy == cut_rewriting_params::minimize_weight ) ? maximum_weighted_independent_set_gwmin( g ) : maximal_weighted_independent_set( g );
+      /* the rewriting function is called for all cuts of the next nodes concurrently */
+      for ( auto t = 0u; t < num_threads; ++t )
+      {
+        locals[t] = local_ntk_t{};
+        local_leaves[t].clear();
+        for ( auto i = 0u; i < ps.cut_enumeration_ps.cut_size; ++i )
+        {
+          auto const pi = locals[t].get_node( locals[t].create_pi() );
+          local_leaves[t].resize( locals[t].node_to_index( pi ) + 1u, 0u );
+          local_leaves[t][locals[t].node_to_index( pi )] = i;
+        }
+      }
+      local_of_window.assign( num_windows, 0u );
+      local_candidates.resize( end - begin );
 
-    if ( ps.very_verbose )
-    {
-      std::cout << "[i] size of independent set is " << is.size() << "\n";
-    }
+      call_with_stopwatch( st.time_rewriting, [&]() {
+        parallel_for( num_threads, num_windows, [&]( uint64_t window, uint32_t thread_id ) {
+          auto& local = locals[thread_id];
+          local_of_window[window] = thread_id;
 
-    for ( const auto v : is )
-    {
-      const auto v_node = map[v].first;
-      const auto v_cut = map[v].second;
+          std::vector<local_signal_t> children;
+          local.foreach_pi( [&]( auto const& pi ) {
+            children.emplace_back( local.make_signal( pi ) );
+          } );
 
-      if ( ps.very_verbose )
+          auto const window_end = std::min<uint64_t>( begin + ( window + 1u ) * window_gates, end );
+          for ( auto i = begin + window * window_gates; i < window_end; ++i )
+          {
+            auto& candidates = local_candidates[i - begin];
+            candidates.clear();
+            for ( auto const& cut : cuts.cuts( ntk.node_to_index( nodes[i].first ) ) )
+            {
+              if ( cut->size() < ps.min_cand_cut_size )
+                continue;
+
+              candidates.emplace_back();
+              rewriting_fn( local, cuts.truth_table( *cut ), children.begin(), children.begin() + cut->size(), [&]( auto const& f ) {
+                candidates.back().emplace_back( f );
+                return true;
+              } );
+            }
+          }
+        } );
+      } );
+
+      /* evaluate the candidates in the network */
+      for ( auto i = begin; i < end; ++i )
       {
-        std::cout << "[i] try to rewrite cut #" << v_cut << " in node #" << ntk.node_to_index( v_node ) << "\n";
+        auto const [n, index] = nodes[i];
+        auto const& local = locals[local_of_window[( i - begin ) / window_gates]];
+        auto const& leaves = local_leaves[local_of_window[( i - begin ) / window_gates]];
+
+        auto c = 0u;
+        for ( auto& cut : cuts.cuts( ntk.node_to_index( n ) ) )
+        {
+          if ( cut->size() < ps.min_cand_cut_size )
+            continue;
+
+          pbar( index, ntk.node_to_index( n ), best_replacements[n].size(), max_total_gain );
+
+          std::vector<signal<Ntk>> children;
+          for ( auto l : *cut )
+          {
+            children.push_back( ntk.make_signal( ntk.index_to_node( l ) ) );
+          }
+
+          evaluate_cut( n, *cut, best_replacements[n], max_total_gain, [&]( auto const& on_signal ) {
+            for ( auto const& f : local_candidates[i - begin][c] )
+            {
+              _copies.clear();
+              auto const g = copy_from_local( local, local.get_node( f ), leaves, children );
+              if ( !on_signal( local.is_complemented( f ) ? ntk.create_not( g ) : g ) )
+                break;
+            }
+          } );
+          ++c;
+        }
       }
+    }
+  }
 
-      if ( best_replacements[v_node].empty() )
-        continue;
+  /* copies the structure of `n` in a thread-local network into the network */
+  template<class LocalNtk>
+  signal<Ntk> copy_from_local( LocalNtk const& local, node<LocalNtk> const& n, std::vector<uint32_t> const& leaves, std::vector<signal<Ntk>> const& children )
+  {
+    if ( local.is_constant( n ) )
+      return ntk.get_constant( local.constant_value( n ) );
+    if ( local.is_pi( n ) )
+      return children[leaves[local.node_to_index( n )]];
+
+    if ( auto it = _copies.find( local.node_to_index( n ) ); it != _copies.end() )
+      return it->second;
+
+    std::vector<signal<Ntk>> fanin;
+    local.foreach_fanin( n, [&]( auto const& f ) {
+      auto const g = copy_from_local( local, local.get_node( f ), leaves, children );
+      fanin.emplace_back( local.is_complemented( f ) ? ntk.create_not( g ) : g );
+    } );
 
-      const auto replacement = best_replacements[v_node][v_cut];
+    auto const g = ntk.clone_node( local, n, fanin );
+    _copies.emplace( local.node_to_index( n ), g );
+    return g;
+  }
 
-      if ( ntk.is_constant( ntk.get_node( replacement ) ) || v_node == ntk.get_node( replacement ) )
-        continue;
+  /* evaluates the candidates generated by `generate` for a cut of `n`, and
+   * keeps the best one if it has a positive gain */
+  template<class Cut, typename GenerateFn>
+  void evaluate_cut( node<Ntk> const& n, Cut& cut, std::vector<signal<Ntk>>& replacements, uint32_t& max_total_gain, GenerateFn&& generate )
+  {
+    int32_t value = recursive_deref<Ntk, NodeCostFn>( ntk, n );
+    int32_t best_gain{ -1 };
 
-      if ( ps.very_verbose )
+    const auto on_signal = [&]( auto const& f_new ) {
+      auto [v, contains] = recursive_ref_contains( ntk.get_node( f_new ), n );
+      recursive_deref<Ntk, NodeCostFn>( ntk, ntk.get_node( f_new ) );
+
+      int32_t gain = contains ? -1 : value - v;
+
+      if ( gain > 0 || ( ps.allow_zero_gain && gain == 0 ) )
       {
-        std::cout << "[i] optimize cut #" << v_cut << " in node #" << ntk.node_to_index( v_node ) << " and replace with node " << ntk.node_to_index( ntk.get_node( replacement ) ) << "\n";
+        if ( best_gain == -1 )
+        {
+          cut->data.gain = best_gain = gain;
+          replacements.push_back( f_new );
+        }
+        else if ( gain > best_gain )
+        {
+          cut->data.gain = best_gain = gain;
+          replacements.back() = f_new;
+        }
       }
 
-      ntk.substitute_node( v_node, replacement );
+      return true;
+    };
+
+    generate( on_signal );
+
+    if ( best_gain > 0 )
+    {
+      max_total_gain += best_gain;
     }
+
+    recursive_ref<Ntk, NodeCostFn>( ntk, n );
   }
 
-private:
   std::pair<int32_t, bool> recursive_ref_contains( node<Ntk> const& n, node<Ntk> const& repl )
   {
     /* terminate? */
@@ -582,6 +772,8 @@ private:
   cut_rewriting_params const& ps;
   cut_rewriting_stats& st;
   NodeCostFn cost_fn;
+
+  std::unordered_map<uint32_t, signal<Ntk>> _copies;
 };
 
 } /* namespace detail */
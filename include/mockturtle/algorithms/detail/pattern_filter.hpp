@@ -0,0 +1,170 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file pattern_filter.hpp
+  \brief Lazy bit-parallel simulation of a small set of patterns
+
+  Used by multi-threaded SAT-based algorithms, in which every thread keeps
+  the counter-examples it found itself to avoid redundant SAT calls.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../../traits.hpp"
+
+#include <kitty/bit_operations.hpp>
+#include <kitty/operators.hpp>
+#include <kitty/static_truth_table.hpp>
+
+namespace mockturtle::detail
+{
+
+/*! \brief Simulates up to 64 patterns on demand.
+ *
+ * Only the transitive fanin cones of queried nodes are simulated.  The
+ * network is only read, such that several filters can be used concurrently
+ * on the same network.
+ */
+template<class Ntk>
+class pattern_filter
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  explicit pattern_filter( Ntk const& ntk )
+      : ntk( ntk )
+  {
+  }
+
+  /*! \brief Adds a pattern (ignored if 64 patterns are stored already). */
+  void add_pattern( std::vector<bool> const& pattern )
+  {
+    if ( num_patterns == 64u )
+    {
+      return;
+    }
+    pis.resize( pattern.size() );
+    for ( auto i = 0u; i < pattern.size(); ++i )
+    {
+      if ( pattern[i] )
+      {
+        kitty::set_bit( pis[i], num_patterns );
+      }
+    }
+    ++num_patterns;
+    values.clear();
+  }
+
+  /*! \brief Whether some pattern distinguishes node `n` from signal `g`. */
+  bool distinguishes( node const& n, signal const& g )
+  {
+    if ( num_patterns == 0u )
+    {
+      return false;
+    }
+    auto const diff = value( n ) ^ value( ntk.get_node( g ) );
+    return ntk.is_complemented( g ) ? !kitty::is_const0( ~diff & mask() ) : !kitty::is_const0( diff & mask() );
+  }
+
+  /*! \brief Whether node `n` evaluates to `v` under some pattern. */
+  bool has_value( node const& n, bool v )
+  {
+    if ( num_patterns == 0u )
+    {
+      return false;
+    }
+    return !kitty::is_const0( ( v ? value( n ) : ~value( n ) ) & mask() );
+  }
+
+private:
+  using sim_t = kitty::static_truth_table<6u>;
+
+  sim_t mask() const
+  {
+    sim_t m;
+    for ( auto i = 0u; i < num_patterns; ++i )
+    {
+      kitty::set_bit( m, i );
+    }
+    return m;
+  }
+
+  sim_t value( node const& root )
+  {
+    std::vector<std::pair<node, bool>> stack{ { root, false } };
+    while ( !stack.empty() )
+    {
+      auto const [n, expanded] = stack.back();
+      stack.pop_back();
+      if ( values.find( n ) != values.end() )
+      {
+        continue;
+      }
+      if ( ntk.is_constant( n ) )
+      {
+        values[n] = ntk.constant_value( n ) ? ~sim_t() : sim_t();
+        continue;
+      }
+      if ( ntk.is_pi( n ) )
+      {
+        values[n] = pis[ntk.pi_index( n )];
+        continue;
+      }
+      if ( !expanded )
+      {
+        stack.emplace_back( n, true );
+        ntk.foreach_fanin( n, [&]( auto const& f ) {
+          if ( values.find( ntk.get_node( f ) ) == values.end() )
+          {
+            stack.emplace_back( ntk.get_node( f ), false );
+          }
+        } );
+        continue;
+      }
+
+      std::vector<sim_t> fanin_values;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        fanin_values.emplace_back( values.at( ntk.get_node( f ) ) );
+      } );
+      values[n] = ntk.compute( n, fanin_values.begin(), fanin_values.end() );
+    }
+    return values.at( root );
+  }
+
+private:
+  Ntk const& ntk;
+  std::vector<sim_t> pis;
+  uint32_t num_patterns{ 0u };
+  std::unordered_map<node, sim_t> values;
+};
+
+} // namespace mockturtle::detail
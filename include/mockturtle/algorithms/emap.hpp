@@ -50,6 +50,7 @@
 #include "../networks/aig.hpp"
 #include "../networks/block.hpp"
 #include "../networks/klut.hpp"
+#include "../utils/cancellation_token.hpp"
 #include "../utils/cuts.hpp"
 #include "../utils/node_map.hpp"
 #include "../utils/stopwatch.hpp"
@@ -140,6 +141,13 @@ struct emap_params
   /*! \brief Remove overlapping multi-output cuts */
   bool remove_overlapping_multicuts{ false };
 
+  /*! \brief Token to skip the remaining area and power recovery rounds.
+   *
+   * The initial mapping is always completed, the mapping of the last
+   * completed round is returned.
+   */
+  cancellation_token cancellation{};
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 };
@@ -992,7 +1000,7 @@ private:
   {
     /* compute mapping using global area flow */
     uint32_t i = 0;
-    while ( i++ < ps.area_flow_rounds )
+    while ( i++ < ps.area_flow_rounds && !ps.cancellation.is_cancelled() )
     {
       if ( !compute_mapping<true>() )
       {
@@ -1003,7 +1011,7 @@ private:
     /* compute mapping using exact area */
     i = 0;
     compute_required_time( true );
-    while ( i++ < ps.ela_rounds )
+    while ( i++ < ps.ela_rounds && !ps.cancellation.is_cancelled() )
     {
       if ( !compute_mapping_exact_reversed<false>() )
       {
@@ -1013,7 +1021,7 @@ private:
 
     /* compute mapping using exact switching activity estimation */
     i = 0;
-    while ( i++ < ps.eswp_rounds )
+    while ( i++ < ps.eswp_rounds && !ps.cancellation.is_cancelled() )
     {
       if ( !compute_mapping_exact_reversed<true>() )
       {
@@ -70,6 +70,13 @@ struct equivalence_checking_params
   /*! \brief Whether to apply functional reduction before SAT solving. */
   bool functional_reduction{ true };
 
+  /*! \brief Whether to encode the miter with cut-based compact CNF.
+   *
+   * If enabled, the CNF is generated with `generate_mapped_cnf` instead of
+   * one set of Tseytin clauses per gate.
+   */
+  bool cnf_mapping{ false };
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 };
@@ -136,15 +143,11 @@ public:
         return opt.po_at( 0 ) == opt.get_constant( false );
       }
 
-      output = generate_cnf( opt, [&]( auto const& clause ) {
-        solver.add_clause( clause );
-      } )[0];
+      output = encode( opt, solver );
     }
     else
     {
-      output = generate_cnf( miter_, [&]( auto const& clause ) {
-        solver.add_clause( clause );
-      } )[0];
+      output = encode( miter_, solver );
     }
 
     const auto res = solver.solve( &output, &output + 1, ps_.conflict_limit );
@@ -167,6 +170,20 @@ public:
     }
   }
 
+private:
+  int encode( Ntk const& ntk, percy::bsat_wrapper& solver )
+  {
+    auto const add_clause = [&]( auto const& clause ) {
+      solver.add_clause( clause );
+    };
+
+    if ( ps_.cnf_mapping )
+    {
+      return generate_mapped_cnf( ntk, add_clause )[0];
+    }
+    return generate_cnf( ntk, add_clause )[0];
+  }
+
 private:
   Ntk const& miter_;
   equivalence_checking_params const& ps_;
@@ -235,9 +252,15 @@ private:
       ntk.add_EXCDC_clauses( solver );
     }
 
-    return generate_cnf<Ntk, bill::lit_type>( ntk, [&]( bill::result::clause_type const& clause ) {
+    auto const add_clause = [&]( bill::result::clause_type const& clause ) {
       solver.add_clause( clause );
-    }, literals )[0];
+    };
+
+    if ( ps_.cnf_mapping )
+    {
+      return generate_mapped_cnf<Ntk, bill::lit_type>( ntk, add_clause, {}, literals )[0];
+    }
+    return generate_cnf<Ntk, bill::lit_type>( ntk, add_clause, literals )[0];
   }
 
 private:
@@ -42,6 +42,7 @@
 #include <kitty/bit_operations.hpp>
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
+#include <kitty/esop.hpp>
 #include <kitty/operations.hpp>
 #include <kitty/properties.hpp>
 
@@ -49,6 +50,7 @@
 #include "../generators/sorting.hpp"
 #include "../io/write_verilog.hpp"
 #include "../networks/xag.hpp"
+#include "../utils/cancellation_token.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/cnf_view.hpp"
@@ -95,6 +97,15 @@ struct exact_mc_synthesis_params
    */
   bool ignore_conflict_limit_for_first_solution{ false };
 
+  /*! \brief Token to stop before the next SAT call.
+   *
+   * If no solution has been found yet, `exact_mc_synthesis` returns a
+   * (non-optimal) network derived from the algebraic normal form of the
+   * function, and `exact_mc_synthesis_multiple` returns the solutions found
+   * so far.
+   */
+  cancellation_token cancellation{};
+
   /*! \brief Show progress (in CEGAR). */
   bool progress{ false };
 
@@ -159,7 +170,7 @@ struct exact_mc_synthesis_impl
     const auto degree = kitty::polynomial_degree( func_ );
     uint32_t num_ands = std::max( ps_.min_and_gates, degree == 0u ? degree : degree - 1u );
 
-    while ( true )
+    while ( !ps_.cancellation.is_cancelled() )
     {
       if ( ps_.verbose )
       {
@@ -189,7 +200,7 @@ struct exact_mc_synthesis_impl
         {
           debug_solution( pntk );
         }
-        while ( ntks.size() < num_solutions_ )
+        while ( ntks.size() < num_solutions_ && !ps_.cancellation.is_cancelled() )
         {
           block( pntk );
           if ( const auto result = solve( pntk, false ); result && *result )
@@ -210,6 +221,8 @@ struct exact_mc_synthesis_impl
       }
       ++num_ands;
     }
+
+    return ntks;
   }
 
 private:
@@ -240,7 +253,7 @@ private:
 
     uint32_t num_ands = static_cast<uint32_t>( ltfi_vars_.size() ) / 2, bctr = 0u;
     progress_bar pbar( static_cast<uint32_t>( func_.num_bits() ), "exact_mc_synthesis |{}| ANDs = {}   asserted bits = {}   SAT solving time = {:.2f} secs", ps_.progress );
-    while ( true )
+    while ( !ps_.cancellation.is_cancelled() )
     {
       pbar( bctr, num_ands, bctr, to_seconds( st_.time_solving ) );
       if ( const auto result = solve( pntk, true ); result && *result )
@@ -267,6 +280,7 @@ private:
         return std::nullopt;
       }
     }
+    return std::nullopt;
   }
 
   std::optional<bool> solve( problem_network_t& pntk, bool first )
@@ -597,13 +611,40 @@ private:
   exact_mc_synthesis_stats& st_;
 };
 
+/* XOR of the monomials of the algebraic normal form */
+template<class Ntk>
+Ntk pprm_network( kitty::dynamic_truth_table const& func )
+{
+  Ntk ntk;
+  std::vector<signal<Ntk>> pis( func.num_vars() );
+  std::generate( pis.begin(), pis.end(), [&]() { return ntk.create_pi(); } );
+
+  std::vector<signal<Ntk>> monomials;
+  for ( auto const& c : kitty::esop_from_pprm( func ) )
+  {
+    std::vector<signal<Ntk>> literals;
+    for ( auto i = 0u; i < func.num_vars(); ++i )
+    {
+      if ( c.get_mask( i ) )
+      {
+        literals.push_back( pis[i] );
+      }
+    }
+    monomials.push_back( ntk.create_nary_and( literals ) );
+  }
+  ntk.create_po( ntk.create_nary_xor( monomials ) );
+
+  return ntk;
+}
+
 } // namespace detail
 
 template<class Ntk = xag_network, bill::solvers Solver = bill::solvers::glucose_41>
 Ntk exact_mc_synthesis( kitty::dynamic_truth_table const& func, exact_mc_synthesis_params const& ps = {}, exact_mc_synthesis_stats* pst = nullptr )
 {
   exact_mc_synthesis_stats st;
-  const auto xag = detail::exact_mc_synthesis_impl<Ntk, Solver>{ func, 1u, ps, st }.run().front();
+  const auto xags = detail::exact_mc_synthesis_impl<Ntk, Solver>{ func, 1u, ps, st }.run();
+  const auto xag = xags.empty() ? detail::pprm_network<Ntk>( func ) : xags.front();
 
   if ( ps.verbose )
   {
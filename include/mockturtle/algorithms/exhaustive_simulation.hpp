@@ -0,0 +1,549 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file exhaustive_simulation.hpp
+  \brief Chunked exhaustive simulation
+
+  Enumerates the complete input space of a network in blocks of 64-bit
+  words, such that the memory footprint only depends on the block size
+  and not on the number of primary inputs.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "../traits.hpp"
+#include "../utils/parallel_utils.hpp"
+#include "../utils/stopwatch.hpp"
+
+#include <fmt/format.h>
+#include <kitty/bit_operations.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for exhaustive_simulation.
+ *
+ * The data structure `exhaustive_simulation_params` holds configurable
+ * parameters with default arguments for `exhaustive_simulation` and
+ * `exhaustive_equivalence_checking`.
+ */
+struct exhaustive_simulation_params
+{
+  /*! \brief Number of 64-bit words simulated per block.
+   *
+   * The value is rounded down to a power of two.  Every thread keeps one
+   * buffer of this size for each node.
+   */
+  uint32_t block_words{ 64u };
+
+  /*! \brief Maximum number of primary inputs. */
+  uint32_t max_pis{ 32u };
+
+  /*! \brief Number of threads (0 = hardware concurrency). */
+  uint32_t num_threads{ 1u };
+
+  /*! \brief Be verbose. */
+  bool verbose{ false };
+};
+
+/*! \brief Statistics for exhaustive_simulation.
+ *
+ * The data structure `exhaustive_simulation_stats` provides data collected
+ * by running `exhaustive_simulation` and `exhaustive_equivalence_checking`.
+ */
+struct exhaustive_simulation_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{};
+
+  /*! \brief Number of simulated blocks. */
+  uint64_t num_blocks{ 0u };
+
+  /*! \brief Counter-example, in case the miter is not equivalent. */
+  std::vector<bool> counter_example;
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] simulated blocks = {:>8d}\n", num_blocks );
+    if ( counter_example.size() > 0 )
+    {
+      std::cout << "[i] Networks are not equivalent under input assignment: ";
+      for ( auto i = 0u; i < counter_example.size(); ++i )
+        std::cout << "pi" << i << "=" << counter_example[i] << " ";
+      std::cout << "\n";
+    }
+    std::cout << fmt::format( "[i] total time       = {:>5.2f} secs\n", to_seconds( time_total ) );
+  }
+};
+
+namespace detail
+{
+
+template<class Ntk>
+class exhaustive_simulation_impl
+{
+public:
+  using node = typename Ntk::node;
+
+  explicit exhaustive_simulation_impl( Ntk const& ntk, exhaustive_simulation_params const& ps, exhaustive_simulation_stats& st )
+      : ntk( ntk ), ps( ps ), st( st )
+  {
+  }
+
+  template<class Fn>
+  bool run( Fn&& fn )
+  {
+    stopwatch<> t( st.time_total );
+
+    if ( ntk.num_pis() > ps.max_pis )
+    {
+      std::cerr << fmt::format( "[e] network has {} primary inputs, exhaustive simulation is limited to {}\n", ntk.num_pis(), ps.max_pis );
+      return false;
+    }
+
+    initialize();
+
+    uint64_t const num_tasks = num_blocks;
+    std::atomic<uint64_t> stop_block{ num_tasks };
+    std::atomic<uint64_t> num_simulated{ 0u };
+
+    std::vector<workspace> workspaces( static_cast<uint32_t>( std::min<uint64_t>( resolve_num_threads( ps.num_threads ), num_tasks ) ) );
+    parallel_for( ps.num_threads, num_tasks, [&]( uint64_t block, uint32_t thread_id ) {
+      /* blocks before the first interrupting block must still be visited */
+      if ( block >= stop_block.load() )
+      {
+        return;
+      }
+
+      auto& ws = workspaces[thread_id];
+      simulate_block( block, ws );
+      ++num_simulated;
+
+      if ( !fn( block * num_bits, static_cast<std::vector<kitty::partial_truth_table> const&>( ws.outputs ) ) )
+      {
+        auto current = stop_block.load();
+        while ( block < current && !stop_block.compare_exchange_weak( current, block ) )
+        {
+        }
+      }
+    } );
+
+    st.num_blocks += num_simulated;
+    return stop_block == num_tasks;
+  }
+
+private:
+  enum class gate_kind : uint8_t
+  {
+    and2,
+    xor2,
+    maj3,
+    xor3,
+    generic
+  };
+
+  struct gate
+  {
+    uint32_t index;
+    gate_kind kind;
+    uint32_t fanin_begin;
+    uint32_t fanin_end;
+    uint32_t function;
+  };
+
+  struct workspace
+  {
+    std::vector<uint64_t> values;
+    std::vector<kitty::partial_truth_table> outputs;
+  };
+
+  void initialize()
+  {
+    auto const num_vars = ntk.num_pis();
+
+    log_words = 0u;
+    while ( ( 2u << log_words ) <= ps.block_words && 6u + log_words < num_vars )
+    {
+      ++log_words;
+    }
+    num_words = 1u << log_words;
+    num_bits = num_vars < 6u ? ( 1u << num_vars ) : 64u * num_words;
+    num_blocks = num_vars <= 6u + log_words ? 1u : UINT64_C( 1 ) << ( num_vars - 6u - log_words );
+
+    constants.clear();
+    auto const add_constant = [&]( auto const& f ) {
+      auto const n = ntk.get_node( f );
+      constants.emplace_back( ntk.node_to_index( n ), ntk.constant_value( n ) );
+    };
+    add_constant( ntk.get_constant( false ) );
+    if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
+    {
+      add_constant( ntk.get_constant( true ) );
+    }
+
+    pis.clear();
+    ntk.foreach_pi( [&]( auto const& n ) {
+      pis.emplace_back( ntk.node_to_index( n ) );
+    } );
+
+    gates.clear();
+    fanins.clear();
+    functions.clear();
+    ntk.foreach_gate( [&]( auto const& n ) {
+      gate g{ ntk.node_to_index( n ), gate_kind::generic, static_cast<uint32_t>( fanins.size() ), 0u, 0u };
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        fanins.emplace_back( ntk.node_to_index( ntk.get_node( f ) ), ntk.is_complemented( f ) ? ~UINT64_C( 0 ) : UINT64_C( 0 ) );
+      } );
+      g.fanin_end = static_cast<uint32_t>( fanins.size() );
+      g.kind = classify( n, g.fanin_end - g.fanin_begin );
+      if ( g.kind == gate_kind::generic )
+      {
+        g.function = static_cast<uint32_t>( functions.size() );
+        functions.emplace_back( ntk.node_function( n ) );
+      }
+      gates.emplace_back( g );
+    } );
+
+    outputs.clear();
+    ntk.foreach_po( [&]( auto const& f ) {
+      outputs.emplace_back( ntk.node_to_index( ntk.get_node( f ) ), ntk.is_complemented( f ) ? ~UINT64_C( 0 ) : UINT64_C( 0 ) );
+    } );
+  }
+
+  gate_kind classify( node const& n, uint32_t num_fanins ) const
+  {
+    if constexpr ( has_is_and_v<Ntk> )
+    {
+      if ( num_fanins == 2u && ntk.is_and( n ) )
+        return gate_kind::and2;
+    }
+    if constexpr ( has_is_xor_v<Ntk> )
+    {
+      if ( num_fanins == 2u && ntk.is_xor( n ) )
+        return gate_kind::xor2;
+    }
+    if constexpr ( has_is_maj_v<Ntk> )
+    {
+      if ( num_fanins == 3u && ntk.is_maj( n ) )
+        return gate_kind::maj3;
+    }
+    if constexpr ( has_is_xor3_v<Ntk> )
+    {
+      if ( num_fanins == 3u && ntk.is_xor3( n ) )
+        return gate_kind::xor3;
+    }
+    (void)n;
+    (void)num_fanins;
+    return gate_kind::generic;
+  }
+
+  void simulate_block( uint64_t block, workspace& ws ) const
+  {
+    if ( ws.values.empty() )
+    {
+      ws.values.resize( static_cast<uint64_t>( ntk.size() ) * num_words );
+      ws.outputs.resize( outputs.size(), kitty::partial_truth_table( num_bits ) );
+    }
+
+    for ( auto const& [index, value] : constants )
+    {
+      std::fill_n( ws.values.begin() + index * num_words, num_words, value ? ~UINT64_C( 0 ) : UINT64_C( 0 ) );
+    }
+
+    static constexpr uint64_t projections[] = { 0xaaaaaaaaaaaaaaaa, 0xcccccccccccccccc, 0xf0f0f0f0f0f0f0f0, 0xff00ff00ff00ff00, 0xffff0000ffff0000, 0xffffffff00000000 };
+    for ( auto i = 0u; i < pis.size(); ++i )
+    {
+      auto* values = &ws.values[static_cast<uint64_t>( pis[i] ) * num_words];
+      for ( auto w = 0u; w < num_words; ++w )
+      {
+        if ( i < 6u )
+        {
+          values[w] = projections[i];
+        }
+        else if ( i < 6u + log_words )
+        {
+          values[w] = ( ( w >> ( i - 6u ) ) & 1u ) ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+        }
+        else
+        {
+          values[w] = ( ( block >> ( i - 6u - log_words ) ) & 1u ) ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+        }
+      }
+    }
+
+    for ( auto const& g : gates )
+    {
+      simulate_gate( g, ws.values );
+    }
+
+    for ( auto i = 0u; i < outputs.size(); ++i )
+    {
+      auto const* values = &ws.values[static_cast<uint64_t>( outputs[i].first ) * num_words];
+      auto& tt = ws.outputs[i];
+      for ( auto w = 0u; w < tt.num_blocks(); ++w )
+      {
+        tt._bits[w] = values[w] ^ outputs[i].second;
+      }
+      tt.mask_bits();
+    }
+  }
+
+  void simulate_gate( gate const& g, std::vector<uint64_t>& values ) const
+  {
+    auto* result = &values[static_cast<uint64_t>( g.index ) * num_words];
+    auto const fanin = [&]( uint32_t i, uint32_t w ) {
+      auto const& [index, mask] = fanins[g.fanin_begin + i];
+      return values[static_cast<uint64_t>( index ) * num_words + w] ^ mask;
+    };
+
+    switch ( g.kind )
+    {
+    case gate_kind::and2:
+      for ( auto w = 0u; w < num_words; ++w )
+      {
+        result[w] = fanin( 0u, w ) & fanin( 1u, w );
+      }
+      break;
+    case gate_kind::xor2:
+      for ( auto w = 0u; w < num_words; ++w )
+      {
+        result[w] = fanin( 0u, w ) ^ fanin( 1u, w );
+      }
+      break;
+    case gate_kind::maj3:
+      for ( auto w = 0u; w < num_words; ++w )
+      {
+        auto const a = fanin( 0u, w ), b = fanin( 1u, w ), c = fanin( 2u, w );
+        result[w] = ( a & b ) | ( a & c ) | ( b & c );
+      }
+      break;
+    case gate_kind::xor3:
+      for ( auto w = 0u; w < num_words; ++w )
+      {
+        result[w] = fanin( 0u, w ) ^ fanin( 1u, w ) ^ fanin( 2u, w );
+      }
+      break;
+    case gate_kind::generic:
+    {
+      /* sum of the minterms of the gate function */
+      auto const& function = functions[g.function];
+      auto const num_fanins = g.fanin_end - g.fanin_begin;
+      for ( auto w = 0u; w < num_words; ++w )
+      {
+        uint64_t word = 0u;
+        for ( uint64_t m = 0u; m < function.num_bits(); ++m )
+        {
+          if ( !kitty::get_bit( function, m ) )
+          {
+            continue;
+          }
+          uint64_t term = ~UINT64_C( 0 );
+          for ( auto j = 0u; j < num_fanins; ++j )
+          {
+            term &= ( ( m >> j ) & 1u ) ? fanin( j, w ) : ~fanin( j, w );
+          }
+          word |= term;
+        }
+        result[w] = word;
+      }
+      break;
+    }
+    }
+  }
+
+private:
+  Ntk const& ntk;
+  exhaustive_simulation_params const& ps;
+  exhaustive_simulation_stats& st;
+
+  uint32_t log_words{ 0u };
+  uint32_t num_words{ 1u };
+  uint32_t num_bits{ 64u };
+  uint64_t num_blocks{ 1u };
+
+  std::vector<std::pair<uint32_t, bool>> constants;
+  std::vector<uint32_t> pis;
+  std::vector<gate> gates;
+  std::vector<std::pair<uint32_t, uint64_t>> fanins;
+  std::vector<kitty::dynamic_truth_table> functions;
+  std::vector<std::pair<uint32_t, uint64_t>> outputs;
+};
+
+} // namespace detail
+
+/*! \brief Exhaustive simulation in blocks.
+ *
+ * Simulates all input assignments of the network without materializing a
+ * complete truth table for each node.  The input space is split into blocks
+ * of `ps.block_words` 64-bit words.  For each block, the function `fn` is
+ * called as `fn( offset, po_values )`, where `po_values` is a vector of
+ * `kitty::partial_truth_table` with the values of the primary outputs.  Bit
+ * `i` of each output corresponds to the input assignment `offset + i`, in
+ * which the `j`-th primary input is assigned bit `j` of the assignment (as
+ * in `kitty::create_nth_var`).  If `fn` returns `false`, no further blocks
+ * are started.
+ *
+ * Blocks are simulated by `ps.num_threads` threads, in which case `fn` is
+ * called concurrently from several threads.  Each thread reuses one buffer
+ * per node for all of its blocks.  Even when interrupted, all blocks before
+ * the first interrupting block are simulated.
+ *
+ * AND, XOR, MAJ, and XOR3 gates are simulated with dedicated word-level
+ * operations; all other gates are simulated from their `node_function`.
+ *
+ * **Required network functions:**
+ * - `foreach_pi`
+ * - `foreach_po`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `get_node`
+ * - `get_constant`
+ * - `constant_value`
+ * - `is_complemented`
+ * - `node_to_index`
+ * - `node_function`
+ *
+ * \param ntk Network
+ * \param fn Function called for each simulated block
+ * \param ps Parameters
+ * \param pst Statistics
+ * \return Returns `false` if the simulation was interrupted by `fn`, or if
+ *         the network has more than `ps.max_pis` primary inputs
+ */
+template<class Ntk, class Fn>
+bool exhaustive_simulation( Ntk const& ntk, Fn&& fn, exhaustive_simulation_params const& ps = {}, exhaustive_simulation_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+  static_assert( has_constant_value_v<Ntk>, "Ntk does not implement the constant_value method" );
+  static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( has_node_function_v<Ntk>, "Ntk does not implement the node_function method" );
+
+  exhaustive_simulation_stats st;
+  detail::exhaustive_simulation_impl<Ntk> p( ntk, ps, st );
+  auto const result = p.run( fn );
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+  return result;
+}
+
+/*! \brief Equivalence checking of a miter by exhaustive simulation.
+ *
+ * Checks whether all outputs of the miter are constant 0 by simulating all
+ * input assignments with `exhaustive_simulation`.  The simulation stops as
+ * soon as an output evaluates to 1.  In that case, the smallest input
+ * assignment (in the order of `exhaustive_simulation`) for which an output
+ * evaluates to 1 is stored as counter-example in the statistics,
+ * independently of the number of threads.
+ *
+ * \param miter Miter network
+ * \param ps Parameters
+ * \param pst Statistics
+ * \return Returns `std::nullopt` if the miter has more than `ps.max_pis`
+ *         primary inputs, and whether all outputs are constant 0 otherwise
+ */
+template<class Ntk>
+std::optional<bool> exhaustive_equivalence_checking( Ntk const& miter, exhaustive_simulation_params const& ps = {}, exhaustive_simulation_stats* pst = nullptr )
+{
+  if ( miter.num_pis() > ps.max_pis )
+  {
+    return std::nullopt;
+  }
+
+  std::mutex mutex;
+  uint64_t first_cex = UINT64_MAX;
+
+  exhaustive_simulation_params ps_sim = ps;
+  ps_sim.verbose = false;
+  exhaustive_simulation_stats st;
+  auto const equivalent = exhaustive_simulation(
+      miter, [&]( uint64_t offset, std::vector<kitty::partial_truth_table> const& po_values ) {
+        int64_t first_bit = -1;
+        for ( auto const& tt : po_values )
+        {
+          auto const bit = kitty::find_first_one_bit( tt );
+          if ( bit != -1 && ( first_bit == -1 || bit < first_bit ) )
+          {
+            first_bit = bit;
+          }
+        }
+        if ( first_bit == -1 )
+        {
+          return true;
+        }
+
+        std::lock_guard<std::mutex> lock( mutex );
+        first_cex = std::min<uint64_t>( first_cex, offset + first_bit );
+        return false;
+      },
+      ps_sim, &st );
+
+  if ( !equivalent )
+  {
+    st.counter_example.resize( miter.num_pis() );
+    for ( auto i = 0u; i < miter.num_pis(); ++i )
+    {
+      st.counter_example[i] = ( first_cex >> i ) & 1u;
+    }
+  }
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+  return equivalent;
+}
+
+} // namespace mockturtle
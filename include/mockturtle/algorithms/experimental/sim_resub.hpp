@@ -86,12 +86,20 @@ struct simulation_guided_resynthesis_params
   /*! \brief Whether to save the appended patterns (with CEXs) into file. */
   std::optional<std::string> save_patterns{};
 
+  /*! \brief Whether to save the patterns in binary format (see `write_binary_patterns`).
+   * If the patterns are saved into the file they were read from, only the new patterns are appended.
+   */
+  bool binary_patterns{ false };
+
   /*! \brief Maximum number of clauses of the SAT solver. */
   uint32_t max_clauses{ 1000 };
 
   /*! \brief Conflict limit for the SAT solver. */
   uint32_t conflict_limit{ 1000 };
 
+  /*! \brief Retire dead CNF cones instead of restarting the SAT solver (see `validator_params::incremental_gc`). */
+  bool incremental_gc{ false };
+
   /*! \brief Random seed for the SAT solver (influences the randomness of counter-examples). */
   uint32_t random_seed{ 1 };
 
@@ -337,7 +345,7 @@ public:
 
   explicit simulation_guided_resynthesis( Ntk const& ntk, params_t const& ps, stats_t& st )
       : ntk( ntk ), ps( ps ), st( st ), engine( rst ),
-        validator( ntk, { ps.max_clauses, ps.odc_levels, ps.conflict_limit, ps.random_seed } ), tts( ntk )
+        validator( ntk, { ps.max_clauses, ps.odc_levels, ps.conflict_limit, ps.random_seed, ps.incremental_gc } ), tts( ntk )
   {}
 
   ~simulation_guided_resynthesis()
@@ -345,7 +353,7 @@ public:
     if ( ps.save_patterns )
     {
       call_with_stopwatch( st.time_patsave, [&]() {
-        write_patterns( sim, *ps.save_patterns );
+        save_simulation_patterns( sim, *ps.save_patterns, ps.binary_patterns, ps.pattern_filename );
       } );
     }
 
@@ -61,7 +61,12 @@
 #include "../io/verilog_reader.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../utils/abc.hpp"
+#include "../utils/cancellation_token.hpp"
+#include "../utils/parallel_utils.hpp"
 
+#include <algorithm>
+#include <mutex>
+#include <optional>
 #include <random>
 
 #define explorer_debug 0
@@ -90,6 +95,24 @@ struct explorer_params
   /*! \brief Timeout per iteration in seconds. */
   uint32_t timeout{30u};
 
+  /*! \brief Number of threads running restarts concurrently (0 = number of hardware threads).
+   *
+   * The scripts and the cost function must be safe to call concurrently on different networks.
+   */
+  uint32_t num_threads{1u};
+
+  /*! \brief Number of steps after which the restarts adopt the best network found so far (0 = never).
+   *
+   * The restarts then run in rounds, such that the result is the same for any number of threads.
+   */
+  uint32_t sync_interval{0u};
+
+  /*! \brief Token to stop all restarts before their next step, returning the best network found so far.
+   *
+   * The same token can be given to the algorithms called in the scripts.
+   */
+  cancellation_token cancellation{};
+
   /*! \brief Be verbose. */
   bool verbose{false};
 
@@ -149,89 +172,204 @@ public:
       return ntk;
     }
 
+    /* the seeds of the restarts do not depend on the number of threads */
     RandEngine rnd( _ps.random_seed );
+    std::vector<uint32_t> seeds( _ps.num_restarts );
+    std::generate( seeds.begin(), seeds.end(), [&]() { return static_cast<uint32_t>( rnd() ); } );
+
     auto init_cost = call_with_stopwatch( _st.time_evaluate, [&](){ return cost( ntk ); } );
-    Ntk best = ntk.clone();
-    auto best_cost = init_cost;
-    for ( auto i = 0u; i < _ps.num_restarts; ++i )
+    shared_best best( ntk.clone(), init_cost );
+
+    if ( _ps.sync_interval == 0u )
+    {
+      /* independent restarts */
+      parallel_for( _ps.num_threads, _ps.num_restarts, [&]( uint64_t i, uint32_t ) {
+        restart_state state( ntk, seeds[i], init_cost, _ps.verbose );
+        run_steps( state, _ps.max_steps );
+        offer( best, state, static_cast<uint32_t>( i ) );
+        merge_stats( state );
+      } );
+    }
+    else
     {
-      Ntk current = ntk.clone();
-      auto new_cost = run_one_iteration( current, rnd(), init_cost );
-      if ( new_cost < best_cost )
+      /* restarts in lock-step rounds of `sync_interval` steps, after which they adopt the best network */
+      std::vector<restart_state> states;
+      states.reserve( _ps.num_restarts );
+      for ( auto i = 0u; i < _ps.num_restarts; ++i )
       {
-        best = current.clone();
-        best_cost = new_cost;
+        states.emplace_back( ntk, seeds[i], init_cost, _ps.verbose );
+      }
+
+      std::vector<uint32_t> active;
+      while ( true )
+      {
+        active.clear();
+        for ( auto i = 0u; i < _ps.num_restarts; ++i )
+        {
+          if ( !states[i].done )
+          {
+            active.emplace_back( i );
+          }
+        }
+        if ( active.empty() )
+        {
+          break;
+        }
+
+        parallel_for( _ps.num_threads, active.size(), [&]( uint64_t i, uint32_t ) {
+          run_steps( states[active[i]], _ps.sync_interval );
+        } );
+
+        for ( auto i : active )
+        {
+          offer( best, states[i], i );
+        }
+        for ( auto& state : states )
+        {
+          if ( !state.done && state.best_cost > best.cost )
+          {
+            state.current = best.ntk.clone();
+            state.best = best.ntk.clone();
+            state.best_cost = best.cost;
+            state.last_update = state.step;
+          }
+        }
+      }
+
+      for ( auto& state : states )
+      {
+        merge_stats( state );
       }
-      if ( _ps.verbose )
-        fmt::print( "[i] best cost in restart {}: {}, overall best cost: {}\n", i, new_cost, best_cost );
     }
-    return best;
+
+    return best.ntk;
   }
 
 private:
-  uint32_t run_one_iteration( Ntk& ntk, uint32_t seed, uint32_t init_cost )
+  /* state of one restart */
+  struct restart_state
   {
-    if ( _ps.verbose )
+    restart_state( Ntk const& ntk, uint32_t seed, uint32_t init_cost, bool verbose )
+        : current( ntk.clone() ), best( ntk.clone() ), best_cost( init_cost ), rnd( seed )
     {
-      fmt::print( "\n[i] new restart using seed {}, original cost = {}\n", seed, init_cost );
+      if ( verbose )
+      {
+        fmt::print( "\n[i] new restart using seed {}, original cost = {}\n", seed, init_cost );
+      }
     }
- 
-    stopwatch<>::duration elapsed_time{0};
-    RandEngine rnd( seed );
-    Ntk best = ntk.clone();
-    auto best_cost = init_cost;
+
+    Ntk current;
+    Ntk best;
+    uint32_t best_cost;
+    RandEngine rnd;
+    uint32_t step{0u};
     uint32_t last_update{0u};
-    for ( auto i = 0u; i < _ps.max_steps; ++i )
+    bool done{false};
+    stopwatch<>::duration elapsed_time{0};
+    stopwatch<>::duration time_evaluate{0};
+  };
+
+  /* best network found by all restarts, ties are broken by the lowest restart index */
+  struct shared_best
+  {
+    shared_best( Ntk const& ntk, uint32_t cost )
+        : ntk( ntk ), cost( cost )
     {
+    }
+
+    std::mutex mutex;
+    Ntk ntk;
+    uint32_t cost;
+    std::optional<uint32_t> restart;
+  };
+
+  void offer( shared_best& best, restart_state const& state, uint32_t restart )
+  {
+    std::lock_guard<std::mutex> lock( best.mutex );
+    if ( state.best_cost < best.cost || ( state.best_cost == best.cost && best.restart && restart < *best.restart ) )
+    {
+      best.ntk = state.best.clone();
+      best.cost = state.best_cost;
+      best.restart = restart;
+    }
+    if ( _ps.verbose && state.done )
+      fmt::print( "[i] best cost in restart {}: {}, overall best cost: {}\n", restart, state.best_cost, best.cost );
+  }
+
+  void merge_stats( restart_state const& state )
+  {
+    std::lock_guard<std::mutex> lock( stats_mutex );
+    _st.time_evaluate += state.time_evaluate;
+  }
+
+  /* runs up to `num_steps` further steps of a restart */
+  void run_steps( restart_state& state, uint32_t num_steps )
+  {
+    Ntk& ntk = state.current;
+    for ( auto end = state.step + std::min( num_steps, _ps.max_steps - state.step ); state.step < end; ++state.step )
+    {
+      auto const i = state.step;
+      if ( _ps.cancellation.is_cancelled() )
+      {
+        if ( _ps.verbose )
+          fmt::print( "[i] break restart at step {} after cancellation\n", i );
+        state.done = true;
+        break;
+      }
     #if explorer_debug
       Ntk backup = ntk.clone();
     #endif
 
       {
-        stopwatch t( elapsed_time );
-        decompress( ntk, rnd, i );
-        compress( ntk, rnd, i );
+        stopwatch t( state.elapsed_time );
+        decompress( ntk, state.rnd, i );
+        compress( ntk, state.rnd, i );
       }
-      auto new_cost = call_with_stopwatch( _st.time_evaluate, [&](){ return cost( ntk ); } );
+      auto new_cost = call_with_stopwatch( state.time_evaluate, [&](){ return cost( ntk ); } );
       if ( _ps.very_verbose )
         fmt::print( "[i] after step {}, cost = {}\n", i, new_cost );
 
     #if explorer_debug
-      if ( !*equivalence_checking( *miter<Ntk>( ntk, best ) ) )
+      if ( !*equivalence_checking( *miter<Ntk>( ntk, state.best ) ) )
       {
         write_verilog( backup, "debug.v" );
         write_verilog( ntk, "wrong.v" );
         fmt::print( "NEQ at step {}!\n", i );
+        state.done = true;
         break;
       }
     #endif
 
-      if ( new_cost < best_cost )
+      if ( new_cost < state.best_cost )
       {
-        best = ntk.clone();
-        best_cost = new_cost;
-        last_update = i;
+        state.best = ntk.clone();
+        state.best_cost = new_cost;
+        state.last_update = i;
         if ( _ps.verbose )
         {
-          fmt::print( "[i] updated new best at step {}: {}\n", i, best_cost );
+          fmt::print( "[i] updated new best at step {}: {}\n", i, state.best_cost );
         }
       }
-      if ( i - last_update >= _ps.max_steps_no_impr )
+      if ( i - state.last_update >= _ps.max_steps_no_impr )
       {
         if ( _ps.verbose )
-          fmt::print( "[i] break restart at step {} after {} steps without improvement (elapsed time: {} secs)\n", i, _ps.max_steps_no_impr, to_seconds( elapsed_time ) );
+          fmt::print( "[i] break restart at step {} after {} steps without improvement (elapsed time: {} secs)\n", i, _ps.max_steps_no_impr, to_seconds( state.elapsed_time ) );
+        state.done = true;
         break;
       }
-      if ( to_seconds( elapsed_time ) >= _ps.timeout )
+      if ( to_seconds( state.elapsed_time ) >= _ps.timeout )
       {
         if ( _ps.verbose )
-          fmt::print( "[i] break restart at step {} after timeout of {} secs\n", i, to_seconds( elapsed_time ) );
+          fmt::print( "[i] break restart at step {} after timeout of {} secs\n", i, to_seconds( state.elapsed_time ) );
+        state.done = true;
         break;
       }
     }
+    if ( state.step >= _ps.max_steps )
+    {
+      state.done = true;
+    }
     std::cout << std::flush;
-    ntk = best;
-    return best_cost;
   }
 
   void decompress( Ntk& ntk, RandEngine& rnd, uint32_t i )
@@ -275,6 +413,7 @@ private:
   float total_weights_com{0.0};
 
   cost_fn_t<Ntk> cost;
+  std::mutex stats_mutex;
 };
 
 mig_network explore_mig( mig_network const& ntk, explorer_params const ps = {} )
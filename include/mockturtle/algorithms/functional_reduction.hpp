@@ -33,13 +33,20 @@
 
 #pragma once
 
+#include "../utils/cancellation_token.hpp"
+#include "../utils/parallel_utils.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/fanout_view.hpp"
+#include "detail/pattern_filter.hpp"
 
 #include <bill/sat/interface/abc_bsat2.hpp>
+#include <kitty/hash.hpp>
 #include <kitty/partial_truth_table.hpp>
 
+#include <memory>
+#include <unordered_map>
+
 #include "../io/write_patterns.hpp"
 #include "circuit_validator.hpp"
 #include "simulation.hpp"
@@ -55,7 +62,7 @@ struct functional_reduction_params
   /*! \brief Be verbose. */
   bool verbose{ false };
 
-  /*! \brief Maximum number of iterations to run. 0 = repeat until no further improvement can be found. */
+  /*! \brief Maximum number of iterations to run after the first pass. 0 = run a single pass. */
   uint32_t max_iterations{ 10 };
 
   /*! \brief Whether to use pre-generated patterns stored in a file.
@@ -66,6 +73,11 @@ struct functional_reduction_params
   /*! \brief Whether to save the appended patterns (with CEXs) into file. */
   std::optional<std::string> save_patterns{};
 
+  /*! \brief Whether to save the patterns in binary format (see `write_binary_patterns`).
+   * If the patterns are saved into the file they were read from, only the new patterns are appended.
+   */
+  bool binary_patterns{ false };
+
   /*! \brief Maximum number of nodes in the transitive fanin cone (and their fanouts) to be compared to. */
   uint32_t max_TFI_nodes{ 1000 };
 
@@ -78,11 +90,29 @@ struct functional_reduction_params
   /*! \brief Maximum number of clauses of the SAT solver. (incremental CNF construction) */
   uint32_t max_clauses{ 1000 };
 
+  /*! \brief Retire dead CNF cones instead of restarting the SAT solver (see `validator_params::incremental_gc`). */
+  bool incremental_gc{ false };
+
   /*! \brief Initial number of (random) simulation patterns. */
   uint32_t num_patterns{ 256 };
 
   /*! \brief Maximum number of simulation patterns. Discards all patterns and re-seeds with random patterns when exceeded. */
   uint32_t max_patterns{ 1024 };
+
+  /*! \brief Number of threads for SAT sweeping (0 = hardware concurrency).
+   *
+   * With more than one thread, candidates are taken from the classes of
+   * equal (or complemented) simulation signatures over the whole network
+   * instead of the transitive fanin cone of each node.  Each thread checks
+   * a disjoint topological range of candidates with its own validator.
+   * Proven merges are committed in topological order and the
+   * counter-examples of all threads are added to the simulation patterns
+   * before the classes are refined in the next iteration.
+   */
+  uint32_t num_threads{ 1 };
+
+  /*! \brief Token to stop before the next candidate, keeping the merges done so far. */
+  cancellation_token cancellation{};
 };
 
 struct functional_reduction_stats
@@ -141,7 +171,7 @@ public:
   using TT = unordered_node_map<kitty::partial_truth_table, Ntk>;
 
   explicit functional_reduction_impl( Ntk& ntk, functional_reduction_params const& ps, validator_params const& vps, functional_reduction_stats& st )
-      : ntk( ntk ), ps( ps ), st( st ), tts( ntk ),
+      : ntk( ntk ), ps( ps ), vps( vps ), st( st ), tts( ntk ),
         sim( ps.pattern_filename ? partial_simulator( *ps.pattern_filename ) : partial_simulator( ntk.num_pis(), ps.num_patterns, std::rand() ) ), validator( ntk, vps )
   {
     static_assert( !validator_t::use_odc_, "`circuit_validator::use_odc` flag should be turned off." );
@@ -151,7 +181,7 @@ public:
   {
     if ( ps.save_patterns )
     {
-      write_patterns( sim, *ps.save_patterns );
+      save_simulation_patterns( sim, *ps.save_patterns, ps.binary_patterns, ps.pattern_filename );
     }
   }
 
@@ -164,6 +194,12 @@ public:
       simulate_nodes<Ntk>( ntk, tts, sim, true );
     } );
 
+    if ( resolve_num_threads( ps.num_threads ) > 1u )
+    {
+      run_parallel();
+      return;
+    }
+
     /* remove constant nodes. */
     substitute_constants();
 
@@ -171,7 +207,7 @@ public:
     auto size_before = ntk.size();
     substitute_equivalent_nodes();
     uint32_t iterations{0};
-    while ( ps.max_iterations && iterations++ <= ps.max_iterations && ntk.size() != size_before )
+    while ( ps.max_iterations && iterations++ <= ps.max_iterations && ntk.size() != size_before && !ps.cancellation.is_cancelled() )
     {
       size_before = ntk.size();
       substitute_equivalent_nodes();
@@ -179,6 +215,178 @@ public:
   }
 
 private:
+  struct candidate
+  {
+    node n;
+    signal g;
+    bool is_constant;
+  };
+
+  enum class candidate_result : uint8_t
+  {
+    skipped,
+    timeout,
+    cex,
+    proven
+  };
+
+  void run_parallel()
+  {
+    uint32_t const num_threads = resolve_num_threads( ps.num_threads );
+
+    std::vector<std::unique_ptr<validator_t>> validators;
+    for ( auto i = 0u; i < num_threads; ++i )
+    {
+      validators.emplace_back( std::make_unique<validator_t>( ntk, vps ) );
+    }
+
+    /* same number of iterations as the sequential run: one pass, repeated only if `max_iterations` is not 0 */
+    uint32_t iterations{ 0 };
+    do
+    {
+      auto const candidates = collect_candidates();
+      if ( candidates.empty() )
+      {
+        break;
+      }
+
+      std::vector<candidate_result> results( candidates.size(), candidate_result::skipped );
+      std::vector<std::vector<bool>> cexs( candidates.size() );
+
+      /* each thread checks a fixed topological range with its own validator, so that the results are deterministic */
+      call_with_stopwatch( st.time_sat, [&]() {
+        parallel_for( num_threads, num_threads, [&]( uint64_t t, uint32_t ) {
+          auto& validator = *validators[t];
+          /* counter-examples found by this thread in this iteration */
+          pattern_filter<Ntk> filter( ntk );
+          for ( auto i = candidates.size() * t / num_threads; i < candidates.size() * ( t + 1 ) / num_threads; ++i )
+          {
+            if ( ps.cancellation.is_cancelled() )
+            {
+              break;
+            }
+
+            auto const& cand = candidates[i];
+            /* skip candidates already disproved by counter-examples found by this thread */
+            if ( filter.distinguishes( cand.n, cand.g ) )
+            {
+              continue;
+            }
+
+            auto const res = cand.is_constant ? validator.validate( cand.n, cand.g == ntk.get_constant( true ) ) : validator.validate( cand.n, cand.g );
+            if ( !res )
+            {
+              results[i] = candidate_result::timeout;
+            }
+            else if ( !( *res ) )
+            {
+              results[i] = candidate_result::cex;
+              cexs[i] = validator.cex;
+              filter.add_pattern( validator.cex );
+            }
+            else
+            {
+              results[i] = candidate_result::proven;
+            }
+          }
+        } );
+      } );
+
+      /* commit merges in topological order */
+      bool changed = false;
+      for ( auto i = 0u; i < candidates.size(); ++i )
+      {
+        auto const& cand = candidates[i];
+        switch ( results[i] )
+        {
+        case candidate_result::skipped:
+          break;
+        case candidate_result::timeout:
+          ++st.num_timeout;
+          break;
+        case candidate_result::cex:
+          ++st.num_cex;
+          changed = true;
+          sim.add_pattern( cexs[i] );
+          if ( sim.num_bits() > ps.max_patterns )
+          {
+            reseed_patterns();
+          }
+          else if ( sim.num_bits() % 64 == 0 )
+          {
+            call_with_stopwatch( st.time_sim, [&]() {
+              simulate_nodes<Ntk>( ntk, tts, sim, false );
+            } );
+          }
+          break;
+        case candidate_result::proven:
+          if constexpr ( has_is_dead_v<Ntk> )
+          {
+            /* earlier merges may have removed one of the nodes by structural hashing */
+            if ( ntk.is_dead( cand.n ) || ntk.is_dead( ntk.get_node( cand.g ) ) )
+            {
+              break;
+            }
+          }
+          ++st.num_reduction;
+          if ( cand.is_constant )
+          {
+            ++st.num_const_accepts;
+          }
+          else
+          {
+            ++st.num_equ_accepts;
+          }
+          changed = true;
+          /* without structural hashing, the representative keeps a smaller index than all fanouts of the merged node */
+          if constexpr ( has_substitute_node_no_restrash_v<Ntk> )
+          {
+            ntk.substitute_node_no_restrash( cand.n, cand.g );
+          }
+          else
+          {
+            ntk.substitute_node( cand.n, cand.g );
+          }
+          break;
+        }
+      }
+
+      if ( !changed )
+      {
+        break;
+      }
+    } while ( ps.max_iterations && iterations++ <= ps.max_iterations && !ps.cancellation.is_cancelled() );
+  }
+
+  /* candidates in topological order; the representative of a class is its first node */
+  std::vector<candidate> collect_candidates()
+  {
+    std::vector<candidate> candidates;
+    std::unordered_map<kitty::partial_truth_table, node, kitty::hash<kitty::partial_truth_table>> classes;
+
+    auto const zero = sim.compute_constant( false );
+    auto const one = sim.compute_constant( true );
+    ntk.foreach_gate( [&]( auto const& n ) {
+      check_tts( n );
+      auto const& tt = tts[n];
+      if ( tt == zero || tt == one )
+      {
+        candidates.push_back( { n, ntk.get_constant( tt == one ), true } );
+        return;
+      }
+
+      bool const phase = kitty::get_bit( tt, 0 );
+      auto const [it, inserted] = classes.try_emplace( phase ? ~tt : tt, n );
+      if ( !inserted )
+      {
+        bool const repr_phase = kitty::get_bit( tts[it->second], 0 );
+        candidates.push_back( { n, ntk.make_signal( it->second ) ^ ( phase != repr_phase ), false } );
+      }
+    } );
+
+    return candidates;
+  }
+
   void substitute_constants()
   {
     progress_bar pbar{ ntk.size(), "FR-const |{0}| node = {1:>4}   cand = {2:>4}", ps.progress };
@@ -186,6 +394,11 @@ private:
     auto zero = sim.compute_constant( false );
     auto one = sim.compute_constant( true );
     ntk.foreach_gate( [&]( auto const& n, auto i ) {
+      if ( ps.cancellation.is_cancelled() )
+      {
+        return false; /* terminate */
+      }
+
       pbar( i, i, candidates );
 
       check_tts( n );
@@ -235,6 +448,11 @@ private:
   {
     progress_bar pbar{ ntk.size(), "FR-equ |{0}| node = {1:>4}   cand = {2:>4}", ps.progress };
     ntk.foreach_gate( [&]( auto const& root, auto i ) {
+      if ( ps.cancellation.is_cancelled() )
+      {
+        return false; /* terminate */
+      }
+
       pbar( i, i, candidates );
 
       check_tts( root );
@@ -328,6 +546,11 @@ private:
       return true; /* try next transitive fanin node */
     }
 
+    if ( ps.cancellation.is_cancelled() )
+    {
+      return false; /* stop trying */
+    }
+
     /* update progress bar */
     candidates++;
 
@@ -431,6 +654,7 @@ private:
 private:
   Ntk& ntk;
   functional_reduction_params const& ps;
+  validator_params const vps;
   functional_reduction_stats& st;
 
   TT tts;
@@ -466,6 +690,7 @@ void functional_reduction( Ntk& ntk, functional_reduction_params const& ps = {},
   validator_params vps;
   vps.max_clauses = ps.max_clauses;
   vps.conflict_limit = ps.conflict_limit;
+  vps.incremental_gc = ps.incremental_gc;
 
   using fanout_view_t = fanout_view<Ntk>;
   fanout_view_t fanout_view{ ntk };
@@ -43,6 +43,7 @@
 #include "../networks/sequential.hpp"
 #include "../networks/xag.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/npn_canonization.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../utils/tech_library.hpp"
 #include "../views/binding_view.hpp"
@@ -2029,7 +2030,7 @@ private:
         /* match the cut using canonization and get the gates */
         const auto tt = cuts.truth_table( *cut );
         const auto fe = kitty::extend_to<NInputs>( tt );
-        const auto config = kitty::exact_npn_canonization( fe );
+        const auto config = cached_exact_npn_canonization( fe );
         auto const supergates_npn = library.get_supergates( std::get<0>( config ) );
         auto const supergates_npn_neg = library.get_supergates( ~std::get<0>( config ) );
 
@@ -2113,7 +2114,7 @@ private:
         const auto tt = cuts.truth_table( *cut );
         const auto fe = kitty::shrink_to<NInputs>( tt );
 
-        auto [tt_npn, neg, perm] = kitty::exact_npn_canonization( fe );
+        auto [tt_npn, neg, perm] = cached_exact_npn_canonization( fe );
         auto perm_neg = perm;
         auto neg_neg = neg;
 
@@ -0,0 +1,235 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file memoized.hpp
+  \brief Resynthesis with a shared cache of index lists
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/dynamic_truth_table.hpp>
+
+#include "../../networks/mig.hpp"
+#include "../../traits.hpp"
+#include "../../utils/index_list/index_list.hpp"
+#include "../../utils/structure_cache.hpp"
+
+namespace mockturtle
+{
+
+namespace detail
+{
+
+template<class Ntk>
+struct memoized_index_list
+{
+  using type = xag_index_list<>;
+};
+
+template<>
+struct memoized_index_list<mig_network>
+{
+  using type = mig_index_list;
+};
+
+} // namespace detail
+
+/*! \brief Resynthesis function with a cache of structures.
+ *
+ * This resynthesis function wraps another resynthesis function, which
+ * synthesizes into networks of type `Ntk`, and can be passed to
+ * ``node_resynthesis``, ``cut_rewriting``, and ``refactoring``.  The first
+ * time a function is queried, the wrapped function is called on a fresh
+ * network of type `Ntk`, and the structures it returns are stored as index
+ * lists in a `structure_cache` (an empty sequence is stored if there is no
+ * structure).  Later queries for the same function only insert the stored
+ * structures into the target network.  Up to `max_candidates` structures are
+ * stored for each function; the default of 1 suffices for ``node_resynthesis``
+ * and ``refactoring``, which only use the first structure.
+ *
+ * The cache is held in a shared pointer and can be shared by several
+ * resynthesis functions of the same network type, as well as saved into and
+ * loaded from a file.  The function can be called concurrently from several
+ * threads if the wrapped function can.
+ *
+ * `Ntk` must be an AIG, XAG, or MIG.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      aig_network aig = ...;
+
+      using cache_t = structure_cache<xag_index_list<>>;
+      auto cache = std::make_shared<cache_t>();
+      cache->load( "sop.structures" ); // optional
+
+      sop_factoring<aig_network> sop;
+      memoized_resynthesis<aig_network, sop_factoring<aig_network>> resyn( sop, cache );
+      refactoring( aig, resyn );
+
+      cache->save( "sop.structures" );
+   \endverbatim
+ */
+template<class Ntk, class ResynthesisFn, class IndexList = typename detail::memoized_index_list<typename Ntk::base_type>::type>
+class memoized_resynthesis
+{
+public:
+  using cache_t = structure_cache<IndexList>;
+
+public:
+  explicit memoized_resynthesis( ResynthesisFn const& resyn_fn, std::shared_ptr<cache_t> cache = std::make_shared<cache_t>(), uint32_t max_candidates = 1u )
+      : _resyn_fn( resyn_fn ),
+        _cache( cache ),
+        _max_candidates( max_candidates )
+  {
+  }
+
+  template<class NtkDest, typename LeavesIterator, typename Fn>
+  void operator()( NtkDest& ntk, kitty::dynamic_truth_table const& function, LeavesIterator begin, LeavesIterator end, Fn&& fn ) const
+  {
+    auto lists = _cache->lookup( function );
+    if ( !lists )
+    {
+      lists = std::make_shared<typename cache_t::entry_t const>( synthesize( function ) );
+      _cache->insert( function, *lists );
+    }
+
+    std::vector<signal<NtkDest>> leaves( begin, end );
+    for ( auto const& list : *lists )
+    {
+      bool next{ true };
+      insert( ntk, leaves.begin(), leaves.end(), list, [&]( auto const& f ) {
+        if constexpr ( std::is_same_v<std::invoke_result_t<Fn, signal<NtkDest> const&>, void> )
+        {
+          fn( f );
+        }
+        else
+        {
+          next = fn( f );
+        }
+      } );
+
+      if ( !next )
+      {
+        return;
+      }
+    }
+  }
+
+  std::shared_ptr<cache_t> const& cache() const
+  {
+    return _cache;
+  }
+
+  void report() const
+  {
+    auto const st = _cache->stats();
+    fmt::print( "[i] cache hits      = {}\n", st.hits );
+    fmt::print( "[i] cache misses    = {}\n", st.misses );
+    fmt::print( "[i] cache evictions = {}\n", st.evictions );
+    fmt::print( "[i] size of cache   = {}\n", _cache->size() );
+  }
+
+private:
+  std::vector<IndexList> synthesize( kitty::dynamic_truth_table const& function ) const
+  {
+    Ntk ntk;
+    std::vector<signal<Ntk>> pis( function.num_vars() );
+    std::generate( pis.begin(), pis.end(), [&]() { return ntk.create_pi(); } );
+
+    std::unordered_map<node<Ntk>, uint32_t> pi_literals;
+    pi_literals.emplace( ntk.get_node( ntk.get_constant( false ) ), 0u );
+    for ( auto i = 0u; i < pis.size(); ++i )
+    {
+      pi_literals.emplace( ntk.get_node( pis[i] ), ( i + 1u ) << 1 );
+    }
+
+    std::vector<IndexList> lists;
+    if ( _max_candidates == 0u )
+    {
+      return lists;
+    }
+
+    _resyn_fn( ntk, function, pis.begin(), pis.end(), [&]( signal<Ntk> const& f ) {
+      IndexList list( function.num_vars() );
+      auto literals = pi_literals;
+      list.add_output( literal( ntk, ntk.get_node( f ), list, literals ) ^ ( ntk.is_complemented( f ) ? 1u : 0u ) );
+      lists.emplace_back( list );
+      return lists.size() < _max_candidates;
+    } );
+
+    return lists;
+  }
+
+  /* adds the cone of `n` to the index list and returns its literal */
+  uint32_t literal( Ntk const& ntk, node<Ntk> const& n, IndexList& list, std::unordered_map<node<Ntk>, uint32_t>& literals ) const
+  {
+    if ( auto const it = literals.find( n ); it != literals.end() )
+    {
+      return it->second;
+    }
+
+    std::vector<uint32_t> fanin;
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      fanin.emplace_back( literal( ntk, ntk.get_node( f ), list, literals ) ^ ( ntk.is_complemented( f ) ? 1u : 0u ) );
+    } );
+
+    uint32_t lit;
+    if constexpr ( std::is_same_v<IndexList, mig_index_list> )
+    {
+      lit = list.add_maj( fanin[0], fanin[1], fanin[2] );
+    }
+    else if constexpr ( has_is_xor_v<Ntk> )
+    {
+      lit = ntk.is_xor( n ) ? list.add_xor( fanin[0], fanin[1] ) : list.add_and( fanin[0], fanin[1] );
+    }
+    else
+    {
+      lit = list.add_and( fanin[0], fanin[1] );
+    }
+
+    literals.emplace( n, lit );
+    return lit;
+  }
+
+private:
+  ResynthesisFn _resyn_fn;
+  std::shared_ptr<cache_t> _cache;
+  uint32_t _max_candidates;
+};
+
+} /* namespace mockturtle */
@@ -45,6 +45,7 @@
 #include "../../algorithms/cleanup.hpp"
 #include "../../networks/mig.hpp"
 #include "../../traits.hpp"
+#include "../../utils/npn_canonization.hpp"
 #include "../../views/topo_view.hpp"
 
 namespace mockturtle
@@ -94,7 +95,7 @@ public:
   {
     assert( function.num_vars() <= 4 );
     const auto fe = kitty::extend_to( function, 4 );
-    const auto config = kitty::exact_npn_canonization( fe );
+    const auto config = cached_exact_npn_canonization( fe );
 
     const auto it = class2signal.find( static_cast<uint16_t>( std::get<0>( config )._bits[0] ) );
 
@@ -119,8 +120,15 @@ public:
 
     for ( auto const& po : it->second )
     {
-      topo_view topo{ db, po };
-      auto f = cleanup_dangling( topo, mig, pis_perm.begin(), pis_perm.end() ).front();
+      /* the database is only read, such that the function can be called concurrently */
+      std::unordered_map<mig_network::node, mig_network::signal> db_to_ntk;
+      db_to_ntk.insert( { 0, mig.get_constant( false ) } );
+      for ( auto i = 0u; i < 4u; ++i )
+      {
+        db_to_ntk.insert( { i + 1, pis_perm[i] } );
+      }
+      const auto g = copy_db_entry( mig, db.get_node( po ), db_to_ntk );
+      const auto f = db.is_complemented( po ) ? !g : g;
 
       if ( !fn( ( ( phase >> 4 ) & 1 ) ? !f : f ) )
       {
@@ -130,6 +138,24 @@ public:
   }
 
 private:
+  mig_network::signal copy_db_entry( mig_network& ntk, mig_network::node const& n, std::unordered_map<mig_network::node, mig_network::signal>& db_to_ntk ) const
+  {
+    if ( const auto it = db_to_ntk.find( n ); it != db_to_ntk.end() )
+    {
+      return it->second;
+    }
+
+    std::vector<mig_network::signal> fanin;
+    db.foreach_fanin( n, [&]( auto const& f ) {
+      const auto ntk_f = copy_db_entry( ntk, db.get_node( f ), db_to_ntk );
+      fanin.push_back( db.is_complemented( f ) ? !ntk_f : ntk_f );
+    } );
+
+    const auto f = ntk.clone_node( db, n, fanin );
+    db_to_ntk.insert( { n, f } );
+    return f;
+  }
+
   void build_db()
   {
     std::vector<mig_network::signal> signals;
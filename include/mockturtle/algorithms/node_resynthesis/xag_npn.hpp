@@ -49,6 +49,7 @@
 #include "../../networks/xag.hpp"
 #include "../../utils/index_list/index_list.hpp"
 #include "../../utils/node_map.hpp"
+#include "../../utils/npn_canonization.hpp"
 #include "../../utils/stopwatch.hpp"
 
 namespace mockturtle
@@ -211,7 +212,7 @@ private:
     kitty::static_truth_table<4u> tt;
     do
     {
-      _repr[*tt.cbegin()] = kitty::exact_npn_canonization( tt );
+      _repr[*tt.cbegin()] = cached_exact_npn_canonization( tt );
       kitty::next_inplace( tt );
     } while ( !kitty::is_const0( tt ) );
   }
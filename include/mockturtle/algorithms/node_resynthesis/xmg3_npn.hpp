@@ -50,6 +50,7 @@
 #include "../../io/write_bench.hpp"
 #include "../../networks/xmg.hpp"
 #include "../../utils/node_map.hpp"
+#include "../../utils/npn_canonization.hpp"
 #include "../../utils/stopwatch.hpp"
 #include "../../views/topo_view.hpp"
 
@@ -160,7 +161,7 @@ public:
       return;
     }
 
-    const auto config = kitty::exact_npn_canonization( tt );
+    const auto config = cached_exact_npn_canonization( tt );
 
     assert( repr == std::get<0>( config ) );
 
@@ -49,6 +49,7 @@
 #include "../../io/write_bench.hpp"
 #include "../../networks/xmg.hpp"
 #include "../../traits.hpp"
+#include "../../utils/npn_canonization.hpp"
 #include "../../views/topo_view.hpp"
 
 namespace mockturtle
@@ -89,7 +90,7 @@ public:
   {
     assert( function.num_vars() <= 4 );
     const auto fe = kitty::extend_to( function, 4 );
-    const auto config = kitty::exact_npn_canonization( fe );
+    const auto config = cached_exact_npn_canonization( fe );
 
     auto func_str = "0x" + kitty::to_hex( std::get<0>( config ) );
     const auto it = class2signal.find( func_str );
@@ -118,8 +119,15 @@ public:
 
     for ( auto const& po : it->second )
     {
-      topo_view topo{ db, po };
-      auto f = cleanup_dangling( topo, xmg, pis_perm.begin(), pis_perm.end() ).front();
+      /* the database is only read, such that the function can be called concurrently */
+      std::unordered_map<xmg_network::node, xmg_network::signal> db_to_ntk;
+      db_to_ntk.insert( { 0, xmg.get_constant( false ) } );
+      for ( auto i = 0u; i < 4u; ++i )
+      {
+        db_to_ntk.insert( { i + 1, pis_perm[i] } );
+      }
+      const auto g = copy_db_entry( xmg, db.get_node( po ), db_to_ntk );
+      const auto f = db.is_complemented( po ) ? !g : g;
 
       if ( !fn( ( ( phase >> 4 ) & 1 ) ? !f : f ) )
       {
@@ -129,6 +137,24 @@ public:
   }
 
 private:
+  xmg_network::signal copy_db_entry( xmg_network& ntk, xmg_network::node const& n, std::unordered_map<xmg_network::node, xmg_network::signal>& db_to_ntk ) const
+  {
+    if ( const auto it = db_to_ntk.find( n ); it != db_to_ntk.end() )
+    {
+      return it->second;
+    }
+
+    std::vector<xmg_network::signal> fanin;
+    db.foreach_fanin( n, [&]( auto const& f ) {
+      const auto ntk_f = copy_db_entry( ntk, db.get_node( f ), db_to_ntk );
+      fanin.push_back( db.is_complemented( f ) ? !ntk_f : ntk_f );
+    } );
+
+    const auto f = ntk.clone_node( db, n, fanin );
+    db_to_ntk.insert( { n, f } );
+    return f;
+  }
+
   std::unordered_map<std::string, std::string> opt_xmgs;
 
   inline std::vector<std::string> split( const std::string& str, const std::string& sep )
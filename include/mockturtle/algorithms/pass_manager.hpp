@@ -0,0 +1,423 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2023  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file pass_manager.hpp
+  \brief Sequences of optimization passes sharing analyses
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/partial_truth_table.hpp>
+
+#include "../traits.hpp"
+#include "../utils/network_utils.hpp"
+#include "../utils/node_map.hpp"
+#include "../utils/stopwatch.hpp"
+#include "../views/depth_view.hpp"
+#include "../views/fanout_view.hpp"
+#include "../views/topo_view.hpp"
+#include "cut_enumeration.hpp"
+#include "simulation.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Analyses maintained by `pass_manager`.
+ *
+ * The values can be combined with `|` to declare the analyses that a pass
+ * preserves.
+ */
+enum pass_analysis : uint32_t
+{
+  analysis_none = 0u,
+  /* levels and depth */
+  analysis_levels = 1u,
+  /* fanouts of all nodes */
+  analysis_fanouts = 2u,
+  /* topological order of all nodes */
+  analysis_topological_order = 4u,
+  /* simulation signatures under random patterns */
+  analysis_signatures = 8u,
+  /* cut database */
+  analysis_cuts = 16u,
+  analysis_all = 31u
+};
+
+/*! \brief Parameters for pass_manager. */
+struct pass_manager_params
+{
+  /*! \brief Number of random simulation patterns for signatures. */
+  uint32_t num_signature_bits{ 256u };
+
+  /*! \brief Random seed for the simulation patterns. */
+  uint32_t signature_seed{ 1u };
+
+  /*! \brief Parameters for the cut database. */
+  cut_enumeration_params cut_enumeration_ps{};
+
+  /*! \brief Print a line after each pass. */
+  bool verbose{ false };
+};
+
+/*! \brief Statistics of a single pass. */
+struct pass_record
+{
+  /*! \brief Name of the pass. */
+  std::string name;
+
+  /*! \brief Runtime of the pass (including analyses). */
+  stopwatch<>::duration time{ 0 };
+
+  /*! \brief Time for building or updating analyses in this pass. */
+  stopwatch<>::duration time_analyses{ 0 };
+
+  /*! \brief Number of gates before the pass. */
+  uint32_t gates_before{ 0u };
+
+  /*! \brief Number of gates after the pass. */
+  uint32_t gates_after{ 0u };
+
+  /*! \brief Estimated memory of the network and the analyses after the pass (in bytes). */
+  uint64_t memory{ 0u };
+};
+
+/*! \brief Statistics for pass_manager. */
+struct pass_manager_stats
+{
+  /*! \brief Total runtime of all passes. */
+  stopwatch<>::duration time_total{ 0 };
+
+  /*! \brief Total time for building or updating analyses. */
+  stopwatch<>::duration time_analyses{ 0 };
+
+  /*! \brief Statistics of each pass in the order they were run. */
+  std::vector<pass_record> passes;
+
+  void report() const
+  {
+    for ( auto const& p : passes )
+    {
+      fmt::print( "[i] {:<12} gates = {:>8} -> {:>8}   time = {:>7.2f} s   analyses = {:>7.2f} s   memory = {:>8.2f} MB\n",
+                  p.name, p.gates_before, p.gates_after, to_seconds( p.time ), to_seconds( p.time_analyses ), p.memory / 1048576.0 );
+    }
+    fmt::print( "[i] total time     = {:>7.2f} secs\n", to_seconds( time_total ) );
+    fmt::print( "[i] analyses time  = {:>7.2f} secs\n", to_seconds( time_analyses ) );
+  }
+};
+
+/*! \brief Runs passes on a network while keeping analyses alive.
+ *
+ * The pass manager owns a copy of a network and maintains analyses of it,
+ * which are built the first time they are requested.  Levels and fanouts are
+ * provided through a `fanout_view<depth_view<Ntk>>`, which can be passed to algorithms
+ * such as `aig_balance`, `aig_resubstitution`, `rewrite`, and `refactoring`.
+ * These algorithms then do not construct their own views, since views are
+ * not stacked on networks that already implement their interface.
+ * Further analyses are the topological order, simulation signatures under
+ * random patterns, and a cut database.
+ *
+ * A pass is a function that is called with the pass manager.  It modifies
+ * the network in-place through `view()` or `network()`, or replaces it
+ * through `replace()`, e.g., with the result of `cleanup_dangling`.  Passes
+ * that assign a new network to the view (such as `aig_balance` and
+ * `rewrite`) are detected and handled as if they called `replace()`.  When
+ * running a pass, it declares which analyses remain valid afterwards.  All
+ * other analyses are updated when they are requested the next time:
+ * levels and fanouts are recomputed in place, the other analyses are
+ * rebuilt.  Replacing the network invalidates all analyses.
+ *
+ * While the network is unchanged, the fanouts are maintained with network
+ * events and the levels of new nodes are computed when they are added.
+ * Signatures of new nodes are computed on demand, and the signatures of
+ * existing nodes stay valid as long as the passes preserve the functions of
+ * the nodes (as all exact rewriting and resubstitution algorithms do).
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      aig_network aig = ...;
+      pass_manager_stats st;
+      pass_manager pm( aig, {}, &st );
+
+      resubstitution_params rps;
+      pm.run( "b", []( auto& pm ) { aig_balance( pm.view() ); } );
+      pm.run( "rs", [&]( auto& pm ) {
+        aig_resubstitution( pm.view(), rps );
+        pm.replace( cleanup_dangling( pm.network() ) );
+      } );
+      pm.run( "rf", [&]( auto& pm ) {
+        sop_factoring<aig_network> resyn;
+        refactoring( pm.view(), resyn );
+        pm.replace( cleanup_dangling( pm.network() ) );
+      } );
+
+      aig = pm.network();
+      st.report();
+   \endverbatim
+ */
+template<class Ntk>
+class pass_manager
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+  using view_t = fanout_view<depth_view<Ntk>>;
+  using cuts_t = network_cuts<Ntk, true, empty_cut_data>;
+
+public:
+  explicit pass_manager( Ntk const& ntk, pass_manager_params const& ps = {}, pass_manager_stats* pst = nullptr )
+      : _ntk( ntk.clone() ),
+        _ps( ps ),
+        _pst( pst )
+  {
+  }
+
+  pass_manager( pass_manager const& ) = delete;
+  pass_manager& operator=( pass_manager const& ) = delete;
+
+  /*! \brief Runs a pass.
+   *
+   * \param name Name of the pass in the statistics
+   * \param fn Pass, called as `fn( *this )`
+   * \param preserved Analyses that are still valid after the pass (by default, the fanouts)
+   */
+  template<class Fn>
+  void run( std::string const& name, Fn&& fn, uint32_t preserved = analysis_fanouts )
+  {
+    pass_record record;
+    record.name = name;
+    record.gates_before = _ntk.num_gates();
+
+    _time_analyses = {};
+    call_with_stopwatch( record.time, [&]() {
+      fn( *this );
+    } );
+    _valid &= preserved;
+
+    /* passes such as `aig_balance` and `rewrite` assign a new network to the view */
+    if ( _view && _view->_storage != _ntk._storage )
+    {
+      replace( Ntk( _view->_storage ) );
+    }
+
+    record.time_analyses = _time_analyses;
+    record.gates_after = _ntk.num_gates();
+    record.memory = memory();
+
+    if ( _ps.verbose )
+    {
+      fmt::print( "[i] {:<12} gates = {:>8} -> {:>8}   time = {:>7.2f} s\n", name, record.gates_before, record.gates_after, to_seconds( record.time ) );
+    }
+
+    if ( _pst )
+    {
+      _pst->time_total += record.time;
+      _pst->time_analyses += record.time_analyses;
+      _pst->passes.emplace_back( record );
+    }
+  }
+
+  /*! \brief Returns the network. */
+  Ntk& network()
+  {
+    return _ntk;
+  }
+
+  /*! \brief Returns the network. */
+  Ntk const& network() const
+  {
+    return _ntk;
+  }
+
+  /*! \brief Replaces the network, which invalidates all analyses. */
+  void replace( Ntk const& ntk )
+  {
+    _view.reset();
+    _cuts.reset();
+    _signatures.reset();
+    _simulator.reset();
+    _topo_order.clear();
+    _valid = analysis_none;
+    _ntk = ntk;
+  }
+
+  /*! \brief Returns a view of the network with valid levels and fanouts. */
+  view_t& view()
+  {
+    if ( !_view )
+    {
+      call_with_stopwatch( _time_analyses, [&]() {
+        _view.emplace( depth_view<Ntk>{ _ntk } );
+      } );
+      _valid |= analysis_levels | analysis_fanouts;
+    }
+    if ( !( _valid & analysis_levels ) )
+    {
+      call_with_stopwatch( _time_analyses, [&]() {
+        _view->update_levels();
+      } );
+      _valid |= analysis_levels;
+    }
+    if ( !( _valid & analysis_fanouts ) )
+    {
+      call_with_stopwatch( _time_analyses, [&]() {
+        _view->update_fanout();
+      } );
+      _valid |= analysis_fanouts;
+    }
+    return *_view;
+  }
+
+  /*! \brief Returns the nodes of the network in topological order. */
+  std::vector<node> const& topological_order()
+  {
+    if ( !( _valid & analysis_topological_order ) )
+    {
+      call_with_stopwatch( _time_analyses, [&]() {
+        _topo_order.clear();
+        topo_view<Ntk>{ _ntk }.foreach_node( [&]( auto const& n ) {
+          _topo_order.emplace_back( n );
+        } );
+      } );
+      _valid |= analysis_topological_order;
+    }
+    return _topo_order;
+  }
+
+  /*! \brief Returns the simulation signature of a node. */
+  kitty::partial_truth_table const& signature( node const& n )
+  {
+    if ( !_signatures || !( _valid & analysis_signatures ) )
+    {
+      call_with_stopwatch( _time_analyses, [&]() {
+        if ( !_simulator || _simulator->get_patterns().size() != _ntk.num_pis() )
+        {
+          _simulator.emplace( _ntk.num_pis(), _ps.num_signature_bits, _ps.signature_seed );
+        }
+        _signatures.emplace( _ntk );
+      } );
+      _valid |= analysis_signatures;
+    }
+
+    call_with_stopwatch( _time_analyses, [&]() {
+      _signatures->resize();
+      simulate_node<Ntk>( _ntk, n, *_signatures, *_simulator );
+    } );
+    return ( *_signatures )[n];
+  }
+
+  /*! \brief Returns the cut database. */
+  cuts_t const& cuts()
+  {
+    if ( !_cuts || !( _valid & analysis_cuts ) )
+    {
+      call_with_stopwatch( _time_analyses, [&]() {
+        _cuts.emplace( cut_enumeration<Ntk, true, empty_cut_data>( _ntk, _ps.cut_enumeration_ps ) );
+      } );
+      _valid |= analysis_cuts;
+    }
+    return *_cuts;
+  }
+
+  /*! \brief Returns the analyses that are currently valid. */
+  uint32_t valid_analyses() const
+  {
+    uint32_t valid = _valid;
+    if ( !_view )
+    {
+      valid &= ~uint32_t( analysis_levels | analysis_fanouts );
+    }
+    if ( !_signatures )
+    {
+      valid &= ~uint32_t( analysis_signatures );
+    }
+    if ( !_cuts )
+    {
+      valid &= ~uint32_t( analysis_cuts );
+    }
+    return valid;
+  }
+
+private:
+  /* estimated memory of the network and the analyses in bytes */
+  uint64_t memory() const
+  {
+    uint64_t bytes{ 0u };
+    if constexpr ( detail::has_node_storage<Ntk>::value )
+    {
+      bytes += _ntk._storage->nodes.capacity() * sizeof( typename decltype( _ntk._storage->nodes )::value_type );
+    }
+    if ( _view )
+    {
+      /* levels and critical path flags */
+      bytes += _ntk.size() * 2u * sizeof( uint32_t );
+      _view->foreach_node( [&]( auto const& n ) {
+        bytes += sizeof( std::vector<node> ) + _view->fanout_size( n ) * sizeof( node );
+      } );
+    }
+    bytes += _topo_order.capacity() * sizeof( node );
+    if ( _signatures )
+    {
+      _ntk.foreach_node( [&]( auto const& n ) {
+        if ( _signatures->has( n ) )
+        {
+          bytes += ( *_signatures )[n].num_blocks() * sizeof( uint64_t );
+        }
+      } );
+    }
+    if ( _cuts )
+    {
+      bytes += _cuts->total_cuts() * sizeof( typename cuts_t::cut_t );
+    }
+    return bytes;
+  }
+
+private:
+  Ntk _ntk;
+  pass_manager_params const _ps;
+  pass_manager_stats* _pst;
+
+  uint32_t _valid{ analysis_none };
+  stopwatch<>::duration _time_analyses{ 0 };
+
+  std::optional<view_t> _view;
+  std::vector<node> _topo_order;
+  std::optional<partial_simulator> _simulator;
+  std::optional<incomplete_node_map<kitty::partial_truth_table, Ntk>> _signatures;
+  std::optional<cuts_t> _cuts;
+};
+
+} /* namespace mockturtle */
@@ -34,14 +34,18 @@
 #pragma once
 
 #include "../networks/aig.hpp"
+#include "../utils/parallel_utils.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "circuit_validator.hpp"
+#include "detail/pattern_filter.hpp"
 #include "dont_cares.hpp"
 #include "simulation.hpp"
 #include <bill/sat/interface/abc_bsat2.hpp>
 #include <bill/sat/interface/z3.hpp>
 #include <kitty/partial_truth_table.hpp>
+#include <iterator>
+#include <memory>
 #include <random>
 
 namespace mockturtle
@@ -74,6 +78,18 @@ struct pattern_generation_params
 
   /*! \brief Maximum number of clauses of the SAT solver. (incremental CNF construction) */
   uint32_t max_clauses{ 1000 };
+
+  /*! \brief Number of threads for stuck-at pattern generation (0 = hardware concurrency).
+   *
+   * With more than one thread, batches of target nodes are distributed over
+   * threads with their own SAT solvers, and the found patterns are merged into
+   * the simulator after each batch.  Observability checking, and stuck-at
+   * checking with `odc_levels != 0`, are always single-threaded.
+   */
+  uint32_t num_threads{ 1 };
+
+  /*! \brief Number of target nodes per thread in each batch (multi-threaded mode). */
+  uint32_t batch_size{ 64 };
 };
 
 struct pattern_generation_stats
@@ -116,6 +132,7 @@ public:
   using node = typename Ntk::node;
   using signal = typename Ntk::signal;
   using TT = incomplete_node_map<kitty::partial_truth_table, Ntk>;
+  using validator_t = circuit_validator<Ntk, bill::solvers::bsat2, true, true, use_odc>;
 
   explicit patgen_impl( Ntk& ntk, Simulator& sim, pattern_generation_params const& ps, validator_params& vps, pattern_generation_stats& st )
       : ntk( ntk ), ps( ps ), st( st ), vps( vps ), validator( ntk, vps ),
@@ -138,7 +155,14 @@ public:
 
     if ( ps.num_stuck_at > 0 )
     {
-      stuck_at_check();
+      if ( !use_odc && resolve_num_threads( ps.num_threads ) > 1u )
+      {
+        stuck_at_check_parallel();
+      }
+      else
+      {
+        stuck_at_check();
+      }
       if constexpr ( std::is_same_v<Simulator, bit_packed_simulator> )
       {
         sim.pack_bits();
@@ -293,6 +317,168 @@ private:
     } );
   }
 
+  struct stuck_at_target
+  {
+    node n;
+
+    /* value of `n` in the patterns to generate */
+    bool value;
+
+    /* whether `n` is constant under the current patterns */
+    bool constant;
+
+    /* current patterns in which `n` has `value` */
+    std::vector<std::vector<bool>> patterns;
+  };
+
+  struct stuck_at_result
+  {
+    /* a pattern found by the same thread in this batch already sets `n` to `value` */
+    bool covered{ false };
+
+    /* `n` is proven constant */
+    bool constant{ false };
+
+    std::vector<std::vector<bool>> patterns;
+  };
+
+  void stuck_at_check_parallel()
+  {
+    uint32_t const num_threads = resolve_num_threads( ps.num_threads );
+    std::vector<std::unique_ptr<validator_t>> validators;
+    for ( auto i = 0u; i < num_threads; ++i )
+    {
+      validators.emplace_back( std::make_unique<validator_t>( ntk, vps ) );
+    }
+
+    progress_bar pbar{ ntk.size(), "patgen-sa |{0}| node = {1:>4} #pat = {2:>4}", ps.progress };
+
+    std::vector<bool> done( ntk.size(), false );
+    uint32_t num_done{ 0u };
+    while ( true )
+    {
+      /* collect the next batch of target nodes */
+      std::vector<stuck_at_target> targets;
+      kitty::partial_truth_table const zero = sim.compute_constant( false );
+      ntk.foreach_gate( [&]( auto const& n ) {
+        if ( targets.size() == static_cast<uint64_t>( num_threads ) * ps.batch_size )
+        {
+          return false;
+        }
+        if ( done[ntk.node_to_index( n )] )
+        {
+          return true;
+        }
+
+        if ( tts[n].num_bits() != sim.num_bits() )
+        {
+          call_with_stopwatch( st.time_sim, [&]() {
+            simulate_node<Ntk>( ntk, n, tts, sim );
+          } );
+        }
+
+        auto const& tt = tts[n];
+        if ( tt == zero || tt == ~zero )
+        {
+          targets.push_back( { n, tt == zero, true, {} } );
+        }
+        else if ( ps.num_stuck_at > 1 && ( kitty::count_ones( tt ) < ps.num_stuck_at || kitty::count_zeros( tt ) < ps.num_stuck_at ) )
+        {
+          bool const value = kitty::count_ones( tt ) < ps.num_stuck_at;
+          targets.push_back( { n, value, false, {} } );
+          for ( auto i = 0u; i < tt.num_bits(); ++i )
+          {
+            if ( kitty::get_bit( tt, i ) == value )
+            {
+              targets.back().patterns.emplace_back();
+              ntk.foreach_pi( [&]( auto const& pi ) {
+                targets.back().patterns.back().emplace_back( kitty::get_bit( tts[pi], i ) );
+              } );
+            }
+          }
+        }
+        else
+        {
+          done[ntk.node_to_index( n )] = true;
+          ++num_done;
+        }
+        return true;
+      } );
+
+      if ( targets.empty() )
+      {
+        break;
+      }
+
+      /* every thread handles a fixed range of targets */
+      std::vector<stuck_at_result> results( targets.size() );
+      call_with_stopwatch( st.time_sat, [&]() {
+        parallel_for( num_threads, num_threads, [&]( uint64_t t, uint32_t ) {
+          auto& validator = *validators[t];
+          pattern_filter<Ntk> filter( ntk );
+          for ( auto i = targets.size() * t / num_threads; i < targets.size() * ( t + 1 ) / num_threads; ++i )
+          {
+            auto const& target = targets[i];
+            auto& result = results[i];
+            if ( !target.constant )
+            {
+              result.patterns = validator.generate_pattern( target.n, target.value, target.patterns, ps.num_stuck_at - target.patterns.size() );
+              continue;
+            }
+
+            if ( filter.has_value( target.n, target.value ) )
+            {
+              result.covered = true;
+              continue;
+            }
+
+            auto const res = validator.validate( target.n, !target.value );
+            if ( !res )
+            {
+              continue; /* timeout */
+            }
+            if ( *res )
+            {
+              result.constant = true;
+              continue;
+            }
+
+            filter.add_pattern( validator.cex );
+            result.patterns.emplace_back( validator.cex );
+            if ( ps.num_stuck_at > 1 )
+            {
+              auto generated = validator.generate_pattern( target.n, target.value, { validator.cex }, ps.num_stuck_at - 1 );
+              std::move( generated.begin(), generated.end(), std::back_inserter( result.patterns ) );
+            }
+          }
+        } );
+      } );
+
+      /* merge the results in topological order */
+      for ( auto i = 0u; i < targets.size(); ++i )
+      {
+        auto const& n = targets[i].n;
+        for ( auto const& pattern : results[i].patterns )
+        {
+          new_pattern( pattern, n );
+        }
+        if ( results[i].constant )
+        {
+          ++st.num_constant;
+          const_nodes.emplace_back( targets[i].value ? ntk.make_signal( n ) : !ntk.make_signal( n ) );
+        }
+
+        /* covered targets are revisited in the next batch if they still need patterns */
+        if ( !results[i].covered )
+        {
+          done[ntk.node_to_index( n )] = true;
+          ++num_done;
+        }
+      }
+      pbar( num_done, num_done, sim.num_bits() );
+    }
+  }
+
   void observability_check()
   {
     progress_bar pbar{ ntk.size(), "patgen-obs |{0}| node = {1:>4} #pat = {2:>4}", ps.progress };
@@ -37,6 +37,8 @@
 #pragma once
 
 #include "../traits.hpp"
+#include "../utils/cancellation_token.hpp"
+#include "../utils/parallel_utils.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/depth_view.hpp"
@@ -46,6 +48,8 @@
 #include "dont_cares.hpp"
 #include "reconv_cut.hpp"
 
+#include <algorithm>
+#include <type_traits>
 #include <vector>
 
 namespace mockturtle
@@ -79,6 +83,23 @@ struct resubstitution_params
   /*! \brief Be verbose. */
   bool verbose{ false };
 
+  /*! \brief Number of threads preparing the windows of upcoming roots (0 = hardware concurrency).
+   *
+   * With more than one thread, cuts, MFFCs, divisors, and (for the
+   * window-based engine) window truth tables are computed concurrently for
+   * `num_speculative_roots` upcoming roots on the unmodified network.  The
+   * roots are then resubstituted one after another; a prepared window is
+   * discarded and recomputed if one of its nodes was changed by an earlier
+   * substitution.  The result does not depend on the number of threads.
+   */
+  uint32_t num_threads{ 1u };
+
+  /*! \brief Number of roots whose windows are prepared at once. */
+  uint32_t num_speculative_roots{ 1024u };
+
+  /*! \brief Token to stop before the next root, keeping the substitutions done so far. */
+  cancellation_token cancellation{};
+
   /****** window-based resub engine ******/
 
   /*! \brief Use don't cares for optimization. Only used by window-based resub engine. */
@@ -100,12 +121,21 @@ struct resubstitution_params
   /*! \brief Whether to save the appended patterns (with CEXs) into file. Only used by simulation-based resub engine. */
   std::optional<std::string> save_patterns{};
 
+  /*! \brief Whether to save the patterns in binary format (see `write_binary_patterns`).
+   * If the patterns are saved into the file they were read from, only the new patterns are appended.
+   * Only used by simulation-based resub engine.
+   */
+  bool binary_patterns{ false };
+
   /*! \brief Maximum number of clauses of the SAT solver. Only used by simulation-based resub engine. */
   uint32_t max_clauses{ 1000 };
 
   /*! \brief Conflict limit for the SAT solver. Only used by simulation-based resub engine. */
   uint32_t conflict_limit{ 1000 };
 
+  /*! \brief Retire dead CNF cones instead of restarting the SAT solver (see `validator_params::incremental_gc`). Only used by simulation-based resub engine. */
+  bool incremental_gc{ false };
+
   /*! \brief Random seed for the SAT solver (influences the randomness of counter-examples). Only used by simulation-based resub engine. */
   uint32_t random_seed{ 1 };
 
@@ -148,6 +178,12 @@ struct resubstitution_stats
   /*! \brief Initial network size (before resubstitution). */
   uint64_t initial_size{ 0 };
 
+  /*! \brief Number of windows prepared concurrently and used. */
+  uint64_t num_prepared{ 0 };
+
+  /*! \brief Number of prepared windows discarded because of earlier substitutions. */
+  uint64_t num_discarded{ 0 };
+
   void report() const
   {
     // clang-format off
@@ -155,6 +191,10 @@ struct resubstitution_stats
     fmt::print( "[i]     ========  Stats  ========\n" );
     fmt::print( "[i]     #divisors = {:8d}\n", num_total_divisors );
     fmt::print( "[i]     est. gain = {:8d} ({:>5.2f}%)\n", estimated_gain, ( 100.0 * estimated_gain ) / initial_size );
+    if ( num_prepared + num_discarded > 0u )
+    {
+      fmt::print( "[i]     prepared  = {:8d} ({:8d} discarded)\n", num_prepared, num_discarded );
+    }
     fmt::print( "[i]     ======== Runtime ========\n" );
     fmt::print( "[i]     total         : {:>5.2f} secs\n", to_seconds( time_total ) );
     fmt::print( "[i]       DivCollector: {:>5.2f} secs\n", to_seconds( time_divs ) );
@@ -210,6 +250,103 @@ struct default_collector_stats
   }
 };
 
+/*! \brief Network view with local traversal data.
+ *
+ * Forwards the structural interface of a network, but keeps traversal ids,
+ * visited flags, values and fanout sizes in local vectors.  Several instances
+ * can therefore analyze the same network concurrently, as long as the network
+ * itself is not modified.  `resize` must be called after nodes were added.
+ */
+template<class Ntk>
+class local_state_view
+{
+public:
+  using storage = typename Ntk::storage;
+  using base_type = typename Ntk::base_type;
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  static constexpr uint32_t min_fanin_size = Ntk::min_fanin_size;
+  static constexpr uint32_t max_fanin_size = Ntk::max_fanin_size;
+
+public:
+  explicit local_state_view( Ntk const& ntk )
+      : ntk( ntk )
+  {
+    resize();
+  }
+
+  void resize()
+  {
+    _visited.resize( ntk.size(), 0u );
+    _values.resize( ntk.size(), 0u );
+    _fanout_deltas.resize( ntk.size(), 0 );
+  }
+
+  auto size() const { return ntk.size(); }
+  node get_node( signal const& f ) const { return ntk.get_node( f ); }
+  signal make_signal( node const& n ) const { return ntk.make_signal( n ); }
+  bool is_complemented( signal const& f ) const { return ntk.is_complemented( f ); }
+  signal get_constant( bool value ) const { return ntk.get_constant( value ); }
+  bool is_constant( node const& n ) const { return ntk.is_constant( n ); }
+  bool is_pi( node const& n ) const { return ntk.is_pi( n ); }
+  bool is_ci( node const& n ) const { return ntk.is_ci( n ); }
+  uint32_t node_to_index( node const& n ) const { return ntk.node_to_index( n ); }
+  node index_to_node( uint32_t index ) const { return ntk.index_to_node( index ); }
+  uint32_t fanin_size( node const& n ) const { return ntk.fanin_size( n ); }
+  uint32_t level( node const& n ) const { return ntk.level( n ); }
+
+  template<class N = Ntk>
+  auto is_and( node const& n ) const -> decltype( std::declval<N const&>().is_and( n ) ) { return ntk.is_and( n ); }
+
+  template<class N = Ntk>
+  auto is_xor( node const& n ) const -> decltype( std::declval<N const&>().is_xor( n ) ) { return ntk.is_xor( n ); }
+
+  template<typename Fn>
+  void foreach_fanin( node const& n, Fn&& fn ) const { ntk.foreach_fanin( n, fn ); }
+
+  template<typename Fn>
+  void foreach_fanout( node const& n, Fn&& fn ) const { ntk.foreach_fanout( n, fn ); }
+
+  uint32_t fanout_size( node const& n ) const { return ntk.fanout_size( n ) + _fanout_deltas[n]; }
+  uint32_t incr_fanout_size( node const& n ) const { return ntk.fanout_size( n ) + _fanout_deltas[n]++; }
+  uint32_t decr_fanout_size( node const& n ) const { return ntk.fanout_size( n ) + --_fanout_deltas[n]; }
+
+  uint32_t visited( node const& n ) const { return _visited[n]; }
+  void set_visited( node const& n, uint32_t v ) const { _visited[n] = v; }
+  uint32_t trav_id() const { return _trav_id; }
+  void incr_trav_id() const { ++_trav_id; }
+
+  uint32_t value( node const& n ) const { return _values[n]; }
+  void set_value( node const& n, uint32_t v ) const { _values[n] = v; }
+  uint32_t incr_value( node const& n ) const { return _values[n]++; }
+  uint32_t decr_value( node const& n ) const { return --_values[n]; }
+
+private:
+  Ntk const& ntk;
+
+  mutable std::vector<uint32_t> _visited;
+  mutable std::vector<uint32_t> _values;
+  mutable std::vector<int32_t> _fanout_deltas;
+  mutable uint32_t _trav_id{ 0u };
+};
+
+/*! \brief Replaces the network type of a helper class template. */
+template<class T, class OtherNtk>
+struct rebind_network;
+
+template<template<class> class T, class Ntk, class OtherNtk>
+struct rebind_network<T<Ntk>, OtherNtk>
+{
+  using type = T<OtherNtk>;
+};
+
+template<template<class, bool, bool> class T, class Ntk, bool B1, bool B2, class OtherNtk>
+struct rebind_network<T<Ntk, B1, B2>, OtherNtk>
+{
+  using type = T<OtherNtk, B1, B2>;
+};
+
 /*! \brief Prepare the three public data members `leaves`, `divs` and `mffc`
  * to be ready for usage.
  *
@@ -238,6 +375,10 @@ public:
   using cut_comp_parameters_type = typename cut_comp::parameters_type;
   using cut_comp_statistics_type = typename cut_comp::statistics_type;
 
+  /*! \brief The same collector on another network type (used to prepare windows concurrently). */
+  template<class OtherNtk>
+  using rebind_t = default_divisor_collector<OtherNtk, typename rebind_network<MffcMgr, OtherNtk>::type, MffcRes, typename rebind_network<cut_comp, OtherNtk>::type>;
+
 public:
   explicit default_divisor_collector( Ntk const& ntk, resubstitution_params const& ps, stats& st )
       : ntk( ntk ), ps( ps ), st( st ), cuts( ntk, cut_comp_parameters_type{ ps.max_pis }, cuts_st )
@@ -498,6 +639,7 @@ public:
 
   using node = typename Ntk::node;
   using signal = typename Ntk::signal;
+  using prepared_tts_t = std::vector<TTsim>;
 
   explicit window_based_resub_engine( Ntk& ntk, resubstitution_params const& ps, stats& st )
       : ntk( ntk ), ps( ps ), st( st ), sim( ntk, ps.max_divisors, ps.max_pis )
@@ -514,6 +656,58 @@ public:
       simulate( leaves, divs, mffc );
     } );
 
+    return resubstitute( n, leaves, divs, potential_gain, last_gain );
+  }
+
+  /*! \brief Runs the engine on a window whose truth tables were computed by `prepare`. */
+  std::optional<signal> run( node const& n, std::vector<node> const& leaves, std::vector<node> const& divs, std::vector<node> const& mffc, prepared_tts_t const& tts, mffc_result_t potential_gain, uint32_t& last_gain )
+  {
+    call_with_stopwatch( st.time_sim, [&]() {
+      load( leaves, divs, mffc, tts );
+    } );
+
+    return resubstitute( n, leaves, divs, potential_gain, last_gain );
+  }
+
+  /*! \brief Computes the truth tables of a window without modifying the engine.
+   *
+   * Windows of several roots can be prepared concurrently.  `positions` is a
+   * scratch vector of the calling thread with at least `ntk.size()` entries.
+   * Entry 0 of `tts` is the constant, entry `i + 1` belongs to the `i`-th node
+   * of `divs` followed by `mffc`.
+   */
+  void prepare( std::vector<node> const& leaves, std::vector<node> const& divs, std::vector<node> const& mffc, prepared_tts_t& tts, std::vector<uint32_t>& positions ) const
+  {
+    tts.resize( divs.size() + mffc.size() + 1u );
+    tts[0] = kitty::create<TTsim>( ps.max_pis );
+    positions[0] = 0u;
+
+    std::vector<TTsim> fanin_tts;
+    for ( auto i = 0u; i < divs.size() + mffc.size(); ++i )
+    {
+      const auto d = i < divs.size() ? divs.at( i ) : mffc.at( i - divs.size() );
+      if ( d == 0 )
+        continue;
+
+      positions[d] = i + 1u;
+      if ( i < leaves.size() )
+      {
+        tts[i + 1u] = tts[0];
+        kitty::create_nth_var( tts[i + 1u], i );
+        continue;
+      }
+
+      fanin_tts.clear();
+      ntk.foreach_fanin( d, [&]( const auto& s ) {
+        fanin_tts.emplace_back( tts[positions[ntk.get_node( s )]] );
+      } );
+      tts[i + 1u] = ntk.compute( d, fanin_tts.begin(), fanin_tts.end() );
+    }
+  }
+
+private:
+  std::optional<signal> resubstitute( node const& n, std::vector<node> const& leaves, std::vector<node> const& divs, mffc_result_t potential_gain, uint32_t& last_gain )
+  {
     auto care = kitty::create<TTdc>( ps.max_pis );
     call_with_stopwatch( st.time_dont_care, [&]() {
       if ( ps.use_dont_cares )
@@ -577,6 +771,29 @@ private:
     sim.normalize( mffc );
   }
 
+  void load( std::vector<node> const& leaves, std::vector<node> const& divs, std::vector<node> const& mffc, prepared_tts_t const& tts )
+  {
+    sim.resize();
+    for ( auto i = 0u; i < divs.size() + mffc.size(); ++i )
+    {
+      const auto d = i < divs.size() ? divs.at( i ) : mffc.at( i - divs.size() );
+      if ( d == 0 )
+        continue;
+
+      if ( i < leaves.size() )
+      {
+        sim.assign( d, i + 1 );
+        continue;
+      }
+
+      sim.assign( d, i - uint32_t( leaves.size() ) + ps.max_pis + 1 );
+      sim.set_tt( i - uint32_t( leaves.size() ) + ps.max_pis + 1, tts[i + 1u] );
+    }
+
+    sim.normalize( divs );
+    sim.normalize( mffc );
+  }
+
 private:
   Ntk& ntk;
   resubstitution_params const& ps;
@@ -585,6 +802,30 @@ private:
   window_simulator<Ntk, TTsim> sim;
 }; /* window_based_resub_engine */
 
+template<class Collector, class OtherNtk, class = void>
+struct has_rebind_network : std::false_type
+{
+};
+
+template<class Collector, class OtherNtk>
+struct has_rebind_network<Collector, OtherNtk, std::void_t<typename Collector::template rebind_t<OtherNtk>>> : std::true_type
+{
+};
+
+template<class Engine, class = void>
+struct prepared_tts_type
+{
+  using type = std::nullptr_t;
+  static constexpr bool value = false;
+};
+
+template<class Engine>
+struct prepared_tts_type<Engine, std::void_t<typename Engine::prepared_tts_t>>
+{
+  using type = typename Engine::prepared_tts_t;
+  static constexpr bool value = true;
+};
+
 /*! \brief The top-level resubstitution framework.
  *
  * \param ResubEngine The engine that computes the resubtitution for a given root
@@ -612,6 +853,17 @@ public:
   using resub_callback_t = std::function<bool( Ntk&, node const&, signal const& )>;
   using mffc_result_t = typename ResubEngine::mffc_result_t;
 
+  /* a window prepared for a root on the unmodified network */
+  struct prepared_window
+  {
+    bool success{ false };
+    mffc_result_t potential_gain{};
+    std::vector<node> leaves;
+    std::vector<node> divs;
+    std::vector<node> mffc;
+    typename prepared_tts_type<ResubEngine>::type tts{};
+  };
+
   /*! \brief Constructor of the top-level resubstitution framework.
    *
    * \param ntk The network to be optimized.
@@ -649,11 +901,20 @@ public:
       resub_engine.init();
     } );
 
+    if constexpr ( has_rebind_network<DivCollector, local_state_view<Ntk>>::value )
+    {
+      if ( ps.num_threads != 1u && !ps.preserve_depth )
+      {
+        run_speculative( collector, resub_engine, callback );
+        return;
+      }
+    }
+
     progress_bar pbar{ ntk.size(), "resub |{0}| node = {1:>4}   cand = {2:>4}   est. gain = {3:>5}", ps.progress };
 
     auto const size = ntk.num_gates();
     ntk.foreach_gate( [&]( auto const& n, auto i ) {
-      if ( i >= size )
+      if ( i >= size || ps.cancellation.is_cancelled() )
       {
         return false; /* terminate */
       }
@@ -708,21 +969,220 @@ public:
   }
 
 private:
+  void run_speculative( DivCollector& collector, ResubEngine& resub_engine, resub_callback_t const& callback )
+  {
+    using local_ntk_t = local_state_view<Ntk>;
+    using local_collector_t = typename DivCollector::template rebind_t<local_ntk_t>;
+
+    /* thread-local collectors on views with local traversal data */
+    auto const num_threads = resolve_num_threads( ps.num_threads );
+    std::vector<local_ntk_t> local_ntks;
+    std::vector<collector_st_t> local_collector_sts( num_threads );
+    std::vector<local_collector_t> local_collectors;
+    std::vector<std::vector<uint32_t>> positions( num_threads );
+    local_ntks.reserve( num_threads );
+    local_collectors.reserve( num_threads );
+    for ( auto t = 0u; t < num_threads; ++t )
+    {
+      local_ntks.emplace_back( ntk );
+      local_collectors.emplace_back( local_ntks[t], ps, local_collector_sts[t] );
+    }
+
+    std::vector<node> roots;
+    auto const size = ntk.num_gates();
+    ntk.foreach_gate( [&]( auto const& n, auto i ) {
+      if ( i >= size )
+        return false;
+      roots.emplace_back( n );
+      return true;
+    } );
+
+    progress_bar pbar{ ntk.size(), "resub |{0}| node = {1:>4}   cand = {2:>4}   est. gain = {3:>5}", ps.progress };
+
+    auto const batch_size = std::max( ps.num_speculative_roots, 1u );
+    std::vector<prepared_window> windows( std::min<std::size_t>( batch_size, roots.size() ) );
+    for ( auto begin = 0u; begin < roots.size() && !ps.cancellation.is_cancelled(); begin += batch_size )
+    {
+      auto const end = std::min<uint32_t>( begin + batch_size, roots.size() );
+
+      /* prepare the windows of the next roots concurrently */
+      ++_batch;
+      _modified.resize( ntk.size(), 0u );
+      _referenced.resize( ntk.size(), 0u );
+      for ( auto t = 0u; t < num_threads; ++t )
+      {
+        local_ntks[t].resize();
+        positions[t].resize( ntk.size(), 0u );
+      }
+
+      call_with_stopwatch( st.time_divs, [&]() {
+        parallel_for( num_threads, end - begin, [&]( uint64_t j, uint32_t thread_id ) {
+          auto const n = roots[begin + j];
+          auto& window = windows[j];
+          auto& local_collector = local_collectors[thread_id];
+
+          local_collector.leaves.clear();
+          local_collector.divs.clear();
+          local_collector.mffc.clear();
+          window.success = !is_dead( n ) && local_collector.run( n, window.potential_gain );
+          window.leaves = local_collector.leaves;
+          window.divs = local_collector.divs;
+          window.mffc = local_collector.mffc;
+
+          if constexpr ( prepared_tts_type<ResubEngine>::value )
+          {
+            if ( window.success )
+            {
+              resub_engine.prepare( window.leaves, window.divs, window.mffc, window.tts, positions[thread_id] );
+            }
+          }
+        } );
+      } );
+
+      /* resubstitute the roots in order */
+      for ( auto j = 0u; j < end - begin; ++j )
+      {
+        if ( ps.cancellation.is_cancelled() )
+          break;
+
+        auto const n = roots[begin + j];
+        if ( is_dead( n ) )
+          continue;
+
+        pbar( begin + j, begin + j, candidates, st.estimated_gain );
+
+        auto& window = windows[j];
+        bool const prepared = is_untouched( n, window );
+        if ( prepared )
+        {
+          ++st.num_prepared;
+        }
+        else
+        {
+          ++st.num_discarded;
+
+          /* recompute the window on the current network */
+          window.success = call_with_stopwatch( st.time_divs, [&]() {
+            return collector.run( n, window.potential_gain );
+          } );
+          window.leaves = collector.leaves;
+          window.divs = collector.divs;
+          window.mffc = collector.mffc;
+        }
+
+        if ( !window.success )
+          continue;
+
+        last_gain = 0;
+        st.num_total_divisors += window.divs.size();
+
+        auto g = call_with_stopwatch( st.time_resub, [&]() {
+          if constexpr ( prepared_tts_type<ResubEngine>::value )
+          {
+            if ( prepared )
+            {
+              return resub_engine.run( n, window.leaves, window.divs, window.mffc, window.tts, window.potential_gain, last_gain );
+            }
+            return resub_engine.run( n, window.leaves, window.divs, window.mffc, window.potential_gain, last_gain );
+          }
+          else if constexpr ( ResubEngine::require_leaves_and_mffc )
+          {
+            return resub_engine.run( n, window.leaves, window.divs, window.mffc, window.potential_gain, last_gain );
+          }
+          else
+          {
+            return resub_engine.run( n, window.divs, window.potential_gain, last_gain );
+          }
+        } );
+        if ( !g )
+          continue;
+
+        candidates++;
+        st.estimated_gain += last_gain;
+
+        bool updated = call_with_stopwatch( st.time_callback, [&]() {
+          return callback( ntk, n, *g );
+        } );
+        if ( updated )
+        {
+          resub_engine.update();
+        }
+      }
+    }
+
+    _modified.clear();
+    _referenced.clear();
+  }
+
+  bool is_dead( node const& n ) const
+  {
+    if constexpr ( has_is_dead_v<Ntk> )
+    {
+      return ntk.is_dead( n );
+    }
+    else
+    {
+      return ntk.fanout_size( n ) == 0u;
+    }
+  }
+
+  /* a prepared window is valid if none of its nodes was modified or deleted in the
+   * current batch, and the reference counts of its MFFC did not change */
+  bool is_untouched( node const& n, prepared_window const& window ) const
+  {
+    auto const modified = [&]( node const& d ) {
+      return _modified[d] == _batch;
+    };
+    auto const referenced = [&]( node const& d ) {
+      return _modified[d] == _batch || _referenced[d] == _batch;
+    };
+    return !referenced( n ) &&
+           std::none_of( window.leaves.begin(), window.leaves.end(), modified ) &&
+           std::none_of( window.divs.begin(), window.divs.end(), modified ) &&
+           std::none_of( window.mffc.begin(), window.mffc.end(), referenced );
+  }
+
+  void mark( std::vector<uint32_t>& stamps, node const& n )
+  {
+    if ( stamps.empty() )
+      return;
+    if ( n >= stamps.size() )
+      stamps.resize( ntk.size(), 0u );
+    stamps[n] = _batch;
+  }
+
   void register_events()
   {
     auto const update_level_of_new_node = [&]( const auto& n ) {
       ntk.resize_levels();
       update_node_level( n );
+
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        mark( _referenced, ntk.get_node( f ) );
+      } );
     };
 
     auto const update_level_of_existing_node = [&]( node const& n, const auto& old_children ) {
-      (void)old_children;
       ntk.resize_levels();
       update_node_level( n );
+
+      mark( _modified, n );
+      for ( auto const& f : old_children )
+      {
+        mark( _referenced, ntk.get_node( f ) );
+      }
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        mark( _referenced, ntk.get_node( f ) );
+      } );
     };
 
     auto const update_level_of_deleted_node = [&]( const auto& n ) {
       ntk.set_level( n, -1 );
+
+      mark( _modified, n );
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        mark( _referenced, ntk.get_node( f ) );
+      } );
     };
 
     add_event = ntk.events().register_add_event( update_level_of_new_node );
@@ -772,6 +1232,11 @@ private:
   uint32_t candidates{ 0 };
   uint32_t last_gain{ 0 };
 
+  /* nodes changed in the current batch of prepared windows */
+  std::vector<uint32_t> _modified;
+  std::vector<uint32_t> _referenced;
+  uint32_t _batch{ 0 };
+
   /* events */
   std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
   std::shared_ptr<typename network_events<Ntk>::modified_event_type> modified_event;
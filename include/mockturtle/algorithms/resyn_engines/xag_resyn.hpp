@@ -41,6 +41,8 @@
 #include <kitty/kitty.hpp>
 
 #include <algorithm>
+#include <array>
+#include <new>
 #include <optional>
 #include <type_traits>
 #include <vector>
@@ -61,7 +63,7 @@ struct xag_resyn_static_params
   /*! \brief Whether to consider single XOR gates (i.e., using XAGs instead of AIGs). */
   static constexpr bool use_xor{ true };
 
-  /*! \brief Whether to copy truth tables. */
+  /*! \brief Whether `*begin` dereferences to arbitrary keys of the truth table storage (instead of nodes). */
   static constexpr bool copy_tts{ false };
 
   /*! \brief Whether to preserve depth. */
@@ -127,6 +129,176 @@ struct aig_resyn_static_params_for_sim_resub : public xag_resyn_static_params_fo
   static constexpr bool use_xor = false;
 };
 
+namespace detail
+{
+
+template<typename T, std::size_t Alignment>
+struct aligned_allocator
+{
+  using value_type = T;
+
+  template<typename U>
+  struct rebind
+  {
+    using other = aligned_allocator<U, Alignment>;
+  };
+
+  aligned_allocator() noexcept = default;
+
+  template<typename U>
+  aligned_allocator( aligned_allocator<U, Alignment> const& ) noexcept
+  {
+  }
+
+  T* allocate( std::size_t n )
+  {
+    return static_cast<T*>( ::operator new( n * sizeof( T ), std::align_val_t( Alignment ) ) );
+  }
+
+  void deallocate( T* p, std::size_t ) noexcept
+  {
+    ::operator delete( p, std::align_val_t( Alignment ) );
+  }
+
+  template<typename U>
+  bool operator==( aligned_allocator<U, Alignment> const& ) const noexcept
+  {
+    return true;
+  }
+
+  template<typename U>
+  bool operator!=( aligned_allocator<U, Alignment> const& ) const noexcept
+  {
+    return false;
+  }
+};
+
+/*! \brief Truth tables stored as rows of one contiguous word matrix.
+ *
+ * Rows with at least `block_size` words are padded with zero words to a
+ * multiple of `block_size` and start at 32-byte boundaries.  Row memory is
+ * kept when the matrix is reset, such that it is reused for the next call.
+ */
+class signature_matrix
+{
+public:
+  static constexpr uint32_t block_size = 4u;
+
+  void reset( uint32_t num_words )
+  {
+    _stride = num_words < block_size ? num_words : ( num_words + block_size - 1u ) / block_size * block_size;
+    _num_rows = 0u;
+  }
+
+  void reserve( uint32_t num_rows )
+  {
+    _data.reserve( static_cast<std::size_t>( num_rows ) * block_size );
+  }
+
+  /* appends a row of zero words and returns it (invalidates other rows) */
+  uint64_t* add_row()
+  {
+    auto const offset = static_cast<std::size_t>( _num_rows++ ) * _stride;
+    if ( _data.size() < offset + _stride )
+    {
+      _data.resize( offset + _stride );
+    }
+    std::fill_n( _data.data() + offset, _stride, UINT64_C( 0 ) );
+    return _data.data() + offset;
+  }
+
+  template<class TT>
+  void add_row( TT const& tt )
+  {
+    std::copy( tt.cbegin(), tt.cend(), add_row() );
+  }
+
+  uint64_t* row( uint32_t index )
+  {
+    return _data.data() + static_cast<std::size_t>( index ) * _stride;
+  }
+
+  uint64_t const* row( uint32_t index ) const
+  {
+    return _data.data() + static_cast<std::size_t>( index ) * _stride;
+  }
+
+  uint32_t num_rows() const
+  {
+    return _num_rows;
+  }
+
+  /* number of words per row, including the padding */
+  uint32_t stride() const
+  {
+    return _stride;
+  }
+
+private:
+  uint32_t _stride{ 0u };
+  uint32_t _num_rows{ 0u };
+  std::vector<uint64_t, aligned_allocator<uint64_t, 32u>> _data;
+};
+
+/* Calls `fn( w )` for all words `w` and stops early once `stop()` holds.
+   Most scans on random-looking signatures are decided by the first word, so
+   `stop` is checked after the first word and then after each block of words,
+   which is evaluated without branches. */
+template<class Fn, class StopFn>
+inline void foreach_word_block( uint32_t num_words, Fn&& fn, StopFn&& stop )
+{
+  if ( num_words == 0u )
+  {
+    return;
+  }
+  fn( 0u );
+  if ( stop() )
+  {
+    return;
+  }
+
+  auto w = 1u;
+  for ( ; w + signature_matrix::block_size <= num_words; w += signature_matrix::block_size )
+  {
+    for ( auto k = 0u; k < signature_matrix::block_size; ++k )
+    {
+      fn( w + k );
+    }
+    if ( stop() )
+    {
+      return;
+    }
+  }
+  for ( ; w < num_words; ++w )
+  {
+    fn( w );
+  }
+}
+
+/* whether `fn( w )` is zero for all words `w` */
+template<class Fn>
+inline bool all_words_zero( uint32_t num_words, Fn&& fn )
+{
+  uint64_t acc{ 0u };
+  foreach_word_block(
+      num_words, [&]( uint32_t w ) { acc |= fn( w ); }, [&]() { return acc != 0u; } );
+  return acc == 0u;
+}
+
+/* number of ones in `fn( w )` over all words `w` */
+template<class Fn>
+inline uint32_t count_ones_in_words( uint32_t num_words, Fn&& fn )
+{
+  uint32_t count{ 0u };
+  for ( auto w = 0u; w < num_words; ++w )
+  {
+    count += __builtin_popcountll( fn( w ) );
+  }
+  return count;
+}
+
+} // namespace detail
+
 struct xag_resyn_stats
 {
   /*! \brief Time for finding 0-resub and collecting unate literals. */
@@ -177,6 +349,13 @@ struct xag_resyn_stats
  * When no simple solutions can be found, the algorithm heuristically chooses an unate
  * divisor or an unate pair to divide the target function with and recursively calls
  * itself to decompose the remainder function.
+ *
+ * The truth tables of the divisors are copied into one contiguous word matrix
+ * at the beginning of each call.  Unateness checks, cover checks, and scoring
+ * are computed directly on its rows, classifying a divisor or a pair of
+ * divisors in all polarities in a single scan, without creating temporary
+ * truth tables.  Before sorting, unate pairs are pruned with the bounds that
+ * the 2- and 3-resubstitution searches use to stop.
    \verbatim embed:rst
 
    Example
@@ -237,13 +416,40 @@ private:
     uint32_t score{ 0 };
   };
 
+  /* words of the function of a divisor literal */
+  struct literal_words
+  {
+    uint64_t operator[]( uint32_t w ) const
+    {
+      return div[w] ^ mask;
+    }
+
+    uint64_t const* div;
+    uint64_t mask;
+  };
+
+  /* words of the function of a fanin pair, i.e., the AND or XOR of two literals */
+  struct pair_words
+  {
+    uint64_t operator[]( uint32_t w ) const
+    {
+      auto const a = div1[w] ^ mask1;
+      auto const b = div2[w] ^ mask2;
+      return ( a & b & ~xor_mask ) | ( ( a ^ b ) & xor_mask );
+    }
+
+    uint64_t const* div1;
+    uint64_t const* div2;
+    uint64_t mask1, mask2, xor_mask;
+  };
+
 public:
   explicit xag_resyn_decompose( stats& st ) noexcept
       : st( st )
   {
     static_assert( std::is_same_v<typename static_params::base_type, xag_resyn_static_params>, "Invalid static_params type" );
     static_assert( !( static_params::uniform_div_cost && static_params::preserve_depth ), "If depth is to be preserved, divisor depth cost must be provided (usually not uniform)" );
-    divisors.reserve( static_params::reserve );
+    divs.reserve( static_params::reserve );
   }
 
   /*! \brief Perform XAG resynthesis.
@@ -264,21 +470,15 @@ public:
   {
     static_assert( static_params::copy_tts || std::is_same_v<typename std::iterator_traits<iterator_type>::value_type, typename static_params::node_type>, "iterator_type does not dereference to static_params::node_type" );
 
-    ptts = &tts;
-    on_off_sets[0] = ~target & care;
-    on_off_sets[1] = target & care;
+    on_off_sets.reset( static_cast<uint32_t>( target.num_blocks() ) );
+    on_off_sets.add_row( ~target & care );
+    on_off_sets.add_row( target & care );
 
-    divisors.resize( 1 ); /* clear previous data and reserve 1 dummy node for constant */
+    divs.reset( static_cast<uint32_t>( target.num_blocks() ) );
+    divs.add_row(); /* reserve 1 dummy row for constant */
     while ( begin != end )
     {
-      if constexpr ( static_params::copy_tts )
-      {
-        divisors.emplace_back( ( *ptts )[*begin] );
-      }
-      else
-      {
-        divisors.emplace_back( *begin );
-      }
+      divs.add_row( tts[*begin] );
       ++begin;
     }
 
@@ -299,7 +499,7 @@ private:
   std::optional<index_list_t> compute_function( uint32_t num_inserts )
   {
     index_list.clear();
-    index_list.add_inputs( divisors.size() - 1 );
+    index_list.add_inputs( divs.num_rows() - 1 );
     auto const lit = compute_function_rec( num_inserts );
     if ( lit )
     {
@@ -375,8 +575,8 @@ private:
       collect_unate_pairs();
     } );
     call_with_stopwatch( st.time_sort, [&]() {
-      sort_unate_pairs( pos_unate_pairs, 1 );
-      sort_unate_pairs( neg_unate_pairs, 0 );
+      sort_unate_pairs( pos_unate_pairs, 1, pos_unate_lits, num_inserts >= 3u );
+      sort_unate_pairs( neg_unate_pairs, 0, neg_unate_lits, num_inserts >= 3u );
     } );
     auto const res2or = call_with_stopwatch( st.time_resub2, [&]() {
       return find_div_pair( pos_unate_lits, pos_unate_pairs, 1 );
@@ -461,7 +661,12 @@ private:
        */
       uint32_t const lit = on_off_div ? pos_unate_lits[0].lit : neg_unate_lits[0].lit;
       call_with_stopwatch( st.time_divide, [&]() {
-        on_off_sets[on_off_div] &= lit & 0x1 ? get_div( lit >> 1 ) : ~get_div( lit >> 1 );
+        auto const f = words_of( lit );
+        auto* set = on_off_sets.row( on_off_div );
+        for ( auto w = 0u; w < divs.stride(); ++w )
+        {
+          set[w] &= ~f[w];
+        }
       } );
 
       auto const res_remain_div = compute_function_rec( num_inserts - 1 );
@@ -475,20 +680,12 @@ private:
     {
       fanin_pair const pair = on_off_pair ? pos_unate_pairs[0] : neg_unate_pairs[0];
       call_with_stopwatch( st.time_divide, [&]() {
-        if constexpr ( static_params::use_xor )
+        /* AND pair: ~(lit1 & lit2) = ~lit1 | ~lit2; XOR pair: ~(lit1 ^ lit2) = ~lit1 ^ lit2 */
+        auto const f = words_of( pair );
+        auto* set = on_off_sets.row( on_off_pair );
+        for ( auto w = 0u; w < divs.stride(); ++w )
         {
-          if ( pair.lit1 > pair.lit2 ) /* XOR pair: ~(lit1 ^ lit2) = ~lit1 ^ lit2 */
-          {
-            on_off_sets[on_off_pair] &= ( pair.lit1 & 0x1 ? get_div( pair.lit1 >> 1 ) : ~get_div( pair.lit1 >> 1 ) ) ^ ( pair.lit2 & 0x1 ? ~get_div( pair.lit2 >> 1 ) : get_div( pair.lit2 >> 1 ) );
-          }
-          else /* AND pair: ~(lit1 & lit2) = ~lit1 | ~lit2 */
-          {
-            on_off_sets[on_off_pair] &= ( pair.lit1 & 0x1 ? get_div( pair.lit1 >> 1 ) : ~get_div( pair.lit1 >> 1 ) ) | ( pair.lit2 & 0x1 ? get_div( pair.lit2 >> 1 ) : ~get_div( pair.lit2 >> 1 ) );
-          }
-        }
-        else /* AND pair: ~(lit1 & lit2) = ~lit1 | ~lit2 */
-        {
-          on_off_sets[on_off_pair] &= ( pair.lit1 & 0x1 ? get_div( pair.lit1 >> 1 ) : ~get_div( pair.lit1 >> 1 ) ) | ( pair.lit2 & 0x1 ? get_div( pair.lit2 >> 1 ) : ~get_div( pair.lit2 >> 1 ) );
+          set[w] &= ~f[w];
         }
       } );
 
@@ -519,8 +716,12 @@ private:
    */
   std::optional<uint32_t> find_one_unate()
   {
-    num_bits[0] = kitty::count_ones( on_off_sets[0] ); /* off-set */
-    num_bits[1] = kitty::count_ones( on_off_sets[1] ); /* on-set */
+    auto const num_words = divs.stride();
+    auto const* off = on_off_sets.row( 0 );
+    auto const* on = on_off_sets.row( 1 );
+
+    num_bits[0] = detail::count_ones_in_words( num_words, [&]( uint32_t w ) { return off[w]; } ); /* off-set */
+    num_bits[1] = detail::count_ones_in_words( num_words, [&]( uint32_t w ) { return on[w]; } );  /* on-set */
     if ( num_bits[0] == 0 )
     {
       return 1;
@@ -530,28 +731,41 @@ private:
       return 0;
     }
 
-    for ( auto v = 1u; v < divisors.size(); ++v )
+    for ( auto v = 1u; v < divs.num_rows(); ++v )
     {
+      /* intersections of the divisor and of its complement with the off-set and the on-set,
+         the scan stops as soon as the divisor is known to be binate */
+      auto const* d = divs.row( v );
+      uint64_t pos_off{ 0u }, neg_off{ 0u }, pos_on{ 0u }, neg_on{ 0u };
+      detail::foreach_word_block(
+          num_words, [&]( uint32_t w ) {
+            pos_off |= d[w] & off[w];
+            neg_off |= ~d[w] & off[w];
+            pos_on |= d[w] & on[w];
+            neg_on |= ~d[w] & on[w];
+          },
+          [&]() { return pos_off && neg_off && pos_on && neg_on; } );
+
       bool unateness[4] = { false, false, false, false };
       /* check intersection with off-set */
-      if ( kitty::intersection_is_empty<TT, 1, 1>( get_div( v ), on_off_sets[0] ) )
+      if ( pos_off == 0u )
       {
         pos_unate_lits.emplace_back( v << 1 );
         unateness[0] = true;
       }
-      else if ( kitty::intersection_is_empty<TT, 0, 1>( get_div( v ), on_off_sets[0] ) )
+      else if ( neg_off == 0u )
       {
         pos_unate_lits.emplace_back( v << 1 | 0x1 );
         unateness[1] = true;
       }
 
       /* check intersection with on-set */
-      if ( kitty::intersection_is_empty<TT, 1, 1>( get_div( v ), on_off_sets[1] ) )
+      if ( pos_on == 0u )
       {
         neg_unate_lits.emplace_back( v << 1 );
         unateness[2] = true;
       }
-      else if ( kitty::intersection_is_empty<TT, 0, 1>( get_div( v ), on_off_sets[1] ) )
+      else if ( neg_on == 0u )
       {
         neg_unate_lits.emplace_back( v << 1 | 0x1 );
         unateness[3] = true;
@@ -587,29 +801,51 @@ private:
    */
   void sort_unate_lits( std::vector<unate_lit>& unate_lits, uint32_t on_off )
   {
+    auto const* set = on_off_sets.row( on_off );
     for ( auto& l : unate_lits )
     {
-      l.score = kitty::count_ones( ( l.lit & 0x1 ? ~get_div( l.lit >> 1 ) : get_div( l.lit >> 1 ) ) & on_off_sets[on_off] );
+      auto const f = words_of( l.lit );
+      l.score = detail::count_ones_in_words( divs.stride(), [&]( uint32_t w ) { return f[w] & set[w]; } );
     }
     std::stable_sort( unate_lits.begin(), unate_lits.end(), [&]( unate_lit const& l1, unate_lit const& l2 ) {
       return l1.score > l2.score; // descending order
     } );
   }
 
-  void sort_unate_pairs( std::vector<fanin_pair>& unate_pairs, uint32_t on_off )
+  /* Sort the unate pairs by the number of minterms in the intersection (see `sort_unate_lits`).
+     Before sorting, pairs that cannot complete a 2-resub with one of `unate_lits` (or a 3-resub
+     with another pair, if `with_pairs` is set) are removed, except for the best pair, which may
+     still be used to divide the target function.  Removing them does not change the result of
+     `find_div_pair` and `find_pair_pair`, which stop at the first pair below these bounds.
+   */
+  void sort_unate_pairs( std::vector<fanin_pair>& unate_pairs, uint32_t on_off, std::vector<unate_lit> const& unate_lits, bool with_pairs )
   {
+    auto const* set = on_off_sets.row( on_off );
+    uint32_t best_score{ 0u };
     for ( auto& p : unate_pairs )
     {
-      if constexpr ( static_params::use_xor )
-      {
-        p.score = ( p.lit1 > p.lit2 ) ? kitty::count_ones( ( ( p.lit1 & 0x1 ? ~get_div( p.lit1 >> 1 ) : get_div( p.lit1 >> 1 ) ) ^ ( p.lit2 & 0x1 ? ~get_div( p.lit2 >> 1 ) : get_div( p.lit2 >> 1 ) ) ) & on_off_sets[on_off] )
-                                      : kitty::count_ones( ( p.lit1 & 0x1 ? ~get_div( p.lit1 >> 1 ) : get_div( p.lit1 >> 1 ) ) & ( p.lit2 & 0x1 ? ~get_div( p.lit2 >> 1 ) : get_div( p.lit2 >> 1 ) ) & on_off_sets[on_off] );
-      }
-      else
+      auto const f = words_of( p );
+      p.score = detail::count_ones_in_words( divs.stride(), [&]( uint32_t w ) { return f[w] & set[w]; } );
+      best_score = std::max( best_score, p.score );
+    }
+
+    uint32_t const partner_score = std::max( unate_lits.empty() ? 0u : unate_lits[0].score, with_pairs ? best_score : 0u );
+    if ( partner_score < num_bits[on_off] )
+    {
+      uint32_t const bound = num_bits[on_off] - partner_score;
+      bool best_kept{ false };
+      auto it = unate_pairs.begin();
+      for ( auto const& p : unate_pairs )
       {
-        p.score = kitty::count_ones( ( p.lit1 & 0x1 ? ~get_div( p.lit1 >> 1 ) : get_div( p.lit1 >> 1 ) ) & ( p.lit2 & 0x1 ? ~get_div( p.lit2 >> 1 ) : get_div( p.lit2 >> 1 ) ) & on_off_sets[on_off] );
+        if ( p.score >= bound || ( !best_kept && p.score == best_score ) )
+        {
+          best_kept = best_kept || p.score == best_score;
+          *it++ = p;
+        }
       }
+      unate_pairs.erase( it, unate_pairs.end() );
     }
+
     std::stable_sort( unate_pairs.begin(), unate_pairs.end(), [&]( fanin_pair const& p1, fanin_pair const& p2 ) {
       return p1.score > p2.score; // descending order
     } );
@@ -621,6 +857,7 @@ private:
    */
   std::optional<uint32_t> find_div_div( std::vector<unate_lit>& unate_lits, uint32_t on_off )
   {
+    auto const* set = on_off_sets.row( on_off );
     for ( auto i = 0u; i < unate_lits.size(); ++i )
     {
       uint32_t const& lit1 = unate_lits[i].lit;
@@ -635,9 +872,9 @@ private:
         {
           break;
         }
-        auto const ntt1 = lit1 & 0x1 ? get_div( lit1 >> 1 ) : ~get_div( lit1 >> 1 );
-        auto const ntt2 = lit2 & 0x1 ? get_div( lit2 >> 1 ) : ~get_div( lit2 >> 1 );
-        if ( kitty::intersection_is_empty( ntt1, ntt2, on_off_sets[on_off] ) )
+        auto const f1 = words_of( lit1 );
+        auto const f2 = words_of( lit2 );
+        if ( detail::all_words_zero( divs.stride(), [&]( uint32_t w ) { return set[w] & ~( f1[w] | f2[w] ); } ) )
         {
           auto const new_lit = index_list.add_and( ( lit1 ^ 0x1 ), ( lit2 ^ 0x1 ) );
           return new_lit + on_off;
@@ -649,6 +886,7 @@ private:
 
   std::optional<uint32_t> find_div_pair( std::vector<unate_lit>& unate_lits, std::vector<fanin_pair>& unate_pairs, uint32_t on_off )
   {
+    auto const* set = on_off_sets.row( on_off );
     for ( auto i = 0u; i < unate_lits.size(); ++i )
     {
       uint32_t const& lit1 = unate_lits[i].lit;
@@ -659,25 +897,9 @@ private:
         {
           break;
         }
-        auto const ntt1 = lit1 & 0x1 ? get_div( lit1 >> 1 ) : ~get_div( lit1 >> 1 );
-        TT ntt2;
-        if constexpr ( static_params::use_xor )
-        {
-          if ( pair2.lit1 > pair2.lit2 )
-          {
-            ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) ^ ( pair2.lit2 & 0x1 ? ~get_div( pair2.lit2 >> 1 ) : get_div( pair2.lit2 >> 1 ) );
-          }
-          else
-          {
-            ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) | ( pair2.lit2 & 0x1 ? get_div( pair2.lit2 >> 1 ) : ~get_div( pair2.lit2 >> 1 ) );
-          }
-        }
-        else
-        {
-          ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) | ( pair2.lit2 & 0x1 ? get_div( pair2.lit2 >> 1 ) : ~get_div( pair2.lit2 >> 1 ) );
-        }
-
-        if ( kitty::intersection_is_empty( ntt1, ntt2, on_off_sets[on_off] ) )
+        auto const f1 = words_of( lit1 );
+        auto const f2 = words_of( pair2 );
+        if ( detail::all_words_zero( divs.stride(), [&]( uint32_t w ) { return set[w] & ~( f1[w] | f2[w] ); } ) )
         {
           uint32_t new_lit1;
           if constexpr ( static_params::use_xor )
@@ -705,6 +927,7 @@ private:
 
   std::optional<uint32_t> find_pair_pair( std::vector<fanin_pair>& unate_pairs, uint32_t on_off )
   {
+    auto const* set = on_off_sets.row( on_off );
     for ( auto i = 0u; i < unate_pairs.size(); ++i )
     {
       fanin_pair const& pair1 = unate_pairs[i];
@@ -719,33 +942,9 @@ private:
         {
           break;
         }
-        TT ntt1, ntt2;
-        if constexpr ( static_params::use_xor )
-        {
-          if ( pair1.lit1 > pair1.lit2 )
-          {
-            ntt1 = ( pair1.lit1 & 0x1 ? get_div( pair1.lit1 >> 1 ) : ~get_div( pair1.lit1 >> 1 ) ) ^ ( pair1.lit2 & 0x1 ? ~get_div( pair1.lit2 >> 1 ) : get_div( pair1.lit2 >> 1 ) );
-          }
-          else
-          {
-            ntt1 = ( pair1.lit1 & 0x1 ? get_div( pair1.lit1 >> 1 ) : ~get_div( pair1.lit1 >> 1 ) ) | ( pair1.lit2 & 0x1 ? get_div( pair1.lit2 >> 1 ) : ~get_div( pair1.lit2 >> 1 ) );
-          }
-          if ( pair2.lit1 > pair2.lit2 )
-          {
-            ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) ^ ( pair2.lit2 & 0x1 ? ~get_div( pair2.lit2 >> 1 ) : get_div( pair2.lit2 >> 1 ) );
-          }
-          else
-          {
-            ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) | ( pair2.lit2 & 0x1 ? get_div( pair2.lit2 >> 1 ) : ~get_div( pair2.lit2 >> 1 ) );
-          }
-        }
-        else
-        {
-          ntt1 = ( pair1.lit1 & 0x1 ? get_div( pair1.lit1 >> 1 ) : ~get_div( pair1.lit1 >> 1 ) ) | ( pair1.lit2 & 0x1 ? get_div( pair1.lit2 >> 1 ) : ~get_div( pair1.lit2 >> 1 ) );
-          ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) | ( pair2.lit2 & 0x1 ? get_div( pair2.lit2 >> 1 ) : ~get_div( pair2.lit2 >> 1 ) );
-        }
-
-        if ( kitty::intersection_is_empty( ntt1, ntt2, on_off_sets[on_off] ) )
+        auto const f1 = words_of( pair1 );
+        auto const f2 = words_of( pair2 );
+        if ( detail::all_words_zero( divs.stride(), [&]( uint32_t w ) { return set[w] & ~( f1[w] | f2[w] ); } ) )
         {
           uint32_t fanin_lit1, fanin_lit2;
           if constexpr ( static_params::use_xor )
@@ -782,32 +981,47 @@ private:
 
   std::optional<uint32_t> find_xor()
   {
+    auto const* off = on_off_sets.row( 0 );
+    auto const* on = on_off_sets.row( 1 );
+
     /* collect XOR-type pairs (d1 ^ d2) & off = 0 or ~(d1 ^ d2) & on = 0, selecting d1, d2 from binate_divs */
     for ( auto i = 0u; i < binate_divs.size(); ++i )
     {
+      auto const* d1 = divs.row( binate_divs[i] );
       for ( auto j = i + 1; j < binate_divs.size(); ++j )
       {
-        auto const tt_xor = get_div( binate_divs[i] ) ^ get_div( binate_divs[j] );
+        auto const* d2 = divs.row( binate_divs[j] );
+        uint64_t pos_off{ 0u }, neg_off{ 0u }, pos_on{ 0u }, neg_on{ 0u };
+        detail::foreach_word_block(
+            divs.stride(), [&]( uint32_t w ) {
+              auto const x = d1[w] ^ d2[w];
+              pos_off |= x & off[w];
+              neg_off |= ~x & off[w];
+              pos_on |= x & on[w];
+              neg_on |= ~x & on[w];
+            },
+            [&]() { return pos_off && neg_off && pos_on && neg_on; } );
+
         bool unateness[4] = { false, false, false, false };
         /* check intersection with off-set; additionally check intersection with on-set is not empty (otherwise it's useless) */
-        if ( kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[0] ) && !kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[1] ) )
+        if ( pos_off == 0u && pos_on != 0u )
         {
           pos_unate_pairs.emplace_back( binate_divs[i] << 1, binate_divs[j] << 1, true );
           unateness[0] = true;
         }
-        if ( kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[0] ) && !kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[1] ) )
+        if ( neg_off == 0u && neg_on != 0u )
         {
           pos_unate_pairs.emplace_back( ( binate_divs[i] << 1 ) + 1, binate_divs[j] << 1, true );
           unateness[1] = true;
         }
 
         /* check intersection with on-set; additionally check intersection with off-set is not empty (otherwise it's useless) */
-        if ( kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[1] ) && !kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[0] ) )
+        if ( pos_on == 0u && pos_off != 0u )
         {
           neg_unate_pairs.emplace_back( binate_divs[i] << 1, binate_divs[j] << 1, true );
           unateness[2] = true;
         }
-        if ( kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[1] ) && !kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[0] ) )
+        if ( neg_on == 0u && neg_off != 0u )
         {
           neg_unate_pairs.emplace_back( ( binate_divs[i] << 1 ) + 1, binate_divs[j] << 1, true );
           unateness[3] = true;
@@ -834,47 +1048,74 @@ private:
     {
       for ( auto j = i + 1; j < binate_divs.size(); ++j )
       {
-        collect_unate_pairs_detail<1, 1>( binate_divs[i], binate_divs[j] );
-        collect_unate_pairs_detail<0, 1>( binate_divs[i], binate_divs[j] );
-        collect_unate_pairs_detail<1, 0>( binate_divs[i], binate_divs[j] );
-        collect_unate_pairs_detail<0, 0>( binate_divs[i], binate_divs[j] );
+        collect_unate_pairs_detail( binate_divs[i], binate_divs[j] );
       }
     }
   }
 
-  template<bool pol1, bool pol2>
+  /* classifies the AND of two divisors in all four polarities in one scan */
   void collect_unate_pairs_detail( uint32_t div1, uint32_t div2 )
   {
-    /* check intersection with off-set; additionally check intersection with on-set is not empty (otherwise it's useless) */
-    if ( kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[0] ) && !kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[1] ) )
-    {
-      pos_unate_pairs.emplace_back( ( div1 << 1 ) + (uint32_t)( !pol1 ), ( div2 << 1 ) + (uint32_t)( !pol2 ) );
-    }
-    /* check intersection with on-set; additionally check intersection with off-set is not empty (otherwise it's useless) */
-    else if ( kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[1] ) && !kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[0] ) )
+    auto const* d1 = divs.row( div1 );
+    auto const* d2 = divs.row( div2 );
+    auto const* off = on_off_sets.row( 0 );
+    auto const* on = on_off_sets.row( 1 );
+
+    /* intersections with the off-set and the on-set for polarities (1, 1), (0, 1), (1, 0), and (0, 0) */
+    std::array<uint64_t, 4> in_off{}, in_on{};
+    detail::foreach_word_block(
+        divs.stride(), [&]( uint32_t w ) {
+          std::array<uint64_t, 4> const ands = { d1[w] & d2[w], ~d1[w] & d2[w], d1[w] & ~d2[w], ~d1[w] & ~d2[w] };
+          for ( auto k = 0u; k < 4u; ++k )
+          {
+            in_off[k] |= ands[k] & off[w];
+            in_on[k] |= ands[k] & on[w];
+          }
+        },
+        [&]() { return in_off[0] && in_off[1] && in_off[2] && in_off[3] && in_on[0] && in_on[1] && in_on[2] && in_on[3]; } );
+
+    for ( auto k = 0u; k < 4u; ++k )
     {
-      neg_unate_pairs.emplace_back( ( div1 << 1 ) + (uint32_t)( !pol1 ), ( div2 << 1 ) + (uint32_t)( !pol2 ) );
+      uint32_t const lit1 = ( div1 << 1 ) + ( k & 0x1 );
+      uint32_t const lit2 = ( div2 << 1 ) + ( k >> 1 );
+      /* check intersection with off-set; additionally check intersection with on-set is not empty (otherwise it's useless) */
+      if ( in_off[k] == 0u && in_on[k] != 0u )
+      {
+        pos_unate_pairs.emplace_back( lit1, lit2 );
+      }
+      /* check intersection with on-set; additionally check intersection with off-set is not empty (otherwise it's useless) */
+      else if ( in_on[k] == 0u && in_off[k] != 0u )
+      {
+        neg_unate_pairs.emplace_back( lit1, lit2 );
+      }
     }
   }
 
-  inline TT const& get_div( uint32_t idx ) const
+  literal_words words_of( uint32_t lit ) const
   {
-    if constexpr ( static_params::copy_tts )
-    {
-      return divisors[idx];
-    }
-    else
+    return { divs.row( lit >> 1 ), ( lit & 0x1 ) ? ~UINT64_C( 0 ) : UINT64_C( 0 ) };
+  }
+
+  pair_words words_of( fanin_pair const& pair ) const
+  {
+    bool is_xor{ false };
+    if constexpr ( static_params::use_xor )
     {
-      return ( *ptts )[divisors[idx]];
+      is_xor = pair.lit1 > pair.lit2;
     }
+    return { divs.row( pair.lit1 >> 1 ), divs.row( pair.lit2 >> 1 ),
+             ( pair.lit1 & 0x1 ) ? ~UINT64_C( 0 ) : UINT64_C( 0 ),
+             ( pair.lit2 & 0x1 ) ? ~UINT64_C( 0 ) : UINT64_C( 0 ),
+             is_xor ? ~UINT64_C( 0 ) : UINT64_C( 0 ) };
   }
 
 private:
-  std::array<TT, 2> on_off_sets;
+  /* rows 0 and 1 are the off-set and the on-set */
+  detail::signature_matrix on_off_sets;
   std::array<uint32_t, 2> num_bits; /* number of bits in on-set and off-set */
 
-  const typename static_params::truth_table_storage_type* ptts;
-  std::vector<std::conditional_t<static_params::copy_tts, TT, typename static_params::node_type>> divisors;
+  /* row i is the truth table of the i-th divisor, row 0 is unused */
+  detail::signature_matrix divs;
 
   index_list_t index_list;
 
@@ -887,4 +1128,4 @@ private:
   stats& st;
 }; /* xag_resyn_decompose */
 
-} /* namespace mockturtle */
\ No newline at end of file
+} /* namespace mockturtle */
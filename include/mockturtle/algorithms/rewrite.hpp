@@ -35,6 +35,8 @@
 #include "../traits.hpp"
 #include "../utils/cost_functions.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/npn_canonization.hpp"
+#include "../utils/parallel_utils.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/color_view.hpp"
 #include "../views/depth_view.hpp"
@@ -52,6 +54,9 @@
 #include <kitty/operations.hpp>
 #include <kitty/static_truth_table.hpp>
 
+#include <unordered_map>
+#include <utility>
+
 namespace mockturtle
 {
 
@@ -87,6 +92,23 @@ struct rewrite_params
   /*! \brief Window size for don't cares calculation. */
   uint32_t window_size{ 8u };
 
+  /*! \brief Number of threads evaluating candidates (0 = hardware concurrency).
+   *
+   * With more than one thread, the network is split into windows of
+   * consecutive gates whose candidates are evaluated concurrently on the
+   * unmodified network.  The best candidates are then re-validated and
+   * committed in topological order, such that the result does not depend on
+   * the number of threads.  Depth preservation and don't cares are only
+   * supported by the sequential pass.
+   */
+  uint32_t num_threads{ 1u };
+
+  /*! \brief Number of gates in a window evaluated by one thread. */
+  uint32_t window_gates{ 512u };
+
+  /*! \brief Maximum number of evaluate-and-commit rounds of the parallel pass. */
+  uint32_t max_rounds{ 3u };
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 };
@@ -107,6 +129,12 @@ struct rewrite_stats
   /*! \brief Candidates */
   uint32_t candidates{ 0 };
 
+  /*! \brief Rounds performed by the parallel pass. */
+  uint32_t rounds{ 0 };
+
+  /*! \brief Candidates of the parallel pass rejected during re-validation. */
+  uint32_t stale_candidates{ 0 };
+
   void report() const
   {
     std::cout << fmt::format( "[i] total time       = {:>5.2f} secs\n", to_seconds( time_total ) );
@@ -121,14 +149,37 @@ class rewrite_impl
 {
   static constexpr uint32_t num_vars = 4u;
   static constexpr uint32_t max_window_size = 8u;
+  static constexpr uint32_t max_cone_size = 256u;
   using network_cuts_t = dynamic_network_cuts<Ntk, num_vars, true, cut_enumeration_rewrite_cut>;
   using cut_manager_t = detail::dynamic_cut_enumeration_impl<Ntk, num_vars, true, cut_enumeration_rewrite_cut>;
   using cut_t = typename network_cuts_t::cut_t;
   using node_data = typename Ntk::storage::element_type::node_type;
+  using leaves_t = std::array<signal<Ntk>, num_vars>;
+
+  /* best replacement of a node found by the parallel evaluation */
+  struct rewrite_candidate
+  {
+    int32_t gain{ -1 };
+    uint32_t improvements{ 0 };
+    signal<Ntk> root;
+    leaves_t leaves;
+    bool phase{ false };
+  };
+
+  /* traversal data of the database and local fanout sizes of the network */
+  struct evaluation_scratch
+  {
+    std::vector<uint32_t> visited;
+    std::vector<uint64_t> values;
+    uint32_t trav_id{ 0 };
+
+    /* fanout sizes of dereferenced nodes, the network is left unchanged */
+    std::vector<std::pair<node<Ntk>, uint32_t>> fanout_sizes;
+  };
 
 public:
   rewrite_impl( Ntk& ntk, Library&& library, rewrite_params const& ps, rewrite_stats& st, NodeCostFn const& cost_fn )
-      : ntk( ntk ), library( library ), ps( ps ), st( st ), cost_fn( cost_fn ), required( ntk, UINT32_MAX )
+      : ntk( ntk ), library( library ), ps( ps ), st( st ), cost_fn( cost_fn ), required( ntk, UINT32_MAX ), _scratch( make_scratch() )
   {
     register_events();
   }
@@ -156,6 +207,8 @@ public:
 
     if ( ps.use_dont_cares )
       perform_rewriting_dc();
+    else if ( ps.num_threads != 1u && !ps.preserve_depth )
+      perform_rewriting_parallel();
     else
       perform_rewriting();
 
@@ -218,7 +271,7 @@ private:
         }
 
         /* Boolean matching */
-        auto config = kitty::exact_npn_canonization( cuts.truth_table( *cut ) );
+        auto config = cached_exact_npn_canonization( cuts.truth_table( *cut ) );
         auto tt_npn = std::get<0>( config );
         auto neg = std::get<1>( config );
         auto perm = std::get<2>( config );
@@ -266,11 +319,11 @@ private:
 
           for ( auto const& dag : *structures )
           {
-            auto [nodes_added, level] = evaluate_entry( n, db.get_node( dag.root ), leaves );
+            auto [nodes_added, level] = evaluate_entry( _scratch, n, db.get_node( dag.root ), leaves );
             int32_t gain = mffc_size - nodes_added;
 
             /* discard if dag.root and n are the same */
-            if ( ntk.node_to_index( n ) == db.value( db.get_node( dag.root ) ) >> 1 )
+            if ( ntk.node_to_index( n ) == _scratch.values[db.node_to_index( db.get_node( dag.root ) )] >> 1 )
               continue;
 
             /* discard if no gain */
@@ -410,7 +463,7 @@ private:
         }
 
         /* Boolean matching */
-        auto config = kitty::exact_npn_canonization( cuts.truth_table( *cut ) );
+        auto config = cached_exact_npn_canonization( cuts.truth_table( *cut ) );
         auto tt_npn = std::get<0>( config );
         auto neg = std::get<1>( config );
         auto perm = std::get<2>( config );
@@ -492,11 +545,11 @@ private:
 
           for ( auto const& dag : *structures )
           {
-            auto [nodes_added, level] = evaluate_entry( n, db.get_node( dag.root ), leaves );
+            auto [nodes_added, level] = evaluate_entry( _scratch, n, db.get_node( dag.root ), leaves );
             int32_t gain = mffc_size - nodes_added;
 
             /* discard if dag.root and n are the same */
-            if ( ntk.node_to_index( n ) == db.value( db.get_node( dag.root ) ) >> 1 )
+            if ( ntk.node_to_index( n ) == _scratch.values[db.node_to_index( db.get_node( dag.root ) )] >> 1 )
               continue;
 
             /* discard if no gain */
@@ -559,6 +612,345 @@ private:
     } );
   }
 
+  void perform_rewriting_parallel()
+  {
+    auto const num_threads = resolve_num_threads( ps.num_threads );
+    auto const window_gates = std::max( ps.window_gates, 1u );
+    std::vector<evaluation_scratch> scratches( num_threads, _scratch );
+
+    std::vector<node<Ntk>> gates;
+    std::vector<rewrite_candidate> candidates;
+    for ( auto round = 0u; round < std::max( ps.max_rounds, 1u ); ++round )
+    {
+      ++st.rounds;
+
+      /* enumerate the cuts of the current network */
+      cut_enumeration_stats cst;
+      network_cuts_t cuts( ntk.size() + ( ntk.size() >> 1 ) );
+      cut_manager_t cut_manager( ntk, ps.cut_enumeration_ps, cst, cuts );
+      cut_manager.init_cuts();
+
+      gates.clear();
+      ntk.foreach_gate( [&]( auto const& n ) {
+        if ( ntk.fanout_size( n ) == 0u )
+          return;
+
+        cut_manager.compute_cuts( n );
+        gates.push_back( n );
+      } );
+
+      /* evaluate windows of gates concurrently, the network is not modified */
+      candidates.assign( gates.size(), rewrite_candidate{} );
+      parallel_for( num_threads, ( gates.size() + window_gates - 1u ) / window_gates, [&]( uint64_t window, uint32_t thread_id ) {
+        auto const end = std::min<uint64_t>( ( window + 1u ) * window_gates, gates.size() );
+        for ( auto i = window * window_gates; i < end; ++i )
+        {
+          candidates[i] = evaluate_node( scratches[thread_id], std::as_const( cuts ), gates[i] );
+        }
+      } );
+
+      /* re-validate and commit the candidates in topological order */
+      uint32_t num_committed = 0;
+      for ( auto i = 0u; i < gates.size(); ++i )
+      {
+        _candidates += candidates[i].improvements;
+        if ( candidates[i].gain < 0 )
+          continue;
+
+        if ( commit_candidate( gates[i], candidates[i] ) )
+          ++num_committed;
+        else
+          ++st.stale_candidates;
+      }
+
+      if ( num_committed == 0u )
+        break;
+    }
+  }
+
+  rewrite_candidate evaluate_node( evaluation_scratch& scratch, network_cuts_t const& cuts, node<Ntk> const& n )
+  {
+    auto& db = library.get_database();
+
+    rewrite_candidate best;
+    uint32_t best_level = UINT32_MAX;
+    std::array<signal<Ntk>, num_vars> leaves;
+    std::array<uint8_t, num_vars> permutation;
+
+    for ( auto const& cut : cuts.cuts( ntk.node_to_index( n ) ) )
+    {
+      /* skip trivial cut */
+      if ( ( cut->size() == 1 && *cut->begin() == ntk.node_to_index( n ) ) )
+        continue;
+
+      /* Boolean matching */
+      auto const [tt_npn, neg, perm] = cached_exact_npn_canonization( cuts.truth_table( *cut ) );
+      auto const structures = library.get_supergates( tt_npn );
+
+      if ( structures == nullptr )
+        continue;
+
+      uint32_t negation = 0;
+      for ( auto j = 0u; j < num_vars; ++j )
+      {
+        permutation[perm[j]] = j;
+        negation |= ( ( neg >> perm[j] ) & 1 ) << j;
+      }
+
+      {
+        auto j = 0u;
+        for ( auto const leaf : *cut )
+        {
+          leaves[permutation[j++]] = ntk.make_signal( ntk.index_to_node( leaf ) );
+        }
+
+        while ( j < num_vars )
+          leaves[permutation[j++]] = ntk.get_constant( false );
+      }
+
+      for ( auto j = 0u; j < num_vars; ++j )
+      {
+        if ( ( negation >> j ) & 1 )
+        {
+          leaves[j] = !leaves[j];
+        }
+      }
+
+      /* measure the MFFC contained in the cut on local fanout sizes */
+      int32_t mffc_size = measure_mffc_local( scratch, n, cut );
+
+      for ( auto const& dag : *structures )
+      {
+        auto [nodes_added, level] = evaluate_entry( scratch, n, db.get_node( dag.root ), leaves );
+        int32_t gain = mffc_size - nodes_added;
+
+        /* discard if dag.root and n are the same */
+        if ( ntk.node_to_index( n ) == scratch.values[db.node_to_index( db.get_node( dag.root ) )] >> 1 )
+          continue;
+
+        /* discard if no gain */
+        if ( gain < 0 || ( !ps.allow_zero_gain && gain == 0 ) )
+          continue;
+
+        if ( ( gain > best.gain ) || ( gain == best.gain && level < best_level ) )
+        {
+          ++best.improvements;
+          best.gain = gain;
+          best.root = dag.root;
+          best.leaves = leaves;
+          best.phase = ( neg >> num_vars ) == 1;
+          best_level = level;
+        }
+
+        if ( !ps.allow_multiple_structures )
+          break;
+      }
+
+      scratch.fanout_sizes.clear();
+
+      if ( cut->size() == 0 || ( cut->size() == 1 && *cut->begin() != ntk.node_to_index( n ) ) )
+        break;
+    }
+
+    return best;
+  }
+
+  bool commit_candidate( node<Ntk> const& n, rewrite_candidate const& candidate )
+  {
+    if ( ntk.is_dead( n ) || ntk.fanout_size( n ) == 0u || !validate_candidate( n, candidate ) )
+      return false;
+
+    /* recompute the gain on the current network */
+    auto& db = library.get_database();
+    int32_t mffc_size = measure_mffc_leaves( n, candidate.leaves, false );
+    auto const nodes_added = evaluate_entry( _scratch, n, db.get_node( candidate.root ), candidate.leaves ).first;
+    int32_t gain = mffc_size - nodes_added;
+    bool const same_root = ntk.node_to_index( n ) == _scratch.values[db.node_to_index( db.get_node( candidate.root ) )] >> 1;
+    measure_mffc_leaves( n, candidate.leaves, true );
+
+    if ( same_root || gain < 0 || ( !ps.allow_zero_gain && gain == 0 ) )
+      return false;
+
+    topo_view topo{ db, candidate.root };
+    auto new_f = cleanup_dangling( topo, ntk, candidate.leaves.begin(), candidate.leaves.end() ).front();
+
+    assert( n != ntk.get_node( new_f ) );
+
+    _estimated_gain += gain;
+    ntk.substitute_node_no_restrash( n, new_f ^ candidate.phase );
+
+    return true;
+  }
+
+  /* checks that the candidate still implements the function of n, i.e., its
+   * leaves are alive and still form a cut of n in the current network */
+  bool validate_candidate( node<Ntk> const& n, rewrite_candidate const& candidate )
+  {
+    using tt_t = kitty::static_truth_table<num_vars>;
+    auto& db = library.get_database();
+
+    _cone_tts.clear();
+    std::array<tt_t, num_vars> leaf_tts;
+    for ( auto j = 0u; j < num_vars; ++j )
+    {
+      auto const l = ntk.get_node( candidate.leaves[j] );
+      if ( ntk.is_dead( l ) )
+        return false;
+
+      tt_t tt;
+      if ( !ntk.is_constant( l ) )
+      {
+        kitty::create_nth_var( tt, j );
+        _cone_tts[l] = tt;
+      }
+      leaf_tts[j] = ntk.is_complemented( candidate.leaves[j] ) ? ~tt : tt;
+    }
+
+    uint32_t budget = max_cone_size;
+    auto const tt_n = simulate_cone_rec( n, budget );
+    if ( !tt_n )
+      return false;
+
+    std::unordered_map<node<Ntk>, tt_t> db_tts;
+    auto tt_root = simulate_db_rec( db.get_node( candidate.root ), leaf_tts, db_tts );
+    if ( db.is_complemented( candidate.root ) != candidate.phase )
+      tt_root = ~tt_root;
+
+    return tt_root == *tt_n;
+  }
+
+  std::optional<kitty::static_truth_table<num_vars>> simulate_cone_rec( node<Ntk> const& n, uint32_t& budget )
+  {
+    if ( auto const it = _cone_tts.find( n ); it != _cone_tts.end() )
+      return it->second;
+    if ( ntk.is_constant( n ) )
+      return kitty::static_truth_table<num_vars>{};
+    if ( ntk.is_ci( n ) || budget == 0u )
+      return std::nullopt;
+    --budget;
+
+    std::array<kitty::static_truth_table<num_vars>, Ntk::max_fanin_size> fanin_tts;
+    bool valid = true;
+    ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+      auto const tt = simulate_cone_rec( ntk.get_node( f ), budget );
+      if ( !tt )
+      {
+        valid = false;
+        return false;
+      }
+      fanin_tts[i] = *tt;
+      return true;
+    } );
+    if ( !valid )
+      return std::nullopt;
+
+    auto const tt = ntk.compute( n, fanin_tts.begin(), fanin_tts.begin() + ntk.fanin_size( n ) );
+    _cone_tts[n] = tt;
+    return tt;
+  }
+
+  template<class TT>
+  TT simulate_db_rec( node<Ntk> const& g, std::array<TT, num_vars> const& leaf_tts, std::unordered_map<node<Ntk>, TT>& tts )
+  {
+    auto& db = library.get_database();
+    if ( db.is_constant( g ) )
+      return TT{};
+    if ( db.is_pi( g ) )
+      return leaf_tts[db.node_to_index( g ) - 1];
+    if ( auto const it = tts.find( g ); it != tts.end() )
+      return it->second;
+
+    std::array<TT, Ntk::max_fanin_size> fanin_tts;
+    db.foreach_fanin( g, [&]( auto const& f, auto i ) {
+      fanin_tts[i] = simulate_db_rec( db.get_node( f ), leaf_tts, tts );
+    } );
+
+    return tts[g] = db.compute( g, fanin_tts.begin(), fanin_tts.begin() + db.fanin_size( g ) );
+  }
+
+  int32_t measure_mffc_leaves( node<Ntk> const& n, leaves_t const& leaves, bool ref )
+  {
+    /* reference cut leaves */
+    for ( auto const& leaf : leaves )
+    {
+      ntk.incr_fanout_size( ntk.get_node( leaf ) );
+    }
+
+    int32_t mffc_size = static_cast<int32_t>( ref ? recursive_ref( n ) : recursive_deref( n ) );
+
+    /* dereference leaves */
+    for ( auto const& leaf : leaves )
+    {
+      ntk.decr_fanout_size( ntk.get_node( leaf ) );
+    }
+
+    return mffc_size;
+  }
+
+  int32_t measure_mffc_local( evaluation_scratch& scratch, node<Ntk> const& n, cut_t const* cut )
+  {
+    /* reference cut leaves */
+    for ( auto leaf : *cut )
+    {
+      update_local_fanout_size( scratch, ntk.index_to_node( leaf ), 1 );
+    }
+
+    int32_t mffc_size = static_cast<int32_t>( recursive_deref_local( scratch, n ) );
+
+    /* dereference leaves */
+    for ( auto leaf : *cut )
+    {
+      update_local_fanout_size( scratch, ntk.index_to_node( leaf ), -1 );
+    }
+
+    return mffc_size;
+  }
+
+  uint32_t recursive_deref_local( evaluation_scratch& scratch, node<Ntk> const& n )
+  {
+    /* terminate? */
+    if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+      return 0;
+
+    /* recursively collect nodes */
+    uint32_t value{ cost_fn( ntk, n ) };
+    ntk.foreach_fanin( n, [&]( auto const& s ) {
+      if ( update_local_fanout_size( scratch, ntk.get_node( s ), -1 ) == 0 )
+      {
+        value += recursive_deref_local( scratch, ntk.get_node( s ) );
+      }
+    } );
+    return value;
+  }
+
+  uint32_t local_fanout_size( evaluation_scratch const& scratch, node<Ntk> const& n ) const
+  {
+    for ( auto const& [m, size] : scratch.fanout_sizes )
+    {
+      if ( m == n )
+        return size;
+    }
+    return ntk.fanout_size( n );
+  }
+
+  uint32_t update_local_fanout_size( evaluation_scratch& scratch, node<Ntk> const& n, int32_t delta )
+  {
+    for ( auto& [m, size] : scratch.fanout_sizes )
+    {
+      if ( m == n )
+        return size += delta;
+    }
+    return scratch.fanout_sizes.emplace_back( n, ntk.fanout_size( n ) + delta ).second;
+  }
+
+  evaluation_scratch make_scratch()
+  {
+    evaluation_scratch scratch;
+    scratch.visited.resize( library.get_database().size(), 0u );
+    scratch.values.resize( library.get_database().size(), 0u );
+    return scratch;
+  }
+
   int32_t measure_mffc_ref( node<Ntk> const& n, cut_t const* cut )
   {
     /* reference cut leaves */
@@ -631,23 +1023,22 @@ private:
     return value;
   }
 
-  inline std::pair<int32_t, uint32_t> evaluate_entry( node<Ntk> const& current_root, node<Ntk> const& n, std::array<signal<Ntk>, num_vars> const& leaves )
+  inline std::pair<int32_t, uint32_t> evaluate_entry( evaluation_scratch& scratch, node<Ntk> const& current_root, node<Ntk> const& n, std::array<signal<Ntk>, num_vars> const& leaves )
   {
-    auto& db = library.get_database();
-    db.incr_trav_id();
+    ++scratch.trav_id;
 
-    return evaluate_entry_rec( current_root, n, leaves );
+    return evaluate_entry_rec( scratch, current_root, n, leaves );
   }
 
-  std::pair<int32_t, uint32_t> evaluate_entry_rec( node<Ntk> const& current_root, node<Ntk> const& n, std::array<signal<Ntk>, num_vars> const& leaves )
+  std::pair<int32_t, uint32_t> evaluate_entry_rec( evaluation_scratch& scratch, node<Ntk> const& current_root, node<Ntk> const& n, std::array<signal<Ntk>, num_vars> const& leaves )
   {
     auto& db = library.get_database();
     if ( db.is_pi( n ) || db.is_constant( n ) )
       return { 0, 0 };
-    if ( db.visited( n ) == db.trav_id() )
+    if ( scratch.visited[db.node_to_index( n )] == scratch.trav_id )
       return { 0, 0 };
 
-    db.set_visited( n, db.trav_id() );
+    scratch.visited[db.node_to_index( n )] = scratch.trav_id;
 
     int32_t area = 0;
     uint32_t level = 0;
@@ -671,15 +1062,15 @@ private:
         return;
       }
 
-      auto [area_rec, level_rec] = evaluate_entry_rec( current_root, g, leaves );
+      auto [area_rec, level_rec] = evaluate_entry_rec( scratch, current_root, g, leaves );
       area += area_rec;
       level = std::max( level, level_rec );
 
       /* check value */
-      if ( db.value( g ) < UINT32_MAX )
+      if ( scratch.values[db.node_to_index( g )] < UINT64_MAX )
       {
         signal<Ntk> s;
-        s.data = static_cast<uint64_t>( db.value( g ) );
+        s.data = scratch.values[db.node_to_index( g )];
         node_data[i] = s ^ db.is_complemented( f );
       }
       else
@@ -738,12 +1129,12 @@ private:
           return { UINT32_MAX / 2, level + 1 };
 
         /* annotate hashing info */
-        db.set_value( n, val->data );
-        return { area + ( ntk.fanout_size( ntk.get_node( *val ) ) > 0 ? 0 : cost_fn( ntk, n ) ), level + 1 };
+        scratch.values[db.node_to_index( n )] = val->data;
+        return { area + ( local_fanout_size( scratch, ntk.get_node( *val ) ) > 0 ? 0 : cost_fn( ntk, n ) ), level + 1 };
       }
     }
 
-    db.set_value( n, UINT32_MAX );
+    scratch.values[db.node_to_index( n )] = UINT64_MAX;
     return { area + cost_fn( ntk, n ), level + 1 };
   }
 
@@ -866,6 +1257,9 @@ private:
 
   node_map<uint32_t, Ntk> required;
 
+  evaluation_scratch _scratch;
+  std::unordered_map<node<Ntk>, kitty::static_truth_table<num_vars>> _cone_tts;
+
   uint32_t _candidates{ 0 };
   uint32_t _estimated_gain{ 0 };
 
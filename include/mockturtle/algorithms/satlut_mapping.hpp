@@ -36,6 +36,7 @@
 #include <cmath>
 
 #include "../generators/sorting.hpp"
+#include "../utils/cancellation_token.hpp"
 #include "../utils/include/percy.hpp"
 #include "../utils/node_map.hpp"
 #include "../utils/progress_bar.hpp"
@@ -76,6 +77,13 @@ struct satlut_mapping_params
    */
   uint32_t conflict_limit{ 0u };
 
+  /*! \brief Token to stop before the next SAT call (or the next window).
+   *
+   * The best mapping found so far is kept.  If the network has no mapping
+   * yet, the search continues until the first mapping is found.
+   */
+  cancellation_token cancellation{};
+
   /*! \brief Show progress. */
   bool progress{ false };
 
@@ -251,7 +259,7 @@ public:
 
     progress_bar pbar{ "satlut iteration = {0}   try size = {1}", ps.progress };
     auto iteration = 0u;
-    while ( true )
+    while ( !( ntk.has_mapping() && ps.cancellation.is_cancelled() ) )
     {
       pbar( ++iteration, best_size );
       if ( best_size > card_out.size() )
@@ -432,6 +440,11 @@ void satlut_mapping( Ntk& ntk, uint32_t window_size, satlut_mapping_params ps =
   progress_bar pbar{ ntk.size(), "satlut (windowed) |{0}| node = {1:>4} / " + std::to_string( ntk.size() ), ps.progress };
   ps.progress = false; /* do not show inner progress */
   ntk.foreach_gate( [&]( auto n, int index ) {
+    if ( ps.cancellation.is_cancelled() )
+    {
+      return false;
+    }
+
     stopwatch<> t( time_total );
     pbar( index, ntk.node_to_index( n ) );
     if ( ntk.is_cell_root( n ) )
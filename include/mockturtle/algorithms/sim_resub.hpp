@@ -162,7 +162,7 @@ public:
   using TT = kitty::partial_truth_table;
 
   explicit simulation_based_resub_engine( Ntk& ntk, resubstitution_params const& ps, stats& st )
-      : ntk( ntk ), ps( ps ), st( st ), tts( ntk ), validator( ntk, { ps.max_clauses, ps.odc_levels, ps.conflict_limit, ps.random_seed } ), engine( st.resyn_st )
+      : ntk( ntk ), ps( ps ), st( st ), tts( ntk ), validator( ntk, { ps.max_clauses, ps.odc_levels, ps.conflict_limit, ps.random_seed, ps.incremental_gc } ), engine( st.resyn_st )
   {
     if constexpr ( !validator_t::use_odc_ )
     {
@@ -182,7 +182,7 @@ public:
     if ( ps.save_patterns )
     {
       call_with_stopwatch( st.time_patsave, [&]() {
-        write_patterns( sim, *ps.save_patterns );
+        save_simulation_patterns( sim, *ps.save_patterns, ps.binary_patterns, ps.pattern_filename );
       } );
     }
 
@@ -236,7 +236,7 @@ public:
 
   std::optional<signal> run( node const& n, std::vector<node> const& divs, mffc_result_t potential_gain, uint32_t& last_gain )
   {
-    for ( auto j = 0u; j < ps.max_trials; ++j )
+    for ( auto j = 0u; j < ps.max_trials && !ps.cancellation.is_cancelled(); ++j )
     {
       check_tts( n );
       for ( auto const& d : divs )
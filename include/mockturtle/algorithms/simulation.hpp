@@ -37,9 +37,11 @@
 
 #include <cstdint>
 #include <fstream>
+#include <optional>
 #include <random>
 #include <vector>
 
+#include "../io/read_patterns.hpp"
 #include "../traits.hpp"
 #include "../utils/node_map.hpp"
 
@@ -49,6 +51,7 @@
 #include <kitty/operators.hpp>
 #include <kitty/partial_truth_table.hpp>
 #include <kitty/static_truth_table.hpp>
+#include <kitty/ternary_truth_table.hpp>
 
 namespace mockturtle
 {
@@ -210,6 +213,8 @@ public:
    *
    * The simulation pattern file should contain `num_pis` lines of the same length.
    * Each line is the simulation signature of a primary input, represented in hexadecimal.
+   * Alternatively, the file can be a binary pattern file (see `write_binary_patterns`),
+   * which is mapped into memory and read without parsing.
    *
    * \param filename Name of the simulation pattern file.
    * \param length Number of simulation patterns to keep. Should not be greater than 4 times
@@ -217,23 +222,36 @@ public:
    */
   partial_simulator( const std::string& filename, uint32_t length = 0u )
   {
-    std::ifstream in( filename, std::ifstream::in );
-    std::string line;
-
-    while ( getline( in, line ) )
+    if ( !read_binary_patterns( filename, patterns ) )
     {
-      patterns.emplace_back( line.length() * 4 );
-      kitty::create_from_hex_string( patterns.back(), line );
-      if ( length != 0u )
+      std::ifstream in( filename, std::ifstream::in );
+      std::string line;
+
+      while ( getline( in, line ) )
       {
-        patterns.back().resize( length );
+        patterns.emplace_back( line.length() * 4 );
+        kitty::create_from_hex_string( patterns.back(), line );
       }
-    }
 
-    in.close();
+      in.close();
+    }
 
     assert( patterns.size() > 0 );
     num_patterns = patterns[0].num_bits();
+
+    /* the file is a prefix of the patterns, unless some of them have been cut off */
+    if ( length == 0u || length >= num_patterns )
+    {
+      file_patterns = num_patterns;
+    }
+    if ( length != 0u )
+    {
+      for ( auto& tt : patterns )
+      {
+        tt.resize( length );
+      }
+      num_patterns = length;
+    }
   }
 
   kitty::partial_truth_table compute_constant( bool value ) const
@@ -277,11 +295,22 @@ public:
    *
    * \return A vector of `num_pis()` patterns stored in `kitty::partial_truth_table`s.
    */
-  std::vector<kitty::partial_truth_table> get_patterns() const
+  std::vector<kitty::partial_truth_table> const& get_patterns() const
   {
     return patterns;
   }
 
+  /*! \brief Get the number of patterns read from a pattern file.
+   *
+   * \return The number of patterns in the file that the simulator has been
+   * constructed from, if the file contents are still the first patterns of the
+   * simulator, and `std::nullopt` otherwise.
+   */
+  std::optional<uint32_t> num_file_patterns() const
+  {
+    return file_patterns;
+  }
+
   template<class Ntk, bool enabled = has_EXCDC_interface_v<Ntk>, typename = std::enable_if_t<enabled>>
   void remove_CDC_patterns( Ntk const& ntk )
   {
@@ -300,6 +329,7 @@ public:
         }
         --num_patterns;
         --i;
+        file_patterns = std::nullopt;
       }
     }
     for ( auto j = 0u; j < patterns.size(); ++j )
@@ -311,6 +341,7 @@ public:
 private:
   std::vector<kitty::partial_truth_table> patterns;
   uint32_t num_patterns;
+  std::optional<uint32_t> file_patterns;
 };
 
 /*! \brief Simulates partial truth tables, and performs bit packing when requested.
@@ -500,6 +531,94 @@ private:
   uint32_t packed_patterns;
 };
 
+/*! \brief Simulates three-valued (0/1/X) partial truth tables.
+ *
+ * Simulation values are of type
+ * `kitty::ternary_truth_table<kitty::partial_truth_table>`, i.e., each bit is
+ * represented with two rails: a care bit that is set if the value is known,
+ * and a value bit that holds the Boolean value of known bits (and is 0 for
+ * unknown bits).  Gates propagate unknown values bit-parallel and
+ * conservatively, e.g., `0 & X = 0` but `1 & X = X`.  Gates of k-LUT networks
+ * are evaluated exactly, i.e., an output bit is known if the gate function
+ * does not depend on the unknown fanins.
+ *
+ * Primary inputs are assigned partial assignments, which can be added
+ * pattern by pattern as `std::optional<bool>` values, where `std::nullopt`
+ * stands for an unknown value.
+ */
+class ternary_simulator
+{
+public:
+  using simulation_type = kitty::ternary_truth_table<kitty::partial_truth_table>;
+
+  /*! \brief Create a `ternary_simulator` without patterns.
+   *
+   * \param num_pis Number of primary inputs.
+   */
+  explicit ternary_simulator( uint32_t num_pis )
+      : patterns( num_pis, simulation_type( 0u ) )
+  {
+  }
+
+  /*! \brief Create a `ternary_simulator` with given simulation patterns.
+   *
+   * \param values Values of the primary inputs.
+   * \param cares Care bits of the primary inputs (unset bits are unknown).
+   */
+  ternary_simulator( std::vector<kitty::partial_truth_table> const& values, std::vector<kitty::partial_truth_table> const& cares )
+  {
+    assert( values.size() == cares.size() );
+    for ( auto i = 0u; i < values.size(); ++i )
+    {
+      assert( values[i].num_bits() == cares[i].num_bits() );
+      patterns.emplace_back( values[i] & cares[i], cares[i] );
+    }
+    num_patterns = patterns.empty() ? 0u : cares[0].num_bits();
+  }
+
+  simulation_type compute_constant( bool value ) const
+  {
+    kitty::partial_truth_table zero( num_patterns );
+    return simulation_type( value ? ~zero : zero, ~zero );
+  }
+
+  simulation_type compute_pi( uint32_t index ) const
+  {
+    return patterns.at( index );
+  }
+
+  simulation_type compute_not( simulation_type const& value ) const
+  {
+    return ~value;
+  }
+
+  /*! \brief Get the current number of simulation patterns. */
+  uint32_t num_bits() const
+  {
+    return num_patterns;
+  }
+
+  /*! \brief Add a partial assignment of the primary inputs.
+   *
+   * \param pattern The pattern, where `std::nullopt` denotes an unknown value.
+   */
+  void add_pattern( std::vector<std::optional<bool>> const& pattern )
+  {
+    assert( pattern.size() == patterns.size() );
+
+    for ( auto i = 0u; i < pattern.size(); ++i )
+    {
+      patterns[i]._bits.add_bit( pattern[i].value_or( false ) );
+      patterns[i]._care.add_bit( pattern[i].has_value() );
+    }
+    ++num_patterns;
+  }
+
+private:
+  std::vector<simulation_type> patterns;
+  uint32_t num_patterns{ 0u };
+};
+
 /*! \brief Simulates a network with a generic simulator.
  *
  * This is a generic simulation algorithm that can simulate arbitrary values.
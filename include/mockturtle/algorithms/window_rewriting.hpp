@@ -51,7 +51,12 @@
 
 #include <fmt/format.h>
 #include <kitty/kitty.hpp>
+
+#include <algorithm>
+#include <array>
 #include <stack>
+#include <unordered_map>
+#include <vector>
 
 #pragma once
 
@@ -87,6 +92,10 @@ struct window_rewriting_params
   uint64_t max_num_divs{ 100 };
 
   bool filter_cyclic_substitutions{ false };
+
+  /* skip windows that have already been optimized without success and
+     whose nodes have not been modified since then */
+  bool reuse_windows{ true };
 }; /* window_rewriting_params */
 
 struct window_rewriting_stats
@@ -138,6 +147,7 @@ struct window_rewriting_stats
   uint64_t num_substitutions{ 0 };
   uint64_t num_restrashes{ 0 };
   uint64_t num_windows{ 0 };
+  uint64_t num_reused_windows{ 0 };
   uint64_t gain{ 0 };
 
   window_rewriting_stats operator+=( window_rewriting_stats const& other )
@@ -158,6 +168,7 @@ struct window_rewriting_stats
     num_substitutions += other.num_substitutions;
     num_restrashes += other.num_restrashes;
     num_windows += other.num_windows;
+    num_reused_windows += other.num_reused_windows;
     num_resyn_invokes += other.num_resyn_invokes;
     gain += other.gain;
     return *this;
@@ -169,8 +180,8 @@ struct window_rewriting_stats
         time_total - time_window - time_topo_sort - time_optimize - time_substitute - time_levels;
 
     fmt::print( "===========================================================================\n" );
-    fmt::print( "[i] Windowing =  {:7.2f} ({:5.2f}%) (#win = {})\n",
-                to_seconds( time_window ), to_seconds( time_window ) / to_seconds( time_total ) * 100, num_windows );
+    fmt::print( "[i] Windowing =  {:7.2f} ({:5.2f}%) (#win = {}, #reused = {})\n",
+                to_seconds( time_window ), to_seconds( time_window ) / to_seconds( time_total ) * 100, num_windows, num_reused_windows );
     fmt::print( "[i] Top.sort =   {:7.2f} ({:5.2f}%)\n", to_seconds( time_topo_sort ), to_seconds( time_topo_sort ) / to_seconds( time_total ) * 100 );
     fmt::print( "[i] Enc.list =   {:7.2f} ({:5.2f}%)\n", to_seconds( time_encode ), to_seconds( time_encode ) / to_seconds( time_total ) * 100 );
     fmt::print( "[i] Optimize =   {:7.2f} ({:5.2f}%) (#invokes = {}, #resubs = {}, est. gain = {})\n",
@@ -236,10 +247,118 @@ bool is_contained_in_tfi( Ntk const& ntk, typename Ntk::node const& node, typena
 namespace detail
 {
 
+/* Truth tables of the nodes in a window network.  The storage is kept
+   across windows, such that the truth tables are only allocated once and
+   later simulated in place. */
+template<typename NtkWin, typename TT>
+class window_truth_tables
+{
+public:
+  using node = typename NtkWin::node;
+  using signal = typename NtkWin::signal;
+
+public:
+  window_truth_tables( TT const& constant, std::vector<TT> const& projections )
+      : constant( constant ), projections( projections )
+  {
+  }
+
+  /* simulates all nodes of a (new) window network */
+  void simulate( NtkWin const& win )
+  {
+    ntk = &win;
+    resize();
+
+    tts[win.node_to_index( win.get_node( win.get_constant( false ) ) )] = constant;
+    win.foreach_pi( [&]( auto const& n, auto i ) {
+      tts[win.node_to_index( n )] = projections[i];
+    } );
+    win.foreach_gate( [&]( auto const& n ) {
+      compute( n );
+    } );
+  }
+
+  /* simulates a node added to the window network */
+  void simulate( node const& n )
+  {
+    resize();
+    compute( n );
+  }
+
+  TT const& operator[]( node const& n ) const
+  {
+    return tts[ntk->node_to_index( n )];
+  }
+
+  template<typename _Ntk = NtkWin, typename = std::enable_if_t<!std::is_same_v<typename _Ntk::signal, typename _Ntk::node>>>
+  TT const& operator[]( signal const& f ) const
+  {
+    return tts[ntk->node_to_index( ntk->get_node( f ) )];
+  }
+
+private:
+  void resize()
+  {
+    if ( tts.size() < ntk->size() )
+    {
+      tts.resize( ntk->size(), constant );
+    }
+  }
+
+  void compute( node const& n )
+  {
+    auto& tt = tts[ntk->node_to_index( n )];
+
+    if constexpr ( std::is_same_v<typename NtkWin::base_type, aig_network> || std::is_same_v<typename NtkWin::base_type, xag_network> )
+    {
+      std::array<signal, 2u> fanins;
+      ntk->foreach_fanin( n, [&]( auto const& f, auto i ) {
+        fanins[i] = f;
+      } );
+
+      auto const& tt0 = ( *this )[fanins[0]];
+      auto const& tt1 = ( *this )[fanins[1]];
+      uint64_t const mask0 = ntk->is_complemented( fanins[0] ) ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+      uint64_t const mask1 = ntk->is_complemented( fanins[1] ) ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+
+      bool is_xor{ false };
+      if constexpr ( has_is_xor_v<NtkWin> )
+      {
+        is_xor = ntk->is_xor( n );
+      }
+
+      if ( is_xor )
+      {
+        std::transform( tt0.cbegin(), tt0.cend(), tt1.cbegin(), tt.begin(), [&]( uint64_t a, uint64_t b ) { return ( a ^ mask0 ) ^ ( b ^ mask1 ); } );
+      }
+      else
+      {
+        std::transform( tt0.cbegin(), tt0.cend(), tt1.cbegin(), tt.begin(), [&]( uint64_t a, uint64_t b ) { return ( a ^ mask0 ) & ( b ^ mask1 ); } );
+      }
+      tt.mask_bits();
+    }
+    else
+    {
+      fanin_values.resize( ntk->fanin_size( n ) );
+      ntk->foreach_fanin( n, [&]( auto const& f, auto i ) {
+        fanin_values[i] = ( *this )[f];
+      } );
+      tt = ntk->compute( n, fanin_values.begin(), fanin_values.end() );
+    }
+  }
+
+private:
+  NtkWin const* ntk{ nullptr };
+  TT const& constant;
+  std::vector<TT> const& projections;
+  std::vector<TT> tts;
+  std::vector<TT> fanin_values;
+};
+
 template<typename NtkWin, typename TT>
 struct resyn_sparams : public xag_resyn_static_params
 {
-  using truth_table_storage_type = node_map<TT, NtkWin>;
+  using truth_table_storage_type = window_truth_tables<NtkWin, TT>;
   using node_type = typename NtkWin::signal;
   static constexpr bool use_xor = false;
 };
@@ -256,7 +375,7 @@ public:
       : ntk( ntk ), ps( ps ), st( st )
         /* initialize levels to network depth */
         ,
-        levels( ntk.depth() ), engine( engine_st )
+        levels( ntk.depth() ), tts( constant, projections ), engine( engine_st )
   {
     register_events();
   }
@@ -266,12 +385,18 @@ public:
     ntk.events().release_add_event( add_event );
     ntk.events().release_modified_event( modified_event );
     ntk.events().release_delete_event( delete_event );
+    if ( ps.reuse_windows )
+    {
+      ntk.events().release_modified_event( reuse_modified_event );
+      ntk.events().release_delete_event( reuse_delete_event );
+    }
   }
 
   void run()
   {
     stopwatch t( st.time_total );
 
+    /* the truth tables of constants and window inputs are the same in all windows */
     if constexpr ( std::is_same_v<TT, kitty::dynamic_truth_table> )
     {
       sim = new default_simulator<TT>( ps.cut_size );
@@ -280,6 +405,13 @@ public:
     {
       sim = new default_simulator<TT>();
     }
+    constant = sim->compute_constant( false );
+    care = ~constant;
+    projections.clear();
+    for ( auto i = 0u; i < ps.cut_size; ++i )
+    {
+      projections.emplace_back( sim->compute_pi( i ) );
+    }
 
     create_window_impl windowing( ntk );
     uint32_t const size = ntk.size();
@@ -294,17 +426,32 @@ public:
       {
         ++st.num_windows;
 
+        uint64_t key{ 0 };
+        if ( ps.reuse_windows )
+        {
+          key = window_key( *w );
+          if ( is_unchanged_window( key, *w ) )
+          {
+            ++st.num_reused_windows;
+            continue;
+          }
+        }
+
         NtkWin win;
         call_with_stopwatch( st.time_encode, [&]() {
-          clone_subnetwork( ntk, w->inputs, w->outputs, w->nodes, win );
+          clone_window( *w, win );
         } );
 
         if ( !optimize( win ) )
         {
+          if ( ps.reuse_windows )
+          {
+            cache_window( key, *w );
+          }
           continue;
         }
 
-        std::vector<signal> signals;
+        signals.clear();
         for ( auto const& i : w->inputs )
         {
           signals.push_back( ntk.make_signal( i ) );
@@ -409,6 +556,131 @@ private:
     add_event = ntk.events().register_add_event( update_level_of_new_node );
     modified_event = ntk.events().register_modified_event( update_level_of_existing_node );
     delete_event = ntk.events().register_delete_event( update_level_of_deleted_node );
+
+    if ( ps.reuse_windows )
+    {
+      /* invalidate the cached windows that contain modified or deleted nodes */
+      reuse_modified_event = ntk.events().register_modified_event( [&]( node const& n, const auto& old_children ) {
+        (void)old_children;
+        mark_modified( n );
+      } );
+      reuse_delete_event = ntk.events().register_delete_event( [&]( node const& n ) {
+        mark_modified( n );
+      } );
+    }
+  }
+
+  void mark_modified( node const& n )
+  {
+    auto const index = ntk.node_to_index( n );
+    if ( last_modified.size() <= index )
+    {
+      last_modified.resize( ntk.size(), 0u );
+    }
+    last_modified[index] = ++num_modifications;
+  }
+
+  uint64_t window_key( typename create_window_impl<Ntk>::window const& w ) const
+  {
+    uint64_t key = w.inputs.size();
+    auto const combine = [&key]( uint64_t value ) {
+      key ^= value + UINT64_C( 0x9e3779b97f4a7c15 ) + ( key << 6 ) + ( key >> 2 );
+    };
+    for ( auto const& n : w.inputs )
+    {
+      combine( ntk.node_to_index( n ) );
+    }
+    for ( auto const& n : w.nodes )
+    {
+      combine( ntk.node_to_index( n ) );
+    }
+    for ( auto const& f : w.outputs )
+    {
+      combine( ( ntk.node_to_index( ntk.get_node( f ) ) << 1 ) | ( ntk.is_complemented( f ) ? 1u : 0u ) );
+    }
+    return key;
+  }
+
+  /* whether the same window has been optimized without success and none of its nodes has been modified since then */
+  bool is_unchanged_window( uint64_t key, typename create_window_impl<Ntk>::window const& w ) const
+  {
+    auto const it = cached_windows.find( key );
+    if ( it == cached_windows.end() || it->second.inputs != w.inputs || it->second.nodes != w.nodes || it->second.outputs != w.outputs )
+    {
+      return false;
+    }
+
+    return std::all_of( w.nodes.begin(), w.nodes.end(), [&]( auto const& n ) {
+      auto const index = ntk.node_to_index( n );
+      return index >= last_modified.size() || last_modified[index] <= it->second.stamp;
+    } );
+  }
+
+  void cache_window( uint64_t key, typename create_window_impl<Ntk>::window& w )
+  {
+    auto& entry = cached_windows[key];
+    entry.stamp = num_modifications;
+    entry.inputs = std::move( w.inputs );
+    entry.nodes = std::move( w.nodes );
+    entry.outputs = std::move( w.outputs );
+  }
+
+  /* same as `clone_subnetwork`, but maps the nodes with a vector that is kept across windows */
+  void clone_window( typename create_window_impl<Ntk>::window const& w, NtkWin& win )
+  {
+    if ( cloned.size() < ntk.size() )
+    {
+      cloned.resize( ntk.size() );
+      cloned_stamp.resize( ntk.size(), 0u );
+    }
+    ++clone_stamp;
+
+    auto const set = [&]( node const& n, typename NtkWin::signal const& f ) {
+      cloned[ntk.node_to_index( n )] = f;
+      cloned_stamp[ntk.node_to_index( n )] = clone_stamp;
+    };
+
+    set( ntk.get_node( ntk.get_constant( false ) ), win.get_constant( false ) );
+    if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
+    {
+      set( ntk.get_node( ntk.get_constant( true ) ), win.get_constant( true ) );
+    }
+    for ( auto const& i : w.inputs )
+    {
+      set( i, win.create_pi() );
+    }
+    for ( auto const& g : w.nodes )
+    {
+      clone_node( win, g, 0u );
+    }
+    for ( auto const& o : w.outputs )
+    {
+      auto const f = cloned[ntk.node_to_index( ntk.get_node( o ) )];
+      win.create_po( ntk.is_complemented( o ) ? win.create_not( f ) : f );
+    }
+  }
+
+  typename NtkWin::signal clone_node( NtkWin& win, node const& n, uint32_t depth )
+  {
+    auto const index = ntk.node_to_index( n );
+    if ( cloned_stamp[index] == clone_stamp )
+    {
+      return cloned[index];
+    }
+
+    /* the children are collected in one vector per recursion depth */
+    if ( clone_children.size() <= depth )
+    {
+      clone_children.resize( depth + 1u );
+    }
+    clone_children[depth].clear();
+    ntk.foreach_fanin( n, [&]( auto const& fi ) {
+      auto const f = clone_node( win, ntk.get_node( fi ), depth + 1u );
+      clone_children[depth].emplace_back( ntk.is_complemented( fi ) ? !f : f );
+    } );
+
+    cloned_stamp[index] = clone_stamp;
+    return cloned[index] = win.clone_node( ntk, n, clone_children[depth] );
   }
 
   bool optimize( NtkWin& win )
@@ -416,17 +688,12 @@ private:
     stopwatch t( st.time_optimize );
     bool changed = false;
 
-    node_map<TT, NtkWin> tts = call_with_stopwatch( st.time_simulate, [&]() {
-      return simulate_nodes<TT, NtkWin>( win, *sim );
+    call_with_stopwatch( st.time_simulate, [&]() {
+      tts.simulate( win );
     } );
     auto win_add_event = win.events().register_add_event( [&]( auto const& n ) {
       call_with_stopwatch( st.time_simulate, [&]() {
-        tts.resize();
-        std::vector<TT> fanin_values( win.fanin_size( n ) );
-        win.foreach_fanin( n, [&]( auto const& f, auto i ) {
-          fanin_values[i] = tts[f];
-        } );
-        tts[n] = win.compute( n, fanin_values.begin(), fanin_values.end() );
+        tts.simulate( n );
       } );
     } );
     fanout_view<NtkWin> fanout_win = make_with_stopwatch<fanout_view<NtkWin>, NtkWin&>( st.time_fanout_view, win );
@@ -437,7 +704,7 @@ private:
       if ( win.value( root ) != 1 )
       {
         win.set_value( root, 1 );
-        changed |= optimize_node( win, fanout_win, tts, root );
+        changed |= optimize_node( win, fanout_win, root );
       }
     } );
 
@@ -453,7 +720,7 @@ private:
           }
         } );
         if ( !all_fanin_is_pi )
-          changed |= optimize_node( win, fanout_win, tts, root );
+          changed |= optimize_node( win, fanout_win, root );
       }
     } );
 
@@ -461,13 +728,13 @@ private:
     return changed;
   }
 
-  bool optimize_node( NtkWin& win, fanout_view<NtkWin>& fanout_win, node_map<TT, NtkWin>& tts, typename NtkWin::node const& root )
+  bool optimize_node( NtkWin& win, fanout_view<NtkWin>& fanout_win, typename NtkWin::node const& root )
   {
     st.num_resyn_invokes++;
 
     auto mffc_size = call_with_stopwatch( st.time_mark, [&]() {
       /* mark MFFC */
-      std::vector<typename NtkWin::node> mffc;
+      mffc.clear();
       node_mffc_inside<NtkWin> mffc_mgr( win );
       auto mffc_size = mffc_mgr.run( root, {}, mffc );
       win.incr_trav_id();
@@ -487,7 +754,7 @@ private:
     } );
 
     /* add divisors (all nodes in the window except TFO and MFFC) */
-    std::vector<typename NtkWin::signal> divs;
+    divs.clear();
     call_with_stopwatch( st.time_add_divisor, [&]() {
       win.foreach_node( [&]( auto const& n ) {
         if ( win.visited( n ) != win.trav_id() )
@@ -504,7 +771,7 @@ private:
 
     /* run resynthesis */
     auto const il = call_with_stopwatch( st.time_resyn, [&]() {
-      return engine( tts[root], ~tts[win.get_constant( false )], divs.begin(), divs.end(), tts, mffc_size - 1 );
+      return engine( tts[root], care, divs.begin(), divs.end(), tts, mffc_size - 1 );
     } );
     if ( il )
     {
@@ -772,7 +1039,34 @@ private:
   std::shared_ptr<typename network_events<Ntk>::modified_event_type> modified_event;
   std::shared_ptr<typename network_events<Ntk>::delete_event_type> delete_event;
 
+  /* reused windows */
+  struct cached_window
+  {
+    uint64_t stamp;
+    std::vector<node> inputs;
+    std::vector<node> nodes;
+    std::vector<signal> outputs;
+  };
+  std::unordered_map<uint64_t, cached_window> cached_windows;
+  std::vector<uint64_t> last_modified;
+  uint64_t num_modifications{ 0 };
+  std::shared_ptr<typename network_events<Ntk>::modified_event_type> reuse_modified_event;
+  std::shared_ptr<typename network_events<Ntk>::delete_event_type> reuse_delete_event;
+
+  /* buffers kept across windows */
+  std::vector<typename NtkWin::signal> cloned;
+  std::vector<uint32_t> cloned_stamp;
+  uint32_t clone_stamp{ 0 };
+  std::vector<std::vector<typename NtkWin::signal>> clone_children;
+  std::vector<typename NtkWin::node> mffc;
+  std::vector<typename NtkWin::signal> divs;
+  std::vector<signal> signals;
+
   default_simulator<TT>* sim;
+  TT constant;
+  TT care;
+  std::vector<TT> projections;
+  window_truth_tables<NtkWin, TT> tts;
   typename ResynEngine::stats engine_st;
   ResynEngine engine;
 }; /* window_rewriting_impl */
@@ -0,0 +1,400 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file batch_reader.hpp
+  \brief Reads several network files concurrently
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <lorina/blif.hpp>
+#include <lorina/verilog.hpp>
+
+#include "../traits.hpp"
+#include "../utils/network_utils.hpp"
+#include "../utils/parallel_utils.hpp"
+#include "../utils/stopwatch.hpp"
+#include "aiger_reader.hpp"
+#include "blif_reader.hpp"
+#include "verilog_reader.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for batch_reader.
+ *
+ * The data structure `batch_reader_params` holds configurable parameters with
+ * default arguments for `batch_reader`.
+ */
+struct batch_reader_params
+{
+  /*! \brief Number of threads that parse files (0 = hardware concurrency). */
+  uint32_t num_threads{ 0u };
+
+  /*! \brief Return the networks in the order of the files.
+   *
+   * If false, networks are returned as soon as they have been parsed.
+   */
+  bool in_order{ true };
+
+  /*! \brief Maximum number of networks that are parsed or ready but not yet taken (0 = no limit).
+   *
+   * Limits the memory used by networks that have been read ahead.
+   */
+  uint32_t max_pending{ 0u };
+
+  /*! \brief Be verbose. */
+  bool verbose{ false };
+};
+
+/*! \brief A network read by batch_reader. */
+template<class Ntk>
+struct batch_reader_result
+{
+  /*! \brief Position of the file in the list of files. */
+  uint32_t index{ 0u };
+
+  /*! \brief Name of the file. */
+  std::string filename;
+
+  /*! \brief Whether the file could be read. */
+  bool success{ false };
+
+  /*! \brief The network. */
+  Ntk ntk;
+
+  /*! \brief Time to parse the file. */
+  stopwatch<>::duration time_parse{ 0 };
+
+  /*! \brief Approximate memory of the network storage in bytes. */
+  uint64_t memory{ 0u };
+
+  void report() const
+  {
+    fmt::print( "[i] {:<40} {:>6} {:>8.2f} secs {:>10.2f} MB\n", filename, success ? "ok" : "failed", to_seconds( time_parse ), memory / ( 1024.0 * 1024.0 ) );
+  }
+};
+
+namespace detail
+{
+
+enum class batch_file_format
+{
+  aiger,
+  ascii_aiger,
+  blif,
+  verilog,
+  unknown
+};
+
+inline batch_file_format batch_file_format_of( std::string_view filename )
+{
+  auto const ends_with = [&]( std::string_view ext ) {
+    return filename.size() >= ext.size() && filename.substr( filename.size() - ext.size() ) == ext;
+  };
+  if ( ends_with( ".aig" ) )
+  {
+    return batch_file_format::aiger;
+  }
+  if ( ends_with( ".aag" ) )
+  {
+    return batch_file_format::ascii_aiger;
+  }
+  if ( ends_with( ".blif" ) )
+  {
+    return batch_file_format::blif;
+  }
+  if ( ends_with( ".v" ) )
+  {
+    return batch_file_format::verilog;
+  }
+  return batch_file_format::unknown;
+}
+
+/* approximates the memory of the storage of a network */
+template<class Ntk>
+uint64_t network_storage_bytes( Ntk const& ntk )
+{
+  if constexpr ( !has_node_storage<Ntk>::value )
+  {
+    (void)ntk;
+    return 0u;
+  }
+  else
+  {
+    auto const& storage = *ntk._storage;
+    using storage_t = std::decay_t<decltype( storage )>;
+
+    uint64_t bytes = sizeof( storage_t );
+    bytes += storage.nodes.capacity() * sizeof( typename storage_t::node_type );
+    bytes += storage.inputs.capacity() * sizeof( storage.inputs[0] );
+    bytes += storage.outputs.capacity() * sizeof( storage.outputs[0] );
+    if constexpr ( has_storage_hash<storage_t>::value )
+    {
+      bytes += storage.hash.capacity() * ( sizeof( typename decltype( storage.hash )::value_type ) + 1u );
+    }
+    return bytes;
+  }
+}
+
+template<class Ntk>
+bool read_batch_file( std::string const& filename, Ntk& ntk )
+{
+  switch ( batch_file_format_of( filename ) )
+  {
+  case batch_file_format::aiger:
+  case batch_file_format::ascii_aiger:
+    if constexpr ( has_create_and_v<Ntk> && has_create_not_v<Ntk> )
+    {
+      aiger_reader<Ntk> reader( ntk );
+      auto const result = batch_file_format_of( filename ) == batch_file_format::aiger ? lorina::read_aiger( filename, reader ) : lorina::read_ascii_aiger( filename, reader );
+      return result == lorina::return_code::success;
+    }
+    break;
+  case batch_file_format::blif:
+    if constexpr ( has_create_node_v<Ntk> || has_create_cover_node_v<Ntk> )
+    {
+      return lorina::read_blif( filename, blif_reader<Ntk>( ntk ) ) == lorina::return_code::success;
+    }
+    break;
+  case batch_file_format::verilog:
+    if constexpr ( has_create_and_v<Ntk> && has_create_or_v<Ntk> && has_create_xor_v<Ntk> && has_create_ite_v<Ntk> && has_create_maj_v<Ntk> )
+    {
+      return lorina::read_verilog( filename, verilog_reader<Ntk>( ntk ) ) == lorina::return_code::success;
+    }
+    break;
+  default:
+    break;
+  }
+  return false;
+}
+
+} // namespace detail
+
+/*! \brief Reads a list of network files concurrently.
+ *
+ * The files are parsed on a pool of threads into independent networks, which
+ * are taken one after the other with `next`.  Parsing continues in the
+ * background while the caller processes a network, such that processing the
+ * first networks overlaps with parsing the remaining ones.
+ *
+ * The format is determined by the file extension: `.aig` (binary AIGER),
+ * `.aag` (ASCII AIGER), `.blif` (BLIF, for networks with `create_node` or
+ * `create_cover_node`) and `.v` (Verilog).  Files with other extensions, and
+ * files that cannot be parsed, are returned with `success` set to false.
+ * Each result contains the time to parse the file and an estimate of the
+ * memory of the network.
+ *
+ * Networks are returned in the order of the files, or as soon as they are
+ * parsed if `in_order` is false.  The number of networks that are read ahead
+ * can be limited with `max_pending`.  Destroying the reader stops parsing the
+ * files that have not been started.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      batch_reader<aig_network> reader( { "adder.aig", "bar.aig", "div.aig" } );
+      while ( auto result = reader.next() )
+      {
+        if ( result->success )
+        {
+          optimize( result->ntk );
+        }
+      }
+   \endverbatim
+ */
+template<class Ntk>
+class batch_reader
+{
+public:
+  using result_type = batch_reader_result<Ntk>;
+
+public:
+  explicit batch_reader( std::vector<std::string> filenames, batch_reader_params const& ps = {} )
+      : _filenames( std::move( filenames ) ), _ps( ps ), _results( _filenames.size() )
+  {
+    auto const num_threads = std::min<uint64_t>( resolve_num_threads( _ps.num_threads ), _filenames.size() );
+    _threads.reserve( num_threads );
+    for ( auto t = 0u; t < num_threads; ++t )
+    {
+      _threads.emplace_back( [this]() { work(); } );
+    }
+  }
+
+  batch_reader( batch_reader const& ) = delete;
+  batch_reader& operator=( batch_reader const& ) = delete;
+
+  ~batch_reader()
+  {
+    {
+      std::lock_guard<std::mutex> lock( _mutex );
+      _stop = true;
+    }
+    _can_start.notify_all();
+    for ( auto& t : _threads )
+    {
+      t.join();
+    }
+  }
+
+  /*! \brief Number of files. */
+  uint32_t size() const
+  {
+    return static_cast<uint32_t>( _filenames.size() );
+  }
+
+  /*! \brief Returns the next network.
+   *
+   * Blocks until the next network has been parsed.  Returns `std::nullopt`
+   * after all networks have been returned.
+   */
+  std::optional<result_type> next()
+  {
+    std::unique_lock<std::mutex> lock( _mutex );
+    if ( _num_taken == _filenames.size() )
+    {
+      return std::nullopt;
+    }
+
+    uint32_t index;
+    if ( _ps.in_order )
+    {
+      index = _num_taken;
+      _ready.wait( lock, [&]() { return _results[index].has_value(); } );
+    }
+    else
+    {
+      _ready.wait( lock, [&]() { return !_completed.empty(); } );
+      index = _completed.front();
+      _completed.pop_front();
+    }
+
+    std::optional<result_type> result;
+    result.swap( _results[index] );
+    ++_num_taken;
+    --_num_pending;
+    lock.unlock();
+    _can_start.notify_one();
+
+    if ( _ps.verbose )
+    {
+      result->report();
+    }
+    return result;
+  }
+
+  /*! \brief Calls a function on each network.
+   *
+   * Calls `fn( result )` for the remaining networks, in the order in which
+   * `next` returns them.
+   */
+  template<class Fn>
+  void foreach_network( Fn&& fn )
+  {
+    while ( auto result = next() )
+    {
+      fn( *result );
+    }
+  }
+
+private:
+  void work()
+  {
+    while ( true )
+    {
+      uint32_t index;
+      {
+        std::unique_lock<std::mutex> lock( _mutex );
+        _can_start.wait( lock, [&]() { return _stop || _ps.max_pending == 0u || _num_pending < _ps.max_pending; } );
+        if ( _stop || _num_started == _filenames.size() )
+        {
+          return;
+        }
+        index = _num_started++;
+        ++_num_pending;
+      }
+
+      result_type result;
+      result.index = index;
+      result.filename = _filenames[index];
+      try
+      {
+        stopwatch t( result.time_parse );
+        result.success = detail::read_batch_file( result.filename, result.ntk );
+      }
+      catch ( ... )
+      {
+        result.success = false;
+      }
+      result.memory = detail::network_storage_bytes( result.ntk );
+
+      {
+        std::lock_guard<std::mutex> lock( _mutex );
+        _results[index].emplace( std::move( result ) );
+        if ( !_ps.in_order )
+        {
+          _completed.push_back( index );
+        }
+      }
+      _ready.notify_all();
+    }
+  }
+
+private:
+  std::vector<std::string> const _filenames;
+  batch_reader_params const _ps;
+
+  std::mutex _mutex;
+  std::condition_variable _ready;
+  std::condition_variable _can_start;
+
+  std::vector<std::optional<result_type>> _results;
+  std::deque<uint32_t> _completed;
+  uint32_t _num_started{ 0u };
+  uint32_t _num_pending{ 0u };
+  uint32_t _num_taken{ 0u };
+  bool _stop{ false };
+
+  std::vector<std::thread> _threads;
+};
+
+} // namespace mockturtle
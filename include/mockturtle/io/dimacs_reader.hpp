@@ -32,7 +32,14 @@
 
 #pragma once
 
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "../traits.hpp"
+#include "../utils/file_utils.hpp"
 #include <lorina/dimacs.hpp>
 
 namespace mockturtle
@@ -110,4 +117,274 @@ private:
   mutable std::vector<signal<Ntk>> _sums;
 };
 
+namespace detail
+{
+
+class dimacs_parser
+{
+public:
+  dimacs_parser( std::string_view contents, lorina::dimacs_reader const& reader, lorina::diagnostic_engine* diag )
+      : _start( contents.data() ),
+        _pos( contents.data() ),
+        _end( contents.data() + contents.size() ),
+        _reader( reader ),
+        _diag( diag )
+  {
+  }
+
+  lorina::return_code run()
+  {
+    bool found_spec = false;
+    std::vector<int> clause;
+
+    while ( true )
+    {
+      skip_whitespace();
+      if ( _pos == _end || *_pos == '%' )
+      {
+        break;
+      }
+
+      if ( *_pos == 'c' )
+      {
+        skip_line();
+        continue;
+      }
+
+      if ( *_pos == 'p' )
+      {
+        if ( found_spec || !clause.empty() || !parse_spec() )
+        {
+          return parse_error();
+        }
+        found_spec = true;
+        continue;
+      }
+
+      if ( !found_spec )
+      {
+        if ( _diag )
+        {
+          _diag->report( lorina::diag_id::ERR_DIMACS_MISSING_SPEC );
+        }
+        return lorina::return_code::parse_error;
+      }
+
+      int64_t lit;
+      if ( !parse_int( lit ) || lit > std::numeric_limits<int>::max() || lit < -std::numeric_limits<int>::max() )
+      {
+        return parse_error();
+      }
+
+      if ( lit == 0 )
+      {
+        _reader.on_clause( clause );
+        clause.clear();
+      }
+      else
+      {
+        clause.push_back( static_cast<int>( lit ) );
+      }
+    }
+
+    /* tolerate a missing terminating 0 after the last clause */
+    if ( !clause.empty() )
+    {
+      _reader.on_clause( clause );
+    }
+
+    _reader.on_end();
+    return lorina::return_code::success;
+  }
+
+private:
+  static bool is_whitespace( char c )
+  {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+  }
+
+  void skip_whitespace()
+  {
+    while ( _pos != _end && is_whitespace( *_pos ) )
+    {
+      ++_pos;
+    }
+  }
+
+  void skip_blanks()
+  {
+    while ( _pos != _end && ( *_pos == ' ' || *_pos == '\t' ) )
+    {
+      ++_pos;
+    }
+  }
+
+  void skip_line()
+  {
+    while ( _pos != _end && *_pos != '\n' )
+    {
+      ++_pos;
+    }
+  }
+
+  bool parse_uint( uint64_t& value )
+  {
+    if ( _pos == _end || *_pos < '0' || *_pos > '9' )
+    {
+      return false;
+    }
+    value = 0u;
+    while ( _pos != _end && *_pos >= '0' && *_pos <= '9' )
+    {
+      value = value * 10u + static_cast<uint64_t>( *_pos++ - '0' );
+      if ( value > std::numeric_limits<uint32_t>::max() )
+      {
+        return false;
+      }
+    }
+    return _pos == _end || is_whitespace( *_pos );
+  }
+
+  bool parse_int( int64_t& value )
+  {
+    bool const negative = *_pos == '-';
+    if ( negative )
+    {
+      ++_pos;
+    }
+    uint64_t magnitude;
+    if ( !parse_uint( magnitude ) )
+    {
+      return false;
+    }
+    value = negative ? -static_cast<int64_t>( magnitude ) : static_cast<int64_t>( magnitude );
+    return true;
+  }
+
+  /* p cnf <variables> <clauses> */
+  bool parse_spec()
+  {
+    ++_pos;
+    skip_blanks();
+    auto const format_begin = _pos;
+    while ( _pos != _end && !is_whitespace( *_pos ) )
+    {
+      ++_pos;
+    }
+    std::string const format( format_begin, _pos );
+    if ( format != "cnf" && format != "dnf" )
+    {
+      return false;
+    }
+
+    uint64_t num_vars, num_clauses;
+    skip_blanks();
+    if ( !parse_uint( num_vars ) )
+    {
+      return false;
+    }
+    skip_blanks();
+    if ( !parse_uint( num_clauses ) )
+    {
+      return false;
+    }
+    skip_blanks();
+    if ( _pos != _end && *_pos != '\n' && *_pos != '\r' )
+    {
+      return false;
+    }
+
+    _reader.on_format( format );
+    _reader.on_number_of_variables( num_vars );
+    _reader.on_number_of_clauses( num_clauses );
+    return true;
+  }
+
+  lorina::return_code parse_error()
+  {
+    if ( _diag )
+    {
+      /* report the line in which the error occurred */
+      auto const line_begin = begin_of_line();
+      auto line_end = _pos;
+      while ( line_end != _end && *line_end != '\n' )
+      {
+        ++line_end;
+      }
+      _diag->report( lorina::diag_id::ERR_PARSE_LINE ).add_argument( std::string( line_begin, line_end ) );
+    }
+    return lorina::return_code::parse_error;
+  }
+
+  char const* begin_of_line() const
+  {
+    auto it = _pos;
+    while ( it != _start && *( it - 1 ) != '\n' )
+    {
+      --it;
+    }
+    return it;
+  }
+
+private:
+  char const* _start;
+  char const* _pos;
+  char const* _end;
+  lorina::dimacs_reader const& _reader;
+  lorina::diagnostic_engine* _diag;
+};
+
+} // namespace detail
+
+/*! \brief Reads DIMACS format from a memory buffer.
+ *
+ * A hand-written parser that invokes the same callbacks of a
+ * `lorina::dimacs_reader` as `lorina::read_dimacs`, but scans the buffer
+ * directly instead of matching regular expressions line by line.  Clauses may
+ * span several lines, and a `%` character ends the input.
+ *
+ * \param contents DIMACS contents
+ * \param reader A DIMACS reader with callback methods invoked for parsed primitives
+ * \param diag An optional diagnostic engine with callback methods for parse errors
+ * \return Success if parsing has been successful, or parse error if parsing has failed
+ */
+[[nodiscard]] inline lorina::return_code read_dimacs_buffer( std::string_view contents, lorina::dimacs_reader const& reader, lorina::diagnostic_engine* diag = nullptr )
+{
+  return detail::dimacs_parser( contents, reader, diag ).run();
+}
+
+/*! \brief Reads a DIMACS file through a memory mapping.
+ *
+ * Maps the file into memory (see `mapped_file`) and parses it with
+ * `read_dimacs_buffer`.  This is the preferred way to read large CNF files.
+
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      xag_network xag;
+      read_dimacs_mmap( "file.cnf", dimacs_reader( xag ) );
+   \endverbatim
+ *
+ * \param filename Name of the file
+ * \param reader A DIMACS reader with callback methods invoked for parsed primitives
+ * \param diag An optional diagnostic engine with callback methods for parse errors
+ * \return Success if parsing has been successful, or parse error if parsing has failed
+ */
+[[nodiscard]] inline lorina::return_code read_dimacs_mmap( std::string const& filename, lorina::dimacs_reader const& reader, lorina::diagnostic_engine* diag = nullptr )
+{
+  mapped_file file( filename );
+  if ( !file.is_open() )
+  {
+    if ( diag )
+    {
+      diag->report( lorina::diag_id::ERR_FILE_OPEN ).add_argument( filename );
+    }
+    return lorina::return_code::parse_error;
+  }
+  return read_dimacs_buffer( file.view(), reader, diag );
+}
+
 } /* namespace mockturtle */
\ No newline at end of file
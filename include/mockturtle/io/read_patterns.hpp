@@ -0,0 +1,192 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file read_patterns.hpp
+  \brief Read simulation patterns in binary format
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <kitty/partial_truth_table.hpp>
+
+#include "../utils/file_utils.hpp"
+
+namespace mockturtle
+{
+
+namespace detail
+{
+
+/*! \brief Header of a binary simulation pattern file.
+ *
+ * A binary pattern file starts with this header, followed by `num_chunks`
+ * chunks.  Each chunk starts with its number of patterns `n` as a 64-bit word,
+ * followed by `ceil(n / 64)` 64-bit words for each primary input, primary
+ * input after primary input.  The patterns of a primary input are the
+ * concatenation of its words over all chunks.  Words are stored in the byte
+ * order of the machine that wrote the file.
+ *
+ * Writing a file produces a single chunk; appending patterns adds a chunk and
+ * updates the header.
+ */
+struct binary_patterns_header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t num_pis;
+  uint64_t num_patterns;
+  uint64_t num_chunks;
+};
+
+inline constexpr char binary_patterns_magic[8] = { 'M', 'T', 'P', 'A', 'T', 'T', 'R', 'N' };
+inline constexpr uint32_t binary_patterns_version = 1u;
+
+inline bool is_binary_patterns_header( binary_patterns_header const& header )
+{
+  return std::memcmp( header.magic, binary_patterns_magic, sizeof( binary_patterns_magic ) ) == 0 && header.version == binary_patterns_version;
+}
+
+inline binary_patterns_header make_binary_patterns_header( uint32_t num_pis, uint64_t num_patterns, uint64_t num_chunks )
+{
+  binary_patterns_header header;
+  std::memcpy( header.magic, binary_patterns_magic, sizeof( binary_patterns_magic ) );
+  header.version = binary_patterns_version;
+  header.num_pis = num_pis;
+  header.num_patterns = num_patterns;
+  header.num_chunks = num_chunks;
+  return header;
+}
+
+/* appends `num_bits` bits, stored in words, to a partial truth table */
+inline void append_pattern_words( kitty::partial_truth_table& tt, char const* words, uint64_t num_bits )
+{
+  auto const num_words = ( num_bits + 63u ) / 64u;
+  auto const offset = tt.num_bits();
+  if ( num_bits == 0u )
+  {
+    return;
+  }
+  if ( ( offset & 0x3f ) == 0 )
+  {
+    tt.resize( static_cast<int>( offset + num_bits ) );
+    std::memcpy( &*( tt.begin() + ( offset >> 6 ) ), words, num_words * sizeof( uint64_t ) );
+    tt.mask_bits();
+    return;
+  }
+
+  for ( auto i = 0u; i < num_words; ++i )
+  {
+    uint64_t word;
+    std::memcpy( &word, words + i * sizeof( uint64_t ), sizeof( uint64_t ) );
+    auto const bits = static_cast<int>( std::min<uint64_t>( 64u, num_bits - i * 64u ) );
+    if ( bits < 64 )
+    {
+      word &= UINT64_MAX >> ( 64 - bits );
+    }
+    tt.add_bits( word, bits );
+  }
+}
+
+} // namespace detail
+
+/*! \brief Reads simulation patterns from a binary pattern file.
+ *
+ * The file is mapped into memory (see `mapped_file`) and the pattern words
+ * are copied into the truth tables without parsing.  Binary pattern files
+ * are written by `write_binary_patterns` and `append_binary_patterns`.
+ *
+ * The `partial_simulator` constructor that takes a filename detects binary
+ * pattern files and reads them with this function.
+ *
+ * \param filename Name of the pattern file
+ * \param patterns Patterns of each primary input (replaced)
+ * \return Whether the file is a valid binary pattern file
+ */
+inline bool read_binary_patterns( std::string const& filename, std::vector<kitty::partial_truth_table>& patterns )
+{
+  mapped_file file( filename );
+  if ( !file.is_open() || file.size() < sizeof( detail::binary_patterns_header ) )
+  {
+    return false;
+  }
+
+  detail::binary_patterns_header header;
+  std::memcpy( &header, file.data(), sizeof( header ) );
+  if ( !detail::is_binary_patterns_header( header ) )
+  {
+    return false;
+  }
+
+  /* check the chunk sizes before allocating the patterns */
+  std::size_t pos = sizeof( header );
+  uint64_t num_patterns = 0u;
+  for ( auto c = 0u; c < header.num_chunks; ++c )
+  {
+    uint64_t chunk_patterns;
+    if ( file.size() - pos < sizeof( uint64_t ) )
+    {
+      return false;
+    }
+    std::memcpy( &chunk_patterns, file.data() + pos, sizeof( uint64_t ) );
+    auto const chunk_size = header.num_pis * ( ( chunk_patterns + 63u ) / 64u ) * sizeof( uint64_t );
+    if ( ( file.size() - pos - sizeof( uint64_t ) ) < chunk_size )
+    {
+      return false;
+    }
+    pos += sizeof( uint64_t ) + chunk_size;
+    num_patterns += chunk_patterns;
+  }
+  if ( num_patterns != header.num_patterns )
+  {
+    return false;
+  }
+
+  patterns.assign( header.num_pis, kitty::partial_truth_table() );
+  pos = sizeof( header );
+  for ( auto c = 0u; c < header.num_chunks; ++c )
+  {
+    uint64_t chunk_patterns;
+    std::memcpy( &chunk_patterns, file.data() + pos, sizeof( uint64_t ) );
+    pos += sizeof( uint64_t );
+
+    auto const num_words = ( chunk_patterns + 63u ) / 64u;
+    for ( auto& tt : patterns )
+    {
+      detail::append_pattern_words( tt, file.data() + pos, chunk_patterns );
+      pos += num_words * sizeof( uint64_t );
+    }
+  }
+
+  return true;
+}
+
+} /* namespace mockturtle */
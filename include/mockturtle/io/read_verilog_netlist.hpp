@@ -0,0 +1,1228 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file read_verilog_netlist.hpp
+  \brief Direct reader for structural Verilog netlists
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/operations.hpp>
+#include <lorina/diagnostics.hpp>
+#include <parallel_hashmap/phmap.h>
+
+#include "../traits.hpp"
+#include "../utils/file_utils.hpp"
+#include "../utils/stopwatch.hpp"
+#include "genlib_reader.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for read_verilog_netlist.
+ *
+ * The data structure `read_verilog_netlist_params` holds configurable
+ * parameters with default arguments for `read_verilog_netlist`.
+ */
+struct read_verilog_netlist_params
+{
+  /*! \brief Name of the module to read.
+   *
+   * If not set, the first module in the file is read.  All other modules are
+   * skipped.
+   */
+  std::optional<std::string> module_name{ std::nullopt };
+
+  /*! \brief Be verbose. */
+  bool verbose{ false };
+};
+
+/*! \brief Statistics for read_verilog_netlist.
+ *
+ * The data structure `read_verilog_netlist_stats` provides data collected by
+ * running `read_verilog_netlist`.
+ */
+struct read_verilog_netlist_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{ 0 };
+
+  /*! \brief Runtime for tokenizing and parsing. */
+  stopwatch<>::duration time_parse{ 0 };
+
+  /*! \brief Number of assign statements. */
+  uint32_t num_assigns{ 0u };
+
+  /*! \brief Number of cell instances. */
+  uint32_t num_instances{ 0u };
+
+  /*! \brief Number of distinct identifiers. */
+  uint32_t num_identifiers{ 0u };
+
+  void report() const
+  {
+    fmt::print( "[i] assigns = {}   instances = {}   identifiers = {}\n", num_assigns, num_instances, num_identifiers );
+    fmt::print( "[i] total time = {:>5.2f} secs (parse = {:>5.2f} secs)\n", to_seconds( time_total ), to_seconds( time_parse ) );
+  }
+};
+
+namespace detail
+{
+
+/* Tokenizer over a contiguous buffer.  Tokens are views into the buffer, and
+ * bit-selects such as `x[3]` are part of the identifier. */
+class verilog_netlist_lexer
+{
+public:
+  enum class kind : uint8_t
+  {
+    identifier,
+    number,
+    symbol,
+    end
+  };
+
+  struct token
+  {
+    kind type{ kind::end };
+    std::string_view text;
+  };
+
+public:
+  explicit verilog_netlist_lexer( std::string_view contents )
+      : _begin( contents.data() ),
+        _pos( contents.data() ),
+        _end( contents.data() + contents.size() )
+  {
+  }
+
+  token next()
+  {
+    skip_whitespace_and_comments();
+    if ( _pos == _end )
+    {
+      return { kind::end, {} };
+    }
+
+    _token_begin = _pos;
+    char const c = *_pos;
+    if ( is_identifier_start( c ) )
+    {
+      while ( _pos != _end && is_identifier_char( *_pos ) )
+      {
+        ++_pos;
+      }
+      read_bit_select();
+      return { kind::identifier, view() };
+    }
+    if ( c == '\\' )
+    {
+      /* escaped identifier up to the next whitespace */
+      ++_pos;
+      while ( _pos != _end && !is_whitespace( *_pos ) )
+      {
+        ++_pos;
+      }
+      return { kind::identifier, std::string_view( _token_begin + 1, _pos - _token_begin - 1 ) };
+    }
+    if ( c >= '0' && c <= '9' )
+    {
+      while ( _pos != _end && ( is_identifier_char( *_pos ) || *_pos == '\'' ) )
+      {
+        ++_pos;
+      }
+      return { kind::number, view() };
+    }
+
+    ++_pos;
+    return { kind::symbol, view() };
+  }
+
+  /* line of the most recent token, counted on demand for error messages */
+  std::string_view current_line() const
+  {
+    auto line_begin = _token_begin;
+    while ( line_begin != _begin && *( line_begin - 1 ) != '\n' )
+    {
+      --line_begin;
+    }
+    auto line_end = _token_begin;
+    while ( line_end != _end && *line_end != '\n' )
+    {
+      ++line_end;
+    }
+    return std::string_view( line_begin, line_end - line_begin );
+  }
+
+private:
+  static bool is_whitespace( char c )
+  {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+  }
+
+  static bool is_identifier_start( char c )
+  {
+    return ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) || c == '_';
+  }
+
+  static bool is_identifier_char( char c )
+  {
+    return is_identifier_start( c ) || ( c >= '0' && c <= '9' ) || c == '$';
+  }
+
+  std::string_view view() const
+  {
+    return std::string_view( _token_begin, _pos - _token_begin );
+  }
+
+  void read_bit_select()
+  {
+    if ( _pos == _end || *_pos != '[' )
+    {
+      return;
+    }
+    auto it = _pos + 1;
+    while ( it != _end && *it >= '0' && *it <= '9' )
+    {
+      ++it;
+    }
+    if ( it != _pos + 1 && it != _end && *it == ']' )
+    {
+      _pos = it + 1;
+    }
+  }
+
+  void skip_whitespace_and_comments()
+  {
+    while ( _pos != _end )
+    {
+      if ( is_whitespace( *_pos ) )
+      {
+        ++_pos;
+      }
+      else if ( *_pos == '/' && _pos + 1 != _end && _pos[1] == '/' )
+      {
+        while ( _pos != _end && *_pos != '\n' )
+        {
+          ++_pos;
+        }
+      }
+      else if ( *_pos == '/' && _pos + 1 != _end && _pos[1] == '*' )
+      {
+        _pos += 2;
+        while ( _pos != _end && !( *_pos == '*' && _pos + 1 != _end && _pos[1] == '/' ) )
+        {
+          ++_pos;
+        }
+        _pos = _pos == _end ? _end : _pos + 2;
+      }
+      else
+      {
+        break;
+      }
+    }
+  }
+
+private:
+  char const* _begin;
+  char const* _pos;
+  char const* _end;
+  char const* _token_begin{ nullptr };
+};
+
+template<class Ntk>
+class read_verilog_netlist_impl
+{
+public:
+  using signal = typename Ntk::signal;
+  using token = typename verilog_netlist_lexer::token;
+  using token_kind = typename verilog_netlist_lexer::kind;
+
+  enum class expr_kind : uint8_t
+  {
+    net,
+    const0,
+    const1,
+    not_,
+    and_,
+    or_,
+    xor_,
+    ite
+  };
+
+  /* expression node; children are indexes into `_exprs` */
+  struct expr
+  {
+    expr_kind kind;
+    uint32_t args[3];
+  };
+
+  /* assign (gate = unused) or output pin of a cell instance */
+  struct statement
+  {
+    uint32_t output;
+    uint32_t begin;
+    uint32_t end;
+    uint32_t gate;
+  };
+
+  static constexpr uint32_t no_gate = std::numeric_limits<uint32_t>::max();
+  static constexpr uint32_t undefined = std::numeric_limits<uint32_t>::max();
+
+public:
+  read_verilog_netlist_impl( Ntk& ntk, std::string_view contents, read_verilog_netlist_params const& ps, read_verilog_netlist_stats& st, lorina::diagnostic_engine* diag )
+      : _ntk( ntk ),
+        _lexer( contents ),
+        _ps( ps ),
+        _st( st ),
+        _diag( diag )
+  {
+    /* constants are the first two nets */
+    intern( "1'b0" );
+    intern( "1'b1" );
+
+    if constexpr ( has_add_binding_v<Ntk> && has_create_node_v<Ntk> )
+    {
+      for ( auto const& g : _ntk.get_library() )
+      {
+        _cells.try_emplace( std::string_view( g.name ), g.id );
+      }
+    }
+  }
+
+  lorina::return_code run()
+  {
+    stopwatch t( _st.time_total );
+
+    bool parsed;
+    {
+      stopwatch t_parse( _st.time_parse );
+      parsed = parse();
+    }
+    if ( !parsed )
+    {
+      return lorina::return_code::parse_error;
+    }
+    _st.num_identifiers = static_cast<uint32_t>( _names.size() );
+
+    if ( !build() )
+    {
+      return lorina::return_code::parse_error;
+    }
+    return lorina::return_code::success;
+  }
+
+private:
+#pragma region Parsing
+  bool parse()
+  {
+    _current = _lexer.next();
+    bool found = false;
+    while ( _current.type != token_kind::end )
+    {
+      if ( !is_keyword( "module" ) )
+      {
+        return error( "expected module" );
+      }
+      advance();
+      if ( _current.type != token_kind::identifier )
+      {
+        return error( "expected module name" );
+      }
+
+      if ( found || ( _ps.module_name && *_ps.module_name != _current.text ) )
+      {
+        skip_module();
+        continue;
+      }
+
+      found = true;
+      if constexpr ( has_set_network_name_v<Ntk> )
+      {
+        _ntk.set_network_name( std::string( _current.text ) );
+      }
+      advance();
+      if ( !skip_past( ';' ) || !parse_module_body() )
+      {
+        return false;
+      }
+    }
+
+    if ( !found )
+    {
+      return error( "module not found" );
+    }
+    return true;
+  }
+
+  void skip_module()
+  {
+    while ( _current.type != token_kind::end && !is_keyword( "endmodule" ) )
+    {
+      advance();
+    }
+    advance();
+  }
+
+  bool parse_module_body()
+  {
+    while ( true )
+    {
+      if ( _current.type != token_kind::identifier )
+      {
+        return error( "expected statement" );
+      }
+
+      if ( is_keyword( "endmodule" ) )
+      {
+        advance();
+        return true;
+      }
+      else if ( is_keyword( "input" ) )
+      {
+        if ( !parse_declaration( _inputs ) )
+          return false;
+      }
+      else if ( is_keyword( "output" ) )
+      {
+        if ( !parse_declaration( _outputs ) )
+          return false;
+      }
+      else if ( is_keyword( "wire" ) )
+      {
+        if ( !skip_past( ';' ) )
+          return false;
+      }
+      else if ( is_keyword( "assign" ) )
+      {
+        if ( !parse_assign() )
+          return false;
+      }
+      else
+      {
+        if ( !parse_instance() )
+          return false;
+      }
+    }
+  }
+
+  /* input|output [msb:0] name, name, ... ; */
+  bool parse_declaration( std::vector<uint32_t>& ids )
+  {
+    advance();
+    uint32_t width = 1u;
+    bool is_vector = false;
+    if ( is_symbol( '[' ) )
+    {
+      advance();
+      uint64_t msb, lsb;
+      if ( !parse_uint( msb ) || !expect( ':' ) || !parse_uint( lsb ) || lsb != 0u || !expect( ']' ) )
+      {
+        return error( "unsupported range" );
+      }
+      width = static_cast<uint32_t>( msb + 1u );
+      is_vector = true;
+    }
+
+    while ( true )
+    {
+      if ( _current.type != token_kind::identifier )
+      {
+        return error( "expected identifier" );
+      }
+      if ( is_vector )
+      {
+        for ( auto i = 0u; i < width; ++i )
+        {
+          _owned_names.emplace_back( fmt::format( "{}[{}]", _current.text, i ) );
+          ids.push_back( intern( _owned_names.back() ) );
+        }
+      }
+      else
+      {
+        ids.push_back( intern( _current.text ) );
+      }
+      advance();
+      if ( is_symbol( ';' ) )
+      {
+        advance();
+        return true;
+      }
+      if ( !expect( ',' ) )
+      {
+        return false;
+      }
+    }
+  }
+
+  /* assign lhs = expr ; */
+  bool parse_assign()
+  {
+    advance();
+    if ( _current.type != token_kind::identifier )
+    {
+      return error( "expected identifier" );
+    }
+    auto const lhs = intern( _current.text );
+    advance();
+    if ( !expect( '=' ) )
+    {
+      return false;
+    }
+
+    auto const begin = static_cast<uint32_t>( _exprs.size() );
+    if ( !parse_ternary() || !expect( ';' ) )
+    {
+      return false;
+    }
+    ++_st.num_assigns;
+    return add_statement( lhs, begin, static_cast<uint32_t>( _exprs.size() ), no_gate );
+  }
+
+  /* cell instance( .pin (net), ... ); */
+  bool parse_instance()
+  {
+    if constexpr ( has_add_binding_v<Ntk> && has_create_node_v<Ntk> )
+    {
+      auto const cell_name = _current.text;
+      auto const it = _cells.find( cell_name );
+      if ( it == _cells.end() )
+      {
+        return error( "unknown cell" );
+      }
+      auto const& library = _ntk.get_library();
+      auto const& cell = library[it->second];
+
+      advance();
+      if ( _current.type != token_kind::identifier )
+      {
+        return error( "expected instance name" );
+      }
+      advance();
+      if ( !expect( '(' ) )
+      {
+        return false;
+      }
+
+      _pin_nets.assign( cell.pins.size(), undefined );
+      _output_pins.clear();
+      while ( !is_symbol( ')' ) )
+      {
+        if ( !expect( '.' ) || _current.type != token_kind::identifier )
+        {
+          return error( "expected named port connection" );
+        }
+        auto const pin_name = _current.text;
+        advance();
+        if ( !expect( '(' ) )
+        {
+          return false;
+        }
+        uint32_t net;
+        if ( !parse_net( net ) || !expect( ')' ) )
+        {
+          return false;
+        }
+
+        auto const pin = std::find_if( cell.pins.begin(), cell.pins.end(), [&]( auto const& p ) { return p.name == pin_name; } );
+        if ( pin != cell.pins.end() )
+        {
+          _pin_nets[std::distance( cell.pins.begin(), pin )] = net;
+        }
+        else
+        {
+          _output_pins.emplace_back( pin_name, net );
+        }
+
+        if ( !is_symbol( ')' ) && !expect( ',' ) )
+        {
+          return false;
+        }
+      }
+      advance();
+      if ( !expect( ';' ) )
+      {
+        return false;
+      }
+
+      if ( std::find( _pin_nets.begin(), _pin_nets.end(), undefined ) != _pin_nets.end() )
+      {
+        return error( "unconnected input pin" );
+      }
+
+      /* one statement per output pin; multi-output cells are gates with the same name */
+      ++_st.num_instances;
+      auto const begin = static_cast<uint32_t>( _exprs.size() );
+      for ( auto net : _pin_nets )
+      {
+        _exprs.push_back( { expr_kind::net, { net, 0u, 0u } } );
+      }
+      for ( auto const& [pin_name, net] : _output_pins )
+      {
+        uint32_t gate_id = no_gate;
+        for ( auto id = it->second; id < library.size() && library[id].name == cell_name; ++id )
+        {
+          if ( library[id].output_name == pin_name )
+          {
+            gate_id = id;
+            break;
+          }
+        }
+        if ( gate_id == no_gate || library[gate_id].pins.size() != cell.pins.size() )
+        {
+          return error( fmt::format( "unknown pin {}", pin_name ) );
+        }
+        if ( !add_statement( net, begin, static_cast<uint32_t>( _exprs.size() ), gate_id ) )
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+    else
+    {
+      return error( "cell instances require a network with bindings" );
+    }
+  }
+
+  /* ternary := or [ '?' ternary ':' ternary ] */
+  bool parse_ternary()
+  {
+    if ( !parse_binary( 0u ) )
+    {
+      return false;
+    }
+    if ( !is_symbol( '?' ) )
+    {
+      return true;
+    }
+    auto const cond = last_expr();
+    advance();
+    if ( !parse_ternary() )
+    {
+      return false;
+    }
+    auto const then_ = last_expr();
+    if ( !expect( ':' ) || !parse_ternary() )
+    {
+      return false;
+    }
+    _exprs.push_back( { expr_kind::ite, { cond, then_, last_expr() } } );
+    return true;
+  }
+
+  /* precedence levels: 0 = '|', 1 = '^', 2 = '&' */
+  bool parse_binary( uint32_t level )
+  {
+    static constexpr char ops[] = { '|', '^', '&' };
+    static constexpr expr_kind kinds[] = { expr_kind::or_, expr_kind::xor_, expr_kind::and_ };
+
+    if ( !( level == 2u ? parse_unary() : parse_binary( level + 1u ) ) )
+    {
+      return false;
+    }
+    while ( is_symbol( ops[level] ) )
+    {
+      auto const lhs = last_expr();
+      advance();
+      if ( !( level == 2u ? parse_unary() : parse_binary( level + 1u ) ) )
+      {
+        return false;
+      }
+      _exprs.push_back( { kinds[level], { lhs, last_expr(), 0u } } );
+    }
+    return true;
+  }
+
+  bool parse_unary()
+  {
+    if ( is_symbol( '~' ) || is_symbol( '!' ) )
+    {
+      advance();
+      if ( !parse_unary() )
+      {
+        return false;
+      }
+      _exprs.push_back( { expr_kind::not_, { last_expr(), 0u, 0u } } );
+      return true;
+    }
+    if ( is_symbol( '(' ) )
+    {
+      advance();
+      return parse_ternary() && expect( ')' );
+    }
+
+    uint32_t net;
+    if ( _current.type == token_kind::number )
+    {
+      bool value;
+      if ( !parse_constant( value ) )
+      {
+        return false;
+      }
+      _exprs.push_back( { value ? expr_kind::const1 : expr_kind::const0, { 0u, 0u, 0u } } );
+      return true;
+    }
+    if ( !parse_net( net ) )
+    {
+      return false;
+    }
+    _exprs.push_back( { expr_kind::net, { net, 0u, 0u } } );
+    return true;
+  }
+
+  /* identifier, or a constant which is mapped to a reserved net */
+  bool parse_net( uint32_t& net )
+  {
+    if ( _current.type == token_kind::number )
+    {
+      bool value;
+      if ( !parse_constant( value ) )
+      {
+        return false;
+      }
+      net = value ? 1u : 0u;
+      return true;
+    }
+    if ( _current.type != token_kind::identifier )
+    {
+      return error( "expected identifier" );
+    }
+    net = intern( _current.text );
+    advance();
+    return true;
+  }
+
+  /* 0, 1, 1'b0, 1'b1, 1'h0, 1'h1 */
+  bool parse_constant( bool& value )
+  {
+    auto text = _current.text;
+    if ( auto const quote = text.find( '\'' ); quote != std::string_view::npos )
+    {
+      text = text.substr( quote + 1u );
+      if ( text.empty() || ( text[0] != 'b' && text[0] != 'h' && text[0] != 'd' ) )
+      {
+        return error( "unsupported constant" );
+      }
+      text = text.substr( 1u );
+    }
+    if ( text != "0" && text != "1" )
+    {
+      return error( "unsupported constant" );
+    }
+    value = text == "1";
+    advance();
+    return true;
+  }
+
+  bool parse_uint( uint64_t& value )
+  {
+    if ( _current.type != token_kind::number )
+    {
+      return error( "expected number" );
+    }
+    value = 0u;
+    for ( auto c : _current.text )
+    {
+      if ( c < '0' || c > '9' )
+      {
+        return error( "expected number" );
+      }
+      value = value * 10u + static_cast<uint64_t>( c - '0' );
+    }
+    advance();
+    return true;
+  }
+
+  bool add_statement( uint32_t output, uint32_t begin, uint32_t end, uint32_t gate )
+  {
+    if ( _drivers[output] != undefined )
+    {
+      return error( "net has multiple drivers" );
+    }
+    _drivers[output] = static_cast<uint32_t>( _statements.size() );
+    _statements.push_back( { output, begin, end, gate } );
+    return true;
+  }
+
+  uint32_t intern( std::string_view name )
+  {
+    auto const [it, inserted] = _names.try_emplace( name, static_cast<uint32_t>( _drivers.size() ) );
+    if ( inserted )
+    {
+      _drivers.push_back( undefined );
+      _net_names.push_back( name );
+    }
+    return it->second;
+  }
+
+  uint32_t last_expr() const
+  {
+    return static_cast<uint32_t>( _exprs.size() - 1u );
+  }
+
+  void advance()
+  {
+    _current = _lexer.next();
+  }
+
+  bool is_keyword( std::string_view keyword ) const
+  {
+    return _current.type == token_kind::identifier && _current.text == keyword;
+  }
+
+  bool is_symbol( char c ) const
+  {
+    return _current.type == token_kind::symbol && _current.text[0] == c;
+  }
+
+  bool expect( char c )
+  {
+    if ( !is_symbol( c ) )
+    {
+      return error( fmt::format( "expected '{}'", c ) );
+    }
+    advance();
+    return true;
+  }
+
+  bool skip_past( char c )
+  {
+    while ( _current.type != token_kind::end && !is_symbol( c ) )
+    {
+      advance();
+    }
+    return expect( c );
+  }
+
+  bool error( std::string const& message )
+  {
+    if ( _diag )
+    {
+      _diag->report( lorina::diag_id::ERR_PARSE_LINE ).add_argument( std::string( _lexer.current_line() ) );
+    }
+    if ( _ps.verbose )
+    {
+      fmt::print( stderr, "[e] {} in line '{}'\n", message, _lexer.current_line() );
+    }
+    return false;
+  }
+#pragma endregion
+
+#pragma region Network construction
+  /* creates the statements in dependency order, independent of their order in the file */
+  bool build()
+  {
+    _signals.resize( _drivers.size() );
+    _status.assign( _drivers.size(), 0u );
+
+    define( 0u, _ntk.get_constant( false ) );
+    define( 1u, _ntk.get_constant( true ) );
+
+    for ( auto id : _inputs )
+    {
+      auto const s = _ntk.create_pi();
+      if constexpr ( has_set_name_v<Ntk> )
+      {
+        _ntk.set_name( s, std::string( name_of( id ) ) );
+      }
+      define( id, s );
+    }
+
+    for ( auto i = 0u; i < _statements.size(); ++i )
+    {
+      if ( !create_statement_cone( i ) )
+      {
+        return false;
+      }
+    }
+
+    for ( auto i = 0u; i < _outputs.size(); ++i )
+    {
+      auto const id = _outputs[i];
+      if ( _status[id] != 2u )
+      {
+        warn_undefined( id );
+      }
+      _ntk.create_po( _signals[id] );
+      if constexpr ( has_set_output_name_v<Ntk> )
+      {
+        _ntk.set_output_name( i, std::string( name_of( id ) ) );
+      }
+    }
+    return true;
+  }
+
+  void define( uint32_t id, signal const& s )
+  {
+    _signals[id] = s;
+    _status[id] = 2u;
+  }
+
+  /* iterative DFS over the statements driving the nets */
+  bool create_statement_cone( uint32_t root )
+  {
+    if ( _status[_statements[root].output] == 2u )
+    {
+      return true;
+    }
+
+    _stack.clear();
+    _stack.push_back( root );
+    _status[_statements[root].output] = 1u;
+    while ( !_stack.empty() )
+    {
+      auto const& stmt = _statements[_stack.back()];
+      bool ready = true;
+      for ( auto i = stmt.begin; i < stmt.end; ++i )
+      {
+        if ( _exprs[i].kind != expr_kind::net )
+        {
+          continue;
+        }
+        auto const net = _exprs[i].args[0];
+        if ( _status[net] == 2u )
+        {
+          continue;
+        }
+        if ( _status[net] == 1u )
+        {
+          if ( _ps.verbose )
+          {
+            fmt::print( stderr, "[e] combinational loop through {}\n", name_of( net ) );
+          }
+          return false;
+        }
+        if ( _drivers[net] == undefined )
+        {
+          warn_undefined( net );
+          define( net, _ntk.get_constant( false ) );
+          continue;
+        }
+        _status[net] = 1u;
+        _stack.push_back( _drivers[net] );
+        ready = false;
+        break;
+      }
+
+      if ( ready )
+      {
+        auto const index = _stack.back();
+        _stack.pop_back();
+        create_statement( _statements[index] );
+      }
+    }
+    return true;
+  }
+
+  void create_statement( statement const& stmt )
+  {
+    if ( stmt.gate == no_gate )
+    {
+      define( stmt.output, create_expr( stmt.end - 1u ) );
+      return;
+    }
+
+    if constexpr ( has_add_binding_v<Ntk> && has_create_node_v<Ntk> )
+    {
+      auto const& cell = _ntk.get_library()[stmt.gate];
+      signal s;
+      if ( cell.num_vars == 0u )
+      {
+        s = _ntk.get_constant( !kitty::is_const0( cell.function ) );
+      }
+      else
+      {
+        _children.clear();
+        for ( auto i = stmt.begin; i < stmt.end; ++i )
+        {
+          _children.push_back( _signals[_exprs[i].args[0]] );
+        }
+        s = _ntk.create_node( _children, cell.function );
+      }
+      _ntk.add_binding( _ntk.get_node( s ), stmt.gate );
+      define( stmt.output, s );
+    }
+  }
+
+  signal create_expr( uint32_t index )
+  {
+    auto const& e = _exprs[index];
+    switch ( e.kind )
+    {
+    case expr_kind::net:
+      return _signals[e.args[0]];
+    case expr_kind::const0:
+      return _ntk.get_constant( false );
+    case expr_kind::const1:
+      return _ntk.get_constant( true );
+    case expr_kind::not_:
+      return _ntk.create_not( create_expr( e.args[0] ) );
+    case expr_kind::and_:
+      return _ntk.create_and( create_expr( e.args[0] ), create_expr( e.args[1] ) );
+    case expr_kind::or_:
+    {
+      if ( auto const maj = create_maj( e ) )
+      {
+        return *maj;
+      }
+      return _ntk.create_or( create_expr( e.args[0] ), create_expr( e.args[1] ) );
+    }
+    case expr_kind::xor_:
+    {
+      if constexpr ( has_create_xor3_v<Ntk> )
+      {
+        /* ( a ^ b ) ^ c */
+        if ( _exprs[e.args[0]].kind == expr_kind::xor_ )
+        {
+          auto const& inner = _exprs[e.args[0]];
+          return _ntk.create_xor3( create_expr( inner.args[0] ), create_expr( inner.args[1] ), create_expr( e.args[1] ) );
+        }
+      }
+      return _ntk.create_xor( create_expr( e.args[0] ), create_expr( e.args[1] ) );
+    }
+    case expr_kind::ite:
+      return _ntk.create_ite( create_expr( e.args[0] ), create_expr( e.args[1] ), create_expr( e.args[2] ) );
+    }
+    return _ntk.get_constant( false );
+  }
+
+  /* literal of a leaf expression: net id and complement */
+  std::optional<std::pair<uint32_t, bool>> leaf_literal( uint32_t index ) const
+  {
+    auto const& e = _exprs[index];
+    if ( e.kind == expr_kind::net )
+    {
+      return std::make_pair( e.args[0], false );
+    }
+    if ( e.kind == expr_kind::not_ && _exprs[e.args[0]].kind == expr_kind::net )
+    {
+      return std::make_pair( _exprs[e.args[0]].args[0], true );
+    }
+    return std::nullopt;
+  }
+
+  /* recognizes ( a & b ) | ( a & c ) | ( b & c ) as written by write_verilog */
+  std::optional<signal> create_maj( expr const& e )
+  {
+    auto const& left = _exprs[e.args[0]];
+    if ( left.kind != expr_kind::or_ )
+    {
+      return std::nullopt;
+    }
+
+    std::array<uint32_t, 3> const terms = { left.args[0], left.args[1], e.args[1] };
+    std::array<std::pair<uint32_t, bool>, 6> lits;
+    for ( auto i = 0u; i < 3u; ++i )
+    {
+      auto const& t = _exprs[terms[i]];
+      if ( t.kind != expr_kind::and_ )
+      {
+        return std::nullopt;
+      }
+      auto const l0 = leaf_literal( t.args[0] );
+      auto const l1 = leaf_literal( t.args[1] );
+      if ( !l0 || !l1 )
+      {
+        return std::nullopt;
+      }
+      lits[2 * i] = *l0;
+      lits[2 * i + 1] = *l1;
+    }
+
+    /* terms must be ( a & b ), ( a & c ), ( b & c ) */
+    auto const a = lits[0], b = lits[1], c = lits[3];
+    if ( lits[2] != a || lits[4] != b || lits[5] != c || a.first == b.first || a.first == c.first || b.first == c.first )
+    {
+      return std::nullopt;
+    }
+
+    auto const literal = [&]( std::pair<uint32_t, bool> const& l ) {
+      return l.second ? _ntk.create_not( _signals[l.first] ) : _signals[l.first];
+    };
+    return _ntk.create_maj( literal( a ), literal( b ), literal( c ) );
+  }
+
+  void warn_undefined( uint32_t id ) const
+  {
+    fmt::print( stderr, "[w] undefined signal {} assigned 0\n", name_of( id ) );
+  }
+
+  std::string_view name_of( uint32_t id ) const
+  {
+    return _net_names[id];
+  }
+#pragma endregion
+
+private:
+  Ntk& _ntk;
+  verilog_netlist_lexer _lexer;
+  read_verilog_netlist_params const& _ps;
+  read_verilog_netlist_stats& _st;
+  lorina::diagnostic_engine* _diag;
+
+  token _current;
+
+  /* interned identifiers; views point into the input or into `_owned_names` */
+  phmap::flat_hash_map<std::string_view, uint32_t> _names;
+  std::deque<std::string> _owned_names;
+  std::vector<std::string_view> _net_names;
+  phmap::flat_hash_map<std::string_view, uint32_t> _cells;
+
+  std::vector<uint32_t> _inputs;
+  std::vector<uint32_t> _outputs;
+  std::vector<uint32_t> _drivers;
+  std::vector<expr> _exprs;
+  std::vector<statement> _statements;
+
+  std::vector<signal> _signals;
+  std::vector<uint8_t> _status;
+  std::vector<uint32_t> _stack;
+  std::vector<signal> _children;
+  std::vector<uint32_t> _pin_nets;
+  std::vector<std::pair<std::string_view, uint32_t>> _output_pins;
+};
+
+} // namespace detail
+
+/*! \brief Reads a structural Verilog netlist from a memory buffer.
+ *
+ * This is a direct reader for the structural subset of Verilog that is
+ * written by `write_verilog` and `write_verilog_with_binding`: `input`,
+ * `output` (including `[n:0]` ranges) and `wire` declarations, `assign`
+ * statements with expressions over `~`, `&`, `|`, `^`, `? :`, parentheses and
+ * constants, and cell instances with named port connections.  Cell instances
+ * require a network with bindings (e.g., `binding_view<klut_network>`) whose
+ * library contains the cells.
+ *
+ * Unlike `lorina::read_verilog` with `verilog_reader`, the buffer is scanned
+ * without copying tokens, identifiers are interned once, and the network is
+ * created directly.  Statements may appear in any order; the network is
+ * created in dependency order.  Majority expressions in the form written by
+ * `write_verilog` are recognized and created with `create_maj`.
+ *
+ * **Required network functions:**
+ * - `create_pi`
+ * - `create_po`
+ * - `get_constant`
+ * - `create_not`
+ * - `create_and`
+ * - `create_or`
+ * - `create_xor`
+ * - `create_ite`
+ * - `create_maj`
+ *
+ * \param contents Verilog contents
+ * \param ntk Network
+ * \param ps Parameters
+ * \param pst Statistics
+ * \param diag An optional diagnostic engine with callback methods for parse errors
+ * \return Success if parsing has been successful, or parse error if parsing has failed
+ */
+template<class Ntk>
+[[nodiscard]] lorina::return_code read_verilog_netlist_buffer( std::string_view contents, Ntk& ntk, read_verilog_netlist_params const& ps = {}, read_verilog_netlist_stats* pst = nullptr, lorina::diagnostic_engine* diag = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_create_pi_v<Ntk>, "Ntk does not implement the create_pi function" );
+  static_assert( has_create_po_v<Ntk>, "Ntk does not implement the create_po function" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant function" );
+  static_assert( has_create_not_v<Ntk>, "Ntk does not implement the create_not function" );
+  static_assert( has_create_and_v<Ntk>, "Ntk does not implement the create_and function" );
+  static_assert( has_create_or_v<Ntk>, "Ntk does not implement the create_or function" );
+  static_assert( has_create_xor_v<Ntk>, "Ntk does not implement the create_xor function" );
+  static_assert( has_create_ite_v<Ntk>, "Ntk does not implement the create_ite function" );
+  static_assert( has_create_maj_v<Ntk>, "Ntk does not implement the create_maj function" );
+
+  read_verilog_netlist_stats st;
+  detail::read_verilog_netlist_impl<Ntk> impl( ntk, contents, ps, st, diag );
+  auto const result = impl.run();
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+  return result;
+}
+
+/*! \brief Reads a structural Verilog netlist from a file.
+ *
+ * Maps the file into memory (see `mapped_file`) and reads it with
+ * `read_verilog_netlist_buffer`.
+
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      names_view<xag_network> xag;
+      read_verilog_netlist( "file.v", xag );
+
+      std::vector<gate> gates;
+      lorina::read_genlib( "library.genlib", genlib_reader( gates ) );
+      binding_view<klut_network> netlist( gates );
+      read_verilog_netlist( "mapped.v", netlist );
+   \endverbatim
+ *
+ * \param filename Name of the file
+ * \param ntk Network
+ * \param ps Parameters
+ * \param pst Statistics
+ * \param diag An optional diagnostic engine with callback methods for parse errors
+ * \return Success if parsing has been successful, or parse error if parsing has failed
+ */
+template<class Ntk>
+[[nodiscard]] lorina::return_code read_verilog_netlist( std::string const& filename, Ntk& ntk, read_verilog_netlist_params const& ps = {}, read_verilog_netlist_stats* pst = nullptr, lorina::diagnostic_engine* diag = nullptr )
+{
+  mapped_file file( filename );
+  if ( !file.is_open() )
+  {
+    if ( diag )
+    {
+      diag->report( lorina::diag_id::ERR_FILE_OPEN ).add_argument( filename );
+    }
+    return lorina::return_code::parse_error;
+  }
+  return read_verilog_netlist_buffer( file.view(), ntk, ps, pst, diag );
+}
+
+} /* namespace mockturtle */
@@ -0,0 +1,857 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file sequential_aiger.hpp
+  \brief Reader and writer for sequential AIGER 1.9 files
+
+  Reads and writes the binary AIGER format including latches with
+  initialization values, bad state properties, invariant constraints, justice
+  properties and fairness constraints [1].
+
+  [1] http://fmv.jku.at/aiger/FORMAT
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <lorina/common.hpp>
+#include <lorina/diagnostics.hpp>
+
+#include "../networks/sequential.hpp"
+#include "../traits.hpp"
+#include "../utils/file_utils.hpp"
+#include "../utils/network_utils.hpp"
+#include "../views/topo_view.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Properties of a sequential AIGER file.
+ *
+ * AIGER 1.9 distinguishes the outputs of a model from bad state properties,
+ * invariant constraints, justice properties and fairness constraints.  The
+ * readers and writers in this file represent all of them as primary outputs of
+ * the network, which keeps them alive in optimizations, and use this data
+ * structure to describe how the last primary outputs are split into the
+ * property sections.  The primary outputs are ordered as follows:
+ *
+ * - regular outputs,
+ * - `num_bad` bad state properties,
+ * - `num_constraints` invariant constraints,
+ * - for each justice property, `justice[i]` literals,
+ * - `num_fairness` fairness constraints.
+ *
+ * A default constructed object describes a network in which all primary
+ * outputs are regular outputs.
+ */
+struct aiger_properties
+{
+  /*! \brief Number of bad state properties. */
+  uint32_t num_bad{ 0u };
+
+  /*! \brief Number of invariant constraints. */
+  uint32_t num_constraints{ 0u };
+
+  /*! \brief Number of literals of each justice property. */
+  std::vector<uint32_t> justice;
+
+  /*! \brief Number of fairness constraints. */
+  uint32_t num_fairness{ 0u };
+
+  /*! \brief Number of primary outputs used by all properties. */
+  uint32_t num_property_outputs() const
+  {
+    return num_bad + num_constraints + std::accumulate( justice.begin(), justice.end(), 0u ) + num_fairness;
+  }
+
+  /*! \brief Whether no properties are present. */
+  bool empty() const
+  {
+    return num_bad == 0u && num_constraints == 0u && justice.empty() && num_fairness == 0u;
+  }
+};
+
+namespace detail
+{
+
+template<class Ntk>
+class read_sequential_aiger_impl
+{
+public:
+  using signal = typename Ntk::signal;
+
+  read_sequential_aiger_impl( Ntk& ntk, std::string_view contents, aiger_properties& props, lorina::diagnostic_engine* diag )
+      : _ntk( ntk ),
+        _contents( contents ),
+        _props( props ),
+        _diag( diag )
+  {
+  }
+
+  lorina::return_code run()
+  {
+    if ( !parse_header() )
+    {
+      return error( lorina::diag_id::ERR_AIGER_HEADER, current_line() );
+    }
+
+    if constexpr ( !has_create_ro_v<Ntk> || !has_create_ri_v<Ntk> )
+    {
+      if ( _num_latches != 0u )
+      {
+        return error( lorina::diag_id::ERR_AIGER_LATCH_DECLARATION, "network type does not support latches" );
+      }
+    }
+
+    /* reserve space for all nodes before the network grows */
+    if constexpr ( has_node_storage<Ntk>::value )
+    {
+      /* inputs take no space in the file, so their number is not bounded by its size */
+      auto const num_reserved = std::min<uint64_t>( _num_inputs, _contents.size() ) + _num_latches + _num_ands + 1u;
+      _ntk._storage->nodes.reserve( _ntk._storage->nodes.size() + num_reserved );
+      if constexpr ( has_storage_hash<std::decay_t<decltype( *_ntk._storage )>>::value )
+      {
+        _ntk._storage->hash.reserve( _ntk._storage->hash.size() + _num_ands );
+      }
+    }
+
+    _signals.reserve( std::min<uint64_t>( _num_inputs, _contents.size() ) + _num_latches + _num_ands + 1u );
+    _signals.emplace_back( _ntk.get_constant( false ) );
+    for ( auto i = 0u; i < _num_inputs; ++i )
+    {
+      _signals.emplace_back( _ntk.create_pi() );
+    }
+    if constexpr ( has_create_ro_v<Ntk> )
+    {
+      for ( auto i = 0u; i < _num_latches; ++i )
+      {
+        _signals.emplace_back( _ntk.create_ro() );
+      }
+    }
+
+    /* latches */
+    _latches.resize( _num_latches );
+    for ( auto i = 0u; i < _num_latches; ++i )
+    {
+      auto const line = current_line();
+      auto& [next, init] = _latches[i];
+      if ( !read_uint( next ) )
+      {
+        return error( lorina::diag_id::ERR_AIGER_LATCH_DECLARATION, line );
+      }
+      if ( !at_end_of_line() && !read_uint( init ) )
+      {
+        return error( lorina::diag_id::ERR_AIGER_LATCH_DECLARATION, line );
+      }
+      if ( !read_end_of_line() || next > 2u * _num_vars + 1u || ( init > 1u && init != 2u * ( 1u + _num_inputs + i ) ) )
+      {
+        return error( lorina::diag_id::ERR_AIGER_LATCH_DECLARATION, line );
+      }
+    }
+
+    /* outputs, bad state properties, invariant constraints */
+    if ( !read_literals( uint64_t( _num_outputs ) + _props.num_bad + _props.num_constraints ) )
+    {
+      return error( lorina::diag_id::ERR_PARSE_LINE, current_line() );
+    }
+
+    /* justice properties: sizes followed by literals */
+    for ( auto& size : _props.justice )
+    {
+      if ( !read_uint( size ) || !read_end_of_line() )
+      {
+        return error( lorina::diag_id::ERR_PARSE_LINE, current_line() );
+      }
+    }
+    if ( !read_literals( std::accumulate( _props.justice.begin(), _props.justice.end(), uint64_t( 0u ) ) + _props.num_fairness ) )
+    {
+      return error( lorina::diag_id::ERR_PARSE_LINE, current_line() );
+    }
+
+    /* and gates in binary encoding */
+    for ( auto i = 0u; i < _num_ands; ++i )
+    {
+      uint32_t const lhs = 2u * ( 1u + _num_inputs + _num_latches + i );
+      uint32_t delta0, delta1;
+      if ( !decode( delta0 ) || !decode( delta1 ) || delta0 == 0u || delta0 > lhs || delta1 > lhs - delta0 )
+      {
+        return error( lorina::diag_id::ERR_AIGER_AND_DECLARATION, std::to_string( lhs ) );
+      }
+      uint32_t const rhs0 = lhs - delta0;
+      uint32_t const rhs1 = rhs0 - delta1;
+      _signals.emplace_back( _ntk.create_and( literal_to_signal( rhs0 ), literal_to_signal( rhs1 ) ) );
+    }
+
+    /* primary outputs (including all properties) and register inputs */
+    for ( auto const lit : _output_literals )
+    {
+      _ntk.create_po( literal_to_signal( lit ) );
+    }
+    if constexpr ( has_create_ri_v<Ntk> )
+    {
+      for ( auto i = 0u; i < _num_latches; ++i )
+      {
+        auto const [next, init] = _latches[i];
+        _ntk.create_ri( literal_to_signal( next ) );
+
+        register_t reg;
+        reg.init = init <= 1u ? static_cast<uint8_t>( init ) : 2u;
+        _ntk.set_register( i, reg );
+      }
+    }
+
+    parse_symbols();
+    return lorina::return_code::success;
+  }
+
+private:
+  bool parse_header()
+  {
+    if ( _contents.substr( 0u, 4u ) != "aig " )
+    {
+      return false;
+    }
+    _pos = 4u;
+
+    std::array<uint32_t, 9u> values{};
+    auto num_values = 0u;
+    while ( !at_end_of_line() )
+    {
+      if ( num_values == values.size() || !read_uint( values[num_values++] ) )
+      {
+        return false;
+      }
+    }
+    if ( num_values < 5u || !read_end_of_line() )
+    {
+      return false;
+    }
+
+    /* the binary format requires the variables to be numbered consecutively, and literals must fit into 32 bits */
+    if ( uint64_t( values[1] ) + values[2] + values[4] != values[0] || values[0] >= ( 1u << 31 ) )
+    {
+      return false;
+    }
+
+    /* check the counts against the rest of the file before allocating: each latch,
+       output, property, and justice size takes a line (the last one possibly without
+       a line break), and each AND gate at least 2 bytes */
+    uint64_t const num_lines = uint64_t( values[2] ) + values[3] + values[5] + values[6] + values[7] + values[8];
+    if ( 2u * ( num_lines + values[4] ) > _contents.size() - _pos + 1u )
+    {
+      return false;
+    }
+
+    _num_vars = values[0];
+    _num_inputs = values[1];
+    _num_latches = values[2];
+    _num_outputs = values[3];
+    _num_ands = values[4];
+    _props.num_bad = values[5];
+    _props.num_constraints = values[6];
+    _props.justice.assign( values[7], 0u );
+    _props.num_fairness = values[8];
+    return true;
+  }
+
+  bool read_literals( uint64_t count )
+  {
+    for ( uint64_t i = 0u; i < count; ++i )
+    {
+      uint32_t lit;
+      if ( !read_uint( lit ) || !read_end_of_line() || lit > 2u * _num_vars + 1u )
+      {
+        return false;
+      }
+      _output_literals.emplace_back( lit );
+    }
+    return true;
+  }
+
+  void parse_symbols()
+  {
+    while ( _pos < _contents.size() )
+    {
+      auto const type = _contents[_pos];
+
+      /* the comment section starts with a line containing only `c` */
+      if ( type == 'c' && ( _pos + 1u == _contents.size() || _contents[_pos + 1u] == '\n' ) )
+      {
+        return;
+      }
+
+      ++_pos;
+      uint32_t index;
+      if ( !read_uint( index ) || _pos == _contents.size() || _contents[_pos] != ' ' )
+      {
+        return;
+      }
+      ++_pos;
+      auto const end = std::min( _contents.find( '\n', _pos ), _contents.size() );
+      auto const name = _contents.substr( _pos, end - _pos );
+      _pos = std::min( end + 1u, _contents.size() );
+
+      switch ( type )
+      {
+      case 'i':
+        if ( index < _num_inputs )
+        {
+          set_name( _signals[1u + index], name );
+        }
+        break;
+      case 'l':
+        if ( index < _num_latches )
+        {
+          set_name( _signals[1u + _num_inputs + index], name );
+        }
+        break;
+      case 'o':
+        set_output_name( index, _num_outputs, 0u, name );
+        break;
+      case 'b':
+        set_output_name( index, _props.num_bad, _num_outputs, name );
+        break;
+      case 'c':
+        set_output_name( index, _props.num_constraints, _num_outputs + _props.num_bad, name );
+        break;
+      case 'j':
+        /* a justice property is named by its first literal */
+        if ( index < _props.justice.size() && _props.justice[index] > 0u )
+        {
+          auto const offset = _num_outputs + _props.num_bad + _props.num_constraints + std::accumulate( _props.justice.begin(), _props.justice.begin() + index, 0u );
+          set_output_name( 0u, 1u, offset, name );
+        }
+        break;
+      case 'f':
+        set_output_name( index, _props.num_fairness, static_cast<uint32_t>( _output_literals.size() ) - _props.num_fairness, name );
+        break;
+      default:
+        return;
+      }
+    }
+  }
+
+  void set_name( signal const& s, std::string_view name )
+  {
+    if constexpr ( has_set_name_v<Ntk> )
+    {
+      _ntk.set_name( s, std::string( name ) );
+    }
+    else
+    {
+      (void)s;
+      (void)name;
+    }
+  }
+
+  void set_output_name( uint32_t index, uint32_t count, uint32_t offset, std::string_view name )
+  {
+    if constexpr ( has_set_output_name_v<Ntk> )
+    {
+      if ( index < count )
+      {
+        _ntk.set_output_name( offset + index, std::string( name ) );
+      }
+    }
+    else
+    {
+      (void)index;
+      (void)count;
+      (void)offset;
+      (void)name;
+    }
+  }
+
+  signal literal_to_signal( uint32_t lit )
+  {
+    auto const& s = _signals[lit >> 1];
+    return ( lit & 1 ) ? _ntk.create_not( s ) : s;
+  }
+
+  bool read_uint( uint32_t& value )
+  {
+    while ( _pos < _contents.size() && _contents[_pos] == ' ' )
+    {
+      ++_pos;
+    }
+    if ( _pos == _contents.size() || _contents[_pos] < '0' || _contents[_pos] > '9' )
+    {
+      return false;
+    }
+    uint64_t v = 0u;
+    while ( _pos < _contents.size() && _contents[_pos] >= '0' && _contents[_pos] <= '9' )
+    {
+      v = 10u * v + ( _contents[_pos++] - '0' );
+      if ( v > std::numeric_limits<uint32_t>::max() )
+      {
+        return false;
+      }
+    }
+    value = static_cast<uint32_t>( v );
+    return true;
+  }
+
+  bool at_end_of_line()
+  {
+    while ( _pos < _contents.size() && ( _contents[_pos] == ' ' || _contents[_pos] == '\r' ) )
+    {
+      ++_pos;
+    }
+    return _pos == _contents.size() || _contents[_pos] == '\n';
+  }
+
+  bool read_end_of_line()
+  {
+    if ( !at_end_of_line() || _pos == _contents.size() )
+    {
+      return false;
+    }
+    ++_pos;
+    return true;
+  }
+
+  bool decode( uint32_t& value )
+  {
+    value = 0u;
+    for ( auto shift = 0u; _pos < _contents.size() && shift < 32u; shift += 7u )
+    {
+      auto const ch = static_cast<unsigned char>( _contents[_pos++] );
+      value |= static_cast<uint32_t>( ch & 0x7f ) << shift;
+      if ( ( ch & 0x80 ) == 0 )
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::string current_line() const
+  {
+    auto const begin = std::min( _pos, _contents.size() );
+    auto const end = std::min( _contents.find( '\n', begin ), _contents.size() );
+    return std::string( _contents.substr( begin, end - begin ) );
+  }
+
+  lorina::return_code error( lorina::diag_id id, std::string const& argument )
+  {
+    if ( _diag )
+    {
+      _diag->report( id ).add_argument( argument );
+    }
+    return lorina::return_code::parse_error;
+  }
+
+private:
+  Ntk& _ntk;
+  std::string_view _contents;
+  aiger_properties& _props;
+  lorina::diagnostic_engine* _diag;
+
+  std::size_t _pos{ 0u };
+  uint32_t _num_vars{ 0u };
+  uint32_t _num_inputs{ 0u };
+  uint32_t _num_latches{ 0u };
+  uint32_t _num_outputs{ 0u };
+  uint32_t _num_ands{ 0u };
+
+  std::vector<signal> _signals;
+  std::vector<std::pair<uint32_t, uint32_t>> _latches;
+  std::vector<uint32_t> _output_literals;
+};
+
+inline void encode( output_buffer& out, uint32_t value )
+{
+  while ( value & ~0x7f )
+  {
+    out.put( static_cast<char>( ( value & 0x7f ) | 0x80 ) );
+    value >>= 7;
+  }
+  out.put( static_cast<char>( value ) );
+}
+
+} // namespace detail
+
+/*! \brief Reads a sequential binary AIGER file from a memory buffer.
+ *
+ * Reads the binary AIGER format including the extensions of AIGER 1.9: the
+ * header may declare bad state properties, invariant constraints, justice
+ * properties and fairness constraints, and latches may have an
+ * initialization value (0, 1, or the latch literal itself for an
+ * uninitialized latch).  Latches are created with `create_ro` and
+ * `create_ri`; their initialization values are stored in the `init` field of
+ * the registers (0, 1, or 2 for uninitialized, as in `aiger_reader`).  All
+ * properties are created as additional primary outputs after the regular
+ * outputs; `props` describes how they are split (see `aiger_properties`).
+ * Names from the symbol table are assigned if the network supports names.
+ *
+ * Unlike `lorina::read_aiger` with `aiger_reader`, the buffer is parsed
+ * without line copies and the network storage is reserved upfront.
+ *
+ * **Required network functions:**
+ * - `create_pi`
+ * - `create_po`
+ * - `get_constant`
+ * - `create_not`
+ * - `create_and`
+ * - `create_ro`, `create_ri`, and `set_register` (for latches)
+ *
+ * \param contents Binary AIGER contents
+ * \param ntk Network
+ * \param props Optional output for the property sections
+ * \param diag An optional diagnostic engine with callback methods for parse errors
+ * \return Success if parsing has been successful, or parse error if parsing has failed
+ */
+template<class Ntk>
+[[nodiscard]] lorina::return_code read_sequential_aiger_buffer( std::string_view contents, Ntk& ntk, aiger_properties* props = nullptr, lorina::diagnostic_engine* diag = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_create_pi_v<Ntk>, "Ntk does not implement the create_pi function" );
+  static_assert( has_create_po_v<Ntk>, "Ntk does not implement the create_po function" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant function" );
+  static_assert( has_create_not_v<Ntk>, "Ntk does not implement the create_not function" );
+  static_assert( has_create_and_v<Ntk>, "Ntk does not implement the create_and function" );
+
+  aiger_properties local_props;
+  detail::read_sequential_aiger_impl<Ntk> impl( ntk, contents, props ? *props : local_props, diag );
+  return impl.run();
+}
+
+/*! \brief Reads a sequential binary AIGER file.
+ *
+ * Maps the file into memory (see `mapped_file`) and reads it with
+ * `read_sequential_aiger_buffer`.
+
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      names_view<sequential<aig_network>> aig;
+      aiger_properties props;
+      if ( read_sequential_aiger( "model.aig", aig, &props ) == lorina::return_code::success )
+      {
+        std::cout << props.num_bad << " bad state properties\n";
+      }
+   \endverbatim
+ *
+ * \param filename Name of the file
+ * \param ntk Network
+ * \param props Optional output for the property sections
+ * \param diag An optional diagnostic engine with callback methods for parse errors
+ * \return Success if parsing has been successful, or parse error if parsing has failed
+ */
+template<class Ntk>
+[[nodiscard]] lorina::return_code read_sequential_aiger( std::string const& filename, Ntk& ntk, aiger_properties* props = nullptr, lorina::diagnostic_engine* diag = nullptr )
+{
+  mapped_file file( filename );
+  if ( !file.is_open() )
+  {
+    if ( diag )
+    {
+      diag->report( lorina::diag_id::ERR_FILE_OPEN ).add_argument( filename );
+    }
+    return lorina::return_code::parse_error;
+  }
+  return read_sequential_aiger_buffer( file.view(), ntk, props, diag );
+}
+
+/*! \brief Writes a sequential AIG or XAG in binary AIGER 1.9 format.
+ *
+ * Latches are written with their initialization values taken from the
+ * registers of the network (an `init` value other than 0 or 1 is written as
+ * uninitialized).  The last primary outputs are written as the property
+ * sections described by `props` (see `aiger_properties`).  Variables are
+ * numbered in topological order, and only gates in the transitive fanin of
+ * the combinational outputs are written; the network does not need to be
+ * cleaned up.  XOR gates of an XAG are decomposed into three AND gates.
+ * Names of inputs, latches and outputs are written into the symbol table if
+ * the network has names.
+ *
+ * **Required network functions:**
+ * - `num_pis`
+ * - `num_pos`
+ * - `foreach_ci`
+ * - `foreach_po`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `get_node`
+ * - `is_complemented`
+ * - `node_to_index`
+ * - `foreach_ri` and `register_at` (for latches)
+ *
+ * \param ntk Sequential AIG or XAG network
+ * \param os Output stream
+ * \param props Property sections of the primary outputs
+ */
+template<class Ntk>
+void write_sequential_aiger( Ntk const& ntk, std::ostream& os, aiger_properties const& props = {} )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_num_pis_v<Ntk>, "Ntk does not implement the num_pis method" );
+  static_assert( has_num_pos_v<Ntk>, "Ntk does not implement the num_pos method" );
+  static_assert( has_foreach_ci_v<Ntk>, "Ntk does not implement the foreach_ci method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  assert( props.num_property_outputs() <= ntk.num_pos() );
+
+  uint32_t num_latches{ 0u };
+  if constexpr ( has_create_ri_v<Ntk> )
+  {
+    num_latches = ntk.num_registers();
+  }
+
+  /* variable numbering: inputs, latches, gates in topological order */
+  std::vector<uint32_t> lits( ntk.size(), 0u );
+  uint32_t num_vars{ 0u };
+  ntk.foreach_ci( [&]( node const& n ) {
+    lits[ntk.node_to_index( n )] = 2u * ++num_vars;
+  } );
+
+  auto const literal = [&]( signal const& f ) {
+    return lits[ntk.node_to_index( ntk.get_node( f ) )] ^ ( ntk.is_complemented( f ) ? 1u : 0u );
+  };
+
+  std::vector<std::array<uint32_t, 2u>> ands;
+  auto const add_and = [&]( uint32_t a, uint32_t b ) {
+    ands.push_back( { std::max( a, b ), std::min( a, b ) } );
+    return 2u * ++num_vars;
+  };
+
+  topo_view topo{ ntk };
+  topo.foreach_gate( [&]( node const& n ) {
+    /* topo_view only skips the primary inputs */
+    if ( ntk.is_ci( n ) )
+    {
+      return;
+    }
+
+    std::array<uint32_t, 2u> fanins{};
+    ntk.foreach_fanin( n, [&]( signal const& fi, auto i ) {
+      fanins[i] = literal( fi );
+    } );
+
+    if constexpr ( has_is_xor_v<Ntk> )
+    {
+      if ( ntk.is_xor( n ) )
+      {
+        auto const l1 = add_and( fanins[0], fanins[1] ^ 1u );
+        auto const l2 = add_and( fanins[0] ^ 1u, fanins[1] );
+        lits[ntk.node_to_index( n )] = add_and( l1 ^ 1u, l2 ^ 1u ) ^ 1u;
+        return;
+      }
+    }
+    lits[ntk.node_to_index( n )] = add_and( fanins[0], fanins[1] );
+  } );
+
+  std::vector<uint32_t> po_lits;
+  po_lits.reserve( ntk.num_pos() );
+  ntk.foreach_po( [&]( signal const& f ) {
+    po_lits.emplace_back( literal( f ) );
+  } );
+
+  uint32_t const num_outputs = ntk.num_pos() - props.num_property_outputs();
+  std::array<uint32_t, 9u> const header = { num_vars, ntk.num_pis(), num_latches, num_outputs, static_cast<uint32_t>( ands.size() ),
+                                            props.num_bad, props.num_constraints, static_cast<uint32_t>( props.justice.size() ), props.num_fairness };
+
+  output_buffer out( os );
+
+  /* HEADER, optional counts are written up to the last non-zero one */
+  auto header_size = header.size();
+  while ( header_size > 5u && header[header_size - 1u] == 0u )
+  {
+    --header_size;
+  }
+  out.write( "aig" );
+  for ( auto i = 0u; i < header_size; ++i )
+  {
+    out.put( ' ' );
+    out.write_uint( header[i] );
+  }
+  out.put( '\n' );
+
+  /* LATCHES */
+  if constexpr ( has_create_ri_v<Ntk> )
+  {
+    ntk.foreach_ri( [&]( signal const& f, auto i ) {
+      out.write_uint( literal( f ) );
+      auto const init = ntk.register_at( i ).init;
+      if ( init == 1u )
+      {
+        out.write( " 1" );
+      }
+      else if ( init != 0u )
+      {
+        out.put( ' ' );
+        out.write_uint( 2u * ( 1u + ntk.num_pis() + i ) );
+      }
+      out.put( '\n' );
+    } );
+  }
+
+  /* OUTPUTS AND PROPERTIES, justice sizes precede the justice literals */
+  auto const write_literals = [&]( uint32_t begin, uint32_t end ) {
+    for ( auto i = begin; i < end; ++i )
+    {
+      out.write_uint( po_lits[i] );
+      out.put( '\n' );
+    }
+  };
+  uint32_t const first_justice = num_outputs + props.num_bad + props.num_constraints;
+  write_literals( 0u, first_justice );
+  for ( auto const size : props.justice )
+  {
+    out.write_uint( size );
+    out.put( '\n' );
+  }
+  write_literals( first_justice, ntk.num_pos() );
+
+  /* GATES */
+  for ( auto i = 0u; i < ands.size(); ++i )
+  {
+    uint32_t const lhs = 2u * ( 1u + ntk.num_pis() + num_latches + i );
+    assert( lhs > ands[i][0] );
+    detail::encode( out, lhs - ands[i][0] );
+    detail::encode( out, ands[i][0] - ands[i][1] );
+  }
+
+  /* SYMBOL TABLE */
+  if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
+  {
+    auto const write_name = [&]( char type, uint32_t index, signal const& s ) {
+      if ( !ntk.has_name( s ) )
+      {
+        return;
+      }
+      out.put( type );
+      out.write_uint( index );
+      out.put( ' ' );
+      if constexpr ( has_get_name_view_v<Ntk> )
+      {
+        out.write( ntk.get_name_view( s ) );
+      }
+      else
+      {
+        out.write( ntk.get_name( s ) );
+      }
+      out.put( '\n' );
+    };
+
+    ntk.foreach_pi( [&]( node const& n, auto i ) {
+      write_name( 'i', i, ntk.make_signal( n ) );
+    } );
+    if constexpr ( has_create_ro_v<Ntk> )
+    {
+      ntk.foreach_ro( [&]( node const& n, auto i ) {
+        write_name( 'l', i, ntk.make_signal( n ) );
+      } );
+    }
+  }
+  if constexpr ( has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk> )
+  {
+    auto const write_output_name = [&]( char type, uint32_t index, uint32_t output ) {
+      if ( !ntk.has_output_name( output ) )
+      {
+        return;
+      }
+      out.put( type );
+      out.write_uint( index );
+      out.put( ' ' );
+      if constexpr ( has_get_output_name_view_v<Ntk> )
+      {
+        out.write( ntk.get_output_name_view( output ) );
+      }
+      else
+      {
+        out.write( ntk.get_output_name( output ) );
+      }
+      out.put( '\n' );
+    };
+
+    auto output = 0u;
+    for ( auto i = 0u; i < num_outputs; ++i )
+    {
+      write_output_name( 'o', i, output++ );
+    }
+    for ( auto i = 0u; i < props.num_bad; ++i )
+    {
+      write_output_name( 'b', i, output++ );
+    }
+    for ( auto i = 0u; i < props.num_constraints; ++i )
+    {
+      write_output_name( 'c', i, output++ );
+    }
+    for ( auto i = 0u; i < props.justice.size(); ++i )
+    {
+      /* a justice property is named by its first literal */
+      if ( props.justice[i] > 0u )
+      {
+        write_output_name( 'j', i, output );
+      }
+      output += props.justice[i];
+    }
+    for ( auto i = 0u; i < props.num_fairness; ++i )
+    {
+      write_output_name( 'f', i, output++ );
+    }
+  }
+}
+
+/*! \brief Writes a sequential AIG or XAG in binary AIGER 1.9 format into a file.
+ *
+ * See `write_sequential_aiger` for writing into an output stream.
+ *
+ * \param ntk Sequential AIG or XAG network
+ * \param filename Filename
+ * \param props Property sections of the primary outputs
+ */
+template<class Ntk>
+void write_sequential_aiger( Ntk const& ntk, std::string const& filename, aiger_properties const& props = {} )
+{
+  std::ofstream os( filename.c_str(), std::ofstream::out | std::ofstream::binary );
+  write_sequential_aiger( ntk, os, props );
+  os.close();
+}
+
+} /* namespace mockturtle */
@@ -147,10 +147,16 @@ inline void write_aiger( Ntk const& aig, std::ostream& os )
       if ( !aig.has_name( aig.make_signal( i ) ) )
         return;
 
-      sprintf( string_buffer, "i%u %s\n",
-               uint32_t( index ),
-               aig.get_name( aig.make_signal( i ) ).c_str() );
+      sprintf( string_buffer, "i%u ", uint32_t( index ) );
       os.write( &string_buffer[0], sizeof( unsigned char ) * std::strlen( string_buffer ) );
+      if constexpr ( has_get_name_view_v<Ntk> )
+      {
+        os << aig.get_name_view( aig.make_signal( i ) ) << '\n';
+      }
+      else
+      {
+        os << aig.get_name( aig.make_signal( i ) ) << '\n';
+      }
     } );
   }
   if constexpr ( has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk> )
@@ -159,10 +165,16 @@ inline void write_aiger( Ntk const& aig, std::ostream& os )
       if ( !aig.has_output_name( index ) )
         return;
 
-      sprintf( string_buffer, "o%u %s\n",
-               uint32_t( index ),
-               aig.get_output_name( index ).c_str() );
+      sprintf( string_buffer, "o%u ", uint32_t( index ) );
       os.write( &string_buffer[0], sizeof( unsigned char ) * std::strlen( string_buffer ) );
+      if constexpr ( has_get_output_name_view_v<Ntk> )
+      {
+        os << aig.get_output_name_view( index ) << '\n';
+      }
+      else
+      {
+        os << aig.get_output_name( index ) << '\n';
+      }
     } );
   }
 
@@ -37,18 +37,25 @@
 
 #include "../networks/sequential.hpp"
 #include "../traits.hpp"
+#include "../utils/file_utils.hpp"
+#include "../utils/string_pool.hpp"
 #include "../views/topo_view.hpp"
 
 #include <kitty/constructors.hpp>
+#include <kitty/hash.hpp>
 #include <kitty/isop.hpp>
 #include <kitty/operations.hpp>
 #include <kitty/print.hpp>
 
 #include <fmt/format.h>
+#include <parallel_hashmap/phmap.h>
 
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace mockturtle
 {
@@ -88,317 +95,500 @@ struct write_blif_params
   uint32_t rename_ri_using_node = 0u;
 };
 
-/*! \brief Writes network in BLIF format into output stream
- *
- * An overloaded variant exists that writes the network into a file.
- *
- * **Required network functions:**
- * - `fanin_size`
- * - `foreach_fanin`
- * - `foreach_pi`
- * - `foreach_po`
- * - `get_node`
- * - `is_constant`
- * - `is_pi`
- * - `node_function`
- * - `node_to_index`
- * - `num_pis`
- * - `num_pos`
+namespace detail
+{
+
+/*! \brief Set of names defined in a BLIF file.
  *
- * \param ntk Network
- * \param os Output stream
+ * Default names of the form `pi<index>` and `new_n<index>` are recorded per
+ * node index instead of as strings, other names are interned in a string
+ * pool.
  */
-template<class Ntk>
-void write_blif( Ntk const& ntk, std::ostream& os, write_blif_params const& ps = {} )
+class blif_defined_names
 {
-  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
-  static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
-  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
-  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
-  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
-  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
-  static_assert( has_is_pi_v<Ntk>, "Ntk does not implement the is_pi method" );
-  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
-  static_assert( has_num_pis_v<Ntk>, "Ntk does not implement the num_pis method" );
-  static_assert( has_num_pos_v<Ntk>, "Ntk does not implement the num_pos method" );
-  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
-  static_assert( has_node_function_v<Ntk>, "Ntk does not implement the node_function method" );
+public:
+  enum prefix : uint8_t
+  {
+    pi = 1,
+    new_n = 2
+  };
 
-  uint32_t num_latches{ 0 };
-  if constexpr ( has_num_registers_v<Ntk> )
+public:
+  void insert( prefix p, uint64_t index )
   {
-    num_latches = ntk.num_registers();
+    if ( index >= _defaults.size() )
+    {
+      _defaults.resize( index + 1u, 0u );
+    }
+    _defaults[index] |= p;
   }
 
-  topo_view topo_ntk{ ntk };
-  std::unordered_set<std::string> defined_names;
+  void insert( std::string_view name )
+  {
+    _names.intern( name );
+  }
 
-  /* write model */
-  os << ".model top\n";
+  bool contains( std::string_view view ) const
+  {
+    if ( _names.find( view ) )
+    {
+      return true;
+    }
+    if ( view.substr( 0u, 2u ) == "pi" )
+    {
+      return contains_default( pi, view.substr( 2u ) );
+    }
+    if ( view.substr( 0u, 5u ) == "new_n" )
+    {
+      return contains_default( new_n, view.substr( 5u ) );
+    }
+    return false;
+  }
 
-  /* write inputs */
-  if ( topo_ntk.num_pis() > 0u )
+private:
+  bool contains_default( prefix p, std::string_view digits ) const
   {
-    os << ".inputs ";
-    topo_ntk.foreach_ci( [&]( auto const& n, auto index ) {
-      if ( ( ( index + 1 ) <= topo_ntk.num_cis() - num_latches ) )
+    /* only the canonical decimal representation is a default name */
+    if ( digits.empty() || digits.size() > 19u || ( digits[0] == '0' && digits.size() > 1u ) )
+    {
+      return false;
+    }
+    uint64_t index = 0u;
+    for ( auto c : digits )
+    {
+      if ( c < '0' || c > '9' )
       {
-        if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
-        {
-          signal<Ntk> const s = topo_ntk.make_signal( topo_ntk.node_to_index( n ) );
-          std::string const input_name = topo_ntk.has_name( s ) ? topo_ntk.get_name( s ) : fmt::format( "pi{}", topo_ntk.get_node( s ) );
-          os << input_name << ' ';
-          defined_names.insert( input_name ); /* we should not have collision here */
-        }
-        else
-        {
-          std::string const input_name = fmt::format( "pi{}", topo_ntk.node_to_index( n ) );
-          os << input_name << ' ';
-          defined_names.insert( input_name ); /* we should not have collision here */
-        }
+        return false;
       }
-    } );
-    os << "\n";
+      index = index * 10u + static_cast<uint64_t>( c - '0' );
+    }
+    return index < _defaults.size() && ( _defaults[index] & p );
   }
 
-  /* write outputs */
-  if ( topo_ntk.num_pos() > 0u )
+private:
+  std::vector<uint8_t> _defaults;
+  string_pool _names;
+};
+
+template<class Ntk>
+class write_blif_impl
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+  using truth_table_t = std::decay_t<decltype( std::declval<Ntk>().node_function( std::declval<node>() ) )>;
+
+  static constexpr bool has_names = has_has_name_v<Ntk> && has_get_name_v<Ntk>;
+
+public:
+  write_blif_impl( Ntk const& ntk, std::ostream& os, write_blif_params const& ps )
+      : topo_ntk( ntk ),
+        os( os ),
+        out( os ),
+        ps( ps )
   {
-    os << ".outputs ";
-    topo_ntk.foreach_co( [&]( auto const& f, auto index ) {
-      (void)f;
-      if ( index < topo_ntk.num_cos() - num_latches )
-      {
-        if constexpr ( has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk> )
-        {
-          std::string const output_name = topo_ntk.has_output_name( index ) ? topo_ntk.get_output_name( index ) : fmt::format( "po{}", index );
-          os << output_name << ' ';
-        }
-        else
-        {
-          std::string const output_name = fmt::format( "po{}", index );
-          os << output_name << ' ';
-        }
-      }
-    } );
-    os << "\n";
   }
 
-  if constexpr ( has_num_registers_v<Ntk> )
+  void run()
   {
-    if ( num_latches > 0u )
+    uint32_t num_latches{ 0 };
+    if constexpr ( has_num_registers_v<Ntk> )
     {
-      uint32_t latch_idx = 0;
-      topo_ntk.foreach_co( [&]( auto const& f, auto index ) {
-        if ( index >= topo_ntk.num_cos() - num_latches )
+      num_latches = topo_ntk.num_registers();
+    }
+
+    /* write model */
+    out.write( ".model top\n" );
+
+    /* write inputs */
+    if ( topo_ntk.num_pis() > 0u )
+    {
+      out.write( ".inputs " );
+      topo_ntk.foreach_ci( [&]( auto const& n, auto index ) {
+        if ( ( ( index + 1 ) <= topo_ntk.num_cis() - num_latches ) )
         {
-          os << ".latch ";
-          auto const ro_signal = topo_ntk.make_signal( topo_ntk.ro_at( latch_idx ) );
-          auto const ri_signal = topo_ntk.ri_at( latch_idx );
-          register_t latch_info = topo_ntk.register_at( latch_idx );
-          if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
+          if constexpr ( has_names )
           {
-            std::string const node_name = topo_ntk.has_name( ri_signal ) ? 
-                topo_ntk.get_name( ri_signal ) 
-              : fmt::format( "new_n{}", topo_ntk.get_node( ri_signal ) );
-            std::string const latch_name = ps.rename_ri_using_node ? 
-                node_name
-              : fmt::format( "li{}", latch_idx );
-            std::string const ri_name = topo_ntk.has_output_name( index ) ? 
-                topo_ntk.get_output_name( index ) 
-              : latch_name;
-            std::string const ro_name = topo_ntk.has_name( ro_signal ) ? topo_ntk.get_name( ro_signal ) : fmt::format( "new_n{}", topo_ntk.get_node( ro_signal ) );
-            os << fmt::format( "{} {} {} {} {}\n", ri_name, ro_name, latch_info.type, latch_info.control, latch_info.init );
-            defined_names.insert( ro_name ); /* we should not have collision here */
+            signal const s = topo_ntk.make_signal( topo_ntk.node_to_index( n ) );
+            if ( topo_ntk.has_name( s ) )
+            {
+              write_name( name_of( s ) );
+            }
+            else
+            {
+              write_default_name( detail::blif_defined_names::pi, topo_ntk.get_node( s ) );
+            }
           }
           else
           {
-            std::string const ri_name = ps.rename_ri_using_node? 
-                fmt::format( "new_n{}", topo_ntk.get_node( topo_ntk.ri_at( latch_idx ) ) )
-              : fmt::format( "li{}", latch_idx );
-            std::string const ro_name = fmt::format( "new_n{}", topo_ntk.get_node( ro_signal ) );
-            os << fmt::format( "{} {} {} {} {}\n", ri_name, ro_name, latch_info.type, latch_info.control, latch_info.init );
-            defined_names.insert( ro_name ); /* we should not have collision here */
+            out.write( "pi" );
+            out.write_uint( topo_ntk.node_to_index( n ) );
           }
-          latch_idx++;
+          out.put( ' ' );
         }
       } );
+      out.put( '\n' );
     }
-  }
-
-  /* write constants */
-  os << ".names new_n0\n";
-  os << "0\n";
-  defined_names.insert( "new_n0" ); /* we should not have collision here */
-
-  if ( topo_ntk.get_constant( false ) != topo_ntk.get_constant( true ) )
-  {
-    os << ".names new_n1\n";
-    os << "1\n";
-    defined_names.insert( "new_n1" ); /* we should not have collision here */
-  }
-
-  /* write nodes */
-  topo_ntk.foreach_node( [&]( auto const& n ) {
-    if ( topo_ntk.is_constant( n ) || topo_ntk.is_ci( n ) )
-      return; /* continue */
 
-    /* write truth table of node */
-    auto func = topo_ntk.node_function( n );
+    /* write outputs */
+    if ( topo_ntk.num_pos() > 0u )
+    {
+      out.write( ".outputs " );
+      topo_ntk.foreach_co( [&]( auto const& f, auto index ) {
+        (void)f;
+        if ( index < topo_ntk.num_cos() - num_latches )
+        {
+          if constexpr ( has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk> )
+          {
+            if ( topo_ntk.has_output_name( index ) )
+            {
+              out.write( output_name_of( index ) );
+              out.put( ' ' );
+              return;
+            }
+          }
+          out.write( "po" );
+          out.write_uint( index );
+          out.put( ' ' );
+        }
+      } );
+      out.put( '\n' );
+    }
 
-    if ( isop( func ).size() == 0 ) /* constants */
+    if constexpr ( has_num_registers_v<Ntk> )
     {
-      if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
-      {
-        auto const s = topo_ntk.make_signal( n );
-        std::string const constant_name = topo_ntk.has_name( s ) ? topo_ntk.get_name( s ) : fmt::format( "new_n{}", topo_ntk.get_node( s ) );
-        os << fmt::format( ".names {}\n", constant_name );
-        os << "0" << '\n';
-        defined_names.insert( constant_name ); /* we should not have collision here */
-      }
-      else
+      if ( num_latches > 0u )
       {
-        std::string const constant_name = fmt::format( "new_n{}", n );
-        os << fmt::format( ".names {}\n", constant_name );
-        os << "0" << '\n';
-        defined_names.insert( constant_name ); /* we should not have collision here */
+        uint32_t latch_idx = 0;
+        topo_ntk.foreach_co( [&]( auto const& f, auto index ) {
+          (void)f;
+          if ( index >= topo_ntk.num_cos() - num_latches )
+          {
+            out.write( ".latch " );
+            auto const ro_signal = topo_ntk.make_signal( topo_ntk.ro_at( latch_idx ) );
+            auto const ri_signal = topo_ntk.ri_at( latch_idx );
+            register_t latch_info = topo_ntk.register_at( latch_idx );
+            if constexpr ( has_names )
+            {
+              std::string const node_name = topo_ntk.has_name( ri_signal ) ? std::string( name_of( ri_signal ) ) : fmt::format( "new_n{}", topo_ntk.get_node( ri_signal ) );
+              std::string const latch_name = ps.rename_ri_using_node ? node_name : fmt::format( "li{}", latch_idx );
+              std::string const ri_name = topo_ntk.has_output_name( index ) ? std::string( output_name_of( index ) ) : latch_name;
+              std::string const ro_name = topo_ntk.has_name( ro_signal ) ? std::string( name_of( ro_signal ) ) : fmt::format( "new_n{}", topo_ntk.get_node( ro_signal ) );
+              out.write( fmt::format( "{} {} {} {} {}\n", ri_name, ro_name, latch_info.type, latch_info.control, latch_info.init ) );
+              defined_names.insert( ro_name ); /* we should not have collision here */
+            }
+            else
+            {
+              std::string const ri_name = ps.rename_ri_using_node ? fmt::format( "new_n{}", topo_ntk.get_node( topo_ntk.ri_at( latch_idx ) ) ) : fmt::format( "li{}", latch_idx );
+              std::string const ro_name = fmt::format( "new_n{}", topo_ntk.get_node( ro_signal ) );
+              out.write( fmt::format( "{} {} {} {} {}\n", ri_name, ro_name, latch_info.type, latch_info.control, latch_info.init ) );
+            }
+            latch_idx++;
+          }
+        } );
       }
-      return;
     }
 
-    os << fmt::format( ".names " );
+    /* write constants */
+    out.write( ".names new_n0\n0\n" );
+    defined_names.insert( detail::blif_defined_names::new_n, 0u ); /* we should not have collision here */
 
-    /* write fanins of node */
-    topo_ntk.foreach_fanin( n, [&]( auto const& f ) {
-      auto f_node = topo_ntk.get_node( f );
-      if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
-      {
-        signal<Ntk> const s = topo_ntk.make_signal( f_node );
-        std::string const fanin_name = topo_ntk.has_name( s ) ? topo_ntk.get_name( s ) : topo_ntk.is_pi( f_node ) ? fmt::format( "pi{}", f_node ) : fmt::format( "new_n{}", f_node );
-        os << fanin_name << ' ';
-      }
-      else
+    if ( topo_ntk.get_constant( false ) != topo_ntk.get_constant( true ) )
+    {
+      out.write( ".names new_n1\n1\n" );
+      defined_names.insert( detail::blif_defined_names::new_n, 1u ); /* we should not have collision here */
+    }
+
+    /* write nodes */
+    topo_ntk.foreach_node( [&]( auto const& n ) {
+      if ( topo_ntk.is_constant( n ) || topo_ntk.is_ci( n ) )
+        return; /* continue */
+
+      /* write truth table of node */
+      auto const& cubes = isop( n );
+
+      if ( cubes.size() == 0 ) /* constants */
       {
-        std::string const fanin_name = topo_ntk.is_pi( f_node ) ? fmt::format( "pi{} ", f_node ) : fmt::format( "new_n{} ", f_node );
-        os << fanin_name;
+        out.write( ".names " );
+        write_node_name( n );
+        out.write( "\n0\n" );
+        return;
       }
-    } );
 
-    /* write fanout of node */
-    if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
-    {
-      auto const s = topo_ntk.make_signal( n );
-      std::string const fanout_name = topo_ntk.has_name( s ) ? topo_ntk.get_name( s ) : fmt::format( "new_n{}", topo_ntk.get_node( s ) );
-      os << fanout_name << '\n';
-      defined_names.insert( fanout_name ); /* we should not have collision here */
-    }
-    else
-    {
-      std::string const fanout_name = fmt::format( "new_n{}", n );
-      os << fanout_name << '\n';
-      defined_names.insert( fanout_name ); /* we should not have collision here */
-    }
+      out.write( ".names " );
 
-    int count = 0;
-    for ( auto cube : isop( func ) )
-    {
-      topo_ntk.foreach_fanin( n, [&]( auto const& f, auto index ) {
-        if ( cube.get_mask( index ) && topo_ntk.is_complemented( f ) )
-          cube.flip_bit( index );
+      /* write fanins of node */
+      topo_ntk.foreach_fanin( n, [&]( auto const& f ) {
+        write_signal_name( topo_ntk.get_node( f ) );
+        out.put( ' ' );
       } );
 
-      cube.print( topo_ntk.fanin_size( n ), os );
-      os << " 1\n";
-      count++;
-    }
-  } );
+      /* write fanout of node */
+      write_node_name( n );
+      out.put( '\n' );
 
-  auto latch_idx = 0;
-  topo_ntk.foreach_co( [&]( auto const& f, auto index ) {
-    auto f_node = topo_ntk.get_node( f );
-    auto const minterm_string = topo_ntk.is_complemented( f ) ? "0" : "1";
+      auto const num_fanins = topo_ntk.fanin_size( n );
+      for ( auto cube : cubes )
+      {
+        topo_ntk.foreach_fanin( n, [&]( auto const& f, auto index ) {
+          if ( cube.get_mask( index ) && topo_ntk.is_complemented( f ) )
+            cube.flip_bit( index );
+        } );
 
-    if ( index < topo_ntk.num_cos() - num_latches ) /* the signal f is a PO */
-    {
-      /* the default name depends on whether the signal is a PI or a regular signal */
-      std::string const node_default_name = topo_ntk.is_pi( f_node ) ? fmt::format( "pi{}", f_node ) : fmt::format( "new_n{}", f_node );
+        for ( auto i = 0u; i < num_fanins; ++i )
+        {
+          out.put( cube.get_mask( i ) ? ( cube.get_bit( i ) ? '1' : '0' ) : '-' );
+        }
+        out.write( " 1\n" );
+      }
+    } );
 
-      if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> && has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk> ) /* with name view */
-      {
-        signal<Ntk> const s = topo_ntk.make_signal( topo_ntk.get_node( f ) );
+    auto latch_idx = 0;
+    topo_ntk.foreach_co( [&]( auto const& f, auto index ) {
+      auto f_node = topo_ntk.get_node( f );
+      char const minterm = topo_ntk.is_complemented( f ) ? '0' : '1';
 
-        /* then we overwrite the default name if we assigned names from name_view */
-        std::string const node_name = topo_ntk.has_name( s ) ? topo_ntk.get_name( s ) : node_default_name;
+      if ( index < topo_ntk.num_cos() - num_latches ) /* the signal f is a PO */
+      {
+        if constexpr ( has_names && has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk> ) /* with name view */
+        {
+          signal const s = topo_ntk.make_signal( topo_ntk.get_node( f ) );
 
-        /* get the default name of PO */
-        std::string default_output_name = fmt::format( "po{}", index );
+          /* the default name depends on whether the signal is a PI or a regular signal,
+             we overwrite it if we assigned names from name_view */
+          std::string_view const node_name = topo_ntk.has_name( s ) ? name_of( s ) : default_node_name( f_node );
 
-        /* over write the name if we have name view */
-        std::string const output_name = topo_ntk.has_output_name( index ) ? topo_ntk.get_output_name( index ) : default_output_name;
+          /* over write the name if we have name view */
+          std::string_view const output_name = topo_ntk.has_output_name( index ) ? output_name_of( index ) : default_name( "po", index );
 
-        /* we need to bridge the nodes */
-        if ( node_name != output_name && defined_names.find( output_name ) == defined_names.end() )
+          /* we need to bridge the nodes */
+          if ( node_name != output_name && !defined_names.contains( output_name ) )
+          {
+            write_bridge( node_name, output_name, minterm );
+            defined_names.insert( output_name );
+          }
+        }
+        else /* without name view */
         {
-          os << fmt::format( ".names {} {}\n{} 1\n", node_name, output_name, minterm_string );
-          defined_names.insert( output_name );
+          /* default output names `po<index>` are unique and differ from node names */
+          out.write( ".names " );
+          write_signal_name( f_node );
+          out.write( " po" );
+          out.write_uint( index );
+          out.put( '\n' );
+          out.put( minterm );
+          out.write( " 1\n" );
         }
       }
-      else /* without name view */
+      else /* the signal f is a RI */
       {
-        std::string const node_name = node_default_name;
-        std::string const output_name = fmt::format( "po{}", index );
-        if ( node_name != output_name && defined_names.find( output_name ) == defined_names.end() )
+        if constexpr ( has_names && has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk> ) /* with name view */
         {
-          os << fmt::format( ".names {} {}\n{} 1\n", node_name, output_name, minterm_string );
-          defined_names.insert( output_name );
+          signal const s = topo_ntk.make_signal( topo_ntk.get_node( f ) );
+
+          /* the default name depends on whether the signal is a PI or a regular signal,
+             we overwrite it if we assigned names from name_view */
+          std::string_view const node_name = topo_ntk.has_name( s ) ? name_of( s ) : default_node_name( f_node );
+
+          /* overwrite the name if we have name view, otherwise use the default name of RI */
+          std::string_view const ri_name = topo_ntk.has_output_name( index ) ? output_name_of( index ) : ( ps.rename_ri_using_node ? node_name : default_name( "li", latch_idx ) );
+
+          /* we need to bridge the nodes */
+          if ( node_name != ri_name && !defined_names.contains( ri_name ) )
+          {
+            write_bridge( node_name, ri_name, minterm );
+            defined_names.insert( ri_name );
+          }
         }
+        else /* without name view */
+        {
+          /* default register input names `li<index>` are unique and differ from node names */
+          if ( !ps.rename_ri_using_node )
+          {
+            out.write( ".names " );
+            write_signal_name( f_node );
+            out.write( " li" );
+            out.write_uint( latch_idx );
+            out.put( '\n' );
+            out.put( minterm );
+            out.write( " 1\n" );
+          }
+        }
+
+        latch_idx++;
       }
-    }
-    else /* the signal f is a RI */
+    } );
+
+    out.write( ".end\n" );
+    out.flush();
+    os << std::flush;
+  }
+
+private:
+  /* ISOP of the node function, shared among nodes with the same function */
+  std::vector<kitty::cube> const& isop( node const& n )
+  {
+    auto func = topo_ntk.node_function( n );
+    auto it = isops.find( func );
+    if ( it == isops.end() )
     {
-      /* the default name depends on whether the signal is a PI or a regular signal */
-      std::string const node_default_name = topo_ntk.is_pi( f_node ) ? fmt::format( "pi{}", f_node ) : fmt::format( "new_n{}", f_node );
+      auto cubes = kitty::isop( func );
+      it = isops.emplace( std::move( func ), std::move( cubes ) ).first;
+    }
+    return it->second;
+  }
 
-      if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> && has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk> ) /* with name view */
+  /* name of a node defined by a `.names` statement; default names use the node, not its topological index */
+  void write_node_name( node const& n )
+  {
+    if constexpr ( has_names )
+    {
+      auto const s = topo_ntk.make_signal( n );
+      if ( topo_ntk.has_name( s ) )
       {
-        signal<Ntk> const s = topo_ntk.make_signal( topo_ntk.get_node( f ) );
+        write_name( name_of( s ) );
+        return;
+      }
+    }
+    write_default_name( detail::blif_defined_names::new_n, n );
+  }
 
-        /* then we overwrite the default name if we assigned names from name_view */
-        std::string const node_name = topo_ntk.has_name( s ) ? topo_ntk.get_name( s ) : node_default_name;
+  /* name of a node used as a fanin */
+  void write_signal_name( node const& n )
+  {
+    if constexpr ( has_names )
+    {
+      signal const s = topo_ntk.make_signal( n );
+      if ( topo_ntk.has_name( s ) )
+      {
+        out.write( name_of( s ) );
+        return;
+      }
+    }
+    out.write( topo_ntk.is_pi( n ) ? "pi" : "new_n" );
+    out.write_uint( n );
+  }
 
-        /* get the default name of RI */
-        std::string default_ri_name = ps.rename_ri_using_node ? node_name : fmt::format( "li{}", latch_idx );
+  /* names are queried without copies if the network supports it */
+  std::string_view name_of( signal const& s )
+  {
+    if constexpr ( has_get_name_view_v<Ntk> )
+    {
+      return topo_ntk.get_name_view( s );
+    }
+    else
+    {
+      name_buffer = topo_ntk.get_name( s );
+      return name_buffer;
+    }
+  }
 
-        /* overwrite the name if we have name view */
-        std::string const ri_name = topo_ntk.has_output_name( index ) ? topo_ntk.get_output_name( index ) : default_ri_name;
+  std::string_view output_name_of( uint32_t index )
+  {
+    if constexpr ( has_get_output_name_view_v<Ntk> )
+    {
+      return topo_ntk.get_output_name_view( index );
+    }
+    else
+    {
+      output_name_buffer = topo_ntk.get_output_name( index );
+      return output_name_buffer;
+    }
+  }
 
-        /* we need to bridge the nodes */
-        if ( node_name != ri_name && defined_names.find( ri_name ) == defined_names.end() )
-        {
-          os << fmt::format( ".names {} {}\n{} 1\n", node_name, ri_name, minterm_string );
-          defined_names.insert( ri_name );
-        }
-      }
-      else /* without name view */
-      {
-        std::string const node_name = node_default_name;
+  /* default output and register input names */
+  std::string_view default_name( char const* prefix, uint64_t index )
+  {
+    default_name_buffer = prefix;
+    default_name_buffer += std::to_string( index );
+    return default_name_buffer;
+  }
 
-        /* get the default name of RI */
-        std::string ri_name = ps.rename_ri_using_node ? node_name : fmt::format( "li{}", latch_idx );
+  std::string_view default_node_name( node const& n )
+  {
+    default_node_name_buffer = topo_ntk.is_pi( n ) ? "pi" : "new_n";
+    default_node_name_buffer += std::to_string( n );
+    return default_node_name_buffer;
+  }
 
-        if ( node_name != ri_name && defined_names.find( ri_name ) == defined_names.end() )
-        {
-          os << fmt::format( ".names {} {}\n{} 1\n", node_name, ri_name, minterm_string );
-          defined_names.insert( ri_name );
-        }
-      }
+  void write_name( std::string_view name )
+  {
+    out.write( name );
+    defined_names.insert( name ); /* we should not have collision here */
+  }
 
-      latch_idx++;
+  void write_default_name( detail::blif_defined_names::prefix prefix, uint64_t index )
+  {
+    out.write( prefix == detail::blif_defined_names::pi ? "pi" : "new_n" );
+    out.write_uint( index );
+    if constexpr ( has_names )
+    {
+      defined_names.insert( prefix, index ); /* we should not have collision here */
     }
-  } );
+  }
+
+  void write_bridge( std::string_view from, std::string_view to, char minterm )
+  {
+    out.write( ".names " );
+    out.write( from );
+    out.put( ' ' );
+    out.write( to );
+    out.put( '\n' );
+    out.put( minterm );
+    out.write( " 1\n" );
+  }
+
+private:
+  topo_view<Ntk> topo_ntk;
+  std::ostream& os;
+  output_buffer out;
+  write_blif_params const& ps;
+
+  blif_defined_names defined_names;
+  std::string name_buffer, output_name_buffer, default_name_buffer, default_node_name_buffer;
+  std::unordered_map<truth_table_t, std::vector<kitty::cube>, kitty::hash<truth_table_t>> isops;
+};
+
+} // namespace detail
+
+/*! \brief Writes network in BLIF format into output stream
+ *
+ * An overloaded variant exists that writes the network into a file.
+ *
+ * **Required network functions:**
+ * - `fanin_size`
+ * - `foreach_fanin`
+ * - `foreach_pi`
+ * - `foreach_po`
+ * - `get_node`
+ * - `is_constant`
+ * - `is_pi`
+ * - `node_function`
+ * - `node_to_index`
+ * - `num_pis`
+ * - `num_pos`
+ *
+ * \param ntk Network
+ * \param os Output stream
+ */
+template<class Ntk>
+void write_blif( Ntk const& ntk, std::ostream& os, write_blif_params const& ps = {} )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+  static_assert( has_is_pi_v<Ntk>, "Ntk does not implement the is_pi method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_num_pis_v<Ntk>, "Ntk does not implement the num_pis method" );
+  static_assert( has_num_pos_v<Ntk>, "Ntk does not implement the num_pos method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( has_node_function_v<Ntk>, "Ntk does not implement the node_function method" );
 
-  os << ".end\n";
-  os << std::flush;
+  detail::write_blif_impl<Ntk> impl( ntk, os, ps );
+  impl.run();
 }
 
 /*! \brief Writes network in BLIF format into a file
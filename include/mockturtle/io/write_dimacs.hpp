@@ -60,17 +60,63 @@
 #include <cstdint>
 #include <fstream>
 #include <iostream>
-#include <sstream>
 #include <string>
 
-#include <fmt/format.h>
-
 #include "../algorithms/cnf.hpp"
 #include "../traits.hpp"
+#include "../utils/file_utils.hpp"
 
 namespace mockturtle
 {
 
+namespace detail
+{
+
+inline void write_dimacs_literal( output_buffer& buffer, uint32_t lit )
+{
+  if ( lit % 2 )
+  {
+    buffer.put( '-' );
+  }
+  buffer.write_uint( ( lit / 2 ) + 1 );
+}
+
+/* The clauses are generated twice: once to count them for the header and once
+ * to write them.  This keeps the memory independent of the size of the CNF. */
+template<class Ntk, class GenerateFn>
+void write_dimacs_impl( Ntk const& ntk, std::ostream& out, GenerateFn&& generate )
+{
+  uint64_t num_clauses = 0u;
+  const auto num_outputs = generate( [&]( std::vector<uint32_t> const& ) {
+                             ++num_clauses;
+                           } ).size();
+  num_clauses += num_outputs;
+
+  output_buffer buffer( out );
+  buffer.write( "p cnf " );
+  buffer.write_uint( ntk.size() );
+  buffer.put( ' ' );
+  buffer.write_uint( num_clauses );
+  buffer.put( '\n' );
+
+  const auto lits = generate( [&]( std::vector<uint32_t> const& clause ) {
+    for ( auto lit : clause )
+    {
+      write_dimacs_literal( buffer, lit );
+      buffer.put( ' ' );
+    }
+    buffer.write( "0\n" );
+  } );
+
+  for ( auto lit : lits )
+  {
+    write_dimacs_literal( buffer, lit );
+    buffer.write( " 0\n" );
+  }
+}
+
+} // namespace detail
+
 /*! \brief Writes network into CNF DIMACS format
  *
  * It also adds unit clauses for the outputs.  Therefore a satisfying solution
@@ -82,29 +128,27 @@ namespace mockturtle
 template<class Ntk>
 void write_dimacs( Ntk const& ntk, std::ostream& out = std::cout )
 {
-  std::stringstream clauses;
-  uint32_t num_clauses = 0u;
-
-  const auto lits = generate_cnf( ntk, [&]( std::vector<uint32_t> const& clause ) {
-    for ( auto lit : clause )
-    {
-      const auto var = ( lit / 2 ) + 1;
-      const auto pol = lit % 2;
-      clauses << fmt::format( "{}{} ", pol ? "-" : "", var );
-    }
-    clauses << fmt::format( "0\n" );
-    ++num_clauses;
+  detail::write_dimacs_impl( ntk, out, [&]( clause_callback_t<uint32_t> const& fn ) {
+    return generate_cnf( ntk, fn );
   } );
+}
 
-  for ( auto lit : lits )
-  {
-    const auto var = ( lit / 2 ) + 1;
-    const auto pol = lit % 2;
-    clauses << fmt::format( "{}{} 0\n", pol ? "-" : "", var );
-    ++num_clauses;
-  }
-
-  out << fmt::format( "p cnf {} {}\n{}", ntk.size(), num_clauses, clauses.str() );
+/*! \brief Writes network into compact CNF DIMACS format
+ *
+ * The clauses are generated with `generate_mapped_cnf`.  Variables of nodes
+ * that are not cut roots remain unconstrained.  As in the Tseytin variant,
+ * unit clauses are added for the outputs.
+ *
+ * \param ntk Logic network
+ * \param out Output stream
+ * \param ps Cut mapping parameters
+ */
+template<class Ntk>
+void write_dimacs( Ntk const& ntk, std::ostream& out, cnf_mapping_params const& ps )
+{
+  detail::write_dimacs_impl( ntk, out, [&]( clause_callback_t<uint32_t> const& fn ) {
+    return generate_mapped_cnf( ntk, fn, ps );
+  } );
 }
 
 /*! \brief Writes network into CNF DIMACS format
@@ -123,4 +167,18 @@ void write_dimacs( Ntk const& ntk, std::string const& filename )
   os.close();
 }
 
+/*! \brief Writes network into compact CNF DIMACS format
+ *
+ * \param ntk Logic network
+ * \param filename Filename
+ * \param ps Cut mapping parameters
+ */
+template<class Ntk>
+void write_dimacs( Ntk const& ntk, std::string const& filename, cnf_mapping_params const& ps )
+{
+  std::ofstream os( filename.c_str(), std::ofstream::out );
+  write_dimacs( ntk, os, ps );
+  os.close();
+}
+
 } /* namespace mockturtle */
\ No newline at end of file
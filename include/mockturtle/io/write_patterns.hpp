@@ -34,14 +34,19 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <kitty/print.hpp>
 
 #include "../algorithms/simulation.hpp"
+#include "../utils/file_utils.hpp"
+#include "read_patterns.hpp"
 
 namespace mockturtle
 {
@@ -84,4 +89,161 @@ void write_patterns( Simulator const& sim, std::string const& filename )
   os.close();
 }
 
+namespace detail
+{
+
+/* writes the patterns `from`, ..., `num_bits() - 1` of every primary input as a chunk */
+inline void write_binary_patterns_chunk( std::vector<kitty::partial_truth_table> const& patterns, uint32_t from, output_buffer& out )
+{
+  uint64_t const num_patterns = patterns.empty() ? 0u : patterns[0].num_bits() - from;
+  out.write( std::string_view( reinterpret_cast<char const*>( &num_patterns ), sizeof( uint64_t ) ) );
+
+  auto const num_words = ( num_patterns + 63u ) / 64u;
+  auto const shift = from & 0x3f;
+  if ( num_words == 0u )
+  {
+    return;
+  }
+  for ( auto const& tt : patterns )
+  {
+    auto const first = tt.cbegin() + ( from >> 6 );
+    if ( shift == 0u )
+    {
+      out.write( std::string_view( reinterpret_cast<char const*>( &*first ), num_words * sizeof( uint64_t ) ) );
+      continue;
+    }
+
+    for ( auto i = 0u; i < num_words; ++i )
+    {
+      uint64_t word = *( first + i ) >> shift;
+      if ( first + i + 1 != tt.cend() )
+      {
+        word |= *( first + i + 1 ) << ( 64u - shift );
+      }
+      out.write( std::string_view( reinterpret_cast<char const*>( &word ), sizeof( uint64_t ) ) );
+    }
+  }
+}
+
+} // namespace detail
+
+/*! \brief Writes simulation patterns in binary format
+ *
+ * The output contains a header and the simulation values of each primary
+ * input as packed 64-bit words (see `read_binary_patterns`).  Binary pattern
+ * files are read by the `partial_simulator` constructor without parsing.
+ *
+ * \param sim The `partial_simulator` or `bit_packed_simulator` object containing simulation patterns
+ * \param os Output stream (should be opened in binary mode)
+ */
+template<class Simulator>
+void write_binary_patterns( Simulator const& sim, std::ostream& os )
+{
+  static_assert( std::is_same_v<Simulator, partial_simulator> || std::is_same_v<Simulator, bit_packed_simulator>, "This function is specialized for partial_simulator or bit_packed_simulator" );
+
+  auto const& patterns = sim.get_patterns();
+  auto const header = detail::make_binary_patterns_header( static_cast<uint32_t>( patterns.size() ), patterns.empty() ? 0u : patterns[0].num_bits(), 1u );
+
+  output_buffer out( os );
+  out.write( std::string_view( reinterpret_cast<char const*>( &header ), sizeof( header ) ) );
+  detail::write_binary_patterns_chunk( patterns, 0u, out );
+  out.flush();
+}
+
+/*! \brief Writes simulation patterns in binary format
+ *
+ * \param sim The `partial_simulator` or `bit_packed_simulator` object containing simulation patterns
+ * \param filename Filename
+ */
+template<class Simulator>
+void write_binary_patterns( Simulator const& sim, std::string const& filename )
+{
+  std::ofstream os( filename.c_str(), std::ofstream::out | std::ofstream::binary );
+  write_binary_patterns( sim, os );
+  os.close();
+}
+
+/*! \brief Appends new simulation patterns to a binary pattern file
+ *
+ * If the simulator has been constructed from this file and the patterns read
+ * from it are unchanged (see `num_file_patterns`), for example because only
+ * counter-examples have been added since, only the patterns that are not yet
+ * in the file are written, as a new chunk at the end of the file.
+ *
+ * Otherwise, e.g., if the file does not exist, if the simulator has been
+ * reseeded, or if it kept only a part of the patterns of the file, the file
+ * is overwritten with all patterns using `write_binary_patterns`.
+ *
+ * \param sim The `partial_simulator` or `bit_packed_simulator` object containing simulation patterns
+ * \param filename Filename
+ * \return Number of patterns written to the file
+ */
+template<class Simulator>
+uint32_t append_binary_patterns( Simulator const& sim, std::string const& filename )
+{
+  static_assert( std::is_same_v<Simulator, partial_simulator> || std::is_same_v<Simulator, bit_packed_simulator>, "This function is specialized for partial_simulator or bit_packed_simulator" );
+
+  auto const& patterns = sim.get_patterns();
+  uint32_t const num_patterns = patterns.empty() ? 0u : patterns[0].num_bits();
+
+  std::fstream fs( filename.c_str(), std::fstream::in | std::fstream::out | std::fstream::binary );
+  detail::binary_patterns_header header;
+  if ( !fs.is_open() || !fs.read( reinterpret_cast<char*>( &header ), sizeof( header ) ) ||
+       !detail::is_binary_patterns_header( header ) || header.num_pis != patterns.size() || sim.num_file_patterns() != header.num_patterns )
+  {
+    fs.close();
+    write_binary_patterns( sim, filename );
+    return num_patterns;
+  }
+
+  if ( header.num_patterns == num_patterns )
+  {
+    return 0u;
+  }
+
+  fs.seekp( 0, std::fstream::end );
+  {
+    output_buffer out( fs );
+    detail::write_binary_patterns_chunk( patterns, static_cast<uint32_t>( header.num_patterns ), out );
+    out.flush();
+  }
+
+  uint32_t const num_appended = num_patterns - static_cast<uint32_t>( header.num_patterns );
+  header.num_patterns = num_patterns;
+  ++header.num_chunks;
+  fs.seekp( 0, std::fstream::beg );
+  fs.write( reinterpret_cast<char const*>( &header ), sizeof( header ) );
+  fs.close();
+  return num_appended;
+}
+
+/*! \brief Saves the simulation patterns of an algorithm
+ *
+ * Writes the patterns with `write_patterns`, or with `write_binary_patterns`
+ * if `binary` is set.  In the binary format, if the simulator has been
+ * constructed from the same file (`pattern_filename`), the patterns added
+ * since are appended with `append_binary_patterns`.
+ *
+ * \param sim The `partial_simulator` or `bit_packed_simulator` object containing simulation patterns
+ * \param filename Filename
+ * \param binary Whether to use the binary format
+ * \param pattern_filename File that the simulator has been constructed from, if any
+ */
+template<class Simulator>
+void save_simulation_patterns( Simulator const& sim, std::string const& filename, bool binary, std::optional<std::string> const& pattern_filename = std::nullopt )
+{
+  if ( !binary )
+  {
+    write_patterns( sim, filename );
+  }
+  else if ( pattern_filename && *pattern_filename == filename )
+  {
+    append_binary_patterns( sim, filename );
+  }
+  else
+  {
+    write_binary_patterns( sim, filename );
+  }
+}
+
 } /* namespace mockturtle */
\ No newline at end of file
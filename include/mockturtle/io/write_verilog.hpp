@@ -36,6 +36,7 @@
 #pragma once
 
 #include "../traits.hpp"
+#include "../utils/file_utils.hpp"
 #include "../utils/node_map.hpp"
 #include "../utils/string_utils.hpp"
 #include "../views/binding_view.hpp"
@@ -43,62 +44,506 @@
 
 #include <fmt/format.h>
 #include <kitty/print.hpp>
-#include <lorina/verilog.hpp>
 
 #include <array>
+#include <cmath>
+#include <deque>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 namespace mockturtle
 {
 
 using namespace std::string_literals;
 
+struct write_verilog_params
+{
+  std::optional<std::string> module_name{ std::nullopt };
+  std::vector<std::pair<std::string, uint32_t>> input_names;
+  std::vector<std::pair<std::string, uint32_t>> output_names;
+  bool verbose{ false };
+};
+
 namespace detail
 {
 
+/*! \brief Name of a net in the Verilog output.
+ *
+ * Names are printed from their parts when written, such that no string is
+ * created per node.  A name is either `text`, `text<index>` (e.g., `n42`),
+ * `text<index>_<output>` (e.g., `n42_1`), or `text[<index>]` (e.g., `x[3]`).
+ */
+struct verilog_name
+{
+  enum class kind : uint8_t
+  {
+    text,
+    index,
+    output,
+    bit
+  };
+
+  static verilog_name named( std::string_view text )
+  {
+    return { text, 0u, 0u, kind::text };
+  }
+
+  static verilog_name indexed( std::string_view prefix, uint64_t index )
+  {
+    return { prefix, index, 0u, kind::index };
+  }
+
+  static verilog_name node_output( uint64_t index, uint32_t output )
+  {
+    return { "n", index, output, kind::output };
+  }
+
+  static verilog_name register_bit( std::string_view name, uint64_t index )
+  {
+    return { name, index, 0u, kind::bit };
+  }
+
+  std::string_view text;
+  uint64_t index;
+  uint32_t output;
+  kind type;
+};
+
+/*! \brief Writes structural Verilog statements into a buffer.
+ *
+ * Provides the statements of `lorina::verilog_writer` in the same format,
+ * but writes names from `verilog_name` into an `output_buffer`.
+ */
+class verilog_output
+{
+public:
+  using fanin_list = std::vector<std::pair<bool, verilog_name>>;
+
+public:
+  explicit verilog_output( std::ostream& os )
+      : _os( os ),
+        _buffer( os )
+  {
+  }
+
+  void on_module_begin( std::string_view name, std::vector<verilog_name> const& xs, std::vector<verilog_name> const& ys )
+  {
+    _buffer.write( "module " );
+    _buffer.write( name );
+    _buffer.write( "( " );
+    bool first = true;
+    for ( auto const& list : { &xs, &ys } )
+    {
+      for ( auto const& x : *list )
+      {
+        if ( !first )
+        {
+          _buffer.write( " , " );
+        }
+        first = false;
+        write_name( x );
+      }
+    }
+    _buffer.write( " );\n" );
+  }
+
+  void on_declaration( std::string_view keyword, std::vector<verilog_name> const& names )
+  {
+    begin_declaration( keyword );
+    for ( auto const& name : names )
+    {
+      add_to_declaration( name );
+    }
+    end_declaration();
+  }
+
+  void on_declaration( std::string_view keyword, uint32_t width, std::string_view name )
+  {
+    _buffer.write( "  " );
+    _buffer.write( keyword );
+    _buffer.write( " [" );
+    _buffer.write_uint( static_cast<uint32_t>( width - 1u ) );
+    _buffer.write( ":0] " );
+    _buffer.write( name );
+    _buffer.write( " ;\n" );
+  }
+
+  /*! \brief Starts a declaration whose names are added one by one. */
+  void begin_declaration( std::string_view keyword )
+  {
+    _buffer.write( "  " );
+    _buffer.write( keyword );
+    _buffer.put( ' ' );
+    _first = true;
+  }
+
+  void add_to_declaration( verilog_name const& name )
+  {
+    if ( !_first )
+    {
+      _buffer.write( " , " );
+    }
+    _first = false;
+    write_name( name );
+  }
+
+  void end_declaration()
+  {
+    _buffer.write( " ;\n" );
+  }
+
+  void on_module_end()
+  {
+    _buffer.write( "endmodule\n" );
+    _buffer.flush();
+    _os.flush();
+  }
+
+  /*! \brief Starts a module instantiation, padding the module name to `width` characters. */
+  void begin_instance( std::string_view module_name, std::size_t width )
+  {
+    _buffer.write( "  " );
+    _buffer.write( module_name );
+    for ( auto i = module_name.size(); i < width; ++i )
+    {
+      _buffer.put( ' ' );
+    }
+    _buffer.put( ' ' );
+  }
+
+  /*! \brief Writes the instance name `<prefix><name>`. */
+  void instance_name( std::string_view prefix, verilog_name const& name )
+  {
+    _buffer.write( prefix );
+    write_name( name );
+    _buffer.write( "( " );
+    _first = true;
+  }
+
+  /*! \brief Writes the instance name `g<counter>`, with `zeros` leading zeros. */
+  void instance_name( int zeros, uint64_t counter )
+  {
+    _buffer.put( 'g' );
+    for ( auto i = 0; i < zeros; ++i )
+    {
+      _buffer.put( '0' );
+    }
+    _buffer.write_uint( counter );
+    _buffer.write( "( " );
+    _first = true;
+  }
+
+  void add_pin( std::string_view pin, verilog_name const& net )
+  {
+    if ( !_first )
+    {
+      _buffer.write( ", " );
+    }
+    _first = false;
+    _buffer.put( '.' );
+    _buffer.write( pin );
+    _buffer.write( " (" );
+    write_name( net );
+    _buffer.put( ')' );
+  }
+
+  void end_instance()
+  {
+    _buffer.write( " );\n" );
+  }
+
+  void on_assign( verilog_name const& out, fanin_list const& ins, char op )
+  {
+    begin_assign( out );
+    for ( auto i = 0u; i < ins.size(); ++i )
+    {
+      if ( i != 0u )
+      {
+        _buffer.put( ' ' );
+        _buffer.put( op );
+        _buffer.put( ' ' );
+      }
+      write_literal( ins[i] );
+    }
+    _buffer.write( " ;\n" );
+  }
+
+  void on_assign_maj3( verilog_name const& out, fanin_list const& ins )
+  {
+    assert( ins.size() == 3u );
+    begin_assign( out );
+    _buffer.write( "( " );
+    write_literal( ins[0] );
+    _buffer.write( " & " );
+    write_literal( ins[1] );
+    _buffer.write( " ) | ( " );
+    write_literal( ins[0] );
+    _buffer.write( " & " );
+    write_literal( ins[2] );
+    _buffer.write( " ) | ( " );
+    write_literal( ins[1] );
+    _buffer.write( " & " );
+    write_literal( ins[2] );
+    _buffer.write( " ) ;\n" );
+  }
+
+  void on_assign_mux21( verilog_name const& out, fanin_list const& ins )
+  {
+    assert( ins.size() == 3u );
+    begin_assign( out );
+    write_literal( ins[0] );
+    _buffer.write( " ? " );
+    write_literal( ins[1] );
+    _buffer.write( " : " );
+    write_literal( ins[2] );
+    _buffer.write( " ;\n" );
+  }
+
+  void on_assign_unknown_gate( verilog_name const& out )
+  {
+    begin_assign( out );
+    _buffer.write( "unknown gate;\n" );
+  }
+
+  void on_assign_po( verilog_name const& out, std::pair<bool, verilog_name> const& in )
+  {
+    begin_assign( out );
+    write_literal( in );
+    _buffer.write( " ;\n" );
+  }
+
+private:
+  void begin_assign( verilog_name const& out )
+  {
+    _buffer.write( "  assign " );
+    write_name( out );
+    _buffer.write( " = " );
+  }
+
+  void write_literal( std::pair<bool, verilog_name> const& literal )
+  {
+    if ( literal.first )
+    {
+      _buffer.put( '~' );
+    }
+    write_name( literal.second );
+  }
+
+  void write_name( verilog_name const& name )
+  {
+    _buffer.write( name.text );
+    switch ( name.type )
+    {
+    case verilog_name::kind::text:
+      break;
+    case verilog_name::kind::index:
+      _buffer.write_uint( name.index );
+      break;
+    case verilog_name::kind::output:
+      _buffer.write_uint( name.index );
+      _buffer.put( '_' );
+      _buffer.write_uint( name.output );
+      break;
+    case verilog_name::kind::bit:
+      _buffer.put( '[' );
+      _buffer.write_uint( name.index );
+      _buffer.put( ']' );
+      break;
+    }
+  }
+
+private:
+  std::ostream& _os;
+  output_buffer _buffer;
+  bool _first{ true };
+};
+
+/*! \brief Names of the primary inputs and outputs.
+ *
+ * `xs` and `ys` name the individual bits, `inputs` and `outputs` are the
+ * ports in the module header.  Names taken from the network are stored in
+ * `storage`, unless the network can return views of its names.
+ */
+struct verilog_ports
+{
+  std::vector<verilog_name> xs, inputs;
+  std::vector<verilog_name> ys, outputs;
+  std::deque<std::string> storage;
+};
+
 template<class Ntk>
-std::vector<std::pair<bool, std::string>>
-format_fanin( Ntk const& ntk, node<Ntk> const& n, node_map<std::string, Ntk>& node_names )
+void compute_verilog_ports( Ntk const& ntk, write_verilog_params const& ps, verilog_ports& ports )
 {
-  std::vector<std::pair<bool, std::string>> children;
-  ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
-    if constexpr ( is_crossed_network_type_v<Ntk> )
+  if ( ps.input_names.empty() )
+  {
+    ntk.foreach_pi( [&]( auto const& i, uint32_t index ) {
+      (void)i;
+      if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
+      {
+        if ( ntk.has_name( ntk.make_signal( i ) ) )
+        {
+          if constexpr ( has_get_name_view_v<Ntk> )
+          {
+            ports.xs.emplace_back( verilog_name::named( ntk.get_name_view( ntk.make_signal( i ) ) ) );
+          }
+          else
+          {
+            ports.xs.emplace_back( verilog_name::named( ports.storage.emplace_back( ntk.get_name( ntk.make_signal( i ) ) ) ) );
+          }
+          return;
+        }
+      }
+      ports.xs.emplace_back( verilog_name::indexed( "x", index ) );
+    } );
+    ports.inputs = ports.xs;
+  }
+  else
+  {
+    uint32_t ctr{ 0u };
+    for ( auto const& [name, width] : ps.input_names )
     {
-      std::string postfix = ntk.is_crossing( ntk.get_node( f ) ) ? ( ntk.is_second( f ) ? "_2" : "_1" ) : "";
-      children.emplace_back( std::make_pair( ntk.get_fanin_negations( n )[i], node_names[f] + postfix ) );
+      ports.inputs.emplace_back( verilog_name::named( name ) );
+      ctr += width;
+      for ( auto i = 0u; i < width; ++i )
+      {
+        ports.xs.emplace_back( verilog_name::register_bit( name, i ) );
+      }
     }
-    else
+    if ( ctr != ntk.num_pis() )
     {
-      children.emplace_back( std::make_pair( ntk.is_complemented( f ), node_names[f] ) );
+      std::cerr << "[e] input names do not partition all inputs\n";
     }
-  } );
-  return children;
+  }
+
+  if ( ps.output_names.empty() )
+  {
+    ntk.foreach_po( [&]( auto const& o, uint32_t index ) {
+      (void)o;
+      if constexpr ( has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk> )
+      {
+        if ( ntk.has_output_name( index ) )
+        {
+          if constexpr ( has_get_output_name_view_v<Ntk> )
+          {
+            ports.ys.emplace_back( verilog_name::named( ntk.get_output_name_view( index ) ) );
+          }
+          else
+          {
+            ports.ys.emplace_back( verilog_name::named( ports.storage.emplace_back( ntk.get_output_name( index ) ) ) );
+          }
+          return;
+        }
+      }
+      ports.ys.emplace_back( verilog_name::indexed( "y", index ) );
+    } );
+    ports.outputs = ports.ys;
+  }
+  else
+  {
+    uint32_t ctr{ 0u };
+    for ( auto const& [name, width] : ps.output_names )
+    {
+      ports.outputs.emplace_back( verilog_name::named( name ) );
+      ctr += width;
+      for ( auto i = 0u; i < width; ++i )
+      {
+        ports.ys.emplace_back( verilog_name::register_bit( name, i ) );
+      }
+    }
+    if ( ctr != ntk.num_pos() )
+    {
+      std::cerr << "[e] output names do not partition all outputs\n";
+    }
+  }
 }
 
+/* writes the module header and the input and output declarations */
 template<class Ntk>
-std::vector<std::pair<bool, std::string>>
-format_fanin( Ntk const& ntk, node<Ntk> const& n, node_map<std::vector<std::string>, Ntk>& node_names )
+void write_verilog_header( Ntk const& ntk, verilog_output& out, verilog_ports const& ports, write_verilog_params const& ps )
 {
-  std::vector<std::pair<bool, std::string>> children;
+  std::string module_name = "top";
+  if ( ps.module_name )
+  {
+    module_name = *ps.module_name;
+  }
+  else
+  {
+    if constexpr ( has_get_network_name_v<Ntk> )
+    {
+      if ( ntk.get_network_name().length() > 0 )
+      {
+        module_name = ntk.get_network_name();
+      }
+    }
+  }
+  out.on_module_begin( module_name, ports.inputs, ports.outputs );
+
+  if ( ps.input_names.empty() )
+  {
+    out.on_declaration( "input", ports.xs );
+  }
+  else
+  {
+    for ( auto const& [name, width] : ps.input_names )
+    {
+      out.on_declaration( "input", width, name );
+    }
+  }
+  if ( ps.output_names.empty() )
+  {
+    out.on_declaration( "output", ports.ys );
+  }
+  else
+  {
+    for ( auto const& [name, width] : ps.output_names )
+    {
+      out.on_declaration( "output", width, name );
+    }
+  }
+}
+
+template<class Ntk>
+void format_fanin( Ntk const& ntk, node<Ntk> const& n, node_map<verilog_name, Ntk> const& node_names, verilog_output::fanin_list& children )
+{
+  children.clear();
   ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
     if constexpr ( is_crossed_network_type_v<Ntk> )
     {
-      std::string postfix = ntk.is_crossing( ntk.get_node( f ) ) ? ( ntk.is_second( f ) ? "_2" : "_1" ) : "";
-      children.emplace_back( std::make_pair( ntk.get_fanin_negations( n )[i], node_names[f].front() + postfix ) );
+      auto name = node_names[f];
+      if ( ntk.is_crossing( ntk.get_node( f ) ) )
+      {
+        name = verilog_name::node_output( name.index, ntk.is_second( f ) ? 2u : 1u );
+      }
+      children.emplace_back( ntk.get_fanin_negations( n )[i], name );
     }
-    else if constexpr ( has_is_multioutput_v<Ntk> )
+    else
     {
-      children.emplace_back( std::make_pair( ntk.is_complemented( f ), node_names[f][ntk.get_output_pin( f )] ) );
+      (void)i;
+      children.emplace_back( ntk.is_complemented( f ), node_names[f] );
+    }
+  } );
+}
+
+/* node names for multi-output nodes, `first_name[n]` is the index of the name of the first output of `n` */
+template<class Ntk>
+void format_fanin( Ntk const& ntk, node<Ntk> const& n, node_map<uint32_t, Ntk> const& first_name, std::vector<verilog_name> const& names, verilog_output::fanin_list& children )
+{
+  children.clear();
+  ntk.foreach_fanin( n, [&]( auto const& f ) {
+    if constexpr ( has_is_multioutput_v<Ntk> )
+    {
+      children.emplace_back( ntk.is_complemented( f ), names[first_name[f] + ntk.get_output_pin( f )] );
     }
     else
     {
-      children.emplace_back( std::make_pair( ntk.is_complemented( f ), node_names[f].front() ) );
+      children.emplace_back( ntk.is_complemented( f ), names[first_name[f]] );
     }
   } );
-  return children;
 }
 
 template<typename Signal>
@@ -112,14 +557,6 @@ struct verilog_writer_signal_hash
 
 } // namespace detail
 
-struct write_verilog_params
-{
-  std::optional<std::string> module_name{ std::nullopt };
-  std::vector<std::pair<std::string, uint32_t>> input_names;
-  std::vector<std::pair<std::string, uint32_t>> output_names;
-  bool verbose{ false };
-};
-
 /*! \brief Writes network in structural Verilog format into output stream
  *
  * An overloaded variant exists that writes the network into a file.
@@ -168,184 +605,77 @@ void write_verilog( Ntk const& ntk, std::ostream& os, write_verilog_params const
 
   assert( ntk.is_combinational() && "Network has to be combinational" );
 
-  lorina::verilog_writer writer( os );
+  using detail::verilog_name;
+  detail::verilog_output writer( os );
 
   if constexpr ( is_buffered_network_type_v<Ntk> )
   {
-    writer.on_module_begin( "buffer", { "i" }, { "o" } );
-    writer.on_input( "i" );
-    writer.on_output( "o" );
+    std::vector<verilog_name> const i{ verilog_name::named( "i" ) }, o{ verilog_name::named( "o" ) };
+    writer.on_module_begin( "buffer", i, o );
+    writer.on_declaration( "input", i );
+    writer.on_declaration( "output", o );
     writer.on_module_end();
 
-    writer.on_module_begin( "inverter", { "i" }, { "o" } );
-    writer.on_input( "i" );
-    writer.on_output( "o" );
+    writer.on_module_begin( "inverter", i, o );
+    writer.on_declaration( "input", i );
+    writer.on_declaration( "output", o );
     writer.on_module_end();
   }
-  if constexpr ( is_crossed_network_type_v<Ntk> )
-  {
-    writer.on_module_begin( "crossing", { "i1", "i2" }, { "o1", "o2" } );
-    writer.on_input( std::vector<std::string>( { "i1", "i2" } ) );
-    writer.on_output( std::vector<std::string>( { "o1", "o2" } ) );
-    writer.on_module_end();
-  }
-
-  std::vector<std::string> xs, inputs;
-  if ( ps.input_names.empty() )
-  {
-    if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
-    {
-      ntk.foreach_pi( [&]( auto const& i, uint32_t index ) {
-        if ( ntk.has_name( ntk.make_signal( i ) ) )
-        {
-          xs.emplace_back( ntk.get_name( ntk.make_signal( i ) ) );
-        }
-        else
-        {
-          xs.emplace_back( fmt::format( "x{}", index ) );
-        }
-      } );
-    }
-    else
-    {
-      ntk.foreach_pi( [&]( auto const& i, uint32_t index ) {
-        (void)i;
-        xs.emplace_back( fmt::format( "x{}", index ) );
-      } );
-    }
-    inputs = xs;
-  }
-  else
-  {
-    uint32_t ctr{ 0u };
-    for ( auto const& [name, width] : ps.input_names )
-    {
-      inputs.emplace_back( name );
-      ctr += width;
-      for ( auto i = 0u; i < width; ++i )
-      {
-        xs.emplace_back( fmt::format( "{}[{}]", name, i ) );
-      }
-    }
-    if ( ctr != ntk.num_pis() )
-    {
-      std::cerr << "[e] input names do not partition all inputs\n";
-    }
-  }
-
-  std::vector<std::string> ys, outputs;
-  if ( ps.output_names.empty() )
-  {
-    if constexpr ( has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk> )
-    {
-      ntk.foreach_po( [&]( auto const& o, uint32_t index ) {
-        if ( ntk.has_output_name( index ) )
-        {
-          ys.emplace_back( ntk.get_output_name( index ) );
-        }
-        else
-        {
-          ys.emplace_back( fmt::format( "y{}", index ) );
-        }
-      } );
-    }
-    else
-    {
-      ntk.foreach_po( [&]( auto const& o, uint32_t index ) {
-        (void)o;
-        ys.emplace_back( fmt::format( "y{}", index ) );
-      } );
-    }
-    outputs = ys;
-  }
-  else
-  {
-    uint32_t ctr{ 0u };
-    for ( auto const& [name, width] : ps.output_names )
-    {
-      outputs.emplace_back( name );
-      ctr += width;
-      for ( auto i = 0u; i < width; ++i )
-      {
-        ys.emplace_back( fmt::format( "{}[{}]", name, i ) );
-      }
-    }
-    if ( ctr != ntk.num_pos() )
-    {
-      std::cerr << "[e] output names do not partition all outputs\n";
-    }
-  }
-
-  std::vector<std::string> ws;
-
-  if constexpr ( is_buffered_network_type_v<Ntk> )
-  {
-    static_assert( has_is_buf_v<Ntk>, "Ntk does not implement the is_buf method" );
-    ntk.foreach_node( [&]( auto const& n ) {
-      if ( ntk.fanin_size( n ) > 0 )
-        ws.emplace_back( fmt::format( "n{}", ntk.node_to_index( n ) ) );
-    } );
-  }
-  else
-  {
-    ntk.foreach_gate( [&]( auto const& n ) {
-      ws.emplace_back( fmt::format( "n{}", ntk.node_to_index( n ) ) );
-    } );
-  }
-
-  std::string module_name = "top";
-  if ( ps.module_name )
-  {
-    module_name = *ps.module_name;
-  }
-  else
-  {
-    if constexpr ( has_get_network_name_v<Ntk> )
-    {
-      if ( ntk.get_network_name().length() > 0 )
-      {
-        module_name = ntk.get_network_name();
-      }
-    }
-  }
-  writer.on_module_begin( module_name, inputs, outputs );
-
-  if ( ps.input_names.empty() )
+  if constexpr ( is_crossed_network_type_v<Ntk> )
   {
-    writer.on_input( xs );
+    std::vector<verilog_name> const i{ verilog_name::named( "i1" ), verilog_name::named( "i2" ) };
+    std::vector<verilog_name> const o{ verilog_name::named( "o1" ), verilog_name::named( "o2" ) };
+    writer.on_module_begin( "crossing", i, o );
+    writer.on_declaration( "input", i );
+    writer.on_declaration( "output", o );
+    writer.on_module_end();
   }
-  else
-  {
-    for ( auto const& [name, width] : ps.input_names )
+
+  detail::verilog_ports ports;
+  detail::compute_verilog_ports( ntk, ps, ports );
+  detail::write_verilog_header( ntk, writer, ports, ps );
+
+  /* wires */
+  bool has_wires = false;
+  auto const add_wire = [&]( auto const& n ) {
+    if ( !has_wires )
     {
-      writer.on_input( width, name );
+      writer.begin_declaration( "wire" );
+      has_wires = true;
     }
-  }
-  if ( ps.output_names.empty() )
+    writer.add_to_declaration( verilog_name::indexed( "n", ntk.node_to_index( n ) ) );
+  };
+  if constexpr ( is_buffered_network_type_v<Ntk> )
   {
-    writer.on_output( ys );
+    static_assert( has_is_buf_v<Ntk>, "Ntk does not implement the is_buf method" );
+    ntk.foreach_node( [&]( auto const& n ) {
+      if ( ntk.fanin_size( n ) > 0 )
+        add_wire( n );
+    } );
   }
   else
   {
-    for ( auto const& [name, width] : ps.output_names )
-    {
-      writer.on_output( width, name );
-    }
+    ntk.foreach_gate( add_wire );
   }
-  if ( !ws.empty() )
+  if ( has_wires )
   {
-    writer.on_wire( ws );
+    writer.end_declaration();
   }
 
-  node_map<std::string, Ntk> node_names( ntk );
-  node_names[ntk.get_constant( false )] = "1'b0";
+  node_map<verilog_name, Ntk> node_names( ntk );
+  node_names[ntk.get_constant( false )] = verilog_name::named( "1'b0" );
   if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
-    node_names[ntk.get_constant( true )] = "1'b1";
+    node_names[ntk.get_constant( true )] = verilog_name::named( "1'b1" );
 
   ntk.foreach_pi( [&]( auto const& n, auto i ) {
-    node_names[n] = xs[i];
+    node_names[n] = ports.xs[i];
   } );
 
+  detail::verilog_output::fanin_list fanin;
+  auto const literal = [&]( signal<Ntk> const& f, bool complement ) {
+    return std::make_pair( complement, node_names[ntk.get_node( f )] );
+  };
+
   topo_view ntk_topo{ ntk };
 
   ntk_topo.foreach_node( [&]( auto const& n ) {
@@ -353,27 +683,27 @@ void write_verilog( Ntk const& ntk, std::ostream& os, write_verilog_params const
       return true;
 
     /* assign a name */
-    node_names[n] = fmt::format( "n{}", ntk.node_to_index( n ) );
+    node_names[n] = verilog_name::indexed( "n", ntk.node_to_index( n ) );
 
     if constexpr ( has_is_buf_v<Ntk> )
     {
       if ( ntk.is_buf( n ) )
       {
-        auto const fanin = detail::format_fanin<Ntk>( ntk, n, node_names );
+        detail::format_fanin<Ntk>( ntk, n, node_names, fanin );
         assert( fanin.size() == 1 );
-        std::vector<std::pair<std::string, std::string>> args;
         if ( fanin[0].first ) /* input negated */
         {
-          args.emplace_back( std::make_pair( "i", fanin[0].second ) );
-          args.emplace_back( std::make_pair( "o", node_names[n] ) );
-          writer.on_module_instantiation( "inverter", {}, "inv_" + node_names[n], args );
+          writer.begin_instance( "inverter", 0u );
+          writer.instance_name( "inv_", node_names[n] );
         }
         else
         {
-          args.emplace_back( std::make_pair( "i", fanin[0].second ) );
-          args.emplace_back( std::make_pair( "o", node_names[n] ) );
-          writer.on_module_instantiation( "buffer", {}, "buf_" + node_names[n], args );
+          writer.begin_instance( "buffer", 0u );
+          writer.instance_name( "buf_", node_names[n] );
         }
+        writer.add_pin( "i", fanin[0].second );
+        writer.add_pin( "o", node_names[n] );
+        writer.end_instance();
         return true;
       }
     }
@@ -382,29 +712,33 @@ void write_verilog( Ntk const& ntk, std::ostream& os, write_verilog_params const
     {
       if ( ntk.is_crossing( n ) )
       {
-        auto const fanin = detail::format_fanin<Ntk>( ntk, n, node_names );
+        detail::format_fanin<Ntk>( ntk, n, node_names, fanin );
         assert( fanin.size() == 2 );
-        std::vector<std::pair<std::string, std::string>> args;
-        args.emplace_back( std::make_pair( "i1", fanin[0].second ) );
-        args.emplace_back( std::make_pair( "i2", fanin[1].second ) );
-        args.emplace_back( std::make_pair( "o1", node_names[n] + "_1" ) );
-        args.emplace_back( std::make_pair( "o2", node_names[n] + "_2" ) );
-        writer.on_module_instantiation( "crossing", {}, "cross_" + node_names[n], args );
+        writer.begin_instance( "crossing", 0u );
+        writer.instance_name( "cross_", node_names[n] );
+        writer.add_pin( "i1", fanin[0].second );
+        writer.add_pin( "i2", fanin[1].second );
+        writer.add_pin( "o1", verilog_name::node_output( ntk.node_to_index( n ), 1u ) );
+        writer.add_pin( "o2", verilog_name::node_output( ntk.node_to_index( n ), 2u ) );
+        writer.end_instance();
         return true;
       }
     }
 
     if ( ntk.is_and( n ) )
     {
-      writer.on_assign( node_names[n], detail::format_fanin<Ntk>( ntk, n, node_names ), "&" );
+      detail::format_fanin<Ntk>( ntk, n, node_names, fanin );
+      writer.on_assign( node_names[n], fanin, '&' );
     }
     else if ( ntk.is_or( n ) )
     {
-      writer.on_assign( node_names[n], detail::format_fanin<Ntk>( ntk, n, node_names ), "|" );
+      detail::format_fanin<Ntk>( ntk, n, node_names, fanin );
+      writer.on_assign( node_names[n], fanin, '|' );
     }
     else if ( ntk.is_xor( n ) || ntk.is_xor3( n ) )
     {
-      writer.on_assign( node_names[n], detail::format_fanin<Ntk>( ntk, n, node_names ), "^" );
+      detail::format_fanin<Ntk>( ntk, n, node_names, fanin );
+      writer.on_assign( node_names[n], fanin, '^' );
     }
     else if ( ntk.is_maj( n ) )
     {
@@ -413,24 +747,25 @@ void write_verilog( Ntk const& ntk, std::ostream& os, write_verilog_params const
 
       if ( ntk.is_constant( ntk.get_node( children[0u] ) ) )
       {
-        std::vector<std::pair<bool, std::string>> vs;
-        vs.emplace_back( std::make_pair( ntk.is_complemented( children[1u] ), node_names[ntk.get_node( children[1u] )] ) );
-        vs.emplace_back( std::make_pair( ntk.is_complemented( children[2u] ), node_names[ntk.get_node( children[2u] )] ) );
+        fanin.clear();
+        fanin.emplace_back( literal( children[1u], ntk.is_complemented( children[1u] ) ) );
+        fanin.emplace_back( literal( children[2u], ntk.is_complemented( children[2u] ) ) );
 
         if ( ntk.is_complemented( children[0u] ) )
         {
           // or
-          writer.on_assign( node_names[n], { vs[0u], vs[1u] }, "|" );
+          writer.on_assign( node_names[n], fanin, '|' );
         }
         else
         {
           // and
-          writer.on_assign( node_names[n], { vs[0u], vs[1u] }, "&" );
+          writer.on_assign( node_names[n], fanin, '&' );
         }
       }
       else
       {
-        writer.on_assign_maj3( node_names[n], detail::format_fanin<Ntk>( ntk, n, node_names ) );
+        detail::format_fanin<Ntk>( ntk, n, node_names, fanin );
+        writer.on_assign_maj3( node_names[n], fanin );
       }
     }
     else if ( ntk.is_ite( n ) )
@@ -442,23 +777,24 @@ void write_verilog( Ntk const& ntk, std::ostream& os, write_verilog_params const
       {
         assert( children[1u] == ntk.get_constant( false ) );
         // a ? 0 : c = ~a & c
-        std::vector<std::pair<bool, std::string>> ins;
-        ins.emplace_back( std::make_pair( !ntk.is_complemented( children[0u] ), node_names[ntk.get_node( children[0u] )] ) );
-        ins.emplace_back( std::make_pair( ntk.is_complemented( children[2u] ), node_names[ntk.get_node( children[2u] )] ) );
-        writer.on_assign( node_names[n], ins, "&" );
+        fanin.clear();
+        fanin.emplace_back( literal( children[0u], !ntk.is_complemented( children[0u] ) ) );
+        fanin.emplace_back( literal( children[2u], ntk.is_complemented( children[2u] ) ) );
+        writer.on_assign( node_names[n], fanin, '&' );
       }
       else if ( ntk.get_node( children[1u] ) == ntk.get_node( children[2u] ) )
       {
         assert( !ntk.is_complemented( children[1u] ) && ntk.is_complemented( children[2u] ) );
         // a ? b : ~b = a ^ ~b
-        std::vector<std::pair<bool, std::string>> ins;
-        ins.emplace_back( std::make_pair( ntk.is_complemented( children[0u] ), node_names[ntk.get_node( children[0u] )] ) );
-        ins.emplace_back( std::make_pair( ntk.is_complemented( children[2u] ), node_names[ntk.get_node( children[2u] )] ) );
-        writer.on_assign( node_names[n], ins, "^" );
+        fanin.clear();
+        fanin.emplace_back( literal( children[0u], ntk.is_complemented( children[0u] ) ) );
+        fanin.emplace_back( literal( children[2u], ntk.is_complemented( children[2u] ) ) );
+        writer.on_assign( node_names[n], fanin, '^' );
       }
       else
       {
-        writer.on_assign_mux21( node_names[n], detail::format_fanin<Ntk>( ntk, n, node_names ) );
+        detail::format_fanin<Ntk>( ntk, n, node_names, fanin );
+        writer.on_assign_mux21( node_names[n], fanin );
       }
     }
     else
@@ -467,7 +803,8 @@ void write_verilog( Ntk const& ntk, std::ostream& os, write_verilog_params const
       {
         if ( ntk.is_nary_and( n ) )
         {
-          writer.on_assign( node_names[n], detail::format_fanin<Ntk>( ntk, n, node_names ), "&" );
+          detail::format_fanin<Ntk>( ntk, n, node_names, fanin );
+          writer.on_assign( node_names[n], fanin, '&' );
           return true;
         }
       }
@@ -475,7 +812,8 @@ void write_verilog( Ntk const& ntk, std::ostream& os, write_verilog_params const
       {
         if ( ntk.is_nary_or( n ) )
         {
-          writer.on_assign( node_names[n], detail::format_fanin<Ntk>( ntk, n, node_names ), "|" );
+          detail::format_fanin<Ntk>( ntk, n, node_names, fanin );
+          writer.on_assign( node_names[n], fanin, '|' );
           return true;
         }
       }
@@ -483,7 +821,8 @@ void write_verilog( Ntk const& ntk, std::ostream& os, write_verilog_params const
       {
         if ( ntk.is_nary_xor( n ) )
         {
-          writer.on_assign( node_names[n], detail::format_fanin<Ntk>( ntk, n, node_names ), "^" );
+          detail::format_fanin<Ntk>( ntk, n, node_names, fanin );
+          writer.on_assign( node_names[n], fanin, '^' );
           return true;
         }
       }
@@ -498,7 +837,7 @@ void write_verilog( Ntk const& ntk, std::ostream& os, write_verilog_params const
   } );
 
   ntk.foreach_po( [&]( auto const& f, auto i ) {
-    writer.on_assign_po( ys[i], std::make_pair( ntk.is_complemented( f ), node_names[f] ) );
+    writer.on_assign_po( ports.ys[i], std::make_pair( ntk.is_complemented( f ), node_names[f] ) );
   } );
 
   writer.on_module_end();
@@ -543,93 +882,11 @@ void write_verilog_with_binding( Ntk const& ntk, std::ostream& os, write_verilog
 
   assert( ntk.is_combinational() && "Network has to be combinational" );
 
-  lorina::verilog_writer writer( os );
-
-  std::vector<std::string> xs, inputs;
-  if ( ps.input_names.empty() )
-  {
-    if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
-    {
-      ntk.foreach_pi( [&]( auto const& i, uint32_t index ) {
-        if ( ntk.has_name( ntk.make_signal( i ) ) )
-        {
-          xs.emplace_back( ntk.get_name( ntk.make_signal( i ) ) );
-        }
-        else
-        {
-          xs.emplace_back( fmt::format( "x{}", index ) );
-        }
-      } );
-    }
-    else
-    {
-      for ( auto i = 0u; i < ntk.num_pis(); ++i )
-      {
-        xs.emplace_back( fmt::format( "x{}", i ) );
-      }
-    }
-    inputs = xs;
-  }
-  else
-  {
-    uint32_t ctr{ 0u };
-    for ( auto const& [name, width] : ps.input_names )
-    {
-      inputs.emplace_back( name );
-      ctr += width;
-      for ( auto i = 0u; i < width; ++i )
-      {
-        xs.emplace_back( fmt::format( "{}[{}]", name, i ) );
-      }
-    }
-    if ( ctr != ntk.num_pis() )
-    {
-      std::cerr << "[e] input names do not partition all inputs\n";
-    }
-  }
+  using detail::verilog_name;
+  detail::verilog_output writer( os );
 
-  std::vector<std::string> ys, outputs;
-  if ( ps.output_names.empty() )
-  {
-    if constexpr ( has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk> )
-    {
-      ntk.foreach_po( [&]( auto const& o, uint32_t index ) {
-        if ( ntk.has_output_name( index ) )
-        {
-          ys.emplace_back( ntk.get_output_name( index ) );
-        }
-        else
-        {
-          ys.emplace_back( fmt::format( "y{}", index ) );
-        }
-      } );
-    }
-    else
-    {
-      for ( auto i = 0u; i < ntk.num_pos(); ++i )
-      {
-        ys.emplace_back( fmt::format( "y{}", i ) );
-      }
-    }
-    outputs = ys;
-  }
-  else
-  {
-    uint32_t ctr{ 0u };
-    for ( auto const& [name, width] : ps.output_names )
-    {
-      outputs.emplace_back( name );
-      ctr += width;
-      for ( auto i = 0u; i < width; ++i )
-      {
-        ys.emplace_back( fmt::format( "{}[{}]", name, i ) );
-      }
-    }
-    if ( ctr != ntk.num_pos() )
-    {
-      std::cerr << "[e] output names do not partition all outputs\n";
-    }
-  }
+  detail::verilog_ports ports;
+  detail::compute_verilog_ports( ntk, ps, ports );
 
   /* compute which nodes are POs and register index */
   node_map<std::vector<uint32_t>, Ntk, std::unordered_map<typename Ntk::node, std::vector<uint32_t>>> po_nodes( ntk );
@@ -637,35 +894,47 @@ void write_verilog_with_binding( Ntk const& ntk, std::ostream& os, write_verilog
     po_nodes[f].push_back( i );
   } );
 
-  std::vector<std::string> ws;
-  node_map<std::string, Ntk> node_names( ntk );
+  detail::write_verilog_header( ntk, writer, ports, ps );
+
+  /* wires */
+  bool has_wires = false;
+  auto const add_wire = [&]( auto const& n ) {
+    if ( !has_wires )
+    {
+      writer.begin_declaration( "wire" );
+      has_wires = true;
+    }
+    writer.add_to_declaration( verilog_name::indexed( "n", ntk.node_to_index( n ) ) );
+  };
+
+  node_map<verilog_name, Ntk> node_names( ntk );
 
   /* constants */
   if ( ntk.has_binding( ntk.get_constant( false ) ) )
   {
-    node_names[ntk.get_constant( false )] = fmt::format( "n{}", ntk.node_to_index( ntk.get_constant( false ) ) );
+    node_names[ntk.get_constant( false )] = verilog_name::indexed( "n", ntk.node_to_index( ntk.get_constant( false ) ) );
     if ( !po_nodes.has( ntk.get_constant( false ) ) )
     {
-      ws.emplace_back( node_names[ntk.get_constant( false )] );
+      add_wire( ntk.get_node( ntk.get_constant( false ) ) );
     }
   }
   else
   {
-    node_names[ntk.get_constant( false )] = "1'b0";
+    node_names[ntk.get_constant( false )] = verilog_name::named( "1'b0" );
   }
   if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
   {
     if ( ntk.has_binding( ntk.get_constant( true ) ) )
     {
-      node_names[ntk.get_constant( true )] = fmt::format( "n{}", ntk.node_to_index( ntk.get_constant( true ) ) );
+      node_names[ntk.get_constant( true )] = verilog_name::indexed( "n", ntk.node_to_index( ntk.get_constant( true ) ) );
       if ( !po_nodes.has( ntk.get_constant( true ) ) )
       {
-        ws.emplace_back( node_names[ntk.get_constant( true )] );
+        add_wire( ntk.get_node( ntk.get_constant( true ) ) );
       }
     }
     else
     {
-      node_names[ntk.get_constant( true )] = "1'b1";
+      node_names[ntk.get_constant( true )] = verilog_name::named( "1'b1" );
     }
   }
 
@@ -673,101 +942,61 @@ void write_verilog_with_binding( Ntk const& ntk, std::ostream& os, write_verilog
   ntk.foreach_gate( [&]( auto const& n ) {
     if ( !po_nodes.has( n ) )
     {
-      ws.emplace_back( fmt::format( "n{}", ntk.node_to_index( n ) ) );
+      add_wire( n );
     }
   } );
-
-  std::string module_name = "top";
-  if ( ps.module_name )
-  {
-    module_name = *ps.module_name;
-  }
-  else
-  {
-    if constexpr ( has_get_network_name_v<Ntk> )
-    {
-      if ( ntk.get_network_name().length() > 0 )
-      {
-        module_name = ntk.get_network_name();
-      }
-    }
-  }
-  writer.on_module_begin( module_name, inputs, outputs );
-  if ( ps.input_names.empty() )
-  {
-    writer.on_input( xs );
-  }
-  else
-  {
-    for ( auto const& [name, width] : ps.input_names )
-    {
-      writer.on_input( width, name );
-    }
-  }
-  if ( ps.output_names.empty() )
-  {
-    writer.on_output( ys );
-  }
-  else
-  {
-    for ( auto const& [name, width] : ps.output_names )
-    {
-      writer.on_output( width, name );
-    }
-  }
-  if ( !ws.empty() )
+  if ( has_wires )
   {
-    writer.on_wire( ws );
+    writer.end_declaration();
   }
 
   ntk.foreach_pi( [&]( auto const& n, auto i ) {
-    node_names[n] = xs[i];
+    node_names[n] = ports.xs[i];
   } );
 
   auto const& gates = ntk.get_library();
 
   int nDigits = (int)std::floor( std::log10( ntk.num_gates() ) );
-  unsigned int length = 0;
+  std::size_t length = 0;
   unsigned counter = 0;
 
   for ( auto const& gate : gates )
   {
-    length = std::max( length, static_cast<unsigned int>( gate.name.length() ) );
+    length = std::max( length, gate.name.length() );
   }
 
+  detail::verilog_output::fanin_list fanin;
+  auto const write_instance = [&]( gate const& g, verilog_name const& output ) {
+    int digits = counter == 0 ? 0 : (int)std::floor( std::log10( counter ) );
+    writer.begin_instance( g.name, length );
+    writer.instance_name( nDigits - digits, counter );
+    for ( auto i = 0u; i < fanin.size(); ++i )
+    {
+      writer.add_pin( g.pins[i].name, fanin[i].second );
+    }
+    writer.add_pin( g.output_name, output );
+    writer.end_instance();
+    ++counter;
+  };
+
   topo_view ntk_topo{ ntk };
 
   ntk_topo.foreach_node( [&]( auto const& n ) {
     if ( po_nodes.has( n ) )
     {
-      node_names[n] = ys[po_nodes[n][0]];
+      node_names[n] = ports.ys[po_nodes[n][0]];
     }
     else if ( !ntk.is_constant( n ) && !ntk.is_pi( n ) )
     {
-      node_names[n] = fmt::format( "n{}", ntk.node_to_index( n ) );
+      node_names[n] = verilog_name::indexed( "n", ntk.node_to_index( n ) );
     }
 
     if ( ntk.has_binding( n ) )
     {
       auto const& gate = gates[ntk.get_binding_index( n )];
-      std::string name = gate.name;
-
-      int digits = counter == 0 ? 0 : (int)std::floor( std::log10( counter ) );
-      auto fanin_names = detail::format_fanin<Ntk>( ntk, n, node_names );
-      std::vector<std::pair<std::string, std::string>> args;
-
-      auto i = 0;
-      for ( auto pair : fanin_names )
-      {
-        args.emplace_back( std::make_pair( gate.pins[i++].name, pair.second ) );
-      }
-      args.emplace_back( std::make_pair( gate.output_name, node_names[n] ) );
 
-      writer.on_module_instantiation( name.append( std::string( length - name.length(), ' ' ) ),
-                                      {},
-                                      std::string( "g" ) + std::string( nDigits - digits, '0' ) + std::to_string( counter ),
-                                      args );
-      ++counter;
+      detail::format_fanin<Ntk>( ntk, n, node_names, fanin );
+      write_instance( gate, node_names[n] );
 
       /* if node drives multiple POs, duplicate */
       if ( po_nodes.has( n ) && po_nodes[n].size() > 1 )
@@ -779,14 +1008,7 @@ void write_verilog_with_binding( Ntk const& ntk, std::ostream& os, write_verilog
         auto const& po_list = po_nodes[n];
         for ( auto i = 1u; i < po_list.size(); ++i )
         {
-          digits = counter == 0 ? 0 : (int)std::floor( std::log10( counter ) );
-          args[args.size() - 1] = std::make_pair( gate.output_name, ys[po_list[i]] );
-
-          writer.on_module_instantiation( name.append( std::string( length - name.length(), ' ' ) ),
-                                          {},
-                                          std::string( "g" ) + std::string( nDigits - digits, '0' ) + std::to_string( counter ),
-                                          args );
-          ++counter;
+          write_instance( gate, ports.ys[po_list[i]] );
         }
       }
     }
@@ -801,6 +1023,7 @@ void write_verilog_with_binding( Ntk const& ntk, std::ostream& os, write_verilog
   writer.on_module_end();
 }
 
+
 /*! \brief Writes mapped network in structural Verilog format into output stream
  *
  * **Required network functions:**
@@ -840,93 +1063,11 @@ void write_verilog_with_cell( Ntk const& ntk, std::ostream& os, write_verilog_pa
 
   assert( ntk.is_combinational() && "Network has to be combinational" );
 
-  lorina::verilog_writer writer( os );
-
-  std::vector<std::string> xs, inputs;
-  if ( ps.input_names.empty() )
-  {
-    if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
-    {
-      ntk.foreach_pi( [&]( auto const& i, uint32_t index ) {
-        if ( ntk.has_name( ntk.make_signal( i ) ) )
-        {
-          xs.emplace_back( ntk.get_name( ntk.make_signal( i ) ) );
-        }
-        else
-        {
-          xs.emplace_back( fmt::format( "x{}", index ) );
-        }
-      } );
-    }
-    else
-    {
-      for ( auto i = 0u; i < ntk.num_pis(); ++i )
-      {
-        xs.emplace_back( fmt::format( "x{}", i ) );
-      }
-    }
-    inputs = xs;
-  }
-  else
-  {
-    uint32_t ctr{ 0u };
-    for ( auto const& [name, width] : ps.input_names )
-    {
-      inputs.emplace_back( name );
-      ctr += width;
-      for ( auto i = 0u; i < width; ++i )
-      {
-        xs.emplace_back( fmt::format( "{}[{}]", name, i ) );
-      }
-    }
-    if ( ctr != ntk.num_pis() )
-    {
-      std::cerr << "[e] input names do not partition all inputs\n";
-    }
-  }
+  using detail::verilog_name;
+  detail::verilog_output writer( os );
 
-  std::vector<std::string> ys, outputs;
-  if ( ps.output_names.empty() )
-  {
-    if constexpr ( has_has_output_name_v<Ntk> && has_get_output_name_v<Ntk> )
-    {
-      ntk.foreach_po( [&]( auto const& o, uint32_t index ) {
-        if ( ntk.has_output_name( index ) )
-        {
-          ys.emplace_back( ntk.get_output_name( index ) );
-        }
-        else
-        {
-          ys.emplace_back( fmt::format( "y{}", index ) );
-        }
-      } );
-    }
-    else
-    {
-      for ( auto i = 0u; i < ntk.num_pos(); ++i )
-      {
-        ys.emplace_back( fmt::format( "y{}", i ) );
-      }
-    }
-    outputs = ys;
-  }
-  else
-  {
-    uint32_t ctr{ 0u };
-    for ( auto const& [name, width] : ps.output_names )
-    {
-      outputs.emplace_back( name );
-      ctr += width;
-      for ( auto i = 0u; i < width; ++i )
-      {
-        ys.emplace_back( fmt::format( "{}[{}]", name, i ) );
-      }
-    }
-    if ( ctr != ntk.num_pos() )
-    {
-      std::cerr << "[e] output names do not partition all outputs\n";
-    }
-  }
+  detail::verilog_ports ports;
+  detail::compute_verilog_ports( ntk, ps, ports );
 
   /* compute which nodes are POs and register index */
   uint32_t additional_buffers = 0;
@@ -936,21 +1077,43 @@ void write_verilog_with_cell( Ntk const& ntk, std::ostream& os, write_verilog_pa
     additional_buffers += po_nodes[f ^ ntk.is_complemented( f )].size() > 1 ? 1 : 0;
   } );
 
-  std::vector<std::string> ws;
-  node_map<std::vector<std::string>, Ntk> node_names( ntk );
+  detail::write_verilog_header( ntk, writer, ports, ps );
+
+  /* wires */
+  bool has_wires = false;
+  auto const add_wire = [&]( verilog_name const& name ) {
+    if ( !has_wires )
+    {
+      writer.begin_declaration( "wire" );
+      has_wires = true;
+    }
+    writer.add_to_declaration( name );
+  };
+
+  /* names of the node outputs, the names of node n start at names[first_name[n]] */
+  std::vector<verilog_name> names;
+  node_map<uint32_t, Ntk> first_name( ntk, std::numeric_limits<uint32_t>::max() );
+  auto const add_name = [&]( node<Ntk> const& n, verilog_name const& name ) {
+    /* only the first name of a single-output node is used */
+    if ( first_name[n] == std::numeric_limits<uint32_t>::max() )
+    {
+      first_name[n] = static_cast<uint32_t>( names.size() );
+      names.push_back( name );
+    }
+  };
 
   /* constants */
   if ( ntk.has_cell( ntk.get_node( ntk.get_constant( false ) ) ) )
   {
     if ( po_nodes.find( ntk.get_constant( false ) ) == po_nodes.end() )
     {
-      node_names[ntk.get_node( ntk.get_constant( false ) )].push_back( fmt::format( "n{}", ntk.node_to_index( ntk.get_constant( false ) ) ) );
-      ws.emplace_back( node_names[ntk.get_constant( false )].front() );
+      add_name( ntk.get_node( ntk.get_constant( false ) ), verilog_name::indexed( "n", ntk.node_to_index( ntk.get_node( ntk.get_constant( false ) ) ) ) );
+      add_wire( names[first_name[ntk.get_constant( false )]] );
     }
   }
   else
   {
-    node_names[ntk.get_node( ntk.get_constant( false ) )].push_back( "1'b0" );
+    add_name( ntk.get_node( ntk.get_constant( false ) ), verilog_name::named( "1'b0" ) );
   }
   if ( ntk.get_node( ntk.get_constant( false ) ) != ntk.get_node( ntk.get_constant( true ) ) )
   {
@@ -958,13 +1121,13 @@ void write_verilog_with_cell( Ntk const& ntk, std::ostream& os, write_verilog_pa
     {
       if ( po_nodes.find( ntk.get_constant( true ) ) == po_nodes.end() )
       {
-        node_names[ntk.get_node( ntk.get_constant( true ) )].push_back( fmt::format( "n{}", ntk.node_to_index( ntk.get_constant( true ) ) ) );
-        ws.emplace_back( node_names[ntk.get_constant( true )].front() );
+        add_name( ntk.get_node( ntk.get_constant( true ) ), verilog_name::indexed( "n", ntk.node_to_index( ntk.get_node( ntk.get_constant( true ) ) ) ) );
+        add_wire( names[first_name[ntk.get_constant( true )]] );
       }
     }
     else
     {
-      node_names[ntk.get_constant( true )].push_back( "1'b1" );
+      add_name( ntk.get_node( ntk.get_constant( true ) ), verilog_name::named( "1'b1" ) );
     }
   }
 
@@ -975,7 +1138,7 @@ void write_verilog_with_cell( Ntk const& ntk, std::ostream& os, write_verilog_pa
       /* create wire for each individual output */
       if ( !ntk.is_multioutput( n ) && po_nodes.find( ntk.make_signal( n ) ) == po_nodes.end() )
       {
-        ws.emplace_back( fmt::format( "n{}", ntk.node_to_index( n ) ) );
+        add_wire( verilog_name::indexed( "n", ntk.node_to_index( n ) ) );
         return;
       }
 
@@ -983,7 +1146,7 @@ void write_verilog_with_cell( Ntk const& ntk, std::ostream& os, write_verilog_pa
       {
         if ( po_nodes.find( ntk.make_signal( n, i ) ) == po_nodes.end() )
         {
-          ws.emplace_back( fmt::format( "n{}_{}", ntk.node_to_index( n ), i ) );
+          add_wire( verilog_name::node_output( ntk.node_to_index( n ), i ) );
         }
       }
 
@@ -992,55 +1155,16 @@ void write_verilog_with_cell( Ntk const& ntk, std::ostream& os, write_verilog_pa
 
     if ( po_nodes.find( ntk.make_signal( n ) ) == po_nodes.end() )
     {
-      ws.emplace_back( fmt::format( "n{}", ntk.node_to_index( n ) ) );
+      add_wire( verilog_name::indexed( "n", ntk.node_to_index( n ) ) );
     }
   } );
-
-  std::string module_name = "top";
-  if ( ps.module_name )
-  {
-    module_name = *ps.module_name;
-  }
-  else
-  {
-    if constexpr ( has_get_network_name_v<Ntk> )
-    {
-      if ( ntk.get_network_name().length() > 0 )
-      {
-        module_name = ntk.get_network_name();
-      }
-    }
-  }
-  writer.on_module_begin( module_name, inputs, outputs );
-  if ( ps.input_names.empty() )
-  {
-    writer.on_input( xs );
-  }
-  else
-  {
-    for ( auto const& [name, width] : ps.input_names )
-    {
-      writer.on_input( width, name );
-    }
-  }
-  if ( ps.output_names.empty() )
-  {
-    writer.on_output( ys );
-  }
-  else
-  {
-    for ( auto const& [name, width] : ps.output_names )
-    {
-      writer.on_output( width, name );
-    }
-  }
-  if ( !ws.empty() )
+  if ( has_wires )
   {
-    writer.on_wire( ws );
+    writer.end_declaration();
   }
 
   ntk.foreach_pi( [&]( auto const& n, auto i ) {
-    node_names[n].push_back( xs[i] );
+    add_name( n, ports.xs[i] );
   } );
 
   auto const& cells = ntk.get_library();
@@ -1064,93 +1188,88 @@ void write_verilog_with_cell( Ntk const& ntk, std::ostream& os, write_verilog_pa
   }
 
   int nDigits = (int)std::floor( std::log10( ntk.num_gates() + additional_buffers ) );
-  unsigned int length = 0;
+  std::size_t length = 0;
   unsigned counter = 0;
 
   for ( auto const& cell : cells )
   {
-    length = std::max( length, static_cast<unsigned int>( cell.name.length() ) );
+    length = std::max( length, cell.name.length() );
   }
 
+  detail::verilog_output::fanin_list fanin;
+
+  /* buffers the output of a node driving multiple POs */
+  auto const write_po_buffers = [&]( verilog_name const& name, std::vector<uint32_t> const& po_list ) {
+    gate const& g = cells[buf_id].gates.front();
+    for ( uint32_t j = 1u; j < po_list.size(); ++j )
+    {
+      writer.begin_instance( g.name, length );
+      writer.instance_name( nDigits, counter );
+      writer.add_pin( g.pins.front().name, name );
+      writer.add_pin( g.output_name, ports.ys[po_list[j]] );
+      writer.end_instance();
+      ++counter;
+    }
+  };
+
   topo_view ntk_topo{ ntk };
 
   ntk_topo.foreach_node( [&]( auto const& n ) {
     /* load names of n */
     if constexpr ( has_is_multioutput_v<Ntk> )
     {
-      /* create wire for each individual output */
-      if ( !ntk.is_multioutput( n ) )
-      {
-        if ( auto el = po_nodes.find( ntk.make_signal( n ) ); el != po_nodes.end() )
-        {
-          node_names[n].emplace_back( ys[el->second.front()] );
-        }
-        else if ( !ntk.is_constant( n ) && !ntk.is_pi( n ) )
-        {
-          node_names[n].emplace_back( fmt::format( "n{}", ntk.node_to_index( n ) ) );
-        }
-      }
-      else
+      if ( ntk.is_multioutput( n ) )
       {
+        first_name[n] = static_cast<uint32_t>( names.size() );
         for ( uint32_t i = 0; i < ntk.num_outputs( n ); ++i )
         {
           if ( auto el = po_nodes.find( ntk.make_signal( n, i ) ); el != po_nodes.end() )
           {
-            node_names[n].emplace_back( ys[el->second.front()] );
+            names.push_back( ports.ys[el->second.front()] );
           }
           else
           {
-            node_names[n].emplace_back( fmt::format( "n{}_{}", ntk.node_to_index( n ), i ) );
+            names.push_back( verilog_name::node_output( ntk.node_to_index( n ), i ) );
           }
         }
       }
     }
-    else
+    if ( first_name[n] == std::numeric_limits<uint32_t>::max() )
     {
       if ( auto el = po_nodes.find( ntk.make_signal( n ) ); el != po_nodes.end() )
       {
-        node_names[n] = ys[el->second.front()];
+        add_name( n, ports.ys[el->second.front()] );
       }
       else if ( !ntk.is_constant( n ) && !ntk.is_pi( n ) )
       {
-        node_names[n] = fmt::format( "n{}", ntk.node_to_index( n ) );
+        add_name( n, verilog_name::indexed( "n", ntk.node_to_index( n ) ) );
       }
     }
 
     if ( ntk.has_cell( n ) )
     {
       auto const& cell = cells[ntk.get_cell_index( n )];
-      std::string name = cell.name;
 
       int digits = counter == 0 ? 0 : (int)std::floor( std::log10( counter ) );
-      auto fanin_names = detail::format_fanin<Ntk>( ntk, n, node_names );
-      std::vector<std::pair<std::string, std::string>> args;
+      detail::format_fanin<Ntk>( ntk, n, first_name, names, fanin );
 
-      auto i = 0;
-      for ( auto pair : fanin_names )
+      writer.begin_instance( cell.name, length );
+      writer.instance_name( nDigits - digits, counter );
+      for ( auto i = 0u; i < fanin.size(); ++i )
       {
-        args.emplace_back( std::make_pair( cell.gates[0].pins[i++].name, pair.second ) );
+        writer.add_pin( cell.gates[0].pins[i].name, fanin[i].second );
       }
-
-      assert( cell.gates.size() == node_names[n].size() );
-
-      i = 0;
-      for ( auto const& ogate : cell.gates )
+      for ( auto i = 0u; i < cell.gates.size(); ++i )
       {
-        args.emplace_back( std::make_pair( ogate.output_name, node_names[n][i++] ) );
+        writer.add_pin( cell.gates[i].output_name, names[first_name[n] + i] );
       }
-
-      writer.on_module_instantiation( name.append( std::string( length - name.length(), ' ' ) ),
-                                      {},
-                                      std::string( "g" ) + std::string( nDigits - digits, '0' ) + std::to_string( counter ),
-                                      args );
+      writer.end_instance();
       ++counter;
 
       /* if node drives multiple POs, buffer */
       if constexpr ( has_is_multioutput_v<Ntk> )
       {
-        i = 0;
-        for ( i = 0; i < ntk.num_outputs( n ); ++i )
+        for ( uint32_t i = 0; i < ntk.num_outputs( n ); ++i )
         {
           if ( auto el = po_nodes.find( ntk.make_signal( n, i ) ); el != po_nodes.end() && el->second.size() > 1 )
           {
@@ -1165,23 +1284,7 @@ void write_verilog_with_cell( Ntk const& ntk, std::ostream& os, write_verilog_pa
               std::cerr << "[i] Buffering node " << n << " driving multiple POs.\n";
             }
 
-            gate const& g = cells[buf_id].gates.front();
-            std::string buf_name = g.name;
-            auto const& po_list = el->second;
-            args.clear();
-            args.emplace_back( std::make_pair( g.pins.front().name, node_names[n].at( i ) ) );
-            args.emplace_back( std::make_pair( "", "" ) );
-            for ( uint32_t j = 1u; j < po_list.size(); ++j )
-            {
-              digits = counter == (int)std::floor( std::log10( counter ) );
-              args[args.size() - 1] = std::make_pair( g.output_name, ys[po_list[j]] );
-
-              writer.on_module_instantiation( buf_name.append( std::string( length - buf_name.length(), ' ' ) ),
-                                              {},
-                                              std::string( "g" ) + std::string( nDigits - digits, '0' ) + std::to_string( counter ),
-                                              args );
-              ++counter;
-            }
+            write_po_buffers( names[first_name[n] + i], el->second );
           }
         }
       }
@@ -1197,23 +1300,7 @@ void write_verilog_with_cell( Ntk const& ntk, std::ostream& os, write_verilog_pa
 
           std::cerr << "[i] Buffering node " << n << " driving multiple POs.\n";
 
-          gate const& g = cells[buf_id].gates.front();
-          std::string buf_name = g.name;
-          auto const& po_list = el->second;
-          args.clear();
-          args.emplace_back( std::make_pair( g.pins.front().name, node_names[n].front() ) );
-          args.emplace_back( std::make_pair( "", "" ) );
-          for ( i = 1u; i < po_list.size(); ++i )
-          {
-            digits = counter == (int)std::floor( std::log10( counter ) );
-            args[args.size() - 1] = std::make_pair( g.output_name, ys[po_list[i]] );
-
-            writer.on_module_instantiation( buf_name.append( std::string( length - buf_name.length(), ' ' ) ),
-                                            {},
-                                            std::string( "g" ) + std::string( nDigits - digits, '0' ) + std::to_string( counter ),
-                                            args );
-            ++counter;
-          }
+          write_po_buffers( names[first_name[n]], el->second );
         }
       }
     }
@@ -54,6 +54,7 @@
 #include "mockturtle/algorithms/balancing/sop_balancing.hpp"
 #include "mockturtle/algorithms/balancing/utils.hpp"
 #include "mockturtle/algorithms/bi_decomposition.hpp"
+#include "mockturtle/algorithms/cec.hpp"
 #include "mockturtle/algorithms/cell_window.hpp"
 #include "mockturtle/algorithms/circuit_validator.hpp"
 #include "mockturtle/algorithms/cleanup.hpp"
@@ -79,6 +80,7 @@
 #include "mockturtle/algorithms/equivalence_checking.hpp"
 #include "mockturtle/algorithms/equivalence_classes.hpp"
 #include "mockturtle/algorithms/exact_mc_synthesis.hpp"
+#include "mockturtle/algorithms/exhaustive_simulation.hpp"
 #include "mockturtle/algorithms/exorcism.hpp"
 #include "mockturtle/algorithms/experimental/boolean_optimization.hpp"
 #include "mockturtle/algorithms/experimental/cost_generic_resub.hpp"
@@ -105,6 +107,7 @@
 #include "mockturtle/algorithms/node_resynthesis/direct.hpp"
 #include "mockturtle/algorithms/node_resynthesis/dsd.hpp"
 #include "mockturtle/algorithms/node_resynthesis/exact.hpp"
+#include "mockturtle/algorithms/node_resynthesis/memoized.hpp"
 #include "mockturtle/algorithms/node_resynthesis/mig_npn.hpp"
 #include "mockturtle/algorithms/node_resynthesis/null.hpp"
 #include "mockturtle/algorithms/node_resynthesis/shannon.hpp"
@@ -114,6 +117,7 @@
 #include "mockturtle/algorithms/node_resynthesis/xag_npn.hpp"
 #include "mockturtle/algorithms/node_resynthesis/xmg3_npn.hpp"
 #include "mockturtle/algorithms/node_resynthesis/xmg_npn.hpp"
+#include "mockturtle/algorithms/pass_manager.hpp"
 #include "mockturtle/algorithms/pattern_generation.hpp"
 #include "mockturtle/algorithms/reconv_cut.hpp"
 #include "mockturtle/algorithms/refactoring.hpp"
@@ -142,12 +146,16 @@
 #include "mockturtle/generators/self_dualize.hpp"
 #include "mockturtle/generators/sorting.hpp"
 #include "mockturtle/io/aiger_reader.hpp"
+#include "mockturtle/io/batch_reader.hpp"
 #include "mockturtle/io/bench_reader.hpp"
 #include "mockturtle/io/blif_reader.hpp"
 #include "mockturtle/io/bristol_reader.hpp"
 #include "mockturtle/io/dimacs_reader.hpp"
 #include "mockturtle/io/genlib_reader.hpp"
 #include "mockturtle/io/pla_reader.hpp"
+#include "mockturtle/io/read_patterns.hpp"
+#include "mockturtle/io/read_verilog_netlist.hpp"
+#include "mockturtle/io/sequential_aiger.hpp"
 #include "mockturtle/io/serialize.hpp"
 #include "mockturtle/io/super_reader.hpp"
 #include "mockturtle/io/verilog_reader.hpp"
@@ -180,9 +188,11 @@
 #include "mockturtle/properties/xmgcost.hpp"
 #include "mockturtle/traits.hpp"
 #include "mockturtle/utils/algorithm.hpp"
+#include "mockturtle/utils/cancellation_token.hpp"
 #include "mockturtle/utils/cost_functions.hpp"
 #include "mockturtle/utils/cuts.hpp"
 #include "mockturtle/utils/debugging_utils.hpp"
+#include "mockturtle/utils/file_utils.hpp"
 #include "mockturtle/utils/hash_functions.hpp"
 #include "mockturtle/utils/include/percy.hpp"
 #include "mockturtle/utils/index_list/index_list.hpp"
@@ -192,10 +202,14 @@
 #include "mockturtle/utils/network_cache.hpp"
 #include "mockturtle/utils/network_utils.hpp"
 #include "mockturtle/utils/node_map.hpp"
+#include "mockturtle/utils/npn_canonization.hpp"
+#include "mockturtle/utils/parallel_utils.hpp"
 #include "mockturtle/utils/progress_bar.hpp"
 #include "mockturtle/utils/recursive_cost_functions.hpp"
 #include "mockturtle/utils/stopwatch.hpp"
+#include "mockturtle/utils/string_pool.hpp"
 #include "mockturtle/utils/string_utils.hpp"
+#include "mockturtle/utils/structure_cache.hpp"
 #include "mockturtle/utils/super_utils.hpp"
 #include "mockturtle/utils/tech_library.hpp"
 #include "mockturtle/utils/truth_table_cache.hpp"
@@ -47,6 +47,7 @@
 
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operators.hpp>
 
 #include <algorithm>
 #include <memory>
@@ -617,24 +618,52 @@ public:
     assert( nfanin != 0 );
     assert( tts.size() == nfanin );
 
-    /* resulting truth table has the same size as any of the children */
-    auto result = tts.front().construct();
     const auto gate_tt = _storage->data.cache[_storage->nodes[n].data[1].h1];
 
-    for ( uint32_t i = 0u; i < static_cast<uint32_t>( result.num_bits() ); ++i )
+    if constexpr ( is_ternary_truth_table_v<typename std::iterator_traits<Iterator>::value_type> )
     {
-      uint32_t pattern = 0u;
-      for ( auto j = 0u; j < nfanin; ++j )
+      /* a bit is known if all fanin assignments compatible with it agree on the gate value */
+      auto must_be_0 = ~tts.front()._care.construct();
+      auto must_be_1 = must_be_0;
+      for ( uint32_t m = 0u; m < static_cast<uint32_t>( gate_tt.num_bits() ); ++m )
       {
-        pattern |= kitty::get_bit( tts[j], i ) << j;
+        auto compatible = must_be_0.construct();
+        compatible = ~compatible;
+        for ( auto j = 0u; j < nfanin; ++j )
+        {
+          compatible &= ( ( m >> j ) & 1u ) ? ( tts[j]._bits | ~tts[j]._care ) : ~tts[j]._bits;
+        }
+        if ( kitty::get_bit( gate_tt, m ) )
+        {
+          must_be_0 &= ~compatible;
+        }
+        else
+        {
+          must_be_1 &= ~compatible;
+        }
       }
-      if ( kitty::get_bit( gate_tt, pattern ) )
+      return typename std::iterator_traits<Iterator>::value_type( must_be_1, must_be_0 | must_be_1 );
+    }
+    else
+    {
+      /* resulting truth table has the same size as any of the children */
+      auto result = tts.front().construct();
+
+      for ( uint32_t i = 0u; i < static_cast<uint32_t>( result.num_bits() ); ++i )
       {
-        kitty::set_bit( result, i );
+        uint32_t pattern = 0u;
+        for ( auto j = 0u; j < nfanin; ++j )
+        {
+          pattern |= kitty::get_bit( tts[j], i ) << j;
+        }
+        if ( kitty::get_bit( gate_tt, pattern ) )
+        {
+          kitty::set_bit( result, i );
+        }
       }
-    }
 
-    return result;
+      return result;
+    }
   }
 #pragma endregion
 
@@ -47,6 +47,7 @@
 
 #include <kitty/cube.hpp>
 #include <kitty/dynamic_truth_table.hpp>
+#include <kitty/ternary_truth_table.hpp>
 #include <kitty/traits.hpp>
 
 namespace mockturtle
@@ -783,6 +784,21 @@ template<class Ntk>
 inline constexpr bool has_substitute_node_v = has_substitute_node<Ntk>::value;
 #pragma endregion
 
+#pragma region has_substitute_node_no_restrash
+template<class Ntk, class = void>
+struct has_substitute_node_no_restrash : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_substitute_node_no_restrash<Ntk, std::void_t<decltype( std::declval<Ntk>().substitute_node_no_restrash( std::declval<node<Ntk>>(), std::declval<signal<Ntk>>() ) )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_substitute_node_no_restrash_v = has_substitute_node_no_restrash<Ntk>::value;
+#pragma endregion
+
 #pragma region has_substitute_nodes
 template<class Ntk, class = void>
 struct has_substitute_nodes : std::false_type
@@ -2448,6 +2464,21 @@ template<class Ntk>
 inline constexpr bool has_get_name_v = has_get_name<Ntk>::value;
 #pragma endregion
 
+#pragma region has_get_name_view
+template<class Ntk, class = void>
+struct has_get_name_view : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_get_name_view<Ntk, std::void_t<decltype( std::declval<Ntk>().get_name_view( std::declval<signal<Ntk>>() ) )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_get_name_view_v = has_get_name_view<Ntk>::value;
+#pragma endregion
+
 #pragma region has_set_name
 template<class Ntk, class = void>
 struct has_set_name : std::false_type
@@ -2493,6 +2524,21 @@ template<class Ntk>
 inline constexpr bool has_get_output_name_v = has_get_output_name<Ntk>::value;
 #pragma endregion
 
+#pragma region has_get_output_name_view
+template<class Ntk, class = void>
+struct has_get_output_name_view : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_get_output_name_view<Ntk, std::void_t<decltype( std::declval<Ntk>().get_output_name_view( uint32_t() ) )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_get_output_name_view_v = has_get_output_name_view<Ntk>::value;
+#pragma endregion
+
 #pragma region has_set_output_name
 template<class Ntk, class = void>
 struct has_set_output_name : std::false_type
@@ -2671,4 +2717,19 @@ using iterates_over_truth_table_t = std::enable_if_t<kitty::is_truth_table<typen
 template<class Iterator, typename T>
 inline constexpr bool iterates_over_v = std::is_same_v<typename Iterator::value_type, T>;
 
+/*! \brief Checks whether a type is a three-valued (0/1/X) truth table.
+ */
+template<class TT>
+struct is_ternary_truth_table : std::false_type
+{
+};
+
+template<class TT>
+struct is_ternary_truth_table<kitty::ternary_truth_table<TT>> : std::true_type
+{
+};
+
+template<class TT>
+inline constexpr bool is_ternary_truth_table_v = is_ternary_truth_table<TT>::value;
+
 } /* namespace mockturtle */
\ No newline at end of file
@@ -36,9 +36,23 @@
 #include "../networks/aig.hpp"
 #include "../networks/gia.hpp"
 
+#include <mutex>
+
 namespace mockturtle
 {
 
+namespace detail
+{
+
+/* ABC scripts run on the global ABC frame, which must not be used by several threads at once */
+inline std::mutex& abc_frame_mutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+} // namespace detail
+
 void aig_to_gia(gia_network &gia, aig_network aig) {
   using aig_node = aig_network::node;
   using aig_signal = aig_network::signal;
@@ -103,8 +117,11 @@ aig_network call_abc_script( aig_network const& aig, std::string const& script )
   gia_network gia( aig.size() << 1 );
   aig_to_gia( gia, aig );
 
-  gia.load_rc();
-  gia.run_opt_script( script );
+  {
+    std::lock_guard<std::mutex> lock( detail::abc_frame_mutex() );
+    gia.load_rc();
+    gia.run_opt_script( script );
+  }
 
   aig_network new_aig;
   gia_to_aig( new_aig, gia );
@@ -0,0 +1,141 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file cancellation_token.hpp
+  \brief Cooperative cancellation of long-running algorithms
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+
+namespace mockturtle
+{
+
+/*! \brief Token to cancel an algorithm or to stop it at a deadline.
+ *
+ * Algorithms that accept a token in their parameters check it at safe
+ * points, e.g., before processing the next node or before the next round
+ * of an iterative improvement.  When the token is cancelled, they stop and
+ * leave the network in a consistent state that contains the best result
+ * found so far.  An operation that is running when the token is cancelled
+ * (e.g., a single SAT call) is finished first.
+ *
+ * Copies of a token share their state, such that a token stored in the
+ * parameters of an algorithm can be cancelled from another thread, and the
+ * same token can be passed to all algorithms of a flow.  A token can be
+ * cancelled explicitly with `cancel`, or implicitly by setting a deadline.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      cancellation_token token;
+      token.set_timeout( std::chrono::seconds( 60 ) );
+
+      resubstitution_params rps;
+      rps.cancellation = token;
+      functional_reduction_params fps;
+      fps.cancellation = token;
+
+      // both algorithms together run for at most about 60 seconds
+      functional_reduction( aig, fps );
+      sim_resubstitution( aig, rps );
+   \endverbatim
+ */
+class cancellation_token
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+public:
+  /*! \brief Creates a token that is not cancelled and has no deadline. */
+  cancellation_token()
+      : _state( std::make_shared<state>() )
+  {
+  }
+
+  /*! \brief Cancels the token (safe to call from any thread). */
+  void cancel() const
+  {
+    _state->cancelled.store( true, std::memory_order_relaxed );
+  }
+
+  /*! \brief Cancels the token at `deadline`. */
+  void set_deadline( clock::time_point const& deadline ) const
+  {
+    _state->deadline.store( deadline.time_since_epoch().count(), std::memory_order_relaxed );
+  }
+
+  /*! \brief Cancels the token after `timeout`, measured from now. */
+  template<class Rep, class Period>
+  void set_timeout( std::chrono::duration<Rep, Period> const& timeout ) const
+  {
+    set_deadline( clock::now() + std::chrono::duration_cast<clock::duration>( timeout ) );
+  }
+
+  /*! \brief Resets the token to not cancelled and without deadline. */
+  void reset() const
+  {
+    _state->cancelled.store( false, std::memory_order_relaxed );
+    _state->deadline.store( no_deadline, std::memory_order_relaxed );
+  }
+
+  /*! \brief Checks whether the token is cancelled or its deadline has passed. */
+  bool is_cancelled() const
+  {
+    if ( _state->cancelled.load( std::memory_order_relaxed ) )
+    {
+      return true;
+    }
+
+    auto const deadline = _state->deadline.load( std::memory_order_relaxed );
+    if ( deadline != no_deadline && clock::now().time_since_epoch().count() >= deadline )
+    {
+      cancel();
+      return true;
+    }
+    return false;
+  }
+
+private:
+  static constexpr clock::rep no_deadline = std::numeric_limits<clock::rep>::max();
+
+  struct state
+  {
+    std::atomic<bool> cancelled{ false };
+    std::atomic<clock::rep> deadline{ no_deadline };
+  };
+
+  std::shared_ptr<state> _state;
+};
+
+} // namespace mockturtle
@@ -0,0 +1,344 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file file_utils.hpp
+  \brief Memory-mapped input files and buffered output streams
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mockturtle
+{
+
+/*! \brief Read-only view of the contents of a file.
+ *
+ * On POSIX systems the file is mapped into memory with `mmap`, such that
+ * parsers can scan it without copying it through a stream.  On other systems
+ * the contents are read into an internal buffer.  The object is movable but
+ * not copyable; the mapping is released on destruction.
+
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      mapped_file file( "large.cnf" );
+      if ( file.is_open() )
+      {
+        std::string_view contents = file.view();
+        ...
+      }
+   \endverbatim
+ */
+class mapped_file
+{
+public:
+  explicit mapped_file( std::string const& filename )
+  {
+#ifndef _MSC_VER
+    int const fd = ::open( filename.c_str(), O_RDONLY );
+    if ( fd < 0 )
+    {
+      return;
+    }
+
+    struct stat st;
+    if ( ::fstat( fd, &st ) == 0 )
+    {
+      _size = static_cast<std::size_t>( st.st_size );
+      _open = true;
+      if ( _size > 0u )
+      {
+        void* addr = ::mmap( nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        if ( addr == MAP_FAILED )
+        {
+          _size = 0u;
+          _open = false;
+        }
+        else
+        {
+          _data = static_cast<char const*>( addr );
+          _mapped = true;
+#ifdef POSIX_MADV_SEQUENTIAL
+          ::posix_madvise( addr, _size, POSIX_MADV_SEQUENTIAL );
+#endif
+        }
+      }
+    }
+    ::close( fd );
+#else
+    std::ifstream in( filename, std::ifstream::in | std::ifstream::binary );
+    if ( !in.is_open() )
+    {
+      return;
+    }
+    _buffer.assign( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+    _data = _buffer.data();
+    _size = _buffer.size();
+    _open = true;
+#endif
+  }
+
+  mapped_file( mapped_file const& ) = delete;
+  mapped_file& operator=( mapped_file const& ) = delete;
+
+  mapped_file( mapped_file&& other ) noexcept
+  {
+    swap( other );
+  }
+
+  mapped_file& operator=( mapped_file&& other ) noexcept
+  {
+    if ( this != &other )
+    {
+      release();
+      swap( other );
+    }
+    return *this;
+  }
+
+  ~mapped_file()
+  {
+    release();
+  }
+
+  /*! \brief Whether the file could be opened. */
+  bool is_open() const
+  {
+    return _open;
+  }
+
+  /*! \brief Pointer to the first byte of the file. */
+  char const* data() const
+  {
+    return _data;
+  }
+
+  /*! \brief Size of the file in bytes. */
+  std::size_t size() const
+  {
+    return _size;
+  }
+
+  char const* begin() const
+  {
+    return _data;
+  }
+
+  char const* end() const
+  {
+    return _data + _size;
+  }
+
+  /*! \brief Contents of the file. */
+  std::string_view view() const
+  {
+    return std::string_view( _data == nullptr ? "" : _data, _size );
+  }
+
+private:
+  void release()
+  {
+#ifndef _MSC_VER
+    if ( _mapped )
+    {
+      ::munmap( const_cast<char*>( _data ), _size );
+    }
+#else
+    _buffer.clear();
+#endif
+    _data = nullptr;
+    _size = 0u;
+    _open = false;
+    _mapped = false;
+  }
+
+  void swap( mapped_file& other ) noexcept
+  {
+    std::swap( _data, other._data );
+    std::swap( _size, other._size );
+    std::swap( _open, other._open );
+    std::swap( _mapped, other._mapped );
+    std::swap( _buffer, other._buffer );
+  }
+
+private:
+  char const* _data{ nullptr };
+  std::size_t _size{ 0u };
+  bool _open{ false };
+  bool _mapped{ false };
+  std::vector<char> _buffer;
+};
+
+/*! \brief Buffered writer for large text outputs.
+ *
+ * Collects characters and integers in a fixed-size buffer and passes it to
+ * the underlying stream in large blocks.  Integers are formatted by hand,
+ * which avoids the overhead of `operator<<` and of temporary strings.  The
+ * buffer is flushed when it is full, when `flush` is called, and on
+ * destruction.
+ */
+class output_buffer
+{
+public:
+  explicit output_buffer( std::ostream& os, std::size_t capacity = 1u << 20 )
+      : _os( os ),
+        _buffer( std::max<std::size_t>( capacity, 64u ) )
+  {
+  }
+
+  output_buffer( output_buffer const& ) = delete;
+  output_buffer& operator=( output_buffer const& ) = delete;
+
+  ~output_buffer()
+  {
+    flush();
+  }
+
+  /*! \brief Appends a character. */
+  void put( char c )
+  {
+    if ( _pos == _buffer.size() )
+    {
+      flush();
+    }
+    _buffer[_pos++] = c;
+  }
+
+  /*! \brief Appends a string. */
+  void write( std::string_view str )
+  {
+    /* strings larger than the buffer bypass it */
+    if ( str.size() > _buffer.size() )
+    {
+      flush();
+      _os.write( str.data(), str.size() );
+      return;
+    }
+    if ( str.size() > _buffer.size() - _pos )
+    {
+      flush();
+    }
+    std::memcpy( _buffer.data() + _pos, str.data(), str.size() );
+    _pos += str.size();
+  }
+
+  /*! \brief Appends an unsigned integer in decimal notation. */
+  void write_uint( uint64_t value )
+  {
+    reserve( 20u );
+    char digits[20];
+    auto len = 0u;
+    do
+    {
+      digits[len++] = static_cast<char>( '0' + value % 10u );
+      value /= 10u;
+    } while ( value != 0u );
+    while ( len > 0u )
+    {
+      _buffer[_pos++] = digits[--len];
+    }
+  }
+
+  /*! \brief Appends a signed integer in decimal notation. */
+  void write_int( int64_t value )
+  {
+    if ( value < 0 )
+    {
+      put( '-' );
+      write_uint( uint64_t( 0 ) - static_cast<uint64_t>( value ) );
+    }
+    else
+    {
+      write_uint( static_cast<uint64_t>( value ) );
+    }
+  }
+
+  /*! \brief Passes the buffered contents to the stream. */
+  void flush()
+  {
+    if ( _pos > 0u )
+    {
+      _os.write( _buffer.data(), _pos );
+      _pos = 0u;
+    }
+  }
+
+private:
+  void reserve( std::size_t num_chars )
+  {
+    if ( _buffer.size() - _pos < num_chars )
+    {
+      flush();
+    }
+  }
+
+private:
+  std::ostream& _os;
+  std::vector<char> _buffer;
+  std::size_t _pos{ 0u };
+};
+
+/*! \brief Unique name for a temporary file next to `filename`.
+ *
+ * The name consists of `filename`, the process id (on POSIX systems), and a
+ * random suffix, such that concurrent jobs writing the same file first into
+ * a temporary file and then renaming it never share the temporary file.
+ */
+inline std::string temporary_filename( std::string const& filename )
+{
+  std::random_device rd;
+  std::uniform_int_distribution<uint64_t> dist;
+  std::string name = filename;
+#ifndef _MSC_VER
+  name += "." + std::to_string( getpid() );
+#endif
+  char suffix[17];
+  std::snprintf( suffix, sizeof( suffix ), "%016llx", static_cast<unsigned long long>( dist( rd ) ) );
+  return name + "." + suffix + ".tmp";
+}
+
+} // namespace mockturtle
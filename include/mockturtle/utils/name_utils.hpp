@@ -83,18 +83,32 @@ void restore_names( const NtkSrc& ntk_src, NtkDest& ntk_dest, node_map<signal<Nt
     const auto restore_signal_name = [&ntk_src, &ntk_dest, &old2new]( const auto& f ) {
       if ( ntk_src.has_name( f ) )
       {
-        const auto name = ntk_src.get_name( f );
-
-        ntk_dest.set_name( old2new[ntk_src.get_node( f )], name );
+        if constexpr ( has_get_name_view_v<NtkSrc> )
+        {
+          ntk_dest.set_name( old2new[ntk_src.get_node( f )], ntk_src.get_name_view( f ) );
+        }
+        else
+        {
+          const auto name = ntk_src.get_name( f );
+
+          ntk_dest.set_name( old2new[ntk_src.get_node( f )], name );
+        }
       }
     };
 
     const auto restore_output_name = [&ntk_src, &ntk_dest]( [[maybe_unused]] const auto& po, const auto i ) {
       if ( ntk_src.has_output_name( i ) )
       {
-        const auto name = ntk_src.get_output_name( i );
-
-        ntk_dest.set_output_name( i, name );
+        if constexpr ( has_get_output_name_view_v<NtkSrc> )
+        {
+          ntk_dest.set_output_name( i, ntk_src.get_output_name_view( i ) );
+        }
+        else
+        {
+          const auto name = ntk_src.get_output_name( i );
+
+          ntk_dest.set_output_name( i, name );
+        }
       }
     };
 
@@ -35,6 +35,7 @@
 #include "../traits.hpp"
 #include "node_map.hpp"
 
+#include <type_traits>
 #include <vector>
 
 namespace mockturtle
@@ -43,6 +44,28 @@ namespace mockturtle
 namespace detail
 {
 
+/* whether the network has a node storage, such as the storage of `aig_network` */
+template<class Ntk, class = void>
+struct has_node_storage : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_node_storage<Ntk, std::void_t<decltype( std::declval<Ntk>()._storage->nodes )>> : std::true_type
+{
+};
+
+/* whether a network storage has a structural hash table */
+template<class Storage, class = void>
+struct has_storage_hash : std::false_type
+{
+};
+
+template<class Storage>
+struct has_storage_hash<Storage, std::void_t<decltype( std::declval<Storage>().hash )>> : std::true_type
+{
+};
+
 template<typename NtkSrc, typename NtkDest>
 auto clone_node_topologically( NtkSrc const& ntk, NtkDest& subntk, unordered_node_map<typename NtkDest::signal, NtkSrc>& node_to_signal, typename NtkSrc::node n )
 {
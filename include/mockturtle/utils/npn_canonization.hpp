@@ -0,0 +1,426 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file npn_canonization.hpp
+  \brief Shared cache for exact NPN canonization
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/npn.hpp>
+#include <kitty/static_truth_table.hpp>
+#include <parallel_hashmap/phmap.h>
+
+#include "file_utils.hpp"
+
+namespace mockturtle
+{
+
+namespace detail
+{
+
+/*! \brief Header of a persistent NPN canonization cache file.
+ *
+ * The header is followed by the tables for up to 4 variables (see
+ * `npn_canonization_cache`), one 32-bit word per function, and by
+ * `num_entries` records of memoized functions with 5 or 6 variables.  Values
+ * are stored in the byte order of the machine that wrote the file.
+ */
+struct npn_cache_header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t num_entries;
+};
+
+struct npn_cache_record
+{
+  uint64_t tt;
+  uint64_t repr;
+  uint32_t phase;
+  uint32_t perm;
+  uint32_t num_vars;
+  uint32_t reserved;
+};
+
+inline constexpr char npn_cache_magic[8] = { 'M', 'T', 'N', 'P', 'N', 'C', 'H', 'E' };
+inline constexpr uint32_t npn_cache_version = 1u;
+
+} // namespace detail
+
+/*! \brief Cache for exact NPN canonization.
+ *
+ * Returns the same results as `kitty::exact_npn_canonization`, i.e., the
+ * representative, the phase (the input negations and, in bit `n`, the output
+ * negation), and the permutation, but computes each of them only once.
+ *
+ * Functions with up to 4 variables are looked up in tables with one entry for
+ * each function (65,536 entries for 4 variables), which are filled on first
+ * use or all at once with `precompute`.  Functions with 5 or 6 variables are
+ * memoized in a concurrent hash map, up to a maximum number of entries.
+ * Larger functions are canonized directly.  Canonization can be called
+ * concurrently from several threads; `save` and `load` must not run
+ * concurrently with other calls.
+ *
+ * The tables and the memoized functions can be saved into a file and loaded
+ * in later runs.  A cache shared by all algorithms is returned by `shared`.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      auto& cache = npn_canonization_cache::shared();
+      cache.load( "npn.cache" ); // optional
+
+      kitty::static_truth_table<4> tt;
+      kitty::create_from_hex_string( tt, "8ff0" );
+      auto const [repr, phase, perm] = cache( tt );
+
+      cache.save( "npn.cache" );
+   \endverbatim
+ */
+class npn_canonization_cache
+{
+private:
+  struct entry
+  {
+    uint64_t repr;
+    uint32_t phase;
+    uint32_t perm;
+  };
+
+  using memo_map_t = phmap::parallel_flat_hash_map<uint64_t, entry, phmap::Hash<uint64_t>, phmap::EqualTo<uint64_t>, std::allocator<std::pair<const uint64_t, entry>>, 4, std::mutex>;
+
+  static constexpr uint32_t max_table_vars = 4u;
+  static constexpr uint32_t max_memo_vars = 6u;
+  static constexpr uint32_t valid_bit = 1u << 31;
+
+public:
+  /*! \brief Constructor.
+   *
+   * \param max_memo_entries Maximum number of memoized functions with 5 or 6 variables
+   */
+  explicit npn_canonization_cache( uint64_t max_memo_entries = 1u << 20 )
+      : _max_memo_entries( max_memo_entries )
+  {
+    for ( auto i = 0u; i <= max_table_vars; ++i )
+    {
+      _tables[i] = std::vector<std::atomic<uint32_t>>( uint64_t( 1 ) << ( uint64_t( 1 ) << i ) );
+    }
+  }
+
+  npn_canonization_cache( npn_canonization_cache const& ) = delete;
+  npn_canonization_cache& operator=( npn_canonization_cache const& ) = delete;
+
+  /*! \brief Cache shared by all algorithms. */
+  static npn_canonization_cache& shared()
+  {
+    static npn_canonization_cache cache;
+    return cache;
+  }
+
+  /*! \brief Exact NPN canonization of a static truth table. */
+  template<uint32_t NumVars, bool IsSmall>
+  std::tuple<kitty::static_truth_table<NumVars, IsSmall>, uint32_t, std::vector<uint8_t>> operator()( kitty::static_truth_table<NumVars, IsSmall> const& tt )
+  {
+    if constexpr ( NumVars <= max_memo_vars )
+    {
+      auto const e = canonize_word( NumVars, tt._bits );
+      kitty::static_truth_table<NumVars> repr;
+      repr._bits = e.repr;
+      return { repr, e.phase, unpack_permutation( NumVars, e.perm ) };
+    }
+    else
+    {
+      return kitty::exact_npn_canonization( tt );
+    }
+  }
+
+  /*! \brief Exact NPN canonization of a dynamic truth table. */
+  std::tuple<kitty::dynamic_truth_table, uint32_t, std::vector<uint8_t>> operator()( kitty::dynamic_truth_table const& tt )
+  {
+    auto const num_vars = static_cast<uint32_t>( tt.num_vars() );
+    if ( num_vars > max_memo_vars )
+    {
+      return kitty::exact_npn_canonization( tt );
+    }
+
+    auto const e = canonize_word( num_vars, tt._bits[0] );
+    kitty::dynamic_truth_table repr( num_vars );
+    repr._bits[0] = e.repr;
+    return { repr, e.phase, unpack_permutation( num_vars, e.perm ) };
+  }
+
+  /*! \brief Fills the tables for all functions with up to `num_vars` variables (at most 4). */
+  void precompute( uint32_t num_vars = max_table_vars )
+  {
+    for ( auto n = 0u; n <= std::min( num_vars, max_table_vars ); ++n )
+    {
+      auto const num_functions = uint64_t( 1 ) << ( uint64_t( 1 ) << n );
+      for ( uint64_t tt = 0u; tt < num_functions; ++tt )
+      {
+        canonize_word( n, tt );
+      }
+    }
+  }
+
+  /*! \brief Number of functions in the tables and memoized functions. */
+  uint64_t size() const
+  {
+    uint64_t count = _num_memo_entries.load( std::memory_order_relaxed );
+    for ( auto const& table : _tables )
+    {
+      for ( auto const& e : table )
+      {
+        count += ( e.load( std::memory_order_relaxed ) & valid_bit ) ? 1u : 0u;
+      }
+    }
+    return count;
+  }
+
+  /*! \brief Saves the tables and the memoized functions into a file.
+   *
+   * \return Whether the file has been written
+   */
+  bool save( std::string const& filename ) const
+  {
+    std::ofstream os( filename, std::ofstream::out | std::ofstream::binary );
+    if ( !os.is_open() )
+    {
+      return false;
+    }
+
+    output_buffer out( os );
+    auto const write = [&]( auto const& value ) {
+      out.write( std::string_view( reinterpret_cast<char const*>( &value ), sizeof( value ) ) );
+    };
+
+    detail::npn_cache_header header;
+    std::memcpy( header.magic, detail::npn_cache_magic, sizeof( header.magic ) );
+    header.version = detail::npn_cache_version;
+    header.reserved = 0u;
+    header.num_entries = _memo[0].size() + _memo[1].size();
+    write( header );
+
+    for ( auto const& table : _tables )
+    {
+      for ( auto const& e : table )
+      {
+        write( e.load( std::memory_order_relaxed ) );
+      }
+    }
+
+    for ( auto n = max_table_vars + 1u; n <= max_memo_vars; ++n )
+    {
+      for ( auto const& [tt, e] : _memo[n - max_table_vars - 1u] )
+      {
+        write( detail::npn_cache_record{ tt, e.repr, e.phase, e.perm, n, 0u } );
+      }
+    }
+
+    out.flush();
+    return static_cast<bool>( os );
+  }
+
+  /*! \brief Loads tables and memoized functions from a file written with `save`.
+   *
+   * Entries already present in the cache are kept.
+   *
+   * \return Whether the file has been read
+   */
+  bool load( std::string const& filename )
+  {
+    mapped_file file( filename );
+    if ( !file.is_open() )
+    {
+      return false;
+    }
+
+    detail::npn_cache_header header;
+    std::size_t const tables_size = table_entries() * sizeof( uint32_t );
+    if ( file.size() < sizeof( header ) + tables_size )
+    {
+      return false;
+    }
+    std::memcpy( &header, file.data(), sizeof( header ) );
+    if ( std::memcmp( header.magic, detail::npn_cache_magic, sizeof( header.magic ) ) != 0 || header.version != detail::npn_cache_version ||
+         file.size() != sizeof( header ) + tables_size + header.num_entries * sizeof( detail::npn_cache_record ) )
+    {
+      return false;
+    }
+
+    auto const* data = file.data() + sizeof( header );
+    for ( auto& table : _tables )
+    {
+      for ( auto& e : table )
+      {
+        uint32_t value;
+        std::memcpy( &value, data, sizeof( uint32_t ) );
+        data += sizeof( uint32_t );
+        if ( value & valid_bit )
+        {
+          e.store( value, std::memory_order_relaxed );
+        }
+      }
+    }
+
+    for ( auto i = 0u; i < header.num_entries; ++i )
+    {
+      detail::npn_cache_record record;
+      std::memcpy( &record, data, sizeof( record ) );
+      data += sizeof( record );
+      if ( record.num_vars > max_table_vars && record.num_vars <= max_memo_vars )
+      {
+        memoize( record.num_vars, record.tt, entry{ record.repr, record.phase, record.perm } );
+      }
+    }
+    return true;
+  }
+
+private:
+  entry canonize_word( uint32_t num_vars, uint64_t word )
+  {
+    /* ignore bits beyond the truth table, which are not guaranteed to be zero */
+    if ( num_vars < 6u )
+    {
+      word &= ( uint64_t( 1 ) << ( uint64_t( 1 ) << num_vars ) ) - 1u;
+    }
+
+    if ( num_vars <= max_table_vars )
+    {
+      auto& slot = _tables[num_vars][word];
+      auto value = slot.load( std::memory_order_relaxed );
+      if ( ( value & valid_bit ) == 0 )
+      {
+        auto const e = canonize( num_vars, word );
+        /* representative (16 bits), phase (5 bits), permutation (8 bits) */
+        value = valid_bit | static_cast<uint32_t>( e.repr ) | ( e.phase << 16 ) | ( e.perm << 21 );
+        slot.store( value, std::memory_order_relaxed );
+      }
+      return entry{ value & 0xffff, ( value >> 16 ) & 0x1f, ( value >> 21 ) & 0xff };
+    }
+
+    auto& memo = _memo[num_vars - max_table_vars - 1u];
+    entry e;
+    if ( memo.if_contains( word, [&]( auto const& value ) { e = value; } ) )
+    {
+      return e;
+    }
+
+    e = canonize( num_vars, word );
+    memoize( num_vars, word, e );
+    return e;
+  }
+
+  void memoize( uint32_t num_vars, uint64_t word, entry const& e )
+  {
+    if ( _num_memo_entries.load( std::memory_order_relaxed ) >= _max_memo_entries )
+    {
+      return;
+    }
+    if ( _memo[num_vars - max_table_vars - 1u].try_emplace_l(
+             word, []( auto& ) {}, e ) )
+    {
+      _num_memo_entries.fetch_add( 1u, std::memory_order_relaxed );
+    }
+  }
+
+  static entry canonize( uint32_t num_vars, uint64_t word )
+  {
+    kitty::dynamic_truth_table tt( num_vars );
+    tt._bits[0] = word;
+    tt.mask_bits();
+    auto const [repr, phase, perm] = kitty::exact_npn_canonization( tt );
+    return entry{ repr._bits[0], phase, pack_permutation( perm ) };
+  }
+
+  /* 2 bits per variable for up to 4 variables, 3 bits per variable otherwise */
+  static uint32_t pack_permutation( std::vector<uint8_t> const& perm )
+  {
+    auto const bits = perm.size() <= max_table_vars ? 2u : 3u;
+    uint32_t packed = 0u;
+    for ( auto i = 0u; i < perm.size(); ++i )
+    {
+      packed |= static_cast<uint32_t>( perm[i] ) << ( bits * i );
+    }
+    return packed;
+  }
+
+  static std::vector<uint8_t> unpack_permutation( uint32_t num_vars, uint32_t packed )
+  {
+    auto const bits = num_vars <= max_table_vars ? 2u : 3u;
+    std::vector<uint8_t> perm( num_vars );
+    for ( auto i = 0u; i < num_vars; ++i )
+    {
+      perm[i] = static_cast<uint8_t>( ( packed >> ( bits * i ) ) & ( ( 1u << bits ) - 1u ) );
+    }
+    return perm;
+  }
+
+  std::size_t table_entries() const
+  {
+    std::size_t count = 0u;
+    for ( auto const& table : _tables )
+    {
+      count += table.size();
+    }
+    return count;
+  }
+
+private:
+  std::array<std::vector<std::atomic<uint32_t>>, max_table_vars + 1u> _tables;
+  std::array<memo_map_t, max_memo_vars - max_table_vars> _memo;
+  uint64_t _max_memo_entries;
+  std::atomic<uint64_t> _num_memo_entries{ 0u };
+};
+
+/*! \brief Exact NPN canonization using the shared cache.
+ *
+ * Drop-in replacement for `kitty::exact_npn_canonization`, which uses
+ * `npn_canonization_cache::shared()` for functions with up to 6 variables.
+ */
+template<typename TT>
+auto cached_exact_npn_canonization( TT const& tt )
+{
+  return npn_canonization_cache::shared()( tt );
+}
+
+} // namespace mockturtle
@@ -0,0 +1,123 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file parallel_utils.hpp
+  \brief Utilities for multi-threaded algorithms
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Resolves the number of worker threads.
+ *
+ * A value of 0 is interpreted as the number of hardware threads of the
+ * machine.  The result is always at least 1.
+ */
+inline uint32_t resolve_num_threads( uint32_t num_threads )
+{
+  if ( num_threads == 0u )
+  {
+    num_threads = std::thread::hardware_concurrency();
+  }
+  return std::max( num_threads, 1u );
+}
+
+/*! \brief Runs a function for a range of tasks on several threads.
+ *
+ * Calls `fn( task, thread_id )` for each `task` in `[0, num_tasks)`.  Tasks
+ * are distributed dynamically, i.e., each thread fetches the next unprocessed
+ * task once it is done with its current one.  If only one thread is requested
+ * (or there is at most one task), all tasks are processed in order on the
+ * calling thread.  The first exception thrown by `fn` is rethrown after all
+ * threads have terminated.
+ *
+ * \param num_threads Number of threads (0 = hardware concurrency)
+ * \param num_tasks Number of tasks
+ * \param fn Function called as `fn( uint64_t task, uint32_t thread_id )`
+ */
+template<typename Fn>
+void parallel_for( uint32_t num_threads, uint64_t num_tasks, Fn&& fn )
+{
+  num_threads = static_cast<uint32_t>( std::min<uint64_t>( resolve_num_threads( num_threads ), num_tasks ) );
+  if ( num_threads <= 1u )
+  {
+    for ( uint64_t i = 0u; i < num_tasks; ++i )
+    {
+      fn( i, 0u );
+    }
+    return;
+  }
+
+  std::atomic<uint64_t> next{ 0u };
+  std::exception_ptr error;
+  std::mutex error_mutex;
+
+  std::vector<std::thread> threads;
+  threads.reserve( num_threads );
+  for ( auto t = 0u; t < num_threads; ++t )
+  {
+    threads.emplace_back( [&]( uint32_t thread_id ) {
+      try
+      {
+        for ( uint64_t i = next++; i < num_tasks; i = next++ )
+        {
+          fn( i, thread_id );
+        }
+      }
+      catch ( ... )
+      {
+        std::lock_guard<std::mutex> lock( error_mutex );
+        if ( !error )
+        {
+          error = std::current_exception();
+        }
+        next = num_tasks; /* stop the other threads */
+      }
+    }, t );
+  }
+
+  for ( auto& t : threads )
+  {
+    t.join();
+  }
+
+  if ( error )
+  {
+    std::rethrow_exception( error );
+  }
+}
+
+} // namespace mockturtle
@@ -0,0 +1,196 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file string_pool.hpp
+  \brief Interned strings stored in an arena
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <parallel_hashmap/phmap.h>
+
+namespace mockturtle
+{
+
+/*! \brief Pool of interned strings.
+ *
+ * Each distinct string is stored once in a list of memory blocks and is
+ * identified by a dense id.  Adding a string never moves previously added
+ * strings, such that the views returned by `operator[]` remain valid for the
+ * lifetime of the pool.  Copying a pool compacts the strings into new blocks.
+ *
+ * Example
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      string_pool pool;
+      auto const a = pool.intern( "a" );
+      auto const b = pool.intern( "b" );
+      assert( pool.intern( "a" ) == a );
+      assert( pool[b] == "b" );
+   \endverbatim
+ */
+class string_pool
+{
+public:
+  using id_type = uint32_t;
+
+  static constexpr id_type invalid_id = std::numeric_limits<id_type>::max();
+
+public:
+  explicit string_pool( std::size_t block_size = 1u << 16 )
+      : _block_size( std::max<std::size_t>( block_size, 64u ) )
+  {
+  }
+
+  string_pool( string_pool const& other )
+      : _block_size( other._block_size )
+  {
+    reserve( other.size() );
+    for ( auto const& str : other._strings )
+    {
+      intern( str );
+    }
+  }
+
+  string_pool& operator=( string_pool const& other )
+  {
+    if ( this != &other )
+    {
+      string_pool copy( other );
+      *this = std::move( copy );
+    }
+    return *this;
+  }
+
+  string_pool( string_pool&& ) = default;
+  string_pool& operator=( string_pool&& ) = default;
+
+  /*! \brief Returns the id of a string, adding it if it is not in the pool. */
+  id_type intern( std::string_view str )
+  {
+    if ( auto const it = _ids.find( str ); it != _ids.end() )
+    {
+      return it->second;
+    }
+
+    auto const id = static_cast<id_type>( _strings.size() );
+    auto const stored = store( str );
+    _strings.push_back( stored );
+    _ids.emplace( stored, id );
+    return id;
+  }
+
+  /*! \brief Returns the id of a string, if it is in the pool. */
+  std::optional<id_type> find( std::string_view str ) const
+  {
+    if ( auto const it = _ids.find( str ); it != _ids.end() )
+    {
+      return it->second;
+    }
+    return std::nullopt;
+  }
+
+  /*! \brief Returns the string with the given id. */
+  std::string_view operator[]( id_type id ) const
+  {
+    return _strings[id];
+  }
+
+  /*! \brief Number of distinct strings. */
+  std::size_t size() const
+  {
+    return _strings.size();
+  }
+
+  /*! \brief Number of bytes used by the strings. */
+  std::size_t num_bytes() const
+  {
+    return _num_bytes;
+  }
+
+  void reserve( std::size_t num_strings )
+  {
+    _strings.reserve( num_strings );
+    _ids.reserve( num_strings );
+  }
+
+private:
+  std::string_view store( std::string_view str )
+  {
+    if ( str.empty() )
+    {
+      return {};
+    }
+    _num_bytes += str.size();
+
+    /* long strings get a block of their own, placed before the current one */
+    if ( str.size() > _block_size / 4u )
+    {
+      auto block = std::make_unique<char[]>( str.size() );
+      std::memcpy( block.get(), str.data(), str.size() );
+      std::string_view const stored( block.get(), str.size() );
+      _blocks.insert( _blocks.empty() ? _blocks.end() : _blocks.end() - 1, std::move( block ) );
+      if ( _blocks.size() == 1u )
+      {
+        /* no current block yet, the next string starts a new one */
+        _used = _block_size;
+      }
+      return stored;
+    }
+
+    if ( _blocks.empty() || _used + str.size() > _block_size )
+    {
+      _blocks.push_back( std::make_unique<char[]>( _block_size ) );
+      _used = 0u;
+    }
+    char* dest = _blocks.back().get() + _used;
+    std::memcpy( dest, str.data(), str.size() );
+    _used += str.size();
+    return std::string_view( dest, str.size() );
+  }
+
+private:
+  std::size_t _block_size;
+  std::size_t _used{ 0u };
+  std::size_t _num_bytes{ 0u };
+  std::vector<std::unique_ptr<char[]>> _blocks;
+  std::vector<std::string_view> _strings;
+  phmap::flat_hash_map<std::string_view, id_type> _ids;
+};
+
+} // namespace mockturtle
@@ -0,0 +1,436 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file structure_cache.hpp
+  \brief Thread-safe cache of index lists keyed by functions
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/hash.hpp>
+
+#include "file_utils.hpp"
+#include "index_list/index_list.hpp"
+
+namespace mockturtle
+{
+
+namespace detail
+{
+
+/*! \brief Header of a persistent structure cache file.
+ *
+ * The header is followed by `num_entries` records, from the least to the
+ * most recently used entry.  Each record consists of the number of
+ * variables, the number of index list values, the words of the truth table,
+ * and the index list values.  Values are stored in the byte order of the
+ * machine that wrote the file.
+ */
+struct structure_cache_header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t kind;
+  uint64_t num_entries;
+};
+
+inline constexpr char structure_cache_magic[8] = { 'M', 'T', 'S', 'T', 'R', 'C', 'H', 'E' };
+inline constexpr uint32_t structure_cache_version = 1u;
+
+template<class IndexList>
+struct structure_cache_kind;
+
+template<>
+struct structure_cache_kind<xag_index_list<false>>
+{
+  static constexpr uint32_t value = 1u;
+};
+
+template<>
+struct structure_cache_kind<xag_index_list<true>>
+{
+  static constexpr uint32_t value = 2u;
+};
+
+template<>
+struct structure_cache_kind<mig_index_list>
+{
+  static constexpr uint32_t value = 3u;
+};
+
+} // namespace detail
+
+/*! \brief Statistics for structure_cache. */
+struct structure_cache_stats
+{
+  /*! \brief Number of successful lookups. */
+  uint64_t hits{ 0u };
+
+  /*! \brief Number of failed lookups. */
+  uint64_t misses{ 0u };
+
+  /*! \brief Number of evicted entries. */
+  uint64_t evictions{ 0u };
+};
+
+/*! \brief Cache of structures keyed by their functions.
+ *
+ * Maps truth tables to a (possibly empty) sequence of index lists, e.g., the
+ * structures that a resynthesis function returned for the truth table.  The
+ * cache holds at most `max_entries` entries and evicts the least recently
+ * used ones.  It is split into shards, each protected by its own mutex, such
+ * that it can be used concurrently from several threads.
+ *
+ * The entries can be saved into a binary file and loaded in later runs.
+ * `save` and `load` may run concurrently with lookups, but the contents of
+ * the file are then only a snapshot.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      structure_cache<xag_index_list<>> cache( 10000u );
+      cache.load( "aig.structures" ); // optional
+
+      kitty::dynamic_truth_table tt( 2u );
+      kitty::create_from_hex_string( tt, "8" );
+
+      xag_index_list<> list( 2u );
+      list.add_output( list.add_and( 2u, 4u ) );
+      cache.insert( tt, { list } );
+
+      if ( auto const lists = cache.lookup( tt ) )
+      {
+        // use ( *lists )[0]
+      }
+
+      cache.save( "aig.structures" );
+   \endverbatim
+ */
+template<class IndexList>
+class structure_cache
+{
+public:
+  using index_list_t = IndexList;
+  using entry_t = std::vector<IndexList>;
+  using entry_ptr = std::shared_ptr<entry_t const>;
+
+private:
+  static constexpr uint32_t num_shards = 16u;
+
+  struct shard
+  {
+    using list_t = std::list<std::pair<kitty::dynamic_truth_table, entry_ptr>>;
+
+    std::mutex mutex;
+    list_t entries; /* from the most to the least recently used entry */
+    std::unordered_map<kitty::dynamic_truth_table, typename list_t::iterator, kitty::hash<kitty::dynamic_truth_table>> index;
+  };
+
+public:
+  /*! \brief Constructor.
+   *
+   * \param max_entries Maximum number of functions in the cache
+   */
+  explicit structure_cache( uint64_t max_entries = 1u << 16 )
+      : _max_shard_entries( std::max<uint64_t>( 1u, ( max_entries + num_shards - 1u ) / num_shards ) )
+  {
+  }
+
+  structure_cache( structure_cache const& ) = delete;
+  structure_cache& operator=( structure_cache const& ) = delete;
+
+  /*! \brief Returns the structures for a function, or `nullptr` if the function is not in the cache.
+   *
+   * The structures are shared with the cache instead of being copied, and
+   * stay valid when the entry is replaced or evicted.
+   */
+  entry_ptr lookup( kitty::dynamic_truth_table const& function )
+  {
+    auto& s = shard_of( function );
+    std::lock_guard<std::mutex> lock( s.mutex );
+
+    auto const it = s.index.find( function );
+    if ( it == s.index.end() )
+    {
+      _misses.fetch_add( 1u, std::memory_order_relaxed );
+      return nullptr;
+    }
+
+    _hits.fetch_add( 1u, std::memory_order_relaxed );
+    s.entries.splice( s.entries.begin(), s.entries, it->second );
+    return it->second->second;
+  }
+
+  /*! \brief Inserts or replaces the structures for a function. */
+  void insert( kitty::dynamic_truth_table const& function, entry_t lists )
+  {
+    auto entry = std::make_shared<entry_t const>( std::move( lists ) );
+    auto& s = shard_of( function );
+    std::lock_guard<std::mutex> lock( s.mutex );
+
+    if ( auto const it = s.index.find( function ); it != s.index.end() )
+    {
+      it->second->second = std::move( entry );
+      s.entries.splice( s.entries.begin(), s.entries, it->second );
+      return;
+    }
+
+    s.entries.emplace_front( function, std::move( entry ) );
+    s.index.emplace( function, s.entries.begin() );
+
+    if ( s.entries.size() > _max_shard_entries )
+    {
+      s.index.erase( s.entries.back().first );
+      s.entries.pop_back();
+      _evictions.fetch_add( 1u, std::memory_order_relaxed );
+    }
+  }
+
+  /*! \brief Number of functions in the cache. */
+  uint64_t size() const
+  {
+    uint64_t count{ 0u };
+    for ( auto& s : _shards )
+    {
+      std::lock_guard<std::mutex> lock( s.mutex );
+      count += s.entries.size();
+    }
+    return count;
+  }
+
+  /*! \brief Removes all entries. */
+  void clear()
+  {
+    for ( auto& s : _shards )
+    {
+      std::lock_guard<std::mutex> lock( s.mutex );
+      s.entries.clear();
+      s.index.clear();
+    }
+  }
+
+  structure_cache_stats stats() const
+  {
+    return { _hits.load( std::memory_order_relaxed ), _misses.load( std::memory_order_relaxed ), _evictions.load( std::memory_order_relaxed ) };
+  }
+
+  /*! \brief Saves the entries into a file.
+   *
+   * \return Whether the file has been written
+   */
+  bool save( std::string const& filename ) const
+  {
+    std::ofstream os( filename, std::ofstream::out | std::ofstream::binary );
+    if ( !os.is_open() )
+    {
+      return false;
+    }
+
+    output_buffer out( os );
+    auto const write = [&]( auto const& value ) {
+      out.write( std::string_view( reinterpret_cast<char const*>( &value ), sizeof( value ) ) );
+    };
+
+    /* lock all shards to write a consistent snapshot */
+    std::vector<std::unique_lock<std::mutex>> locks;
+    for ( auto& s : _shards )
+    {
+      locks.emplace_back( s.mutex );
+    }
+
+    detail::structure_cache_header header;
+    std::memcpy( header.magic, detail::structure_cache_magic, sizeof( header.magic ) );
+    header.version = detail::structure_cache_version;
+    header.kind = detail::structure_cache_kind<IndexList>::value;
+    header.num_entries = 0u;
+    for ( auto const& s : _shards )
+    {
+      header.num_entries += s.entries.size();
+    }
+    write( header );
+
+    std::vector<uint32_t> values;
+    for ( auto const& s : _shards )
+    {
+      for ( auto it = s.entries.rbegin(); it != s.entries.rend(); ++it )
+      {
+        values.clear();
+        values.emplace_back( static_cast<uint32_t>( it->second->size() ) );
+        for ( auto const& list : *it->second )
+        {
+          auto const raw = list.raw();
+          values.emplace_back( static_cast<uint32_t>( raw.size() ) );
+          values.insert( values.end(), raw.begin(), raw.end() );
+        }
+
+        write( static_cast<uint32_t>( it->first.num_vars() ) );
+        write( static_cast<uint32_t>( values.size() ) );
+        for ( auto const& word : it->first._bits )
+        {
+          write( word );
+        }
+        for ( auto const& value : values )
+        {
+          write( value );
+        }
+      }
+    }
+
+    out.flush();
+    return static_cast<bool>( os );
+  }
+
+  /*! \brief Loads entries from a file written with `save`.
+   *
+   * The loaded entries are inserted as the most recently used ones.
+   *
+   * \return Whether the file has been read
+   */
+  bool load( std::string const& filename )
+  {
+    mapped_file file( filename );
+    if ( !file.is_open() )
+    {
+      return false;
+    }
+
+    detail::structure_cache_header header;
+    if ( file.size() < sizeof( header ) )
+    {
+      return false;
+    }
+    std::memcpy( &header, file.data(), sizeof( header ) );
+    if ( std::memcmp( header.magic, detail::structure_cache_magic, sizeof( header.magic ) ) != 0 || header.version != detail::structure_cache_version ||
+         header.kind != detail::structure_cache_kind<IndexList>::value )
+    {
+      return false;
+    }
+
+    auto const* data = file.data() + sizeof( header );
+    auto const* const end = file.data() + file.size();
+    auto const read = [&]( auto& value ) {
+      if ( data + sizeof( value ) > end )
+      {
+        return false;
+      }
+      std::memcpy( &value, data, sizeof( value ) );
+      data += sizeof( value );
+      return true;
+    };
+
+    std::vector<std::pair<kitty::dynamic_truth_table, entry_t>> records;
+    for ( auto i = 0u; i < header.num_entries; ++i )
+    {
+      uint32_t num_vars, num_values;
+      if ( !read( num_vars ) || !read( num_values ) || num_vars > 16u )
+      {
+        return false;
+      }
+
+      /* check the sizes against the remaining file before allocating */
+      uint64_t const num_words = num_vars <= 6u ? 1u : uint64_t( 1u ) << ( num_vars - 6u );
+      if ( ( num_words * sizeof( uint64_t ) + uint64_t( num_values ) * sizeof( uint32_t ) ) > uint64_t( end - data ) )
+      {
+        return false;
+      }
+
+      kitty::dynamic_truth_table tt( num_vars );
+      for ( auto& word : tt._bits )
+      {
+        if ( !read( word ) )
+        {
+          return false;
+        }
+      }
+
+      std::vector<uint32_t> values( num_values );
+      for ( auto& value : values )
+      {
+        if ( !read( value ) )
+        {
+          return false;
+        }
+      }
+
+      entry_t lists;
+      auto pos = 1u;
+      for ( auto j = 0u; j < ( values.empty() ? 0u : values[0] ); ++j )
+      {
+        if ( pos >= values.size() || pos + 1u + values[pos] > values.size() )
+        {
+          return false;
+        }
+        lists.emplace_back( std::vector<uint32_t>( values.begin() + pos + 1u, values.begin() + pos + 1u + values[pos] ) );
+        pos += 1u + values[pos];
+      }
+      records.emplace_back( tt, lists );
+    }
+
+    if ( data != end )
+    {
+      return false;
+    }
+
+    for ( auto& [tt, lists] : records )
+    {
+      insert( tt, std::move( lists ) );
+    }
+    return true;
+  }
+
+private:
+  shard& shard_of( kitty::dynamic_truth_table const& function )
+  {
+    return _shards[kitty::hash<kitty::dynamic_truth_table>()( function ) % num_shards];
+  }
+
+private:
+  uint64_t _max_shard_entries;
+  mutable std::array<shard, num_shards> _shards;
+
+  std::atomic<uint64_t> _hits{ 0u };
+  std::atomic<uint64_t> _misses{ 0u };
+  std::atomic<uint64_t> _evictions{ 0u };
+};
+
+} /* namespace mockturtle */
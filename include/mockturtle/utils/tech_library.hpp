@@ -36,6 +36,12 @@
 
 #include <array>
 #include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -51,7 +57,9 @@
 
 #include "../io/genlib_reader.hpp"
 #include "../io/super_reader.hpp"
+#include "file_utils.hpp"
 #include "include/supergate.hpp"
+#include "npn_canonization.hpp"
 #include "standard_cell.hpp"
 #include "struct_library.hpp"
 #include "super_utils.hpp"
@@ -126,6 +134,17 @@ struct tech_library_params
 
   /*! \brief reports all the entries in the library */
   bool very_verbose{ false };
+
+  /*! \brief Binary cache file of the enumerated library (no cache if empty)
+   *
+   * If the file exists and was written for the same gates, supergates, and
+   * parameters, the enumerated configurations are loaded from it instead of
+   * being generated.  Otherwise, they are generated and the file is written.
+   */
+  std::string cache_filename{};
+
+  /*! \brief Memory-map the cache file instead of reading it */
+  bool mmap_cache{ true };
 };
 
 namespace detail
@@ -145,6 +164,143 @@ struct tuple_tt_hash
   }
 };
 
+/*! \brief Header of a tech_library cache file.
+ *
+ * The header is followed by the inverter and buffer information, the
+ * enumerated single-output configurations, the enumerated multi-output
+ * configurations, and the multi-output function IDs.  Gates are referenced by
+ * their index in the libraries of `super_utils`, which are reconstructed when
+ * loading the cache.  Values are stored in the byte order of the machine that
+ * wrote the file.
+ */
+struct tech_library_cache_header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t num_inputs;
+  uint32_t configuration;
+  uint32_t reserved;
+  uint64_t key;
+};
+
+inline constexpr char tech_library_cache_magic[8] = { 'M', 'T', 'T', 'E', 'C', 'H', 'L', 'B' };
+inline constexpr uint32_t tech_library_cache_version = 1u;
+
+/* FNV-1a hash of the contents that determine a tech_library */
+class tech_library_cache_key
+{
+public:
+  void add( void const* data, std::size_t size )
+  {
+    auto const* bytes = static_cast<unsigned char const*>( data );
+    for ( auto i = 0u; i < size; ++i )
+    {
+      _key = ( _key ^ bytes[i] ) * 0x100000001b3ull;
+    }
+  }
+
+  template<typename T>
+  void add( T const& value )
+  {
+    static_assert( std::is_arithmetic_v<T> || std::is_enum_v<T>, "only plain values can be hashed directly" );
+    add( &value, sizeof( T ) );
+  }
+
+  void add( std::string const& str )
+  {
+    add( static_cast<uint64_t>( str.size() ) );
+    add( str.data(), str.size() );
+  }
+
+  void add( std::vector<gate> const& gates )
+  {
+    add( static_cast<uint64_t>( gates.size() ) );
+    for ( auto const& g : gates )
+    {
+      add( g.id );
+      add( g.name );
+      add( g.expression );
+      add( g.num_vars );
+      add( g.function.num_vars() );
+      add( g.function._bits.data(), g.function._bits.size() * sizeof( uint64_t ) );
+      add( g.area );
+      add( g.output_name );
+      add( static_cast<uint64_t>( g.pins.size() ) );
+      for ( auto const& p : g.pins )
+      {
+        add( p.name );
+        add( p.phase );
+        add( p.input_load );
+        add( p.max_load );
+        add( p.rise_block_delay );
+        add( p.rise_fanout_delay );
+        add( p.fall_block_delay );
+        add( p.fall_fanout_delay );
+      }
+    }
+  }
+
+  void add( super_lib const& spec )
+  {
+    add( spec.genlib_name );
+    add( spec.max_num_vars );
+    add( spec.num_supergates );
+    add( static_cast<uint64_t>( spec.supergates.size() ) );
+    for ( auto const& sg : spec.supergates )
+    {
+      add( sg.id );
+      add( sg.name );
+      add( sg.is_super );
+      add( static_cast<uint64_t>( sg.fanin_id.size() ) );
+      add( sg.fanin_id.data(), sg.fanin_id.size() * sizeof( uint32_t ) );
+    }
+  }
+
+  uint64_t value() const
+  {
+    return _key;
+  }
+
+private:
+  uint64_t _key{ 0xcbf29ce484222325ull };
+};
+
+/* bounds-checked reader over the contents of a cache file */
+class tech_library_cache_reader
+{
+public:
+  explicit tech_library_cache_reader( std::string_view contents )
+      : _contents( contents )
+  {
+  }
+
+  template<typename T>
+  bool read( T& value )
+  {
+    return read( &value, sizeof( T ) );
+  }
+
+  bool read( void* data, std::size_t size )
+  {
+    if ( size > _contents.size() - _pos )
+    {
+      return false;
+    }
+    std::memcpy( data, _contents.data() + _pos, size );
+    _pos += size;
+    return true;
+  }
+
+  bool at_end() const
+  {
+    return _pos == _contents.size();
+  }
+
+private:
+  std::string_view _contents;
+  std::size_t _pos{ 0u };
+};
+
 } // namespace detail
 
 /*! \brief Library of gates for Boolean matching
@@ -212,10 +368,16 @@ public:
   {
     static_assert( NInputs < 16, "The technology library database supports NInputs up to 15\n" );
 
-    generate_library();
+    if ( ps.cache_filename.empty() || !load_cache() )
+    {
+      generate_library();
+
+      if ( ps.load_multioutput_gates )
+        generate_multioutput_library();
 
-    if ( ps.load_multioutput_gates )
-      generate_multioutput_library();
+      if ( !ps.cache_filename.empty() )
+        save_cache();
+    }
 
     if ( ps.load_large_gates )
     {
@@ -237,10 +399,16 @@ public:
   {
     static_assert( NInputs < 16, "The technology library database supports NInputs up to 15\n" );
 
-    generate_library();
+    if ( ps.cache_filename.empty() || !load_cache() )
+    {
+      generate_library();
+
+      if ( ps.load_multioutput_gates )
+        generate_multioutput_library();
 
-    if ( ps.load_multioutput_gates )
-      generate_multioutput_library();
+      if ( !ps.cache_filename.empty() )
+        save_cache();
+    }
 
     if ( ps.load_large_gates )
     {
@@ -371,6 +539,12 @@ public:
     return _struct.get_struct_library().size();
   }
 
+  /*! \brief Returns whether the library has been loaded from the cache file. */
+  bool loaded_from_cache() const
+  {
+    return _loaded_from_cache;
+  }
+
 private:
   void generate_library()
   {
@@ -1042,6 +1216,265 @@ private:
     return false;
   }
 
+  /* gates of the cache are referenced by index: standard gates and supergates first, then multi-output gates */
+  std::vector<composed_gate<NInputs> const*> cache_gates() const
+  {
+    std::vector<composed_gate<NInputs> const*> gates;
+    for ( auto const& g : _super.get_super_library() )
+    {
+      gates.push_back( &g );
+    }
+    for ( auto const& multi_gate : _super.get_multioutput_library() )
+    {
+      for ( auto const& g : multi_gate )
+      {
+        gates.push_back( &g );
+      }
+    }
+    return gates;
+  }
+
+  uint64_t cache_key() const
+  {
+    detail::tech_library_cache_key key;
+    key.add( _gates );
+    key.add( _supergates_spec );
+    key.add( _ps.load_multioutput_gates );
+    key.add( _ps.ignore_symmetries );
+    key.add( _ps.load_minimum_size_only );
+    key.add( _ps.remove_dominated_gates );
+    key.add( _ps.load_multioutput_gates_single );
+    return key.value();
+  }
+
+  bool load_cache()
+  {
+    if ( _ps.mmap_cache )
+    {
+      mapped_file file( _ps.cache_filename );
+      return file.is_open() && load_cache( file.view() );
+    }
+
+    std::ifstream in( _ps.cache_filename, std::ifstream::in | std::ifstream::binary );
+    if ( !in.is_open() )
+    {
+      return false;
+    }
+    std::string const contents( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+    return load_cache( contents );
+  }
+
+  bool load_cache( std::string_view contents )
+  {
+    detail::tech_library_cache_reader in( contents );
+
+    detail::tech_library_cache_header header;
+    if ( !in.read( header ) || std::memcmp( header.magic, detail::tech_library_cache_magic, sizeof( header.magic ) ) != 0 ||
+         header.version != detail::tech_library_cache_version || header.num_inputs != NInputs ||
+         header.configuration != static_cast<uint32_t>( Configuration ) || header.key != cache_key() )
+    {
+      return false;
+    }
+
+    auto const gates = cache_gates();
+    auto const read_supergates = [&]( supergates_list_t& list ) {
+      uint32_t size;
+      if ( !in.read( size ) )
+      {
+        return false;
+      }
+      list.resize( size );
+      for ( auto& sg : list )
+      {
+        uint32_t root;
+        uint8_t perm_size;
+        if ( !in.read( root ) || root >= gates.size() || !in.read( sg.area ) || !in.read( sg.tdelay ) || !in.read( perm_size ) )
+        {
+          return false;
+        }
+        sg.root = gates[root];
+        sg.permutation.resize( perm_size );
+        if ( !in.read( sg.permutation.data(), perm_size ) || !in.read( sg.polarity ) )
+        {
+          return false;
+        }
+      }
+      return true;
+    };
+
+    if ( !in.read( _inv_area ) || !in.read( _inv_delay ) || !in.read( _inv_id ) ||
+         !in.read( _buf_area ) || !in.read( _buf_delay ) || !in.read( _buf_id ) || !in.read( _max_size ) )
+    {
+      return false;
+    }
+
+    uint64_t num_entries;
+    if ( !in.read( num_entries ) )
+    {
+      return false;
+    }
+    _super_lib.reserve( num_entries );
+    for ( auto i = 0u; i < num_entries; ++i )
+    {
+      TT tt;
+      if ( !in.read( tt._bits ) || !read_supergates( _super_lib[tt] ) )
+      {
+        return reset_library();
+      }
+    }
+
+    if ( !in.read( num_entries ) )
+    {
+      return reset_library();
+    }
+    _multi_lib.reserve( num_entries );
+    for ( auto i = 0u; i < num_entries; ++i )
+    {
+      multi_relation_t tts;
+      for ( auto& tt : tts )
+      {
+        if ( !in.read( tt._bits ) )
+        {
+          return reset_library();
+        }
+      }
+      auto& lists = _multi_lib[tts];
+      for ( auto& list : lists )
+      {
+        if ( !read_supergates( list ) )
+        {
+          return reset_library();
+        }
+      }
+    }
+
+    if ( !in.read( num_entries ) )
+    {
+      return reset_library();
+    }
+    _multi_funcs.reserve( num_entries );
+    for ( auto i = 0u; i < num_entries; ++i )
+    {
+      uint64_t tt, func;
+      if ( !in.read( tt ) || !in.read( func ) )
+      {
+        return reset_library();
+      }
+      _multi_funcs[tt] = func;
+    }
+
+    if ( !in.at_end() )
+    {
+      return reset_library();
+    }
+
+    _loaded_from_cache = true;
+    return true;
+  }
+
+  /* discards a partially loaded cache, always returns false */
+  bool reset_library()
+  {
+    _super_lib.clear();
+    _multi_lib.clear();
+    _multi_funcs.clear();
+    _max_size = 0;
+    return false;
+  }
+
+  void save_cache() const
+  {
+    phmap::flat_hash_map<composed_gate<NInputs> const*, uint32_t> gate_index;
+    auto const gates = cache_gates();
+    for ( auto i = 0u; i < gates.size(); ++i )
+    {
+      gate_index[gates[i]] = i;
+    }
+
+    /* write into a temporary file of this job first, such that concurrent jobs never read a partial cache */
+    std::string const tmp_filename = temporary_filename( _ps.cache_filename );
+    {
+      std::ofstream os( tmp_filename, std::ofstream::out | std::ofstream::binary );
+      if ( !os.is_open() )
+      {
+        return;
+      }
+
+      output_buffer out( os );
+      auto const write = [&]( auto const& value ) {
+        out.write( std::string_view( reinterpret_cast<char const*>( &value ), sizeof( value ) ) );
+      };
+      auto const write_supergates = [&]( supergates_list_t const& list ) {
+        write( static_cast<uint32_t>( list.size() ) );
+        for ( auto const& sg : list )
+        {
+          write( gate_index.at( sg.root ) );
+          write( sg.area );
+          write( sg.tdelay );
+          write( static_cast<uint8_t>( sg.permutation.size() ) );
+          out.write( std::string_view( reinterpret_cast<char const*>( sg.permutation.data() ), sg.permutation.size() ) );
+          write( sg.polarity );
+        }
+      };
+
+      detail::tech_library_cache_header header;
+      std::memcpy( header.magic, detail::tech_library_cache_magic, sizeof( header.magic ) );
+      header.version = detail::tech_library_cache_version;
+      header.num_inputs = NInputs;
+      header.configuration = static_cast<uint32_t>( Configuration );
+      header.reserved = 0u;
+      header.key = cache_key();
+      write( header );
+
+      write( _inv_area );
+      write( _inv_delay );
+      write( _inv_id );
+      write( _buf_area );
+      write( _buf_delay );
+      write( _buf_id );
+      write( _max_size );
+
+      write( static_cast<uint64_t>( _super_lib.size() ) );
+      for ( auto const& [tt, list] : _super_lib )
+      {
+        write( tt._bits );
+        write_supergates( list );
+      }
+
+      write( static_cast<uint64_t>( _multi_lib.size() ) );
+      for ( auto const& [tts, lists] : _multi_lib )
+      {
+        for ( auto const& tt : tts )
+        {
+          write( tt._bits );
+        }
+        for ( auto const& list : lists )
+        {
+          write_supergates( list );
+        }
+      }
+
+      write( static_cast<uint64_t>( _multi_funcs.size() ) );
+      for ( auto const& [tt, func] : _multi_funcs )
+      {
+        write( tt );
+        write( func );
+      }
+
+      out.flush();
+      if ( !os )
+      {
+        os.close();
+        std::remove( tmp_filename.c_str() );
+        return;
+      }
+    }
+    if ( std::rename( tmp_filename.c_str(), _ps.cache_filename.c_str() ) != 0 )
+    {
+      std::remove( tmp_filename.c_str() );
+    }
+  }
+
   float compute_worst_delay( gate const& g )
   {
     float worst_delay = 0.0f;
@@ -1164,6 +1597,7 @@ private:
   unsigned _max_size{ 0 }; /* max #fanins of the gates in the library */
 
   bool _use_supergates;
+  bool _loaded_from_cache{ false };
 
   std::vector<gate> const _gates;    /* collection of gates */
   super_lib const _supergates_spec;  /* collection of supergates declarations */
@@ -1372,7 +1806,7 @@ private:
     TT tt;
     do
     {
-      const auto res = kitty::exact_npn_canonization( tt );
+      const auto res = cached_exact_npn_canonization( tt );
       classes.insert( std::get<0>( res ) );
       kitty::next_inplace( tt );
     } while ( !kitty::is_const0( tt ) );
@@ -103,7 +103,7 @@ public:
   }
 
   explicit fanout_view( Ntk const& ntk, fanout_view_params const& ps = {} )
-      : Ntk( ntk ), _fanout( ntk ), _ps( ps )
+      : Ntk( ntk ), _fanout( *this ), _ps( ps )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
@@ -116,8 +116,9 @@ public:
 
   /*! \brief Copy constructor. */
   fanout_view( fanout_view<Ntk, false> const& other )
-      : Ntk( other ), _fanout( other._fanout ), _ps( other._ps )
+      : Ntk( other ), _fanout( *this ), _ps( other._ps )
   {
+    copy_fanout( other );
     register_events();
   }
 
@@ -131,7 +132,8 @@ public:
 
     /* copy */
     _ps = other._ps;
-    _fanout = other._fanout;
+    _fanout = node_map<std::vector<node>, Ntk>( *this );
+    copy_fanout( other );
 
     register_events();
 
@@ -302,6 +304,14 @@ private:
     }
   }
 
+  /* copies do not share the fanout map, since each copy updates it on events */
+  void copy_fanout( fanout_view<Ntk, false> const& other )
+  {
+    this->foreach_node( [&]( auto const& n ) {
+      _fanout[n] = other._fanout[n];
+    } );
+  }
+
   void compute_fanout()
   {
     _fanout.reset();
@@ -36,13 +36,71 @@
 #pragma once
 
 #include "../traits.hpp"
+#include "../utils/string_pool.hpp"
 
+#include <cstdint>
+#include <cstring>
 #include <map>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <parallel_hashmap/phmap.h>
 
 namespace mockturtle
 {
 
+namespace detail
+{
+
+/*! \brief Name storage shared by copies of a names view.
+ *
+ * Names are interned in a string pool.  Signals that fit into 64 bits are
+ * mapped to name ids by a flat hash map over their bit pattern, output names
+ * are stored as a vector of ids indexed by the output index.
+ */
+template<class Signal>
+struct names_storage
+{
+  static constexpr bool compact_signals = std::is_trivially_copyable_v<Signal> && sizeof( Signal ) <= sizeof( uint64_t );
+  static constexpr uint32_t no_name = string_pool::invalid_id;
+
+  using signal_map = std::conditional_t<compact_signals, phmap::flat_hash_map<uint64_t, uint32_t>, std::map<Signal, uint32_t>>;
+
+  static auto key( Signal const& s )
+  {
+    if constexpr ( compact_signals )
+    {
+      uint64_t k{ 0u };
+      std::memcpy( &k, &s, sizeof( Signal ) );
+      return k;
+    }
+    else
+    {
+      return s;
+    }
+  }
+
+  string_pool pool;
+  signal_map signal_names;
+  std::vector<uint32_t> output_names;
+};
+
+} // namespace detail
+
+/*! \brief Assigns names to signals and primary outputs.
+ *
+ * Names are interned: every distinct name is stored once, and signals as well
+ * as outputs only refer to it by an id.  Copies of a names view share the name
+ * storage until one of them changes a name (copy-on-write), such that copying
+ * a named network does not copy its names.
+ *
+ * Names returned by `get_name_view` and `get_output_name_view` remain valid
+ * until the names of this view are changed.
+ */
 template<class Ntk>
 class names_view : public Ntk
 {
@@ -51,15 +109,18 @@ public:
   using node = typename Ntk::node;
   using signal = typename Ntk::signal;
 
+private:
+  using names_storage = detail::names_storage<signal>;
+
 public:
   template<typename StrType = const char*>
   names_view( Ntk const& ntk = Ntk(), StrType name = "" )
-      : Ntk( ntk ), _network_name{ name }
+      : Ntk( ntk ), _network_name{ name }, _names( std::make_shared<names_storage>() )
   {
   }
 
   names_view( names_view<Ntk> const& named_ntk )
-      : Ntk( named_ntk ), _network_name( named_ntk._network_name ), _signal_names( named_ntk._signal_names ), _output_names( named_ntk._output_names )
+      : Ntk( named_ntk ), _network_name( named_ntk._network_name ), _names( named_ntk._names )
   {
   }
 
@@ -68,9 +129,8 @@ public:
     if ( this != &named_ntk ) // Check for self-assignment
     {
       Ntk::operator=( named_ntk );
-      _signal_names = named_ntk._signal_names;
+      _names = named_ntk._names;
       _network_name = named_ntk._network_name;
-      _output_names = named_ntk._output_names;
     }
     return *this;
   }
@@ -79,7 +139,7 @@ public:
    *
    * \param name Name of the created primary input
    */
-  signal create_pi( std::string const& name = {} )
+  signal create_pi( std::string_view name = {} )
   {
     const auto s = Ntk::create_pi();
     if ( !name.empty() )
@@ -94,7 +154,7 @@ public:
    * \param s Signal that drives the created primary output
    * \param name Name of the created primary output
    */
-  void create_po( signal const& s, std::string const& name = {} )
+  void create_po( signal const& s, std::string_view name = {} )
   {
     const auto index = Ntk::num_pos();
     Ntk::create_po( s );
@@ -132,7 +192,7 @@ public:
    */
   bool has_name( signal const& s ) const
   {
-    return ( _signal_names.find( s ) != _signal_names.end() );
+    return _names->signal_names.find( names_storage::key( s ) ) != _names->signal_names.end();
   }
 
   /*! \brief Sets the name for a signal.
@@ -142,9 +202,10 @@ public:
    * \param s Signal to be set a name
    * \param name Name of the signal
    */
-  void set_name( signal const& s, std::string const& name )
+  void set_name( signal const& s, std::string_view name )
   {
-    _signal_names[s] = name;
+    auto& names = mutable_names();
+    names.signal_names[names_storage::key( s )] = names.pool.intern( name );
   }
 
   /*! \brief Gets signal name.
@@ -156,7 +217,24 @@ public:
    */
   std::string get_name( signal const& s ) const
   {
-    return _signal_names.at( s );
+    return std::string( get_name_view( s ) );
+  }
+
+  /*! \brief Gets signal name without copying it.
+   *
+   * Throws `std::out_of_range` if the signal has no name.
+   *
+   * \param s Signal to be queried
+   * \return Name of the signal
+   */
+  std::string_view get_name_view( signal const& s ) const
+  {
+    auto const it = _names->signal_names.find( names_storage::key( s ) );
+    if ( it == _names->signal_names.end() )
+    {
+      throw std::out_of_range( "signal has no name" );
+    }
+    return _names->pool[it->second];
   }
 
   /*! \brief Checks if a primary output has a name.
@@ -166,7 +244,7 @@ public:
    */
   bool has_output_name( uint32_t index ) const
   {
-    return ( _output_names.find( index ) != _output_names.end() );
+    return index < _names->output_names.size() && _names->output_names[index] != names_storage::no_name;
   }
 
   /*! \brief Sets the name for a primary output.
@@ -177,9 +255,14 @@ public:
    * \param index Index of the primary output to set a name
    * \param name Name of the primary output
    */
-  void set_output_name( uint32_t index, std::string const& name )
+  void set_output_name( uint32_t index, std::string_view name )
   {
-    _output_names[index] = name;
+    auto& names = mutable_names();
+    if ( index >= names.output_names.size() )
+    {
+      names.output_names.resize( index + 1u, names_storage::no_name );
+    }
+    names.output_names[index] = names.pool.intern( name );
   }
 
   /*! \brief Gets the name of a primary output.
@@ -192,13 +275,38 @@ public:
    */
   std::string get_output_name( uint32_t index ) const
   {
-    return _output_names.at( index );
+    return std::string( get_output_name_view( index ) );
+  }
+
+  /*! \brief Gets the name of a primary output without copying it.
+   *
+   * Throws `std::out_of_range` if the primary output has no name.
+   *
+   * \param index Index of the primary output to be queried
+   * \return Name of the primary output
+   */
+  std::string_view get_output_name_view( uint32_t index ) const
+  {
+    if ( !has_output_name( index ) )
+    {
+      throw std::out_of_range( "output has no name" );
+    }
+    return _names->pool[_names->output_names[index]];
+  }
+
+private:
+  names_storage& mutable_names()
+  {
+    if ( _names.use_count() > 1 )
+    {
+      _names = std::make_shared<names_storage>( *_names );
+    }
+    return *_names;
   }
 
 private:
   std::string _network_name;
-  std::map<signal, std::string> _signal_names;
-  std::map<uint32_t, std::string> _output_names;
+  std::shared_ptr<names_storage> _names;
 }; /* names_view */
 
 template<class T>
@@ -207,4 +315,4 @@ names_view( T const& ) -> names_view<T>;
 template<class T>
 names_view( T const&, typename T::signal const& ) -> names_view<T>;
 
-} // namespace mockturtle
\ No newline at end of file
+} // namespace mockturtle
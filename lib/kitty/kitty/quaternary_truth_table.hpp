@@ -104,7 +104,7 @@ struct quaternary_truth_table
 
   /*! Returns number of variables.
    */
-  template<typename = std::enable_if_t<is_complete_truth_table<TT>::value>>
+  template<typename T = TT, typename = std::enable_if_t<is_complete_truth_table<T>::value>>
   auto num_vars() const noexcept { return _onset.num_vars(); }
 
   /*! Returns number of blocks.
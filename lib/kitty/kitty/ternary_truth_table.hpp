@@ -102,7 +102,7 @@ struct ternary_truth_table
 
   /*! Returns number of variables.
    */
-  template<typename = std::enable_if_t<is_complete_truth_table<TT>::value>>
+  template<typename T = TT, typename = std::enable_if_t<is_complete_truth_table<T>::value>>
   auto num_vars() const noexcept { return _bits.num_vars(); }
 
   /*! Returns number of blocks.
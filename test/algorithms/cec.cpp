@@ -0,0 +1,146 @@
+#include <catch.hpp>
+
+#include <vector>
+
+#include <mockturtle/algorithms/cec.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+template<class Ntk>
+Ntk ripple_adder( uint32_t bitwidth )
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> a( bitwidth ), b( bitwidth );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+  auto carry = ntk.get_constant( false );
+  carry_ripple_adder_inplace( ntk, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { ntk.create_po( f ); } );
+  ntk.create_po( carry );
+  return ntk;
+}
+
+template<class Ntk>
+Ntk lookahead_adder( uint32_t bitwidth )
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> a( bitwidth ), b( bitwidth );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+  auto carry = ntk.get_constant( false );
+  carry_lookahead_adder_inplace( ntk, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { ntk.create_po( f ); } );
+  ntk.create_po( carry );
+  return ntk;
+}
+
+} // namespace
+
+TEST_CASE( "CEC of two structurally different adders", "[cec]" )
+{
+  auto const aig = ripple_adder<aig_network>( 16u );
+  auto const mig = lookahead_adder<mig_network>( 16u );
+
+  cec_stats st;
+  auto const result = cec( aig, mig, {}, &st );
+  CHECK( result );
+  CHECK( *result );
+  CHECK( !st.failing_output );
+}
+
+TEST_CASE( "CEC with multiple threads and without sweeping", "[cec]" )
+{
+  auto const aig = ripple_adder<aig_network>( 12u );
+  auto const xag = lookahead_adder<xag_network>( 12u );
+
+  cec_params ps;
+  ps.sat_sweeping = false;
+  ps.num_threads = 4u;
+  cec_stats st;
+  auto const result = cec( aig, xag, ps, &st );
+  CHECK( result );
+  CHECK( *result );
+  CHECK( st.num_merges == 0u );
+}
+
+TEST_CASE( "CEC of identical networks is structural", "[cec]" )
+{
+  auto const aig = ripple_adder<aig_network>( 8u );
+
+  cec_stats st;
+  auto const result = cec( aig, aig, {}, &st );
+  CHECK( result );
+  CHECK( *result );
+  CHECK( st.num_structural == aig.num_pos() );
+  CHECK( st.num_obligations == 0u );
+}
+
+TEST_CASE( "CEC finds counter-example for rare difference", "[cec]" )
+{
+  auto const aig1 = ripple_adder<aig_network>( 24u );
+  auto aig2 = lookahead_adder<aig_network>( 24u );
+
+  /* the carry-out differs only when all inputs are 1 */
+  aig_network aig3;
+  std::vector<aig_network::signal> pis;
+  for ( auto i = 0u; i < aig2.num_pis(); ++i )
+  {
+    pis.emplace_back( aig3.create_pi() );
+  }
+  auto pos = cleanup_dangling( aig2, aig3, pis.begin(), pis.end() );
+  pos.back() = aig3.create_xor( pos.back(), aig3.create_nary_and( pis ) );
+  std::for_each( pos.begin(), pos.end(), [&]( auto const& f ) { aig3.create_po( f ); } );
+
+  for ( auto const threads : { 1u, 3u } )
+  {
+    cec_params ps;
+    ps.num_threads = threads;
+    cec_stats st;
+    auto const result = cec( aig1, aig3, ps, &st );
+    CHECK( result );
+    CHECK( !*result );
+    REQUIRE( st.failing_output );
+    CHECK( *st.failing_output == aig1.num_pos() - 1u );
+    CHECK( st.counter_example == std::vector<bool>( aig1.num_pis(), true ) );
+
+    /* the counter-example distinguishes the networks */
+    default_simulator<bool> sim( st.counter_example );
+    CHECK( simulate<bool>( aig1, sim ) != simulate<bool>( aig3, sim ) );
+  }
+}
+
+TEST_CASE( "CEC finds counter-example by simulation", "[cec]" )
+{
+  aig_network aig1, aig2;
+  auto const a1 = aig1.create_pi();
+  auto const b1 = aig1.create_pi();
+  aig1.create_po( aig1.create_xor( a1, b1 ) );
+
+  auto const a2 = aig2.create_pi();
+  auto const b2 = aig2.create_pi();
+  aig2.create_po( aig2.create_or( a2, b2 ) );
+
+  cec_stats st;
+  auto const result = cec( aig1, aig2, {}, &st );
+  CHECK( result );
+  CHECK( !*result );
+  CHECK( st.counter_example == std::vector<bool>( { true, true } ) );
+}
+
+TEST_CASE( "CEC of networks with different interfaces", "[cec]" )
+{
+  aig_network aig1, aig2;
+  aig1.create_po( aig1.create_pi() );
+  aig2.create_pi();
+  aig2.create_po( aig2.create_pi() );
+
+  CHECK( !cec( aig1, aig2 ) );
+}
@@ -2,6 +2,8 @@
 
 #include <bill/sat/interface/abc_bsat2.hpp>
 #include <mockturtle/algorithms/circuit_validator.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/mig.hpp>
 #include <mockturtle/networks/xag.hpp>
@@ -184,4 +186,73 @@ TEST_CASE( "Validating with ODC", "[validator]" )
   v.set_odc_levels( 2 );
   CHECK( *( v.validate( f1, false ) ) == true );
   CHECK( *( v.validate( aig.get_node( f1 ), aig.get_constant( false ) ) ) == true );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Validating with incremental garbage collection", "[validator]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 8u ), b( 8u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  auto s = a, t = a;
+  auto c1 = aig.get_constant( false ), c2 = aig.get_constant( false );
+  carry_ripple_adder_inplace( aig, s, b, c1 );
+  carry_lookahead_adder_inplace( aig, t, b, c2 );
+  s.emplace_back( c1 );
+  t.emplace_back( c2 );
+  std::for_each( s.begin(), s.end(), [&]( auto const& f ) { aig.create_po( f ); } );
+  std::for_each( t.begin(), t.end(), [&]( auto const& f ) { aig.create_po( f ); } );
+
+  validator_params ps;
+  ps.max_clauses = 30u;
+  ps.gc_restart_ratio = 1000u;
+  ps.incremental_gc = true;
+  circuit_validator<aig_network, bill::solvers::bsat2, false, true, false> v( aig, ps );
+
+  for ( auto i = 0u; i < s.size(); ++i )
+  {
+    for ( auto j = 0u; j < s.size(); ++j )
+    {
+      auto const res = v.validate( t[i], s[j] );
+      REQUIRE( res );
+      CHECK( *res == ( i == j ) );
+      if ( !*res )
+      {
+        auto const values = simulate_nodes<bool>( aig, default_simulator<bool>( v.cex ) );
+        CHECK( ( values[t[i]] ^ aig.is_complemented( t[i] ) ) != ( values[s[j]] ^ aig.is_complemented( s[j] ) ) );
+      }
+    }
+
+    /* the cone of t[i] becomes dead */
+    if ( aig.get_node( t[i] ) != aig.get_node( s[i] ) )
+    {
+      aig.substitute_node( aig.get_node( t[i] ), s[i] ^ aig.is_complemented( t[i] ) );
+    }
+  }
+
+  /* equivalent cones of different structure; the redundant ones become dead */
+  for ( auto i = 0u; i < 64u; ++i )
+  {
+    auto const x = a[i % 8u], y = b[( i / 8u ) % 8u], z = a[( i + 3u ) % 8u];
+    auto const f = aig.create_and( aig.create_and( x, y ), z );
+    auto const g = aig.create_and( x, aig.create_and( y, z ) );
+    CHECK( *v.validate( g, f ) == true );
+    CHECK( *v.validate( g, aig.create_and( x, y ) ) == false );
+    aig.substitute_node( aig.get_node( g ), f );
+  }
+
+  /* index lists are guarded by the query */
+  xag_index_list id_list;
+  id_list.add_inputs( 2 );
+  id_list.add_xor( 2, 4 );
+  id_list.add_output( 6 );
+  for ( auto i = 0u; i < 30u; ++i )
+  {
+    CHECK( *v.validate( s[0], { aig.get_node( a[0] ), aig.get_node( b[0] ) }, id_list ) == true );
+    CHECK( *v.validate( s[1], { aig.get_node( a[1] ), aig.get_node( b[1] ) }, id_list ) == false );
+  }
+
+  /* clauses were freed by garbage collection instead of restarting the solver */
+  CHECK( v.num_garbage_collections > 0u );
+  CHECK( v.num_restarts == 0u );
+}
@@ -1,16 +1,80 @@
 #include <catch.hpp>
 
 #include <mockturtle/algorithms/cnf.hpp>
+#include <mockturtle/algorithms/miter.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
 #include <mockturtle/networks/xag.hpp>
 #include <mockturtle/utils/include/percy.hpp>
 
+#include <bill/sat/interface/abc_bsat2.hpp>
+#include <bill/sat/interface/common.hpp>
+
 #include <fmt/format.h>
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
 
 using namespace mockturtle;
 
+namespace
+{
+
+template<class Ntk>
+Ntk ripple_adder( uint32_t bitwidth )
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> a( bitwidth ), b( bitwidth );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+  auto carry = ntk.get_constant( false );
+  carry_ripple_adder_inplace( ntk, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { ntk.create_po( f ); } );
+  ntk.create_po( carry );
+  return ntk;
+}
+
+/* checks that the mapped CNF of a network is equivalent to its Tseytin CNF */
+template<class Ntk>
+void check_mapped_cnf( Ntk const& ntk )
+{
+  percy::bsat_wrapper solver;
+  auto const tseytin_lits = generate_cnf( ntk, [&]( auto const& clause ) {
+    solver.add_clause( clause );
+  } );
+
+  /* share the variables of the constant and the primary inputs */
+  auto lits = node_literals( ntk );
+  ntk.foreach_gate( [&]( auto const& n ) {
+    lits[n] += 2 * ntk.size();
+  } );
+
+  uint32_t num_tseytin{ 0u };
+  generate_cnf( ntk, [&]( auto const& ) { ++num_tseytin; } );
+
+  cnf_mapping_stats st;
+  auto const mapped_lits = generate_mapped_cnf(
+      ntk, [&]( auto const& clause ) {
+        solver.add_clause( clause );
+      },
+      {}, std::make_optional( lits ), &st );
+
+  CHECK( st.num_clauses < num_tseytin );
+  CHECK( st.num_roots <= ntk.num_gates() );
+
+  /* the outputs are equal under all input assignments */
+  for ( auto i = 0u; i < tseytin_lits.size(); ++i )
+  {
+    std::vector<int> assumptions{ static_cast<int>( tseytin_lits[i] ), static_cast<int>( lit_not( mapped_lits[i] ) ) };
+    CHECK( solver.solve( &assumptions[0], &assumptions[0] + 2, 0 ) == percy::synth_result::failure );
+    assumptions = { static_cast<int>( lit_not( tseytin_lits[i] ) ), static_cast<int>( mapped_lits[i] ) };
+    CHECK( solver.solve( &assumptions[0], &assumptions[0] + 2, 0 ) == percy::synth_result::failure );
+  }
+}
+
+} // namespace
+
 TEST_CASE( "Translate XAG into CNF", "[cnf]" )
 {
   xag_network xag;
@@ -108,3 +172,74 @@ TEST_CASE( "Use CNF generation for CEC on XAG", "[cnf]" )
   const auto res = solver.solve( 0 );
   CHECK( res == percy::synth_result::failure );
 }
+
+TEST_CASE( "Translate XAG into compact CNF", "[cnf]" )
+{
+  xag_network xag;
+
+  const auto a = xag.create_pi();
+  const auto b = xag.create_pi();
+
+  const auto f1 = xag.create_nand( a, b );
+  const auto f2 = xag.create_nand( a, f1 );
+  const auto f3 = xag.create_nand( b, f1 );
+  const auto f4 = xag.create_nand( f2, f3 );
+
+  xag.create_po( f4 );
+
+  std::vector<std::vector<uint32_t>> clauses;
+  cnf_mapping_stats st;
+  const auto output = generate_mapped_cnf(
+      xag, [&]( auto const& clause ) {
+        clauses.push_back( clause );
+      },
+      {}, {}, &st )[0];
+
+  /* constant unit clause and 4 clauses for the XOR of both inputs */
+  CHECK( st.num_clauses == 5u );
+  CHECK( st.num_roots == 1u );
+  CHECK( clauses.size() == 5u );
+  CHECK( output / 2 == 6u );
+}
+
+TEST_CASE( "Compact CNF is equivalent to Tseytin CNF", "[cnf]" )
+{
+  check_mapped_cnf( ripple_adder<aig_network>( 8u ) );
+  check_mapped_cnf( ripple_adder<xag_network>( 8u ) );
+  check_mapped_cnf( ripple_adder<mig_network>( 6u ) );
+}
+
+TEST_CASE( "Compact CNF of k-LUT network with bill literals", "[cnf]" )
+{
+  klut_network ntk;
+
+  const auto a = ntk.create_pi();
+  const auto b = ntk.create_pi();
+  const auto c = ntk.create_pi();
+
+  const auto f1 = ntk.create_xor( a, b );
+  const auto f2 = ntk.create_and( f1, c );
+  const auto f3 = ntk.create_or( f2, ntk.create_not( a ) );
+  ntk.create_po( f3 );
+  ntk.create_po( ntk.create_not( f2 ) );
+
+  bill::solver<bill::solvers::bsat2> solver;
+  node_map<bill::lit_type, klut_network> lits( ntk );
+  ntk.foreach_node( [&]( auto const& n ) {
+    lits[n] = bill::lit_type( solver.add_variable(), bill::lit_type::polarities::positive );
+  } );
+
+  const auto outputs = generate_mapped_cnf<klut_network, bill::lit_type>(
+      ntk, [&]( auto const& clause ) {
+        solver.add_clause( clause );
+      },
+      {}, lits );
+  REQUIRE( outputs.size() == 2u );
+
+  /* first output is 0 only if a = 1 and f2 = 0 */
+  CHECK( solver.solve( { ~outputs[0] } ) == bill::result::states::satisfiable );
+  CHECK( solver.get_model().model().at( lits[ntk.get_node( a )].variable() ) == bill::lbool_type::true_ );
+
+  /* second output is the complement of f2 */
+  CHECK( solver.solve( { ~outputs[0], ~outputs[1] } ) == bill::result::states::unsatisfiable );
+}
@@ -1,5 +1,6 @@
 #include <catch.hpp>
 
+#include <mockturtle/algorithms/cec.hpp>
 #include <mockturtle/algorithms/cut_rewriting.hpp>
 #include <mockturtle/algorithms/node_resynthesis/akers.hpp>
 #include <mockturtle/algorithms/node_resynthesis/exact.hpp>
@@ -7,6 +8,7 @@
 #include <mockturtle/algorithms/node_resynthesis/xag_minmc2.hpp>
 #include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
 #include <mockturtle/algorithms/node_resynthesis/xmg3_npn.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/klut.hpp>
 #include <mockturtle/networks/mig.hpp>
@@ -461,3 +463,37 @@ TEST_CASE( "Cut rewriting with stacked depth-fanout views", "[cut_rewriting]" )
   CHECK( aig.num_pos() == 2 );
   CHECK( aig.num_gates() == 8 );
 }
+
+TEST_CASE( "In-place cut rewriting with parallel candidate generation", "[cut_rewriting]" )
+{
+  mig_network mig;
+  std::vector<mig_network::signal> a( 5u ), b( 5u );
+  std::generate( a.begin(), a.end(), [&]() { return mig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return mig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( mig, a, b ) )
+  {
+    mig.create_po( f );
+  }
+
+  mig_npn_resynthesis resyn;
+  std::vector<uint32_t> sizes;
+  for ( auto const threads : { 1u, 2u, 3u } )
+  {
+    auto res = mig.clone();
+    cut_rewriting_params ps;
+    ps.cut_enumeration_ps.cut_size = 4u;
+    ps.num_threads = threads;
+    ps.window_gates = 8u;
+    cut_rewriting_with_compatibility_graph( res, resyn, ps );
+    res = cleanup_dangling( res );
+
+    auto const result = cec( mig, res );
+    REQUIRE( result );
+    CHECK( *result );
+    sizes.emplace_back( res.num_gates() );
+  }
+
+  CHECK( sizes[0] < mig.num_gates() );
+  CHECK( sizes[1] == sizes[0] );
+  CHECK( sizes[2] == sizes[0] );
+}
@@ -3,9 +3,11 @@
 #include <cstdint>
 #include <vector>
 
+#include <kitty/dynamic_truth_table.hpp>
 #include <lorina/genlib.hpp>
 #include <lorina/super.hpp>
 #include <mockturtle/algorithms/emap.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/io/genlib_reader.hpp>
 #include <mockturtle/io/super_reader.hpp>
@@ -1011,4 +1013,51 @@ TEST_CASE( "Emap on circuit with don't touch cells", "[emap]" )
   CHECK( st.area < 11.0f + eps );
   CHECK( st.delay > 5.8f - eps );
   CHECK( st.delay < 5.8f + eps );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Emap with cancelled area recovery", "[emap]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  tech_library<3> lib( gates );
+
+  aig_network aig;
+  std::vector<aig_network::signal> a( 4u ), b( 4u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  auto carry = aig.get_constant( false );
+  carry_ripple_adder_inplace( aig, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { aig.create_po( f ); } );
+  aig.create_po( carry );
+
+  emap_stats st;
+  emap_klut( aig, lib, {}, &st );
+
+  emap_params ps_delay;
+  ps_delay.area_flow_rounds = 0u;
+  ps_delay.ela_rounds = 0u;
+  emap_stats st_delay;
+  emap_klut( aig, lib, ps_delay, &st_delay );
+
+  /* the initial mapping is completed, but no area recovery round is run */
+  emap_params ps;
+  ps.cancellation.cancel();
+  emap_stats st_cancelled;
+  binding_view<klut_network> luts_cancelled = emap_klut( aig, lib, ps, &st_cancelled );
+
+  const float eps{ 0.005f };
+
+  CHECK( !st_cancelled.mapping_error );
+  CHECK( st.area < st_delay.area - eps );
+  CHECK( st_cancelled.area > st_delay.area - eps );
+  CHECK( st_cancelled.area < st_delay.area + eps );
+  CHECK( st_cancelled.delay > st_delay.delay - eps );
+  CHECK( st_cancelled.delay < st_delay.delay + eps );
+
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  CHECK( simulate<kitty::dynamic_truth_table>( luts_cancelled, sim ) == simulate<kitty::dynamic_truth_table>( aig, sim ) );
+}
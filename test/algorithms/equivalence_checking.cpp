@@ -72,3 +72,54 @@ TEST_CASE( "Equivalence check on two non-equivalent AIGs", "[equivalence_checkin
   CHECK( !*result );
   CHECK( st.counter_example == std::vector<bool>( { true, true } ) );
 }
+
+TEST_CASE( "Equivalence check with compact CNF", "[equivalence_checking]" )
+{
+  xag_network xag1, xag2;
+
+  const auto a = xag1.create_pi();
+  const auto b = xag1.create_pi();
+  const auto c = xag1.create_pi();
+  xag1.create_po( xag1.create_maj( a, b, c ) );
+  xag1.create_po( xag1.create_xor3( a, b, c ) );
+
+  const auto a_ = xag2.create_pi();
+  const auto b_ = xag2.create_pi();
+  const auto c_ = xag2.create_pi();
+  xag2.create_po( xag2.create_or( xag2.create_and( a_, b_ ), xag2.create_and( c_, xag2.create_or( a_, b_ ) ) ) );
+  xag2.create_po( xag2.create_or( a_, xag2.create_xor( b_, c_ ) ) );
+
+  equivalence_checking_params ps;
+  ps.cnf_mapping = true;
+
+  for ( auto const functional_reduction : { true, false } )
+  {
+    ps.functional_reduction = functional_reduction;
+
+    equivalence_checking_stats st;
+    const auto result = equivalence_checking( *miter<xag_network>( xag1, xag2 ), ps, &st );
+    CHECK( result );
+    CHECK( !*result );
+    REQUIRE( st.counter_example.size() == 3u );
+    /* outputs differ only if a = 1 and b != c */
+    CHECK( st.counter_example[0] );
+    CHECK( st.counter_example[1] != st.counter_example[2] );
+  }
+
+  /* the majority outputs are equivalent */
+  xag_network xag3, xag4;
+
+  const auto x = xag3.create_pi();
+  const auto y = xag3.create_pi();
+  const auto z = xag3.create_pi();
+  xag3.create_po( xag3.create_maj( x, y, z ) );
+
+  const auto x_ = xag4.create_pi();
+  const auto y_ = xag4.create_pi();
+  const auto z_ = xag4.create_pi();
+  xag4.create_po( xag4.create_or( xag4.create_and( x_, y_ ), xag4.create_and( z_, xag4.create_or( x_, y_ ) ) ) );
+
+  const auto result = equivalence_checking( *miter<xag_network>( xag3, xag4 ), ps );
+  CHECK( result );
+  CHECK( *result );
+}
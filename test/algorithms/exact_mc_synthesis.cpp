@@ -51,3 +51,17 @@ TEST_CASE( "Find multiple ITE with exact MC synthesis", "[exact_mc_synthesis]" )
     CHECK( simulate<kitty::dynamic_truth_table>( xag, { 3u } )[0] == func );
   }
 }
+
+TEST_CASE( "Cancelled exact MC synthesis", "[exact_mc_synthesis]" )
+{
+  kitty::dynamic_truth_table func( 3u );
+  kitty::create_majority( func );
+
+  exact_mc_synthesis_params ps;
+  ps.cancellation.cancel();
+
+  /* no solution has been found, the network is derived from the algebraic normal form */
+  const auto xag = exact_mc_synthesis<xag_network>( func, ps );
+  CHECK( simulate<kitty::dynamic_truth_table>( xag, { 3u } )[0] == func );
+  CHECK( exact_mc_synthesis_multiple<xag_network>( func, 2u, ps ).empty() );
+}
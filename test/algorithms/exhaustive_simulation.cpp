@@ -0,0 +1,172 @@
+#include <catch.hpp>
+
+#include <mutex>
+#include <vector>
+
+#include <mockturtle/algorithms/exhaustive_simulation.hpp>
+#include <mockturtle/algorithms/miter.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xmg.hpp>
+
+#include <kitty/dynamic_truth_table.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+template<class Ntk>
+Ntk adder( uint32_t bitwidth, bool lookahead, bool faulty = false )
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> a( bitwidth ), b( bitwidth );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+  auto carry = ntk.get_constant( false );
+  if ( lookahead )
+  {
+    carry_lookahead_adder_inplace( ntk, a, b, carry );
+  }
+  else
+  {
+    carry_ripple_adder_inplace( ntk, a, b, carry );
+  }
+  if ( faulty )
+  {
+    /* change the carry-out if all but the lowest 6 inputs are 1 */
+    std::vector<typename Ntk::signal> pis;
+    ntk.foreach_pi( [&]( auto const& n, auto i ) {
+      if ( i >= 6u )
+      {
+        pis.emplace_back( ntk.make_signal( n ) );
+      }
+    } );
+    carry = ntk.create_xor( carry, ntk.create_nary_and( pis ) );
+  }
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { ntk.create_po( f ); } );
+  ntk.create_po( carry );
+  return ntk;
+}
+
+/* assembles the output truth tables from the simulated blocks */
+template<class Ntk>
+std::vector<kitty::dynamic_truth_table> simulate_in_blocks( Ntk const& ntk, exhaustive_simulation_params const& ps )
+{
+  std::vector<kitty::dynamic_truth_table> tts( ntk.num_pos(), kitty::dynamic_truth_table( ntk.num_pis() ) );
+  std::mutex mutex;
+  auto const complete = exhaustive_simulation(
+      ntk, [&]( uint64_t offset, std::vector<kitty::partial_truth_table> const& po_values ) {
+        std::lock_guard<std::mutex> lock( mutex );
+        for ( auto i = 0u; i < po_values.size(); ++i )
+        {
+          for ( auto j = 0u; j < po_values[i].num_bits(); ++j )
+          {
+            if ( kitty::get_bit( po_values[i], j ) )
+            {
+              kitty::set_bit( tts[i], offset + j );
+            }
+          }
+        }
+        return true;
+      },
+      ps );
+  CHECK( complete );
+  return tts;
+}
+
+} // namespace
+
+TEST_CASE( "Exhaustive simulation matches truth table simulation", "[exhaustive_simulation]" )
+{
+  auto const aig = adder<aig_network>( 6u, false );
+  auto const mig = adder<mig_network>( 4u, true );
+  auto const xmg = adder<xmg_network>( 2u, false );
+
+  for ( auto const block_words : { 1u, 4u, 64u } )
+  {
+    for ( auto const threads : { 1u, 3u } )
+    {
+      exhaustive_simulation_params ps;
+      ps.block_words = block_words;
+      ps.num_threads = threads;
+
+      CHECK( simulate_in_blocks( aig, ps ) == simulate<kitty::dynamic_truth_table>( aig, default_simulator<kitty::dynamic_truth_table>( aig.num_pis() ) ) );
+      CHECK( simulate_in_blocks( mig, ps ) == simulate<kitty::dynamic_truth_table>( mig, default_simulator<kitty::dynamic_truth_table>( mig.num_pis() ) ) );
+      CHECK( simulate_in_blocks( xmg, ps ) == simulate<kitty::dynamic_truth_table>( xmg, default_simulator<kitty::dynamic_truth_table>( xmg.num_pis() ) ) );
+    }
+  }
+}
+
+TEST_CASE( "Exhaustive simulation of k-LUT network", "[exhaustive_simulation]" )
+{
+  klut_network klut;
+  std::vector<klut_network::signal> pis( 8u );
+  std::generate( pis.begin(), pis.end(), [&]() { return klut.create_pi(); } );
+  auto const f1 = klut.create_maj( pis[0], pis[1], pis[2] );
+  auto const f2 = klut.create_xor( f1, pis[3] );
+  auto const f3 = klut.create_ite( pis[4], f2, pis[5] );
+  auto const f4 = klut.create_and( f3, klut.create_not( pis[6] ) );
+  klut.create_po( f4 );
+  klut.create_po( klut.create_or( f2, pis[7] ) );
+  klut.create_po( klut.get_constant( true ) );
+
+  exhaustive_simulation_params ps;
+  ps.block_words = 2u;
+  CHECK( simulate_in_blocks( klut, ps ) == simulate<kitty::dynamic_truth_table>( klut, default_simulator<kitty::dynamic_truth_table>( klut.num_pis() ) ) );
+}
+
+TEST_CASE( "Exhaustive equivalence checking of adder miters", "[exhaustive_simulation]" )
+{
+  auto const aig1 = adder<aig_network>( 10u, false );
+  auto const aig2 = adder<aig_network>( 10u, true );
+  auto const miter_ntk = *miter<aig_network>( aig1, aig2 );
+
+  for ( auto const threads : { 1u, 4u } )
+  {
+    exhaustive_simulation_params ps;
+    ps.num_threads = threads;
+    exhaustive_simulation_stats st;
+    auto const result = exhaustive_equivalence_checking( miter_ntk, ps, &st );
+    CHECK( result );
+    CHECK( *result );
+    CHECK( st.num_blocks == 256u );
+    CHECK( st.counter_example.empty() );
+  }
+
+  exhaustive_simulation_params ps;
+  ps.max_pis = 16u;
+  CHECK( !exhaustive_equivalence_checking( miter_ntk, ps ) );
+}
+
+TEST_CASE( "Exhaustive equivalence checking finds first counter-example", "[exhaustive_simulation]" )
+{
+  auto const aig1 = adder<aig_network>( 9u, false );
+  auto const aig2 = adder<aig_network>( 9u, true, true );
+  auto const miter_ntk = *miter<aig_network>( aig1, aig2 );
+
+  for ( auto const threads : { 1u, 3u } )
+  {
+    exhaustive_simulation_params ps;
+    ps.block_words = 2u;
+    ps.num_threads = threads;
+    exhaustive_simulation_stats st;
+    auto const result = exhaustive_equivalence_checking( miter_ntk, ps, &st );
+    CHECK( result );
+    CHECK( !*result );
+
+    /* the first 6 inputs are 0 in the smallest counter-example */
+    std::vector<bool> expected( 18u, true );
+    std::fill( expected.begin(), expected.begin() + 6u, false );
+    CHECK( st.counter_example == expected );
+    CHECK( simulate<bool>( aig1, default_simulator<bool>( st.counter_example ) ) != simulate<bool>( aig2, default_simulator<bool>( st.counter_example ) ) );
+    if ( threads == 1u )
+    {
+      /* the counter-example is in the last block */
+      CHECK( st.num_blocks == 2048u );
+    }
+  }
+}
@@ -0,0 +1,127 @@
+#include <catch.hpp>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <mockturtle/algorithms/explorer.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/random_network.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+aig_network explore_aig( aig_network const& aig, explorer_params const& ps )
+{
+  using Ntk = aig_network;
+
+  explorer_stats st;
+  explorer<Ntk> expl( ps, st );
+
+  expl.add_decompressing_script( []( Ntk& _ntk, uint32_t i, uint32_t rand ) {
+    (void)i;
+    lut_map_params mps;
+    mps.cut_enumeration_ps.cut_size = 3 + ( rand & 0x3 );
+    klut_network klut = lut_map( _ntk, mps );
+    sop_factoring<Ntk> resyn;
+    _ntk = node_resynthesis<Ntk>( klut, resyn );
+  } );
+
+  expl.add_compressing_script( []( Ntk& _ntk, uint32_t i, uint32_t rand ) {
+    (void)i;
+    resubstitution_params rps;
+    rps.max_inserts = rand & 0x3;
+    aig_resubstitution( _ntk, rps );
+    _ntk = cleanup_dangling( _ntk );
+  } );
+
+  expl.add_compressing_script( []( Ntk& _ntk, uint32_t i, uint32_t rand ) {
+    (void)i;
+    (void)rand;
+    aig_balancing_params bps;
+    aig_balance( _ntk, bps );
+  } );
+
+  return expl.run( aig );
+}
+
+} // namespace
+
+TEST_CASE( "Parallel restarts of the explorer", "[explorer]" )
+{
+  random_network_generator_params_size gps;
+  gps.num_pis = 8u;
+  gps.num_gates = 200u;
+  auto gen = random_aig_generator( gps );
+  auto const aig = gen.generate();
+
+  default_simulator<kitty::dynamic_truth_table> sim( gps.num_pis );
+  auto const tts = simulate<kitty::dynamic_truth_table>( aig, sim );
+
+  explorer_params ps;
+  ps.num_restarts = 4u;
+  ps.max_steps = 3u;
+  ps.random_seed = 7u;
+
+  ps.num_threads = 1u;
+  auto const opt1 = explore_aig( aig, ps );
+  ps.num_threads = 4u;
+  auto const opt4 = explore_aig( aig, ps );
+
+  /* the result does not depend on the number of threads */
+  CHECK( opt1.num_gates() <= aig.num_gates() );
+  CHECK( opt1.num_gates() == opt4.num_gates() );
+  CHECK( simulate<kitty::dynamic_truth_table>( opt1, sim ) == tts );
+  CHECK( simulate<kitty::dynamic_truth_table>( opt4, sim ) == tts );
+}
+
+TEST_CASE( "Explorer restarts adopting the best network", "[explorer]" )
+{
+  random_network_generator_params_size gps;
+  gps.num_pis = 8u;
+  gps.num_gates = 200u;
+  auto gen = random_aig_generator( gps );
+  auto const aig = gen.generate();
+
+  default_simulator<kitty::dynamic_truth_table> sim( gps.num_pis );
+  auto const tts = simulate<kitty::dynamic_truth_table>( aig, sim );
+
+  explorer_params ps;
+  ps.num_restarts = 3u;
+  ps.max_steps = 4u;
+  ps.sync_interval = 2u;
+
+  ps.num_threads = 1u;
+  auto const opt1 = explore_aig( aig, ps );
+  ps.num_threads = 3u;
+  auto const opt3 = explore_aig( aig, ps );
+
+  CHECK( opt1.num_gates() <= aig.num_gates() );
+  CHECK( opt1.num_gates() == opt3.num_gates() );
+  CHECK( simulate<kitty::dynamic_truth_table>( opt3, sim ) == tts );
+}
+
+TEST_CASE( "Cancelled explorer returns the best network so far", "[explorer]" )
+{
+  random_network_generator_params_size gps;
+  gps.num_pis = 8u;
+  gps.num_gates = 200u;
+  auto gen = random_aig_generator( gps );
+  auto const aig = gen.generate();
+
+  default_simulator<kitty::dynamic_truth_table> sim( gps.num_pis );
+  auto const tts = simulate<kitty::dynamic_truth_table>( aig, sim );
+
+  explorer_params ps;
+  ps.num_restarts = 2u;
+  ps.max_steps = 3u;
+  ps.cancellation.cancel();
+
+  for ( auto const sync_interval : { 0u, 1u } )
+  {
+    ps.sync_interval = sync_interval;
+    auto const opt = explore_aig( aig, ps );
+    CHECK( opt.num_gates() == aig.num_gates() );
+    CHECK( simulate<kitty::dynamic_truth_table>( opt, sim ) == tts );
+  }
+}
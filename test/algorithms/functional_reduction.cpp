@@ -2,9 +2,11 @@
 
 #include <kitty/static_truth_table.hpp>
 
+#include <mockturtle/algorithms/cec.hpp>
 #include <mockturtle/algorithms/cleanup.hpp>
 #include <mockturtle/algorithms/functional_reduction.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/mig.hpp>
 #include <mockturtle/networks/xag.hpp>
@@ -129,3 +131,125 @@ TEST_CASE( "functional reduction on XMG", "[functional_reduction]" )
   CHECK( ntk.size() == 9 );
   CHECK( vals == simulate<kitty::static_truth_table<4>>( ntk ) );
 }
+
+TEST_CASE( "parallel functional reduction on AIG", "[functional_reduction]" )
+{
+  aig_network ntk;
+
+  const auto a = ntk.create_pi();
+  const auto b = ntk.create_pi();
+
+  const auto f1 = ntk.create_and( a, !b );
+  const auto f2 = ntk.create_and( !a, b );
+  const auto f3 = ntk.create_and( !a, !b );
+  const auto f4 = ntk.create_and( a, b );
+  const auto f5 = ntk.create_or( f1, f2 );  // a ^ b
+  const auto f6 = ntk.create_or( f3, f4 );  // a == b
+  const auto f7 = ntk.create_and( f5, f6 ); // 0
+
+  ntk.create_po( f5 );
+  ntk.create_po( f6 );
+  ntk.create_po( f7 );
+
+  auto vals = simulate<kitty::static_truth_table<2>>( ntk );
+
+  functional_reduction_params ps;
+  ps.num_threads = 2u;
+  functional_reduction( ntk, ps );
+  ntk = cleanup_dangling( ntk );
+  CHECK( ntk.size() == 6 );
+  CHECK( vals == simulate<kitty::static_truth_table<2>>( ntk ) );
+}
+
+TEST_CASE( "parallel functional reduction merges two adders", "[functional_reduction]" )
+{
+  aig_network ntk;
+  std::vector<aig_network::signal> a( 16u ), b( 16u );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+
+  auto sum1 = a;
+  auto carry1 = ntk.get_constant( false );
+  carry_ripple_adder_inplace( ntk, sum1, b, carry1 );
+  auto sum2 = a;
+  auto carry2 = ntk.get_constant( false );
+  carry_lookahead_adder_inplace( ntk, sum2, b, carry2 );
+
+  std::for_each( sum1.begin(), sum1.end(), [&]( auto const& f ) { ntk.create_po( f ); } );
+  std::for_each( sum2.begin(), sum2.end(), [&]( auto const& f ) { ntk.create_po( f ); } );
+  ntk.create_po( carry1 );
+  ntk.create_po( carry2 );
+
+  auto const orig = ntk.clone();
+
+  for ( auto const threads : { 1u, 4u } )
+  {
+    auto opt = orig.clone();
+    functional_reduction_params ps;
+    ps.num_threads = threads;
+    functional_reduction_stats st;
+    functional_reduction( opt, ps, &st );
+    opt = cleanup_dangling( opt );
+
+    CHECK( st.num_equ_accepts > 0u );
+    CHECK( opt.num_gates() < orig.num_gates() );
+    CHECK( opt.po_at( 32u ) == opt.po_at( 33u ) );
+
+    auto const result = cec( orig, opt );
+    CHECK( result );
+    CHECK( *result );
+  }
+}
+
+TEST_CASE( "cancelled functional reduction keeps the merges done so far", "[functional_reduction]" )
+{
+  aig_network ntk;
+  std::vector<aig_network::signal> a( 8u ), b( 8u );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+
+  auto sum1 = a;
+  auto carry1 = ntk.get_constant( false );
+  carry_ripple_adder_inplace( ntk, sum1, b, carry1 );
+  auto sum2 = a;
+  auto carry2 = ntk.get_constant( false );
+  carry_lookahead_adder_inplace( ntk, sum2, b, carry2 );
+
+  std::for_each( sum1.begin(), sum1.end(), [&]( auto const& f ) { ntk.create_po( f ); } );
+  std::for_each( sum2.begin(), sum2.end(), [&]( auto const& f ) { ntk.create_po( f ); } );
+
+  auto const orig = ntk.clone();
+
+  functional_reduction_stats st_full;
+  auto full = orig.clone();
+  functional_reduction( full, {}, &st_full );
+
+  /* cancelled before the start */
+  for ( auto const threads : { 1u, 4u } )
+  {
+    functional_reduction_params ps;
+    ps.num_threads = threads;
+    ps.cancellation.cancel();
+    functional_reduction_stats st;
+    auto opt = orig.clone();
+    functional_reduction( opt, ps, &st );
+    CHECK( st.num_reduction == 0u );
+    CHECK( opt.num_gates() == orig.num_gates() );
+  }
+
+  /* cancelled after the first merge */
+  functional_reduction_params ps;
+  functional_reduction_stats st;
+  auto opt = orig.clone();
+  auto const token = ps.cancellation;
+  opt.events().register_modified_event( [token]( auto const&, auto const& ) { token.cancel(); } );
+  functional_reduction( opt, ps, &st );
+  opt = cleanup_dangling( opt );
+
+  CHECK( st.num_reduction > 0u );
+  CHECK( st.num_reduction < st_full.num_reduction );
+
+  auto const result = cec( orig, opt );
+  CHECK( result );
+  CHECK( *result );
+}
@@ -0,0 +1,118 @@
+#include <catch.hpp>
+
+#include <memory>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/collapse_mapped.hpp>
+#include <mockturtle/algorithms/equivalence_checking.hpp>
+#include <mockturtle/algorithms/lut_mapping.hpp>
+#include <mockturtle/algorithms/miter.hpp>
+#include <mockturtle/algorithms/node_resynthesis.hpp>
+#include <mockturtle/algorithms/node_resynthesis/memoized.hpp>
+#include <mockturtle/algorithms/node_resynthesis/mig_npn.hpp>
+#include <mockturtle/algorithms/node_resynthesis/sop_factoring.hpp>
+#include <mockturtle/algorithms/refactoring.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/views/mapping_view.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "Memoized resynthesis of MAJ", "[memoized]" )
+{
+  kitty::dynamic_truth_table maj( 3u );
+  kitty::create_majority( maj );
+
+  aig_network aig;
+  std::vector<aig_network::signal> pis = { aig.create_pi(), aig.create_pi(), aig.create_pi() };
+
+  sop_factoring<aig_network> sop;
+  memoized_resynthesis<aig_network, sop_factoring<aig_network>> resyn( sop );
+
+  for ( auto i = 0u; i < 2u; ++i )
+  {
+    resyn( aig, maj, pis.begin(), pis.end(), [&]( auto const& f ) {
+      aig.create_po( f );
+      return true;
+    } );
+  }
+
+  CHECK( aig.num_pos() == 2u );
+  CHECK( aig.po_at( 0u ) == aig.po_at( 1u ) );
+  CHECK( resyn.cache()->size() == 1u );
+  CHECK( resyn.cache()->stats().hits == 1u );
+
+  default_simulator<kitty::dynamic_truth_table> sim( 3u );
+  CHECK( simulate<kitty::dynamic_truth_table>( aig, sim )[0] == maj );
+}
+
+TEST_CASE( "Refactoring with memoized SOP factoring", "[memoized]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 6u ), b( 6u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, a, b ) )
+  {
+    aig.create_po( f );
+  }
+
+  auto direct = aig.clone();
+  sop_factoring<aig_network> sop;
+  refactoring( direct, sop );
+  direct = cleanup_dangling( direct );
+
+  auto memoized = aig.clone();
+  memoized_resynthesis<aig_network, sop_factoring<aig_network>> resyn( sop );
+  refactoring( memoized, resyn );
+  memoized = cleanup_dangling( memoized );
+
+  CHECK( memoized.num_gates() == direct.num_gates() );
+  CHECK( resyn.cache()->stats().hits > 0u );
+  CHECK( *equivalence_checking( *miter<aig_network>( aig, memoized ) ) );
+
+  /* a second resynthesis function shares the cache and does not miss */
+  auto const misses = resyn.cache()->stats().misses;
+  auto again = aig.clone();
+  memoized_resynthesis<aig_network, sop_factoring<aig_network>> resyn2( sop, resyn.cache() );
+  refactoring( again, resyn2 );
+  again = cleanup_dangling( again );
+
+  CHECK( again.num_gates() == direct.num_gates() );
+  CHECK( resyn.cache()->stats().misses == misses );
+}
+
+TEST_CASE( "Node resynthesis with memoized MIG NPN database", "[memoized]" )
+{
+  mig_network mig;
+  std::vector<mig_network::signal> a( 4u ), b( 4u );
+  std::generate( a.begin(), a.end(), [&]() { return mig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return mig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( mig, a, b ) )
+  {
+    mig.create_po( f );
+  }
+
+  mapping_view<mig_network, true> mapped{ mig };
+  lut_mapping_params ps;
+  ps.cut_enumeration_ps.cut_size = 4u;
+  lut_mapping<mapping_view<mig_network, true>, true>( mapped, ps );
+  auto const klut = *collapse_mapped_network<klut_network>( mapped );
+
+  mig_npn_resynthesis npn;
+  auto const direct = node_resynthesis<mig_network>( klut, npn );
+
+  memoized_resynthesis<mig_network, mig_npn_resynthesis> resyn( npn );
+  auto const memoized = node_resynthesis<mig_network>( klut, resyn );
+
+  CHECK( memoized.num_gates() == direct.num_gates() );
+  CHECK( resyn.cache()->size() > 0u );
+  CHECK( *equivalence_checking( *miter<mig_network>( mig, memoized ) ) );
+}
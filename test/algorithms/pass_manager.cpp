@@ -0,0 +1,144 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/partial_truth_table.hpp>
+#include <mockturtle/algorithms/aig_balancing.hpp>
+#include <mockturtle/algorithms/aig_resub.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/node_resynthesis/sop_factoring.hpp>
+#include <mockturtle/algorithms/pass_manager.hpp>
+#include <mockturtle/algorithms/refactoring.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/random_network.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+aig_network random_aig()
+{
+  random_network_generator_params_size gps;
+  gps.num_pis = 8u;
+  gps.num_gates = 300u;
+  auto gen = random_aig_generator( gps );
+  return gen.generate();
+}
+
+template<class Ntk, class View>
+bool has_valid_view( Ntk const& ntk, View const& view )
+{
+  depth_view<Ntk> d_ntk{ ntk };
+  fanout_view<Ntk> f_ntk{ ntk };
+
+  bool valid = d_ntk.depth() == view.depth();
+  ntk.foreach_gate( [&]( auto const& n ) {
+    std::vector<typename Ntk::node> fanout, expected;
+    view.foreach_fanout( n, [&]( auto const& fo ) { fanout.emplace_back( fo ); } );
+    f_ntk.foreach_fanout( n, [&]( auto const& fo ) { expected.emplace_back( fo ); } );
+    std::sort( fanout.begin(), fanout.end() );
+    std::sort( expected.begin(), expected.end() );
+    valid &= d_ntk.level( n ) == view.level( n ) && fanout == expected;
+  } );
+  return valid;
+}
+
+} // namespace
+
+TEST_CASE( "Pass manager with AIG optimization passes", "[pass_manager]" )
+{
+  auto const aig = random_aig();
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  auto const tts = simulate<kitty::dynamic_truth_table>( aig, sim );
+
+  pass_manager_stats st;
+  pass_manager<aig_network> pm( aig, {}, &st );
+
+  resubstitution_params rps;
+  pm.run( "b", []( auto& pm ) { aig_balance( pm.view() ); } );
+  CHECK( has_valid_view( pm.network(), pm.view() ) );
+
+  pm.run( "rs", [&]( auto& pm ) { aig_resubstitution( pm.view(), rps ); } );
+  CHECK( has_valid_view( pm.network(), pm.view() ) );
+
+  pm.run( "rf", []( auto& pm ) {
+    sop_factoring<aig_network> resyn;
+    refactoring( pm.view(), resyn );
+    pm.replace( cleanup_dangling( pm.network() ) );
+  } );
+  CHECK( pm.valid_analyses() == analysis_none );
+  CHECK( has_valid_view( pm.network(), pm.view() ) );
+
+  rps.max_inserts = 1u;
+  pm.run( "rs", [&]( auto& pm ) { aig_resubstitution( pm.view(), rps ); } );
+
+  CHECK( st.passes.size() == 4u );
+  CHECK( st.passes[0].gates_before == aig.num_gates() );
+  CHECK( st.passes[3].gates_after == pm.network().num_gates() );
+  CHECK( pm.network().num_gates() <= aig.num_gates() );
+  CHECK( st.passes[3].memory > 0u );
+  CHECK( simulate<kitty::dynamic_truth_table>( cleanup_dangling( pm.network() ), sim ) == tts );
+}
+
+TEST_CASE( "Analyses of the pass manager", "[pass_manager]" )
+{
+  auto const aig = random_aig();
+
+  pass_manager_params ps;
+  ps.num_signature_bits = 128u;
+  ps.cut_enumeration_ps.cut_size = 4u;
+  pass_manager<aig_network> pm( aig, ps );
+
+  /* analyses are only built when requested */
+  CHECK( pm.valid_analyses() == analysis_none );
+  auto const num_nodes = pm.topological_order().size();
+  CHECK( num_nodes == aig.size() );
+  CHECK( pm.cuts().total_cuts() > 0u );
+  CHECK( pm.valid_analyses() == ( analysis_topological_order | analysis_cuts ) );
+
+  /* the topological order is kept by passes that preserve it */
+  pm.run( "nop", []( auto& ) {}, analysis_all );
+  CHECK( ( pm.valid_analyses() & analysis_topological_order ) );
+
+  /* signatures match a complete simulation, also for nodes added later */
+  auto& ntk = pm.network();
+  partial_simulator sim( aig.num_pis(), ps.num_signature_bits, ps.signature_seed );
+  auto const f = ntk.make_signal( ntk.index_to_node( ntk.size() - 1u ) );
+  CHECK( pm.signature( ntk.get_node( f ) ).num_bits() == 128u );
+
+  pm.run( "add", [&]( auto& pm ) {
+    auto& ntk = pm.network();
+    ntk.create_po( ntk.create_and( ntk.make_signal( ntk.pi_at( 0u ) ), f ) );
+  }, analysis_signatures );
+  CHECK( !( pm.valid_analyses() & analysis_topological_order ) );
+  CHECK( pm.topological_order().size() == num_nodes + 1u );
+
+  auto const sigs = simulate_nodes<kitty::partial_truth_table>( ntk, sim );
+  bool equal = true;
+  ntk.foreach_node( [&]( auto const& n ) {
+    equal &= pm.signature( n ) == sigs[n];
+  } );
+  CHECK( equal );
+
+  /* a replaced network with more inputs gets a new simulator */
+  aig_network other;
+  auto const a = other.create_pi(), b = other.create_pi();
+  std::vector<aig_network::signal> pis{ a, b };
+  for ( auto i = 0u; i < aig.num_pis(); ++i )
+  {
+    pis.emplace_back( other.create_pi() );
+  }
+  auto const g = other.create_xor( other.create_and( a, pis.back() ), b );
+  other.create_po( g );
+  pm.replace( other );
+
+  partial_simulator other_sim( other.num_pis(), ps.num_signature_bits, ps.signature_seed );
+  auto const other_sigs = simulate_nodes<kitty::partial_truth_table>( other, other_sim );
+  CHECK( pm.signature( other.get_node( g ) ) == other_sigs[other.get_node( g )] );
+}
@@ -3,6 +3,7 @@
 #include <mockturtle/algorithms/cleanup.hpp>
 #include <mockturtle/algorithms/pattern_generation.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/xag.hpp>
 
@@ -117,3 +118,51 @@ TEST_CASE( "With observability awareness", "[pattern_generation]" )
   /* the generated pattern should be either 000, 010, or 101 */
   CHECK( ( ( !kitty::get_bit( sim.compute_pi( 0 ), 3 ) && !kitty::get_bit( sim.compute_pi( 2 ), 3 ) ) || ( kitty::get_bit( sim.compute_pi( 0 ), 3 ) && !kitty::get_bit( sim.compute_pi( 1 ), 3 ) && kitty::get_bit( sim.compute_pi( 2 ), 3 ) ) ) == true );
 }
+
+TEST_CASE( "Multi-threaded stuck-at pattern generation", "[pattern_generation]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 12u ), b( 12u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  auto carry = aig.get_constant( false );
+  carry_ripple_adder_inplace( aig, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { aig.create_po( f ); } );
+  aig.create_po( carry );
+
+  /* constant nodes that are not structurally recognized */
+  aig.create_po( aig.create_and( aig.create_and( a[0], b[0] ), aig.create_and( !a[0], b[1] ) ) );
+  aig.create_po( aig.create_and( aig.create_and( a[2], b[2] ), !b[2] ) );
+
+  for ( auto const num_stuck_at : { 1u, 2u } )
+  {
+    pattern_generation_stats st1, st2;
+    pattern_generation_params ps;
+    ps.num_stuck_at = num_stuck_at;
+
+    partial_simulator sim1( aig.num_pis(), 0 );
+    pattern_generation( aig, sim1, ps, &st1 );
+
+    ps.num_threads = 3u;
+    ps.batch_size = 4u;
+    partial_simulator sim2( aig.num_pis(), 0 );
+    pattern_generation( aig, sim2, ps, &st2 );
+
+    CHECK( st2.num_constant == st1.num_constant );
+    CHECK( st2.num_constant == 2u );
+
+    /* every non-constant node takes both values at least `num_stuck_at` times */
+    auto const tts = simulate_nodes<kitty::partial_truth_table>( aig, sim2 );
+    uint32_t num_constant = 0u;
+    aig.foreach_gate( [&]( auto const& n ) {
+      if ( kitty::is_const0( tts[n] ) || kitty::is_const0( ~tts[n] ) )
+      {
+        ++num_constant;
+        return;
+      }
+      CHECK( kitty::count_ones( tts[n] ) >= num_stuck_at );
+      CHECK( kitty::count_zeros( tts[n] ) >= num_stuck_at );
+    } );
+    CHECK( num_constant >= 2u );
+  }
+}
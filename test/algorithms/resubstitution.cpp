@@ -1,8 +1,10 @@
 #include <catch.hpp>
 
+#include <mockturtle/algorithms/cec.hpp>
 #include <mockturtle/algorithms/cleanup.hpp>
 #include <mockturtle/algorithms/resubstitution.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/io/write_verilog.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/mig.hpp>
@@ -22,6 +24,27 @@
 
 using namespace mockturtle;
 
+namespace
+{
+
+/* multiplier whose outputs f are computed redundantly as f * ( f + x ) */
+aig_network redundant_multiplier( uint32_t num_bits )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( num_bits ), b( num_bits );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  auto const outputs = carry_ripple_multiplier( aig, a, b );
+  for ( auto i = 0u; i < outputs.size(); ++i )
+  {
+    auto const& f = outputs[i];
+    aig.create_po( aig.create_and( f, aig.create_or( f, a[i % a.size()] ) ) );
+  }
+  return aig;
+}
+
+} // namespace
+
 TEST_CASE( "Resubstitution of AIGs", "[resubstitution]" )
 {
   /* The test cases are (a,b)-pairs, where a is an index_list and b is
@@ -548,3 +571,74 @@ TEST_CASE( "Simulation-guided resubstitution", "[resubstitution]" )
   CHECK( aig.num_pos() == 1 );
   CHECK( aig.num_gates() == 1 );
 }
+
+TEST_CASE( "Resubstitution with speculative window preparation", "[resubstitution]" )
+{
+  auto const aig = redundant_multiplier( 6u );
+
+  std::vector<uint32_t> sizes;
+  for ( auto const threads : { 1u, 2u, 4u } )
+  {
+    aig_network res = aig.clone();
+    fanout_view<aig_network> fanout_res{ res };
+    depth_view<fanout_view<aig_network>> resub_view{ fanout_res };
+
+    resubstitution_params ps;
+    ps.max_inserts = 2u;
+    ps.num_threads = threads;
+    ps.num_speculative_roots = 16u;
+    resubstitution_stats st;
+    aig_resubstitution( resub_view, ps, &st );
+    res = cleanup_dangling( res );
+    CHECK( ( threads == 1u || st.num_prepared > 0u ) );
+
+    auto const result = cec( aig, res );
+    REQUIRE( result );
+    CHECK( *result );
+    sizes.emplace_back( res.num_gates() );
+  }
+
+  /* the result does not depend on the number of threads */
+  CHECK( sizes[0] < aig.num_gates() );
+  CHECK( sizes[1] == sizes[0] );
+  CHECK( sizes[2] == sizes[0] );
+
+  aig_network res = aig.clone();
+  resubstitution_params ps;
+  ps.num_threads = 2u;
+  sim_resubstitution( res, ps );
+  auto const result = cec( aig, res );
+  REQUIRE( result );
+  CHECK( *result );
+}
+
+TEST_CASE( "Cancelled resubstitution keeps the substitutions done so far", "[resubstitution]" )
+{
+  auto const aig = redundant_multiplier( 4u );
+
+  auto full = aig.clone();
+  aig_resubstitution( full );
+  full = cleanup_dangling( full );
+
+  /* cancelled before the start */
+  resubstitution_params ps;
+  ps.cancellation.cancel();
+  auto none = aig.clone();
+  aig_resubstitution( none, ps );
+  sim_resubstitution( none, ps );
+  CHECK( none.num_gates() == aig.num_gates() );
+
+  /* cancelled after the first substitution */
+  ps.cancellation.reset();
+  auto partial = aig.clone();
+  auto const token = ps.cancellation;
+  partial.events().register_modified_event( [token]( auto const&, auto const& ) { token.cancel(); } );
+  aig_resubstitution( partial, ps );
+  partial = cleanup_dangling( partial );
+
+  CHECK( partial.num_gates() < aig.num_gates() );
+  CHECK( partial.num_gates() > full.num_gates() );
+  auto const result = cec( aig, partial );
+  REQUIRE( result );
+  CHECK( *result );
+}
@@ -1,5 +1,8 @@
 #include <catch.hpp>
 
+#include <numeric>
+#include <random>
+
 #include <kitty/kitty.hpp>
 
 #include <mockturtle/algorithms/resyn_engines/xag_resyn.hpp>
@@ -234,3 +237,39 @@ TEST_CASE( "Synthesize XAGs for all 4-input functions", "[xag_resyn]" )
   CHECK( success_counter == 54622 );
   CHECK( failed_counter == 10914 );
 }
+
+TEST_CASE( "XAG resynthesis with multi-word truth tables", "[xag_resyn]" )
+{
+  /* 700 bits span 11 words, such that the scans use both full blocks and a tail */
+  std::mt19937_64 rng( 5 );
+  std::vector<kitty::partial_truth_table> tts( 40, kitty::partial_truth_table( 700 ) );
+  for ( auto& tt : tts )
+  {
+    kitty::create_random( tt, rng() );
+  }
+  std::vector<uint32_t> divs( tts.size() );
+  std::iota( divs.begin(), divs.end(), 0u );
+  partial_simulator sim( tts );
+
+  xag_resyn_stats st;
+  xag_resyn_decompose<kitty::partial_truth_table> engine( st );
+  for ( auto i = 0u; i < 100u; ++i )
+  {
+    auto const& a = tts[rng() % tts.size()];
+    auto const& b = tts[rng() % tts.size()];
+    auto const& c = tts[rng() % tts.size()];
+    auto const& d = tts[rng() % tts.size()];
+    kitty::partial_truth_table target = ( i % 4u == 0u ) ? ( a & ~b ) : ( i % 4u == 1u ) ? ( a ^ b ) : ( i % 4u == 2u ) ? ( ( a | b ) & ~c ) : ( ( a & b ) | ( c ^ d ) );
+    auto const care = ~target.construct();
+
+    auto const res = engine( target, care, divs.begin(), divs.end(), tts, 3u );
+    CHECK( ( res || i % 4u == 3u ) );
+    if ( res )
+    {
+      CHECK( ( *res ).num_gates() <= 3u );
+      xag_network xag;
+      decode( xag, *res );
+      CHECK( simulate<kitty::partial_truth_table, xag_network, partial_simulator>( xag, sim )[0] == target );
+    }
+  }
+}
@@ -1,9 +1,11 @@
 #include <catch.hpp>
 
+#include <mockturtle/algorithms/cec.hpp>
 #include <mockturtle/algorithms/rewrite.hpp>
 #include <mockturtle/algorithms/node_resynthesis/mig_npn.hpp>
 #include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
 #include <mockturtle/algorithms/node_resynthesis/xmg3_npn.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/xag.hpp>
 #include <mockturtle/networks/mig.hpp>
@@ -216,3 +218,40 @@ TEST_CASE( "Rewrite depth-preserving", "[rewrite]" )
   CHECK( aig.num_pos() == 2 );
   CHECK( aig.num_gates() == 8 );
 }
+
+TEST_CASE( "Rewrite with parallel candidate evaluation", "[rewrite]" )
+{
+  xag_network xag;
+  std::vector<xag_network::signal> a( 6u ), b( 6u );
+  std::generate( a.begin(), a.end(), [&]() { return xag.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return xag.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( xag, a, b ) )
+  {
+    xag.create_po( f );
+  }
+
+  xag_npn_resynthesis<xag_network, xag_network, xag_npn_db_kind::xag_complete> resyn;
+  exact_library<xag_network> exact_lib( resyn );
+
+  std::vector<uint32_t> sizes;
+  for ( auto const threads : { 1u, 2u, 4u } )
+  {
+    auto opt = xag.clone();
+    rewrite_params ps;
+    ps.num_threads = threads;
+    ps.window_gates = 16u;
+    rewrite_stats st;
+    rewrite( opt, exact_lib, ps, &st );
+    CHECK( ( threads == 1u || st.rounds > 1u ) );
+
+    auto const result = cec( xag, opt );
+    REQUIRE( result );
+    CHECK( *result );
+    sizes.emplace_back( opt.num_gates() );
+  }
+
+  /* the result does not depend on the number of threads */
+  CHECK( sizes[0] < xag.num_gates() );
+  CHECK( sizes[1] == sizes[0] );
+  CHECK( sizes[2] == sizes[0] );
+}
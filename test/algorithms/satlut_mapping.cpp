@@ -33,3 +33,31 @@ TEST_CASE( "SAT-LUT mapping of AIG", "[satlut_mapping]" )
 
   satlut_mapping( mapped_aig );
 }
+
+TEST_CASE( "Cancelled SAT-LUT mapping of AIG", "[satlut_mapping]" )
+{
+  aig_network aig;
+
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto f1 = aig.create_nand( a, b );
+  const auto f2 = aig.create_nand( f1, a );
+  const auto f3 = aig.create_nand( f1, b );
+  const auto f4 = aig.create_nand( f2, f3 );
+  aig.create_po( f4 );
+
+  satlut_mapping_params ps;
+  ps.cut_enumeration_ps.cut_size = 2u;
+  ps.cancellation.cancel();
+
+  /* a network without mapping is still mapped */
+  mapping_view mapped_aig{ aig };
+  satlut_mapping( mapped_aig, ps );
+  CHECK( mapped_aig.has_mapping() );
+
+  /* an existing mapping is kept */
+  auto const num_cells = mapped_aig.num_cells();
+  satlut_mapping( mapped_aig, ps );
+  CHECK( mapped_aig.has_mapping() );
+  CHECK( mapped_aig.num_cells() == num_cells );
+}
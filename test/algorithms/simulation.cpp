@@ -2,9 +2,16 @@
 
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
 #include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
 
 #include <kitty/static_truth_table.hpp>
+#include <kitty/ternary_truth_table.hpp>
+
+#include <optional>
+#include <vector>
 
 using namespace mockturtle;
 
@@ -307,3 +314,120 @@ TEST_CASE( "Bit packing", "[simulation]" )
   CHECK( ( sim.compute_pi( 3 )._bits[0] & 0x0f ) == 0x0d ); /* x3 = xx1x101 -> x1101 */
   CHECK( ( sim.compute_pi( 4 )._bits[0] & 0x1f ) == 0x1d ); /* x4 = x1x1101 -> 11101 */
 }
+
+template<class Ntk>
+void test_ternary_full_adder()
+{
+  Ntk ntk;
+  auto const a = ntk.create_pi();
+  auto const b = ntk.create_pi();
+  auto const c = ntk.create_pi();
+  ntk.create_po( ntk.create_xor( ntk.create_xor( a, b ), c ) );
+  ntk.create_po( ntk.create_maj( a, b, c ) );
+
+  std::vector<std::vector<std::optional<bool>>> const patterns = {
+      { false, true, false },
+      { true, std::nullopt, false },
+      { true, true, std::nullopt },
+      { false, std::nullopt, false },
+      { std::nullopt, std::nullopt, std::nullopt } };
+
+  ternary_simulator sim( ntk.num_pis() );
+  for ( auto const& pattern : patterns )
+  {
+    sim.add_pattern( pattern );
+  }
+  CHECK( sim.num_bits() == patterns.size() );
+
+  auto const values = simulate<kitty::ternary_truth_table<kitty::partial_truth_table>>( ntk, sim );
+
+  /* sum */
+  CHECK( kitty::get_bit( values[0], 0 ) == 1 );
+  CHECK( kitty::is_dont_care( values[0], 1 ) );
+  CHECK( kitty::is_dont_care( values[0], 2 ) );
+  CHECK( kitty::is_dont_care( values[0], 3 ) );
+  CHECK( kitty::is_dont_care( values[0], 4 ) );
+
+  /* carry */
+  CHECK( kitty::get_bit( values[1], 0 ) == 0 );
+  CHECK( kitty::is_dont_care( values[1], 1 ) );
+  CHECK( !kitty::is_dont_care( values[1], 2 ) );
+  CHECK( kitty::get_bit( values[1], 2 ) == 1 );
+  CHECK( !kitty::is_dont_care( values[1], 3 ) );
+  CHECK( kitty::get_bit( values[1], 3 ) == 0 );
+  CHECK( kitty::is_dont_care( values[1], 4 ) );
+
+  /* known values agree with all completions of the partial assignments */
+  for ( auto i = 0u; i < patterns.size(); ++i )
+  {
+    for ( auto m = 0u; m < 8u; ++m )
+    {
+      std::vector<bool> assignment( 3u );
+      bool compatible = true;
+      for ( auto j = 0u; j < 3u; ++j )
+      {
+        assignment[j] = ( m >> j ) & 1;
+        compatible &= !patterns[i][j] || *patterns[i][j] == assignment[j];
+      }
+      if ( !compatible )
+      {
+        continue;
+      }
+
+      auto const outputs = simulate<bool>( ntk, default_simulator<bool>( assignment ) );
+      for ( auto o = 0u; o < outputs.size(); ++o )
+      {
+        if ( !kitty::is_dont_care( values[o], i ) )
+        {
+          CHECK( kitty::get_bit( values[o], i ) == outputs[o] );
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE( "Ternary simulation of full adders", "[simulation]" )
+{
+  test_ternary_full_adder<aig_network>();
+  test_ternary_full_adder<xag_network>();
+  test_ternary_full_adder<mig_network>();
+  test_ternary_full_adder<xmg_network>();
+  test_ternary_full_adder<klut_network>();
+}
+
+TEST_CASE( "Ternary simulation of k-LUT network is exact per gate", "[simulation]" )
+{
+  klut_network klut;
+  auto const s = klut.create_pi();
+  auto const a = klut.create_pi();
+  auto const b = klut.create_pi();
+  klut.create_po( klut.create_ite( s, a, b ) );
+
+  aig_network aig;
+  auto const s2 = aig.create_pi();
+  auto const a2 = aig.create_pi();
+  auto const b2 = aig.create_pi();
+  aig.create_po( aig.create_ite( s2, a2, b2 ) );
+
+  kitty::partial_truth_table values( 3u ), cares( 3u );
+  kitty::create_from_binary_string( cares, "110" );
+  std::vector<kitty::partial_truth_table> pi_values( 3u, values ), pi_cares( 3u, ~values );
+  pi_cares[0] = cares;
+  kitty::create_from_binary_string( pi_values[0], "100" ); /* s = X, 0, 1 */
+  pi_values[1] = ~values;                                   /* a = 1, 1, 1 */
+  kitty::create_from_binary_string( pi_values[2], "001" ); /* b = 1, 0, 0 */
+
+  ternary_simulator sim( pi_values, pi_cares );
+  auto const klut_values = simulate<kitty::ternary_truth_table<kitty::partial_truth_table>>( klut, sim );
+  auto const aig_values = simulate<kitty::ternary_truth_table<kitty::partial_truth_table>>( aig, sim );
+
+  /* ite( X, 1, 1 ) = 1 is only derived by the LUT */
+  CHECK( !kitty::is_dont_care( klut_values[0], 0 ) );
+  CHECK( kitty::get_bit( klut_values[0], 0 ) == 1 );
+  CHECK( kitty::is_dont_care( aig_values[0], 0 ) );
+
+  CHECK( kitty::get_bit( klut_values[0], 1 ) == 0 );
+  CHECK( kitty::get_bit( aig_values[0], 1 ) == 0 );
+  CHECK( kitty::get_bit( klut_values[0], 2 ) == 1 );
+  CHECK( kitty::get_bit( aig_values[0], 2 ) == 1 );
+}
@@ -0,0 +1,100 @@
+#include <catch.hpp>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/algorithms/window_rewriting.hpp>
+#include <mockturtle/generators/random_network.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/xag.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "Window rewriting of redundant AIG", "[window_rewriting]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const c = aig.create_pi();
+
+  /* a & ( a & b | a & c ) == a & ( b | c ) */
+  auto const f1 = aig.create_and( a, b );
+  auto const f2 = aig.create_and( a, c );
+  auto const f3 = aig.create_or( f1, f2 );
+  auto const f4 = aig.create_and( a, f3 );
+  aig.create_po( f4 );
+
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  auto const tts = simulate<kitty::dynamic_truth_table>( aig, sim );
+
+  window_rewriting_stats st;
+  window_rewriting( aig, {}, &st );
+  aig = cleanup_dangling( aig );
+
+  CHECK( aig.num_gates() == 2u );
+  CHECK( st.num_windows > 0u );
+  CHECK( simulate<kitty::dynamic_truth_table>( aig, sim ) == tts );
+}
+
+TEST_CASE( "Window rewriting with and without reusing windows", "[window_rewriting]" )
+{
+  random_network_generator_params_size gps;
+  gps.num_pis = 8u;
+  gps.num_gates = 300u;
+
+  auto gen = random_aig_generator( gps );
+  default_simulator<kitty::dynamic_truth_table> sim( gps.num_pis );
+
+  uint64_t num_reused_windows{ 0u };
+  for ( auto i = 0u; i < 10u; ++i )
+  {
+    auto const aig = gen.generate();
+    auto const tts = simulate<kitty::dynamic_truth_table>( aig, sim );
+
+    window_rewriting_params ps;
+    ps.reuse_windows = false;
+    window_rewriting_stats st;
+    auto aig1 = aig.clone();
+    window_rewriting( aig1, ps, &st );
+    aig1 = cleanup_dangling( aig1 );
+    CHECK( st.num_reused_windows == 0u );
+
+    ps.reuse_windows = true;
+    window_rewriting_stats st_reuse;
+    auto aig2 = aig.clone();
+    window_rewriting( aig2, ps, &st_reuse );
+    aig2 = cleanup_dangling( aig2 );
+    num_reused_windows += st_reuse.num_reused_windows;
+
+    /* skipping unchanged windows does not change the result */
+    CHECK( aig1.num_gates() == aig2.num_gates() );
+    CHECK( st.num_substitutions == st_reuse.num_substitutions );
+    CHECK( simulate<kitty::dynamic_truth_table>( aig1, sim ) == tts );
+    CHECK( simulate<kitty::dynamic_truth_table>( aig2, sim ) == tts );
+  }
+  CHECK( num_reused_windows > 0u );
+}
+
+TEST_CASE( "Window rewriting of XAG", "[window_rewriting]" )
+{
+  xag_network xag;
+  auto const a = xag.create_pi();
+  auto const b = xag.create_pi();
+  auto const c = xag.create_pi();
+  auto const d = xag.create_pi();
+
+  /* ( a ^ b ) & c and ( a ^ b ) & d, each with a separately built XOR */
+  auto const f1 = xag.create_and( xag.create_xor( a, b ), c );
+  auto const f2 = xag.create_and( xag.create_or( xag.create_and( a, !b ), xag.create_and( !a, b ) ), d );
+  xag.create_po( xag.create_or( f1, f2 ) );
+
+  default_simulator<kitty::dynamic_truth_table> sim( xag.num_pis() );
+  auto const tts = simulate<kitty::dynamic_truth_table>( xag, sim );
+  auto const size_before = xag.num_gates();
+
+  window_rewriting( xag );
+  xag = cleanup_dangling( xag );
+
+  CHECK( xag.num_gates() <= size_before );
+  CHECK( simulate<kitty::dynamic_truth_table>( xag, sim ) == tts );
+}
@@ -0,0 +1,135 @@
+#include <catch.hpp>
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/io/batch_reader.hpp>
+#include <mockturtle/io/write_aiger.hpp>
+#include <mockturtle/io/write_blif.hpp>
+#include <mockturtle/io/write_verilog.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/xag.hpp>
+
+#include <kitty/dynamic_truth_table.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+aig_network adder( uint32_t bitwidth )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( bitwidth ), b( bitwidth );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  auto carry = aig.get_constant( false );
+  carry_ripple_adder_inplace( aig, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { aig.create_po( f ); } );
+  aig.create_po( carry );
+  return aig;
+}
+
+template<class Ntk>
+std::vector<kitty::dynamic_truth_table> functions( Ntk const& ntk )
+{
+  return simulate<kitty::dynamic_truth_table>( ntk, default_simulator<kitty::dynamic_truth_table>( ntk.num_pis() ) );
+}
+
+} // namespace
+
+TEST_CASE( "read AIGER files in batch", "[batch_reader]" )
+{
+  std::vector<std::string> filenames;
+  for ( auto i = 1u; i <= 6u; ++i )
+  {
+    filenames.emplace_back( fmt::format( "batch_adder{}.aig", i ) );
+    write_aiger( adder( i ), filenames.back() );
+  }
+  filenames.emplace_back( "batch_missing.aig" );
+
+  for ( auto const in_order : { true, false } )
+  {
+    batch_reader_params ps;
+    ps.num_threads = 3u;
+    ps.in_order = in_order;
+    ps.max_pending = 2u;
+    batch_reader<aig_network> reader( filenames, ps );
+    CHECK( reader.size() == 7u );
+
+    std::set<uint32_t> indices;
+    uint32_t expected_index = 0u;
+    reader.foreach_network( [&]( auto const& result ) {
+      if ( in_order )
+      {
+        CHECK( result.index == expected_index++ );
+      }
+      indices.insert( result.index );
+      CHECK( result.filename == filenames[result.index] );
+      if ( result.index == 6u )
+      {
+        CHECK( !result.success );
+        return;
+      }
+      CHECK( result.success );
+      CHECK( result.memory > 0u );
+      CHECK( result.ntk.num_pis() == 2u * ( result.index + 1u ) );
+      CHECK( functions( result.ntk ) == functions( adder( result.index + 1u ) ) );
+    } );
+    CHECK( indices.size() == 7u );
+    CHECK( !reader.next() );
+  }
+}
+
+TEST_CASE( "read files of different formats in batch", "[batch_reader]" )
+{
+  auto const aig = adder( 3u );
+  write_aiger( aig, "batch_formats.aig" );
+  write_blif( aig, "batch_formats.blif" );
+  write_verilog( aig, "batch_formats.v" );
+
+  batch_reader<klut_network> klut_reader( { "batch_formats.aig", "batch_formats.blif", "batch_formats.unknown" } );
+  auto const klut1 = klut_reader.next();
+  auto const klut2 = klut_reader.next();
+  auto const unknown = klut_reader.next();
+  REQUIRE( klut1 );
+  REQUIRE( klut2 );
+  REQUIRE( unknown );
+  CHECK( klut1->success );
+  CHECK( klut2->success );
+  CHECK( !unknown->success );
+  CHECK( functions( klut1->ntk ) == functions( aig ) );
+  CHECK( functions( klut2->ntk ) == functions( aig ) );
+  CHECK( !klut_reader.next() );
+
+  /* BLIF is not supported for XAGs */
+  batch_reader<xag_network> xag_reader( { "batch_formats.v", "batch_formats.blif" } );
+  auto const xag = xag_reader.next();
+  REQUIRE( xag );
+  CHECK( xag->success );
+  CHECK( functions( xag->ntk ) == functions( aig ) );
+  CHECK( !xag_reader.next()->success );
+}
+
+TEST_CASE( "stop batch reading early", "[batch_reader]" )
+{
+  std::vector<std::string> filenames;
+  for ( auto i = 0u; i < 20u; ++i )
+  {
+    filenames.emplace_back( fmt::format( "batch_stop{}.aig", i ) );
+    write_aiger( adder( 8u ), filenames.back() );
+  }
+
+  batch_reader_params ps;
+  ps.num_threads = 2u;
+  ps.max_pending = 1u;
+  batch_reader<aig_network> reader( filenames, ps );
+  auto const result = reader.next();
+  REQUIRE( result );
+  CHECK( result->success );
+  CHECK( result->index == 0u );
+}
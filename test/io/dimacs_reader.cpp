@@ -1,12 +1,16 @@
 #include <catch.hpp>
 
+#include <cstdio>
 #include <sstream>
 #include <string>
 
+#include <kitty/bit_operations.hpp>
 #include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
 #include <kitty/static_truth_table.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/io/dimacs_reader.hpp>
+#include <mockturtle/io/write_dimacs.hpp>
 #include <mockturtle/networks/xag.hpp>
 
 #include <lorina/pla.hpp>
@@ -40,3 +44,66 @@ TEST_CASE( "read a DIMACS file into an XAG", "[dimacs_reader]" )
   kitty::create_from_expression( expected, "({a!ed}{!aecd}{!c!d})" );
   CHECK( simulate<kitty::static_truth_table<5u>>( xag )[0] == expected );
 }
+
+TEST_CASE( "read a DIMACS buffer into an XAG", "[dimacs_reader]" )
+{
+  xag_network xag;
+
+  /* clauses may span lines, and `%` ends the input */
+  std::string dimacs =
+      "c comment\n"
+      "p cnf 5 3\n"
+      "1 -5 4 0 -1 5\n"
+      "  3 4 0\r\n"
+      "-3 -4 0\n"
+      "%\n"
+      "0\n";
+
+  dimacs_reader reader( xag );
+  auto result = read_dimacs_buffer( dimacs, reader );
+
+  CHECK( result == lorina::return_code::success );
+  CHECK( xag.num_pis() == 5 );
+  CHECK( xag.num_pos() == 1 );
+  CHECK( xag.num_gates() == 8 );
+
+  kitty::static_truth_table<5u> expected;
+  kitty::create_from_expression( expected, "({a!ed}{!aecd}{!c!d})" );
+  CHECK( simulate<kitty::static_truth_table<5u>>( xag )[0] == expected );
+}
+
+TEST_CASE( "detect errors in DIMACS buffers", "[dimacs_reader]" )
+{
+  xag_network xag;
+  dimacs_reader reader( xag );
+
+  CHECK( read_dimacs_buffer( "1 2 0\n", reader ) == lorina::return_code::parse_error );
+  CHECK( read_dimacs_buffer( "p cnf 2\n1 2 0\n", reader ) == lorina::return_code::parse_error );
+  CHECK( read_dimacs_buffer( "p cnf 2 1\n1 x 0\n", reader ) == lorina::return_code::parse_error );
+  CHECK( read_dimacs_buffer( "p cnf 2 1\n1 -2- 0\n", reader ) == lorina::return_code::parse_error );
+}
+
+TEST_CASE( "write and read a DIMACS file", "[dimacs_reader]" )
+{
+  xag_network xag;
+  const auto a = xag.create_pi();
+  const auto b = xag.create_pi();
+  const auto c = xag.create_pi();
+  xag.create_po( xag.create_maj( a, b, xag.create_xor( b, c ) ) );
+
+  write_dimacs( xag, "mockturtle-test.cnf" );
+
+  xag_network xag2;
+  CHECK( read_dimacs_mmap( "mockturtle-test.cnf", dimacs_reader( xag2 ) ) == lorina::return_code::success );
+  std::remove( "mockturtle-test.cnf" );
+
+  /* one input per node of the written network */
+  CHECK( xag2.num_pis() == xag.size() );
+  CHECK( xag2.num_pos() == 1u );
+
+  /* the CNF is satisfiable exactly for the consistent assignments with output 1 */
+  const auto tt = simulate<kitty::dynamic_truth_table>( xag2, default_simulator<kitty::dynamic_truth_table>( xag2.num_pis() ) )[0];
+  CHECK( kitty::count_ones( tt ) == 4u );
+
+  CHECK( read_dimacs_mmap( "mockturtle-missing.cnf", dimacs_reader( xag2 ) ) == lorina::return_code::parse_error );
+}
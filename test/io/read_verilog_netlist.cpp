@@ -0,0 +1,210 @@
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/io/genlib_reader.hpp>
+#include <mockturtle/io/read_verilog_netlist.hpp>
+#include <mockturtle/io/write_verilog.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/views/binding_view.hpp>
+#include <mockturtle/views/names_view.hpp>
+
+#include <kitty/kitty.hpp>
+#include <lorina/genlib.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+template<class Ntk>
+Ntk ripple_adder( uint32_t bitwidth )
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> a( bitwidth ), b( bitwidth );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+  auto carry = ntk.get_constant( false );
+  carry_ripple_adder_inplace( ntk, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { ntk.create_po( f ); } );
+  ntk.create_po( carry );
+  ntk.create_po( ntk.get_constant( true ) );
+  return ntk;
+}
+
+template<class Ntk>
+std::vector<kitty::dynamic_truth_table> simulate_outputs( Ntk const& ntk )
+{
+  return simulate<kitty::dynamic_truth_table>( ntk, default_simulator<kitty::dynamic_truth_table>( ntk.num_pis() ) );
+}
+
+std::string const test_library = "GATE zero 0 O=CONST0;\n"
+                                 "GATE one 0 O=CONST1;\n"
+                                 "GATE inverter 1 O=!a; PIN * INV 1 999 1.0 1.0 1.0 1.0\n"
+                                 "GATE buffer 2 O=a; PIN * NONINV 1 999 1.0 1.0 1.0 1.0\n"
+                                 "GATE and 5 O=a*b; PIN * NONINV 1 999 1.0 1.0 1.0 1.0\n"
+                                 "GATE or 5 O=a+b; PIN * NONINV 1 999 1.0 1.0 1.0 1.0\n"
+                                 "GATE ha 7 C=a*b; PIN * NONINV 1 999 1.0 1.0 1.0 1.0\n"
+                                 "GATE ha 7 S=!a*b+a*!b; PIN * UNKNOWN 1 999 1.0 1.0 1.0 1.0\n";
+
+} // namespace
+
+TEST_CASE( "read structural Verilog into XAG", "[read_verilog_netlist]" )
+{
+  std::string const file{
+      "// comment\n"
+      "module top( a , b , c , y1 , y2 , y3 ) ;\n"
+      "  input a , b , c ;\n"
+      "  output y1 , y2 , y3 ;\n"
+      "  wire g1 , g2 , g3 ;\n"
+      "  assign y1 = g3 ;\n"
+      "  assign g3 = g1 | ~( g2 ^ c ) ; /* out of order */\n"
+      "  assign g1 = a & ~b ;\n"
+      "  assign g2 = a ? b : c ;\n"
+      "  assign y2 = 1'b1 ;\n"
+      "  assign y3 = a ^ b ^ c ;\n"
+      "endmodule\n" };
+
+  names_view<xag_network> xag;
+  read_verilog_netlist_stats st;
+  CHECK( read_verilog_netlist_buffer( file, xag, {}, &st ) == lorina::return_code::success );
+  CHECK( xag.num_pis() == 3u );
+  CHECK( xag.num_pos() == 3u );
+  CHECK( st.num_assigns == 6u );
+  CHECK( xag.get_network_name() == "top" );
+  CHECK( xag.get_name( xag.make_signal( xag.pi_at( 1u ) ) ) == "b" );
+  CHECK( xag.get_output_name( 2u ) == "y3" );
+
+  auto const tts = simulate_outputs( xag );
+  CHECK( kitty::to_hex( tts[0] ) == "f7" );
+  CHECK( kitty::to_hex( tts[1] ) == "ff" );
+  CHECK( kitty::to_hex( tts[2] ) == "96" );
+}
+
+TEST_CASE( "read structural Verilog written by write_verilog", "[read_verilog_netlist]" )
+{
+  auto const check_roundtrip = []( auto const& ntk, auto&& read_ntk ) {
+    std::ostringstream out;
+    write_verilog( ntk, out );
+    CHECK( read_verilog_netlist_buffer( out.str(), read_ntk ) == lorina::return_code::success );
+    CHECK( read_ntk.num_pis() == ntk.num_pis() );
+    CHECK( read_ntk.num_pos() == ntk.num_pos() );
+    CHECK( simulate_outputs( read_ntk ) == simulate_outputs( ntk ) );
+    return read_ntk;
+  };
+
+  check_roundtrip( ripple_adder<xag_network>( 4u ), xag_network{} );
+  check_roundtrip( ripple_adder<xmg_network>( 4u ), xmg_network{} );
+
+  /* majority gates are recovered from their sum-of-products form */
+  auto const mig = ripple_adder<mig_network>( 4u );
+  auto const mig2 = check_roundtrip( mig, mig_network{} );
+  CHECK( mig2.num_gates() == mig.num_gates() );
+}
+
+TEST_CASE( "read structural Verilog with vector ports and names", "[read_verilog_netlist]" )
+{
+  std::string const file{
+      "module other( a , y ) ;\n"
+      "  input a ;\n"
+      "  output y ;\n"
+      "  assign y = ~a ;\n"
+      "endmodule\n"
+      "module adder( x , y ) ;\n"
+      "  input [1:0] x ;\n"
+      "  output [1:0] y ;\n"
+      "  assign y[0] = x[0] ^ x[1] ;\n"
+      "  assign y[1] = x[0] & x[1] ;\n"
+      "endmodule\n" };
+
+  names_view<xag_network> xag;
+  read_verilog_netlist_params ps;
+  ps.module_name = "adder";
+  CHECK( read_verilog_netlist_buffer( file, xag, ps ) == lorina::return_code::success );
+  CHECK( xag.num_pis() == 2u );
+  CHECK( xag.get_name( xag.make_signal( xag.pi_at( 1u ) ) ) == "x[1]" );
+  CHECK( xag.get_output_name( 0u ) == "y[0]" );
+
+  auto const tts = simulate_outputs( xag );
+  CHECK( kitty::to_hex( tts[0] ) == "6" );
+  CHECK( kitty::to_hex( tts[1] ) == "8" );
+
+  /* the first module is read by default */
+  xag_network xag2;
+  CHECK( read_verilog_netlist_buffer( file, xag2 ) == lorina::return_code::success );
+  CHECK( xag2.num_pis() == 1u );
+}
+
+TEST_CASE( "read mapped Verilog into binding_view", "[read_verilog_netlist]" )
+{
+  std::vector<gate> gates;
+  std::istringstream in( test_library );
+  auto const result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  binding_view<klut_network> ntk( gates );
+  auto const a = ntk.create_pi();
+  auto const b = ntk.create_pi();
+  auto const c = ntk.create_pi();
+  auto const f1 = ntk.create_and( a, b );
+  ntk.add_binding( ntk.get_node( f1 ), 4u );
+  auto const f2 = ntk.create_or( f1, c );
+  ntk.add_binding( ntk.get_node( f2 ), 5u );
+  auto const f3 = ntk.create_not( f2 );
+  ntk.add_binding( ntk.get_node( f3 ), 2u );
+  ntk.add_binding( ntk.get_node( ntk.get_constant( false ) ), 0u );
+  ntk.create_po( f3 );
+  ntk.create_po( ntk.get_constant( false ) );
+  ntk.create_po( f2 );
+
+  std::ostringstream out;
+  write_verilog_with_binding( ntk, out );
+
+  binding_view<klut_network> ntk2( gates );
+  read_verilog_netlist_stats st;
+  CHECK( read_verilog_netlist_buffer( out.str(), ntk2, {}, &st ) == lorina::return_code::success );
+  CHECK( st.num_instances == 4u );
+  CHECK( ntk2.num_pis() == 3u );
+  CHECK( ntk2.num_pos() == 3u );
+  CHECK( simulate_outputs( ntk2 ) == simulate_outputs( ntk ) );
+  ntk2.foreach_gate( [&]( auto const& n ) {
+    CHECK( ntk2.has_binding( n ) );
+  } );
+  CHECK( ntk2.compute_area() == ntk.compute_area() );
+
+  /* multi-output cells are connected by output pin names */
+  std::string const file{
+      "module top( a , b , s , c ) ;\n"
+      "  input a , b ;\n"
+      "  output s , c ;\n"
+      "  ha g0( .a (a), .b (b), .S (s), .C (c) );\n"
+      "endmodule\n" };
+
+  binding_view<klut_network> ntk3( gates );
+  CHECK( read_verilog_netlist_buffer( file, ntk3 ) == lorina::return_code::success );
+  auto const tts = simulate_outputs( ntk3 );
+  CHECK( kitty::to_hex( tts[0] ) == "6" );
+  CHECK( kitty::to_hex( tts[1] ) == "8" );
+  CHECK( ntk3.get_binding_index( ntk3.get_node( ntk3.po_at( 0u ) ) ) == 7u );
+}
+
+TEST_CASE( "read structural Verilog with errors", "[read_verilog_netlist]" )
+{
+  auto const parse = []( std::string const& body ) {
+    xag_network xag;
+    return read_verilog_netlist_buffer( "module top( a , y ) ;\n input a ;\n output y ;\n" + body + "endmodule\n", xag );
+  };
+
+  CHECK( parse( "assign y = a ;\n" ) == lorina::return_code::success );
+  CHECK( parse( "assign y = a & ;\n" ) == lorina::return_code::parse_error );
+  CHECK( parse( "assign y = a ;\n assign y = ~a ;\n" ) == lorina::return_code::parse_error );
+  CHECK( parse( "assign y = w ;\n assign w = y ;\n" ) == lorina::return_code::parse_error );
+  CHECK( parse( "and g0( .a (a), .b (a), .O (y) );\n" ) == lorina::return_code::parse_error );
+}
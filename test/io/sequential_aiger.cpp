@@ -0,0 +1,175 @@
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/sequential_aiger.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/sequential.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/views/names_view.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+template<class Ntk>
+std::string to_aiger( Ntk const& ntk, aiger_properties const& props = {} )
+{
+  std::ostringstream os;
+  write_sequential_aiger( ntk, os, props );
+  return os.str();
+}
+
+} // namespace
+
+TEST_CASE( "read sequential AIGER with properties and symbols", "[sequential_aiger]" )
+{
+  /* toggle flip-flop with enable input, one output, one bad state property,
+     one constraint, one justice property with two literals, one fairness constraint */
+  std::string contents = "aig 5 1 2 1 2 1 1 1 1\n"
+                         "10 1\n"
+                         "4 6\n"
+                         "8\n"
+                         "11\n"
+                         "2\n"
+                         "2\n"
+                         "4\n"
+                         "7\n"
+                         "3\n";
+  contents += std::string( { 0x04, 0x02, 0x02, 0x06 } );
+  contents += "i0 enable\nl0 q\nl1 r\no0 out\nb0 never\nc0 assume\nj0 live\nf0 fair\nc\ncomment\n";
+
+  names_view<sequential<aig_network>> aig;
+  aiger_properties props;
+  CHECK( read_sequential_aiger_buffer( contents, aig, &props ) == lorina::return_code::success );
+
+  CHECK( aig.num_pis() == 1u );
+  CHECK( aig.num_registers() == 2u );
+  CHECK( aig.num_pos() == 6u );
+  CHECK( aig.num_gates() == 2u );
+  CHECK( props.num_bad == 1u );
+  CHECK( props.num_constraints == 1u );
+  CHECK( props.justice == std::vector<uint32_t>{ 2u } );
+  CHECK( props.num_fairness == 1u );
+  CHECK( props.num_property_outputs() == 5u );
+
+  CHECK( aig.register_at( 0u ).init == 1u );
+  CHECK( aig.register_at( 1u ).init == 2u );
+  CHECK( aig.ri_at( 1u ) == aig.make_signal( aig.ro_at( 0u ) ) );
+
+  CHECK( aig.get_name( aig.make_signal( aig.pi_at( 0u ) ) ) == "enable" );
+  CHECK( aig.get_name( aig.make_signal( aig.ro_at( 1u ) ) ) == "r" );
+  CHECK( aig.get_output_name( 0u ) == "out" );
+  CHECK( aig.get_output_name( 1u ) == "never" );
+  CHECK( aig.get_output_name( 2u ) == "assume" );
+  CHECK( aig.get_output_name( 3u ) == "live" );
+  CHECK( !aig.has_output_name( 4u ) );
+  CHECK( aig.get_output_name( 5u ) == "fair" );
+
+  /* writing reproduces the file up to the comment section */
+  CHECK( to_aiger( aig, props ) == contents.substr( 0u, contents.find( "c\ncomment" ) ) );
+}
+
+TEST_CASE( "round-trip of sequential XAG through AIGER", "[sequential_aiger]" )
+{
+  sequential<xag_network> xag;
+  auto const a = xag.create_pi();
+  auto const b = xag.create_pi();
+  auto const q0 = xag.create_ro();
+  auto const q1 = xag.create_ro();
+  auto const q2 = xag.create_ro();
+
+  auto const f1 = xag.create_xor( a, q0 );
+  auto const f2 = xag.create_and( f1, !q1 );
+  auto const f3 = xag.create_xor( f2, b );
+  xag.create_po( f3 );
+  xag.create_po( xag.create_and( q0, q2 ) );
+  xag.create_ri( f2 );
+  xag.create_ri( !f3 );
+  xag.create_ri( xag.get_constant( true ) );
+
+  for ( auto i = 0u; i < 3u; ++i )
+  {
+    mockturtle::register_t reg;
+    reg.init = i == 2u ? 2u : i;
+    xag.set_register( i, reg );
+  }
+
+  aiger_properties props;
+  props.num_bad = 1u;
+
+  auto const contents = to_aiger( xag, props );
+  CHECK( contents.substr( 0u, contents.find( '\n' ) ) == "aig 13 2 3 1 8 1" );
+
+  sequential<aig_network> aig;
+  aiger_properties read_props;
+  CHECK( read_sequential_aiger_buffer( contents, aig, &read_props ) == lorina::return_code::success );
+  CHECK( read_props.num_bad == 1u );
+  CHECK( read_props.num_property_outputs() == 1u );
+  CHECK( aig.num_pis() == 2u );
+  CHECK( aig.num_pos() == 2u );
+  CHECK( aig.num_registers() == 3u );
+  CHECK( aig.register_at( 0u ).init == 0u );
+  CHECK( aig.register_at( 1u ).init == 1u );
+  CHECK( aig.register_at( 2u ).init == 2u );
+
+  /* writing the read network again gives the same file */
+  CHECK( to_aiger( aig, read_props ) == contents );
+}
+
+TEST_CASE( "write combinational AIG as AIGER 1.9", "[sequential_aiger]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const dangling = aig.create_or( a, b );
+  (void)dangling;
+  aig.create_po( aig.create_and( a, !b ) );
+
+  auto const contents = to_aiger( aig );
+  CHECK( contents == std::string( "aig 3 2 0 1 1\n6\n" ) + std::string( { 0x01, 0x03 } ) );
+
+  aig_network aig2;
+  CHECK( read_sequential_aiger_buffer( contents, aig2 ) == lorina::return_code::success );
+  CHECK( aig2.num_gates() == 1u );
+
+  /* XOR gates are decomposed into AND gates */
+  xag_network xag;
+  auto const c = xag.create_pi();
+  auto const d = xag.create_pi();
+  auto const e = xag.create_pi();
+  xag.create_po( xag.create_xor( xag.create_and( c, d ), !e ) );
+  xag.create_po( !xag.create_xor( c, e ) );
+
+  aig_network aig3;
+  CHECK( read_sequential_aiger_buffer( to_aiger( xag ), aig3 ) == lorina::return_code::success );
+  CHECK( aig3.num_gates() == 7u );
+
+  default_simulator<kitty::dynamic_truth_table> sim( 3u );
+  CHECK( simulate<kitty::dynamic_truth_table>( xag, sim ) == simulate<kitty::dynamic_truth_table>( aig3, sim ) );
+}
+
+TEST_CASE( "reject malformed sequential AIGER", "[sequential_aiger]" )
+{
+  sequential<aig_network> aig1, aig2, aig3, aig4;
+  CHECK( read_sequential_aiger_buffer( "aag 1 1 0 1 0\n2\n2\n", aig1 ) == lorina::return_code::parse_error );
+  CHECK( read_sequential_aiger_buffer( "aig 3 1 0 1 1\n2\n", aig2 ) == lorina::return_code::parse_error );
+  CHECK( read_sequential_aiger_buffer( "aig 2 1 1 0 0\n2 6\n", aig3 ) == lorina::return_code::parse_error );
+  CHECK( read_sequential_aiger_buffer( "aig 1 0 1 0 0\n2 2\n", aig4 ) == lorina::return_code::success );
+  CHECK( aig4.register_at( 0u ).init == 2u );
+
+  aig_network comb;
+  CHECK( read_sequential_aiger_buffer( "aig 1 0 1 0 0\n2\n", comb ) == lorina::return_code::parse_error );
+
+  /* counts that do not fit into the file are rejected before allocating */
+  sequential<aig_network> aig5, aig6, aig7, aig8;
+  CHECK( read_sequential_aiger_buffer( "aig 4000000000 4000000000 0 0 0\n", aig5 ) == lorina::return_code::parse_error );
+  CHECK( read_sequential_aiger_buffer( "aig 4000000000 0 4000000000 0 0\n", aig6 ) == lorina::return_code::parse_error );
+  CHECK( read_sequential_aiger_buffer( "aig 1 1 0 1 0 0 0 4000000000\n2\n", aig7 ) == lorina::return_code::parse_error );
+  CHECK( read_sequential_aiger_buffer( "aig 2000000 0 0 1 2000000\n2\n", aig8 ) == lorina::return_code::parse_error );
+  CHECK( aig8.size() == 1u );
+}
@@ -40,3 +40,30 @@ TEST_CASE( "write XAG into DIMACS", "[write_dimacs]" )
                       "5 6 7 0\n"
                       "-7 0\n" );
 }
+
+TEST_CASE( "write XAG into compact DIMACS", "[write_dimacs]" )
+{
+  xag_network xag;
+
+  const auto a = xag.create_pi();
+  const auto b = xag.create_pi();
+
+  const auto f1 = xag.create_nand( a, b );
+  const auto f2 = xag.create_nand( a, f1 );
+  const auto f3 = xag.create_nand( b, f1 );
+  const auto f4 = xag.create_nand( f2, f3 );
+
+  xag.create_po( f4 );
+
+  std::ostringstream out;
+  write_dimacs( xag, out, cnf_mapping_params{} );
+
+  /* a single cut rooted in f4 encodes the XNOR of both inputs */
+  CHECK( out.str() == "p cnf 7 6\n"
+                      "-1 0\n"
+                      "-2 3 -7 0\n"
+                      "2 -3 -7 0\n"
+                      "2 3 7 0\n"
+                      "-2 -3 7 0\n"
+                      "-7 0\n" );
+}
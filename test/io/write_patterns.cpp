@@ -30,3 +30,89 @@ TEST_CASE( "write patterns", "[write_patterns]" )
                       "0d4\n"
                       "19a\n" );
 }
+
+TEST_CASE( "write and read binary patterns", "[write_patterns]" )
+{
+  partial_simulator sim( 5, 100 );
+  write_binary_patterns( sim, "patterns.bin" );
+
+  partial_simulator sim2( "patterns.bin" );
+  CHECK( sim2.num_bits() == 100u );
+  CHECK( sim2.get_patterns() == sim.get_patterns() );
+
+  partial_simulator sim3( "patterns.bin", 70u );
+  CHECK( sim3.num_bits() == 70u );
+  auto expected = sim.get_patterns()[4];
+  expected.resize( 70 );
+  CHECK( sim3.get_patterns()[4] == expected );
+
+  /* text files are still read */
+  write_patterns( sim, "patterns.txt" );
+  partial_simulator sim4( "patterns.txt" );
+  CHECK( sim4.get_patterns() == sim.get_patterns() );
+}
+
+TEST_CASE( "append binary patterns", "[write_patterns]" )
+{
+  partial_simulator sim( 3, 100 );
+  CHECK( append_binary_patterns( sim, "append.bin" ) == 100u );
+
+  partial_simulator sim2( "append.bin" );
+  for ( auto i = 0u; i < 37u; ++i )
+  {
+    sim2.add_pattern( { i % 2 == 0, i % 3 == 0, i % 5 == 0 } );
+  }
+  CHECK( append_binary_patterns( sim2, "append.bin" ) == 37u );
+  /* the file no longer holds exactly the patterns read by `sim2` */
+  CHECK( append_binary_patterns( sim2, "append.bin" ) == 137u );
+
+  partial_simulator sim3( "append.bin" );
+  CHECK( sim3.num_bits() == 137u );
+  CHECK( sim3.get_patterns() == sim2.get_patterns() );
+
+  for ( auto i = 0u; i < 91u; ++i )
+  {
+    sim3.add_pattern( { i % 7 == 0, true, i % 2 == 1 } );
+  }
+  save_simulation_patterns( sim3, "append.bin", true, std::string( "append.bin" ) );
+
+  partial_simulator sim4( "append.bin" );
+  CHECK( sim4.num_bits() == 228u );
+  CHECK( sim4.get_patterns() == sim3.get_patterns() );
+
+  /* a file with more patterns is overwritten */
+  CHECK( append_binary_patterns( sim, "append.bin" ) == 100u );
+  CHECK( partial_simulator( "append.bin" ).get_patterns() == sim.get_patterns() );
+}
+
+TEST_CASE( "save binary patterns after reseeding or partial loading", "[write_patterns]" )
+{
+  partial_simulator sim( 4, 100 );
+  write_binary_patterns( sim, "reseed.bin" );
+
+  /* a reseeded simulator replaces all patterns read from the file */
+  partial_simulator sim2( "reseed.bin" );
+  CHECK( sim2.num_file_patterns() == 100u );
+  sim2 = partial_simulator( 4, 130, 7 );
+  CHECK( !sim2.num_file_patterns() );
+  sim2.add_pattern( { true, false, true, false } );
+  save_simulation_patterns( sim2, "reseed.bin", true, std::string( "reseed.bin" ) );
+  CHECK( partial_simulator( "reseed.bin" ).get_patterns() == sim2.get_patterns() );
+
+  /* a simulator keeping only a part of the file adds patterns at a different position */
+  partial_simulator sim3( "reseed.bin", 60u );
+  CHECK( !sim3.num_file_patterns() );
+  for ( auto i = 0u; i < 90u; ++i )
+  {
+    sim3.add_pattern( { i % 2 == 0, i % 3 == 0, true, i % 5 == 0 } );
+  }
+  save_simulation_patterns( sim3, "reseed.bin", true, std::string( "reseed.bin" ) );
+  CHECK( partial_simulator( "reseed.bin" ).get_patterns() == sim3.get_patterns() );
+
+  /* keeping more patterns than the file has leaves the file as a prefix */
+  partial_simulator sim4( "reseed.bin", 200u );
+  CHECK( sim4.num_file_patterns() == 150u );
+  sim4.add_pattern( { false, false, true, true } );
+  CHECK( append_binary_patterns( sim4, "reseed.bin" ) == 51u );
+  CHECK( partial_simulator( "reseed.bin" ).get_patterns() == sim4.get_patterns() );
+}
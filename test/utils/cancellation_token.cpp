@@ -0,0 +1,52 @@
+#include <catch.hpp>
+
+#include <chrono>
+#include <thread>
+
+#include <mockturtle/utils/cancellation_token.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "Cancel a token and its copies", "[cancellation_token]" )
+{
+  cancellation_token token;
+  auto const copy = token;
+  CHECK( !token.is_cancelled() );
+  CHECK( !copy.is_cancelled() );
+
+  copy.cancel();
+  CHECK( token.is_cancelled() );
+  CHECK( copy.is_cancelled() );
+
+  token.reset();
+  CHECK( !token.is_cancelled() );
+  CHECK( !copy.is_cancelled() );
+
+  /* a new token has its own state */
+  cancellation_token other;
+  token.cancel();
+  CHECK( !other.is_cancelled() );
+}
+
+TEST_CASE( "Cancel a token at a deadline", "[cancellation_token]" )
+{
+  cancellation_token token;
+  token.set_timeout( std::chrono::hours( 1 ) );
+  CHECK( !token.is_cancelled() );
+
+  token.set_deadline( cancellation_token::clock::now() - std::chrono::seconds( 1 ) );
+  CHECK( token.is_cancelled() );
+
+  token.reset();
+  token.set_timeout( std::chrono::milliseconds( 1 ) );
+  std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+  CHECK( token.is_cancelled() );
+}
+
+TEST_CASE( "Cancel a token from another thread", "[cancellation_token]" )
+{
+  cancellation_token token;
+  std::thread t( [token]() { token.cancel(); } );
+  t.join();
+  CHECK( token.is_cancelled() );
+}
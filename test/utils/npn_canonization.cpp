@@ -0,0 +1,145 @@
+#include <catch.hpp>
+
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/npn.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/operators.hpp>
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/utils/npn_canonization.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "NPN canonization cache matches exact canonization for small functions", "[npn_canonization]" )
+{
+  npn_canonization_cache cache;
+
+  kitty::static_truth_table<3> tt3;
+  do
+  {
+    CHECK( cache( tt3 ) == kitty::exact_npn_canonization( tt3 ) );
+    kitty::next_inplace( tt3 );
+  } while ( !kitty::is_const0( tt3 ) );
+
+  kitty::static_truth_table<4> tt4;
+  do
+  {
+    auto const expected = kitty::exact_npn_canonization( tt4 );
+    CHECK( cache( tt4 ) == expected );
+
+    /* a second query is served by the table */
+    CHECK( cache( tt4 ) == expected );
+
+    kitty::dynamic_truth_table dtt( 4 );
+    kitty::create_from_words( dtt, &tt4._bits, &tt4._bits + 1 );
+    auto const [repr, phase, perm] = cache( dtt );
+    CHECK( repr._bits[0] == std::get<0>( expected )._bits );
+    CHECK( phase == std::get<1>( expected ) );
+    CHECK( perm == std::get<2>( expected ) );
+
+    kitty::next_inplace( tt4 );
+  } while ( !kitty::is_const0( tt4 ) );
+
+  CHECK( cache.size() == 256u + 65536u );
+}
+
+TEST_CASE( "NPN canonization cache ignores bits beyond the truth table", "[npn_canonization]" )
+{
+  npn_canonization_cache cache;
+
+  kitty::static_truth_table<3> tt3;
+  tt3._bits = 0xffffffffffff0096;
+  kitty::static_truth_table<3> masked;
+  masked._bits = 0x96;
+  CHECK( cache( tt3 ) == kitty::exact_npn_canonization( masked ) );
+
+  kitty::dynamic_truth_table tt4( 4 ), masked4( 4 );
+  tt4._bits[0] = 0xabcd00000000e8e8;
+  masked4._bits[0] = 0xe8e8;
+  CHECK( cache( tt4 ) == kitty::exact_npn_canonization( masked4 ) );
+
+  kitty::static_truth_table<5> tt5;
+  tt5._bits = 0x1234567800000000 | 0x8ee8e88e;
+  kitty::static_truth_table<5> masked5;
+  masked5._bits = 0x8ee8e88e;
+  CHECK( cache( tt5 ) == kitty::exact_npn_canonization( masked5 ) );
+}
+
+TEST_CASE( "NPN canonization cache memoizes 5- and 6-input functions", "[npn_canonization]" )
+{
+  npn_canonization_cache cache( 30u );
+  std::mt19937 rng( 42 );
+
+  for ( auto i = 0u; i < 20u; ++i )
+  {
+    kitty::static_truth_table<5> tt5;
+    kitty::create_random( tt5, rng() );
+    CHECK( cache( tt5 ) == kitty::exact_npn_canonization( tt5 ) );
+    CHECK( cache( tt5 ) == kitty::exact_npn_canonization( tt5 ) );
+
+    kitty::dynamic_truth_table tt6( 6 );
+    kitty::create_random( tt6, rng() );
+    CHECK( cache( tt6 ) == kitty::exact_npn_canonization( tt6 ) );
+  }
+
+  /* the number of memoized functions is limited */
+  CHECK( cache.size() == 30u );
+}
+
+TEST_CASE( "NPN canonization cache from several threads", "[npn_canonization]" )
+{
+  npn_canonization_cache cache;
+
+  std::vector<std::thread> threads;
+  std::vector<uint32_t> mismatches( 4u, 0u );
+  for ( auto t = 0u; t < 4u; ++t )
+  {
+    threads.emplace_back( [&, t]() {
+      std::mt19937 rng( 7 );
+      for ( auto i = 0u; i < 200u; ++i )
+      {
+        kitty::static_truth_table<4> tt4;
+        tt4._bits = rng() & 0xffff;
+        kitty::static_truth_table<5> tt5;
+        kitty::create_random( tt5, rng() % 16u );
+        if ( cache( tt4 ) != kitty::exact_npn_canonization( tt4 ) || cache( tt5 ) != kitty::exact_npn_canonization( tt5 ) )
+        {
+          ++mismatches[t];
+        }
+      }
+    } );
+  }
+  for ( auto& t : threads )
+  {
+    t.join();
+  }
+
+  CHECK( mismatches == std::vector<uint32_t>( 4u, 0u ) );
+}
+
+TEST_CASE( "Save and load NPN canonization cache", "[npn_canonization]" )
+{
+  npn_canonization_cache cache;
+  cache.precompute( 3u );
+
+  kitty::static_truth_table<6> tt6;
+  kitty::create_from_hex_string( tt6, "8ff08ff0deadbeef" );
+  auto const expected6 = cache( tt6 );
+  CHECK( cache.size() == 2u + 4u + 16u + 256u + 1u );
+
+  CHECK( cache.save( "npn.cache" ) );
+
+  npn_canonization_cache loaded;
+  CHECK( loaded.load( "npn.cache" ) );
+  CHECK( loaded.size() == cache.size() );
+  CHECK( loaded( tt6 ) == expected6 );
+  CHECK( loaded.size() == cache.size() );
+
+  std::remove( "npn.cache" );
+  CHECK( !loaded.load( "npn.cache" ) );
+}
@@ -0,0 +1,164 @@
+#include <catch.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <mockturtle/utils/index_list/index_list.hpp>
+#include <mockturtle/utils/structure_cache.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+kitty::dynamic_truth_table function( uint32_t num_vars, uint64_t word )
+{
+  kitty::dynamic_truth_table tt( num_vars );
+  kitty::create_from_words( tt, &word, &word + 1 );
+  return tt;
+}
+
+} // namespace
+
+TEST_CASE( "Insert and look up structures", "[structure_cache]" )
+{
+  structure_cache<xag_index_list<>> cache;
+
+  xag_index_list<> and2( 2u );
+  and2.add_output( and2.add_and( 2u, 4u ) );
+  xag_index_list<> xor2( 2u );
+  xor2.add_output( xor2.add_xor( 2u, 4u ) );
+
+  CHECK( !cache.lookup( function( 2u, 0x8 ) ) );
+  cache.insert( function( 2u, 0x8 ), { and2 } );
+  cache.insert( function( 2u, 0x6 ), { xor2, and2 } );
+  cache.insert( function( 3u, 0x80 ), {} );
+
+  CHECK( cache.size() == 3u );
+  CHECK( cache.lookup( function( 2u, 0x8 ) )->size() == 1u );
+  CHECK( ( *cache.lookup( function( 2u, 0x8 ) ) )[0].raw() == and2.raw() );
+  CHECK( ( *cache.lookup( function( 2u, 0x6 ) ) )[1].raw() == and2.raw() );
+  CHECK( cache.lookup( function( 3u, 0x80 ) )->empty() );
+
+  /* same bits, but different number of variables */
+  CHECK( !cache.lookup( function( 3u, 0x8 ) ) );
+
+  auto const st = cache.stats();
+  CHECK( st.hits == 4u );
+  CHECK( st.misses == 2u );
+
+  /* looked up structures are shared with the cache and outlive their entry */
+  auto const entry = cache.lookup( function( 2u, 0x6 ) );
+  CHECK( entry == cache.lookup( function( 2u, 0x6 ) ) );
+  cache.clear();
+  CHECK( ( *entry )[0].raw() == xor2.raw() );
+}
+
+TEST_CASE( "Evict least recently used structures", "[structure_cache]" )
+{
+  /* at most one entry in each shard */
+  structure_cache<mig_index_list> cache( 16u );
+
+  mig_index_list maj( 3u );
+  maj.add_output( maj.add_maj( 2u, 4u, 6u ) );
+
+  for ( auto i = 0u; i < 256u; ++i )
+  {
+    cache.insert( function( 3u, i ), { maj } );
+  }
+  CHECK( cache.size() <= 16u );
+  CHECK( cache.stats().evictions == 256u - cache.size() );
+
+  /* the last inserted function is the most recently used one in its shard */
+  CHECK( cache.lookup( function( 3u, 255u ) ) );
+}
+
+TEST_CASE( "Save and load structure cache", "[structure_cache]" )
+{
+  structure_cache<xag_index_list<>> cache;
+
+  std::vector<xag_index_list<>> lists;
+  for ( auto i = 0u; i < 100u; ++i )
+  {
+    xag_index_list<> list( 4u );
+    auto const lit = list.add_and( 2u + ( i & 1u ), 4u );
+    list.add_output( list.add_xor( lit, 6u + ( ( i >> 1 ) & 1u ) ) );
+    cache.insert( function( 4u, i * 7919u ), { list } );
+    lists.emplace_back( list );
+  }
+  cache.insert( function( 6u, 0xdeadbeef ), {} );
+
+  CHECK( cache.save( "structures.cache" ) );
+
+  structure_cache<xag_index_list<>> loaded;
+  CHECK( loaded.load( "structures.cache" ) );
+  CHECK( loaded.size() == cache.size() );
+  for ( auto i = 0u; i < 100u; ++i )
+  {
+    auto const entry = loaded.lookup( function( 4u, i * 7919u ) );
+    CHECK( entry );
+    CHECK( ( *entry )[0].raw() == lists[i].raw() );
+  }
+  CHECK( loaded.lookup( function( 6u, 0xdeadbeef ) )->empty() );
+
+  /* files are not loaded into caches of another index list type */
+  structure_cache<mig_index_list> other;
+  CHECK( !other.load( "structures.cache" ) );
+
+  /* a corrupt size is rejected before allocating the values */
+  {
+    std::ifstream in( "structures.cache", std::ifstream::binary );
+    std::string contents( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+    uint32_t const num_values = 0xffffffffu;
+    std::memcpy( &contents[sizeof( detail::structure_cache_header ) + sizeof( uint32_t )], &num_values, sizeof( num_values ) );
+    std::ofstream( "corrupt.cache", std::ofstream::binary ) << contents;
+  }
+  structure_cache<xag_index_list<>> corrupt;
+  CHECK( !corrupt.load( "corrupt.cache" ) );
+  CHECK( corrupt.size() == 0u );
+  std::remove( "corrupt.cache" );
+
+  std::remove( "structures.cache" );
+  CHECK( !loaded.load( "structures.cache" ) );
+}
+
+TEST_CASE( "Structure cache from several threads", "[structure_cache]" )
+{
+  structure_cache<xag_index_list<>> cache( 64u );
+
+  std::vector<std::thread> threads;
+  std::vector<uint32_t> mismatches( 4u, 0u );
+  for ( auto t = 0u; t < 4u; ++t )
+  {
+    threads.emplace_back( [&, t]() {
+      for ( auto i = 0u; i < 1000u; ++i )
+      {
+        auto const word = ( i * 31u + t ) % 200u;
+        xag_index_list<> list( 3u );
+        list.add_output( 2u * ( word % 3u + 1u ) );
+        if ( auto const entry = cache.lookup( function( 3u, word ) ) )
+        {
+          mismatches[t] += ( *entry )[0].raw() == list.raw() ? 0u : 1u;
+        }
+        else
+        {
+          cache.insert( function( 3u, word ), { list } );
+        }
+      }
+    } );
+  }
+  for ( auto& t : threads )
+  {
+    t.join();
+  }
+
+  CHECK( mismatches == std::vector<uint32_t>( 4u, 0u ) );
+  CHECK( cache.size() <= 64u );
+}
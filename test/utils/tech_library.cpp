@@ -1,6 +1,7 @@
 #include <catch.hpp>
 
 #include <cstdint>
+#include <cstdio>
 #include <vector>
 
 #include <lorina/genlib.hpp>
@@ -1114,4 +1115,71 @@ TEST_CASE( "Complete library generation", "[tech_library]" )
 
     kitty::exact_np_enumeration( tt, test_enumeration );
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Library loaded from cache file", "[tech_library]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( multioutput_test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+
+  CHECK( result == lorina::return_code::success );
+
+  tech_library_params tps;
+  tps.load_multioutput_gates = true;
+  tech_library<2, classification_type::np_configurations> lib( gates, tps );
+  CHECK( !lib.loaded_from_cache() );
+
+  std::remove( "tech_library.cache" );
+  tps.cache_filename = "tech_library.cache";
+  tech_library<2, classification_type::np_configurations> lib_write( gates, tps );
+  CHECK( !lib_write.loaded_from_cache() );
+
+  for ( auto const mmap : { true, false } )
+  {
+    tps.mmap_cache = mmap;
+    tech_library<2, classification_type::np_configurations> lib_cached( gates, tps );
+    CHECK( lib_cached.loaded_from_cache() );
+    CHECK( lib_cached.max_gate_size() == lib.max_gate_size() );
+    CHECK( lib_cached.get_inverter_info() == lib.get_inverter_info() );
+    CHECK( lib_cached.get_buffer_info() == lib.get_buffer_info() );
+    CHECK( lib_cached.num_multioutput_gates() == lib.num_multioutput_gates() );
+
+    for ( uint64_t func = 0u; func < 16u; ++func )
+    {
+      kitty::static_truth_table<2> tt;
+      kitty::create_from_words( tt, &func, &func + 1 );
+      auto const expected = lib.get_supergates( kitty::extend_to<6>( tt ) );
+      auto const actual = lib_cached.get_supergates( kitty::extend_to<6>( tt ) );
+      CHECK( lib_cached.get_multi_function_id( kitty::extend_to<6>( tt )._bits ) == lib.get_multi_function_id( kitty::extend_to<6>( tt )._bits ) );
+      REQUIRE( ( expected == nullptr ) == ( actual == nullptr ) );
+      if ( expected == nullptr )
+      {
+        continue;
+      }
+      REQUIRE( expected->size() == actual->size() );
+      for ( auto i = 0u; i < expected->size(); ++i )
+      {
+        CHECK( ( *expected )[i].root->root->name == ( *actual )[i].root->root->name );
+        CHECK( ( *expected )[i].area == ( *actual )[i].area );
+        CHECK( ( *expected )[i].tdelay == ( *actual )[i].tdelay );
+        CHECK( ( *expected )[i].permutation == ( *actual )[i].permutation );
+        CHECK( ( *expected )[i].polarity == ( *actual )[i].polarity );
+      }
+    }
+  }
+
+  /* a cache for different parameters is replaced */
+  tps.ignore_symmetries = true;
+  tech_library<2, classification_type::np_configurations> lib_other( gates, tps );
+  CHECK( !lib_other.loaded_from_cache() );
+  tech_library<2, classification_type::np_configurations> lib_other_cached( gates, tps );
+  CHECK( lib_other_cached.loaded_from_cache() );
+
+  /* a cache for a different configuration is not used */
+  tech_library<2, classification_type::p_configurations> lib_p( gates, tps );
+  CHECK( !lib_p.loaded_from_cache() );
+
+  std::remove( "tech_library.cache" );
+}
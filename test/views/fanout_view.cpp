@@ -298,4 +298,27 @@ TEST_CASE( "substitute node with no restrash complemented node in fanout view",
   CHECK( faig.fanout_size( faig.get_node( f2 ) ) == 1 );
 
   CHECK( simulate<kitty::static_truth_table<2u>>( faig )[0]._bits == 0x7 );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "fanouts of a copied fanout view are updated once", "[fanout_view]" )
+{
+  aig_network aig;
+  fanout_view faig( aig );
+  auto const x1 = faig.create_pi();
+  auto const x2 = faig.create_pi();
+  auto const x3 = faig.create_pi();
+  auto const f1 = faig.create_and( x1, x2 );
+  faig.create_po( f1 );
+
+  {
+    fanout_view<aig_network> faig_copy{ faig }; // copy ctor
+    faig_copy.create_po( faig_copy.create_and( f1, x3 ) );
+
+    CHECK( faig_copy.fanout( faig.get_node( f1 ) ).size() == 1u );
+  }
+
+  /* the view and its copy both update their own fanouts */
+  CHECK( faig.fanout( faig.get_node( f1 ) ).size() == 1u );
+  CHECK( faig.fanout( faig.get_node( x1 ) ).size() == 1u );
+  CHECK( faig.fanout( faig.get_node( x3 ) ).size() == 1u );
+}
@@ -120,3 +120,43 @@ TEST_CASE( "copy names", "[names_view]" )
   test_copy_names_view<xmg_network>();
   test_copy_names_view<klut_network>();
 }
+
+template<typename Ntk>
+void test_shared_names_view()
+{
+  names_view<Ntk> named_ntk;
+  auto const a = named_ntk.create_pi( "a" );
+  auto const b = named_ntk.create_pi( "b" );
+  named_ntk.create_po( named_ntk.create_and( a, b ), "f" );
+  named_ntk.create_po( a );
+
+  CHECK( has_get_name_view_v<names_view<Ntk>> );
+  CHECK( has_get_output_name_view_v<names_view<Ntk>> );
+  CHECK( named_ntk.get_name_view( a ) == "a" );
+  CHECK( named_ntk.get_output_name_view( 0 ) == "f" );
+  CHECK( !named_ntk.has_output_name( 1 ) );
+  CHECK_THROWS_AS( named_ntk.get_output_name_view( 1 ), std::out_of_range );
+  CHECK_THROWS_AS( named_ntk.get_name( named_ntk.get_constant( false ) ), std::out_of_range );
+
+  /* names are copied on the first change */
+  names_view<Ntk> copy = named_ntk;
+  copy.set_name( a, "x" );
+  copy.set_output_name( 1, "a" );
+  CHECK( copy.get_name( a ) == "x" );
+  CHECK( copy.get_name( b ) == "b" );
+  CHECK( copy.get_output_name( 1 ) == "a" );
+  CHECK( named_ntk.get_name( a ) == "a" );
+  CHECK( !named_ntk.has_output_name( 1 ) );
+
+  /* equal names share their storage */
+  copy.set_name( b, "a" );
+  CHECK( copy.get_output_name_view( 1 ).data() == copy.get_name_view( b ).data() );
+  CHECK( copy.get_name_view( a ).data() != named_ntk.get_name_view( a ).data() );
+}
+
+TEST_CASE( "share names between copies", "[names_view]" )
+{
+  test_shared_names_view<aig_network>();
+  test_shared_names_view<xag_network>();
+  test_shared_names_view<klut_network>();
+}